@@ -0,0 +1,45 @@
+#include <map>
+#include <benchmark/benchmark.h>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
+#include "generators.hpp"
+
+
+namespace
+{
+
+void BM_pddlToDomain(benchmark::State& pState)
+{
+  const auto domainPddl = logisticsDomainPddl();
+  for (auto _ : pState)
+  {
+    std::map<std::string, ogp::Domain> loadedDomains;
+    auto domain = ogp::pddlToDomain(domainPddl, loadedDomains);
+    benchmark::DoNotOptimize(domain);
+  }
+}
+
+
+void BM_pddlToProblem(benchmark::State& pState)
+{
+  std::map<std::string, ogp::Domain> loadedDomains;
+  auto domain = ogp::pddlToDomain(logisticsDomainPddl(), loadedDomains);
+  loadedDomains.emplace(domain.getName(), std::move(domain));
+  const auto problemPddl = logisticsProblemPddl(static_cast<std::size_t>(pState.range(0)),
+                                                static_cast<std::size_t>(pState.range(1)),
+                                                static_cast<std::size_t>(pState.range(2)));
+  for (auto _ : pState)
+  {
+    auto domainAndProblem = ogp::pddlToProblem(problemPddl, loadedDomains);
+    benchmark::DoNotOptimize(domainAndProblem.problemPtr);
+  }
+}
+
+}
+
+
+BENCHMARK(BM_pddlToDomain);
+BENCHMARK(BM_pddlToProblem)
+    ->ArgNames({"trucks", "locations", "goals"})
+    ->Args({1, 4, 4})->Args({4, 16, 32})->Args({16, 64, 256});
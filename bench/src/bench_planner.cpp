@@ -0,0 +1,135 @@
+#include <list>
+#include <benchmark/benchmark.h>
+#include <orderedgoalsplanner/orderedgoalsplanner.hpp>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/parallelplan.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/types/setofcallbacks.hpp>
+#include "generators.hpp"
+
+
+namespace
+{
+const std::unique_ptr<std::chrono::steady_clock::time_point> _now = {};
+
+enum class DomainKind
+{
+  LOGISTICS,
+  ROVER
+};
+
+
+ogp::DomainAndProblemPtrs _load(DomainKind pDomainKind,
+                                const benchmark::State& pState)
+{
+  auto nbOfAgents = static_cast<std::size_t>(pState.range(0));
+  auto nbOfPlaces = static_cast<std::size_t>(pState.range(1));
+  auto nbOfGoals = static_cast<std::size_t>(pState.range(2));
+  if (pDomainKind == DomainKind::LOGISTICS)
+    return loadDomainAndProblem(logisticsDomainPddl(), logisticsProblemPddl(nbOfAgents, nbOfPlaces, nbOfGoals));
+  return loadDomainAndProblem(roverDomainPddl(), roverProblemPddl(nbOfAgents, nbOfPlaces, nbOfGoals));
+}
+
+
+void BM_planForEveryGoals(benchmark::State& pState, DomainKind pDomainKind)
+{
+  auto domainAndProblem = _load(pDomainKind, pState);
+  std::size_t planSize = 0;
+  for (auto _ : pState)
+  {
+    pState.PauseTiming();
+    auto problem = *domainAndProblem.problemPtr;
+    pState.ResumeTiming();
+    auto plan = ogp::planForEveryGoals(problem, *domainAndProblem.domainPtr, _now);
+    planSize = plan.size();
+    benchmark::DoNotOptimize(plan);
+  }
+  pState.counters["actions"] = static_cast<double>(planSize);
+}
+
+
+/// Same as planForEveryGoals but without trying to find a more optimal solution at each step.
+void BM_planForEveryGoalsWithoutLookahead(benchmark::State& pState, DomainKind pDomainKind)
+{
+  auto domainAndProblem = _load(pDomainKind, pState);
+  const auto& domain = *domainAndProblem.domainPtr;
+  ogp::SetOfCallbacks callbacks;
+  std::size_t planSize = 0;
+  for (auto _ : pState)
+  {
+    pState.PauseTiming();
+    auto problem = *domainAndProblem.problemPtr;
+    pState.ResumeTiming();
+    planSize = 0;
+    while (true)
+    {
+      auto actions = ogp::planForMoreImportantGoalPossible(problem, domain, false, _now);
+      if (actions.empty())
+        break;
+      ogp::notifyActionDone(problem, domain, callbacks, actions.front(), _now);
+      ++planSize;
+    }
+  }
+  pState.counters["actions"] = static_cast<double>(planSize);
+}
+
+
+void BM_notifyActionDone(benchmark::State& pState, DomainKind pDomainKind)
+{
+  auto domainAndProblem = _load(pDomainKind, pState);
+  const auto& domain = *domainAndProblem.domainPtr;
+  ogp::SetOfCallbacks callbacks;
+  auto problemForPlan = *domainAndProblem.problemPtr;
+  const auto plan = ogp::planForEveryGoals(problemForPlan, domain, _now);
+  for (auto _ : pState)
+  {
+    pState.PauseTiming();
+    auto problem = *domainAndProblem.problemPtr;
+    pState.ResumeTiming();
+    for (const auto& currAction : plan)
+      ogp::notifyActionDone(problem, domain, callbacks, currAction, _now);
+  }
+  pState.SetItemsProcessed(pState.iterations() * static_cast<int64_t>(plan.size()));
+}
+
+
+void BM_toParallelPlan(benchmark::State& pState, DomainKind pDomainKind)
+{
+  auto domainAndProblem = _load(pDomainKind, pState);
+  std::size_t nbOfSteps = 0;
+  for (auto _ : pState)
+  {
+    pState.PauseTiming();
+    auto problem = *domainAndProblem.problemPtr;
+    pState.ResumeTiming();
+    auto parallelPlan = ogp::parallelPlanForEveryGoals(problem, *domainAndProblem.domainPtr, _now, nullptr);
+    nbOfSteps = parallelPlan.actionsToDoInParallel.size();
+    benchmark::DoNotOptimize(parallelPlan);
+  }
+  pState.counters["steps"] = static_cast<double>(nbOfSteps);
+}
+
+
+void _logisticsArgs(benchmark::internal::Benchmark* pBenchmark)
+{
+  pBenchmark->ArgNames({"trucks", "locations", "goals"})
+      ->Args({1, 4, 2})->Args({2, 4, 4})->Args({2, 8, 8});
+}
+
+void _roverArgs(benchmark::internal::Benchmark* pBenchmark)
+{
+  pBenchmark->ArgNames({"rovers", "waypoints", "goals"})
+      ->Args({1, 4, 4})->Args({4, 8, 16})->Args({8, 20, 40});
+}
+
+}
+
+
+BENCHMARK_CAPTURE(BM_planForEveryGoals, logistics, DomainKind::LOGISTICS)->Apply(_logisticsArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_planForEveryGoals, rover, DomainKind::ROVER)->Apply(_roverArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_planForEveryGoalsWithoutLookahead, logistics, DomainKind::LOGISTICS)->Apply(_logisticsArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_planForEveryGoalsWithoutLookahead, rover, DomainKind::ROVER)->Apply(_roverArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_notifyActionDone, logistics, DomainKind::LOGISTICS)->Apply(_logisticsArgs);
+BENCHMARK_CAPTURE(BM_notifyActionDone, rover, DomainKind::ROVER)->Apply(_roverArgs);
+BENCHMARK_CAPTURE(BM_toParallelPlan, logistics, DomainKind::LOGISTICS)->Apply(_logisticsArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_toParallelPlan, rover, DomainKind::ROVER)->Apply(_roverArgs)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,88 @@
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/types/setofcallbacks.hpp>
+#include "generators.hpp"
+
+
+namespace
+{
+const std::unique_ptr<std::chrono::steady_clock::time_point> _now = {};
+
+
+ogp::DomainAndProblemPtrs _load(const benchmark::State& pState)
+{
+  return loadDomainAndProblem(logisticsDomainPddl(),
+                              logisticsProblemPddl(static_cast<std::size_t>(pState.range(0)),
+                                                   static_cast<std::size_t>(pState.range(1)),
+                                                   static_cast<std::size_t>(pState.range(2))));
+}
+
+
+/// Facts moving every package of the problem to another location.
+std::vector<ogp::Fact> _packageMoves(const ogp::DomainAndProblemPtrs& pDomainAndProblem,
+                                     const benchmark::State& pState)
+{
+  auto nbOfLocations = static_cast<std::size_t>(pState.range(1));
+  auto nbOfPackages = static_cast<std::size_t>(pState.range(2));
+  std::vector<ogp::Fact> res;
+  res.reserve(nbOfPackages);
+  for (std::size_t i = 0; i < nbOfPackages; ++i)
+    res.emplace_back("(package-at package" + std::to_string(i) + " location" + std::to_string(i % nbOfLocations) + ")",
+                     true, pDomainAndProblem.domainPtr->getOntology(), pDomainAndProblem.problemPtr->entities,
+                     std::vector<ogp::Parameter>());
+  return res;
+}
+
+
+void BM_addFacts(benchmark::State& pState)
+{
+  auto domainAndProblem = _load(pState);
+  const auto& domain = *domainAndProblem.domainPtr;
+  const auto facts = _packageMoves(domainAndProblem, pState);
+  ogp::SetOfCallbacks callbacks;
+  for (auto _ : pState)
+  {
+    pState.PauseTiming();
+    auto problem = *domainAndProblem.problemPtr;
+    pState.ResumeTiming();
+    problem.worldState.addFacts(facts, problem.goalStack, domain.getSetOfEvents(), callbacks,
+                                domain.getOntology(), problem.entities, _now);
+  }
+  pState.SetItemsProcessed(pState.iterations() * static_cast<int64_t>(facts.size()));
+}
+
+
+void BM_setOfFactsFind(benchmark::State& pState)
+{
+  auto domainAndProblem = _load(pState);
+  auto& problem = *domainAndProblem.problemPtr;
+  const auto facts = _packageMoves(domainAndProblem, pState);
+  ogp::SetOfCallbacks callbacks;
+  problem.worldState.addFacts(facts, problem.goalStack, domainAndProblem.domainPtr->getSetOfEvents(), callbacks,
+                              domainAndProblem.domainPtr->getOntology(), problem.entities, _now);
+  const auto& setOfFacts = problem.worldState.factsMapping();
+  for (auto _ : pState)
+  {
+    for (const auto& currFact : facts)
+    {
+      auto factsFound = setOfFacts.find(currFact);
+      benchmark::DoNotOptimize(factsFound.empty());
+    }
+  }
+  pState.SetItemsProcessed(pState.iterations() * static_cast<int64_t>(facts.size()));
+}
+
+
+void _worldStateArgs(benchmark::internal::Benchmark* pBenchmark)
+{
+  pBenchmark->ArgNames({"trucks", "locations", "packages"})
+      ->Args({1, 4, 8})->Args({4, 16, 64})->Args({16, 64, 512});
+}
+
+}
+
+
+BENCHMARK(BM_addFacts)->Apply(_worldStateArgs);
+BENCHMARK(BM_setOfFactsFind)->Apply(_worldStateArgs);
@@ -0,0 +1,151 @@
+#include "generators.hpp"
+#include <map>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+
+
+namespace
+{
+
+std::string _objects(const std::string& pPrefix,
+                     std::size_t pNbOfObjects,
+                     const std::string& pType)
+{
+  std::string res;
+  for (std::size_t i = 0; i < pNbOfObjects; ++i)
+    res += pPrefix + std::to_string(i) + " ";
+  return res + "- " + pType + "\n";
+}
+
+}
+
+
+std::string logisticsDomainPddl()
+{
+  return "(define (domain logistics)\n"
+         "  (:requirements :strips :typing)\n"
+         "  (:types truck location package)\n"
+         "  (:predicates\n"
+         "    (at ?t - truck ?l - location)\n"
+         "    (package-at ?p - package ?l - location)\n"
+         "    (in ?p - package ?t - truck)\n"
+         "    (delivered ?p - package ?l - location ?t - truck)\n"
+         "  )\n"
+         "  (:action drive\n"
+         "    :parameters (?t - truck ?from - location ?to - location)\n"
+         "    :precondition (at ?t ?from)\n"
+         "    :effect (and (not (at ?t ?from)) (at ?t ?to))\n"
+         "  )\n"
+         "  (:action load\n"
+         "    :parameters (?t - truck ?p - package ?l - location)\n"
+         "    :precondition (and (at ?t ?l) (package-at ?p ?l))\n"
+         "    :effect (and (not (package-at ?p ?l)) (in ?p ?t))\n"
+         "  )\n"
+         "  (:action unload\n"
+         "    :parameters (?t - truck ?p - package ?l - location)\n"
+         "    :precondition (and (at ?t ?l) (in ?p ?t))\n"
+         "    :effect (and (package-at ?p ?l) (not (in ?p ?t)) (delivered ?p ?l ?t))\n"
+         "  )\n"
+         ")\n";
+}
+
+
+std::string logisticsProblemPddl(std::size_t pNbOfTrucks,
+                                 std::size_t pNbOfLocations,
+                                 std::size_t pNbOfGoals)
+{
+  std::string res = "(define (problem logistics-" + std::to_string(pNbOfTrucks) + "-" +
+      std::to_string(pNbOfLocations) + "-" + std::to_string(pNbOfGoals) + ")\n"
+      "  (:domain logistics)\n"
+      "  (:objects\n" +
+      _objects("truck", pNbOfTrucks, "truck") +
+      _objects("location", pNbOfLocations, "location") +
+      _objects("package", pNbOfGoals, "package") +
+      "  )\n"
+      "  (:init\n";
+  for (std::size_t i = 0; i < pNbOfTrucks; ++i)
+    res += "    (at truck" + std::to_string(i) + " location" + std::to_string(i % pNbOfLocations) + ")\n";
+  for (std::size_t i = 0; i < pNbOfGoals; ++i)
+    res += "    (package-at package" + std::to_string(i) + " location" + std::to_string((i * 7 + 1) % pNbOfLocations) + ")\n";
+  res += "  )\n"
+         "  (:goal\n"
+         "    (and ;; __ORDERED\n";
+  for (std::size_t i = 0; i < pNbOfGoals; ++i)
+    res += "      (delivered package" + std::to_string(i) + " location" + std::to_string((i * 3 + 2) % pNbOfLocations) +
+        " truck" + std::to_string(i % pNbOfTrucks) + ")\n";
+  res += "    )\n"
+         "  )\n"
+         ")\n";
+  return res;
+}
+
+
+std::string roverDomainPddl()
+{
+  return "(define (domain rover)\n"
+         "  (:requirements :strips :typing :object-fluents)\n"
+         "  (:types rover waypoint)\n"
+         "  (:predicates\n"
+         "    (rock-at ?w - waypoint)\n"
+         "    (has-sample ?r - rover ?w - waypoint)\n"
+         "    (communicated ?r - rover ?w - waypoint)\n"
+         "  )\n"
+         "  (:functions\n"
+         "    (rover-at ?r - rover) - waypoint\n"
+         "  )\n"
+         "  (:action navigate\n"
+         "    :parameters (?r - rover ?from - waypoint ?to - waypoint)\n"
+         "    :precondition (= (rover-at ?r) ?from)\n"
+         "    :effect (assign (rover-at ?r) ?to)\n"
+         "  )\n"
+         "  (:action sample\n"
+         "    :parameters (?r - rover ?w - waypoint)\n"
+         "    :precondition (and (= (rover-at ?r) ?w) (rock-at ?w))\n"
+         "    :effect (has-sample ?r ?w)\n"
+         "  )\n"
+         "  (:action communicate\n"
+         "    :parameters (?r - rover ?w - waypoint)\n"
+         "    :precondition (has-sample ?r ?w)\n"
+         "    :effect (communicated ?r ?w)\n"
+         "  )\n"
+         ")\n";
+}
+
+
+std::string roverProblemPddl(std::size_t pNbOfRovers,
+                             std::size_t pNbOfWaypoints,
+                             std::size_t pNbOfGoals)
+{
+  std::string res = "(define (problem rover-" + std::to_string(pNbOfRovers) + "-" +
+      std::to_string(pNbOfWaypoints) + "-" + std::to_string(pNbOfGoals) + ")\n"
+      "  (:domain rover)\n"
+      "  (:objects\n" +
+      _objects("rover", pNbOfRovers, "rover") +
+      _objects("waypoint", pNbOfWaypoints, "waypoint") +
+      "  )\n"
+      "  (:init\n";
+  for (std::size_t i = 0; i < pNbOfRovers; ++i)
+    res += "    (= (rover-at rover" + std::to_string(i) + ") waypoint" + std::to_string(i % pNbOfWaypoints) + ")\n";
+  for (std::size_t i = 0; i < pNbOfWaypoints; ++i)
+    res += "    (rock-at waypoint" + std::to_string(i) + ")\n";
+  res += "  )\n"
+         "  (:goal\n"
+         "    (and ;; __ORDERED\n";
+  for (std::size_t i = 0; i < pNbOfGoals; ++i)
+    res += "      (communicated rover" + std::to_string(i % pNbOfRovers) + " waypoint" + std::to_string((i + 1) % pNbOfWaypoints) + ")\n";
+  res += "    )\n"
+         "  )\n"
+         ")\n";
+  return res;
+}
+
+
+ogp::DomainAndProblemPtrs loadDomainAndProblem(const std::string& pDomainPddl,
+                                               const std::string& pProblemPddl)
+{
+  std::map<std::string, ogp::Domain> loadedDomains;
+  auto domain = ogp::pddlToDomain(pDomainPddl, loadedDomains);
+  auto domainName = domain.getName();
+  loadedDomains.emplace(domainName, std::move(domain));
+  return ogp::pddlToProblem(pProblemPddl, loadedDomains);
+}
@@ -0,0 +1,43 @@
+#ifndef ORDEREDGOALSPLANNERBENCH_GENERATORS_HPP
+#define ORDEREDGOALSPLANNERBENCH_GENERATORS_HPP
+
+#include <cstddef>
+#include <string>
+#include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
+
+
+/// PDDL domain of logistics: trucks that move between locations to load and unload packages.
+std::string logisticsDomainPddl();
+
+/**
+ * @brief Generate a PDDL problem of logistics.
+ * @param[in] pNbOfTrucks Number of trucks.
+ * @param[in] pNbOfLocations Number of locations.
+ * @param[in] pNbOfGoals Number of packages to deliver, there is one goal per package.
+ * @return The PDDL problem.
+ */
+std::string logisticsProblemPddl(std::size_t pNbOfTrucks,
+                                 std::size_t pNbOfLocations,
+                                 std::size_t pNbOfGoals);
+
+/// PDDL domain of rovers: rovers, with their position in an object fluent, that sample rocks and communicate them.
+std::string roverDomainPddl();
+
+/**
+ * @brief Generate a PDDL problem of rovers.
+ * @param[in] pNbOfRovers Number of rovers.
+ * @param[in] pNbOfWaypoints Number of waypoints.
+ * @param[in] pNbOfGoals Number of rock samples to communicate, there is one goal per sample.
+ * @return The PDDL problem.
+ */
+std::string roverProblemPddl(std::size_t pNbOfRovers,
+                             std::size_t pNbOfWaypoints,
+                             std::size_t pNbOfGoals);
+
+
+/// Parse a domain and a problem written in PDDL.
+ogp::DomainAndProblemPtrs loadDomainAndProblem(const std::string& pDomainPddl,
+                                               const std::string& pProblemPddl);
+
+
+#endif // ORDEREDGOALSPLANNERBENCH_GENERATORS_HPP
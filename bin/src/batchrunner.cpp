@@ -0,0 +1,376 @@
+#include "batchrunner.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/util/mappedfile.hpp>
+#include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
+#include <orderedgoalsplanner/orderedgoalsplanner.hpp>
+
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/// Result of a problem of the batch.
+struct BatchResult
+{
+  /// "solved", "no_plan" or "error".
+  std::string status = "error";
+  std::string errorMessage{};
+  double parsingTimeInMs = 0;
+  double minPlanningTimeInMs = 0;
+  double meanPlanningTimeInMs = 0;
+  double maxPlanningTimeInMs = 0;
+  std::size_t planLength = 0;
+  /// Stats of the last planning.
+  ogp::PlannerStats stats{};
+};
+
+
+double _elapsedInMs(const Clock::time_point& pBegin)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - pBegin).count();
+}
+
+
+std::string _msToStr(double pTimeInMs)
+{
+  std::ostringstream ss;
+  ss << std::fixed << std::setprecision(3) << pTimeInMs;
+  return ss.str();
+}
+
+
+void _solve(BatchResult& pResult,
+            const BatchProblem& pProblem,
+            const std::map<std::string, ogp::Domain>& pLoadedDomains,
+            const BatchOptions& pOptions)
+{
+  try
+  {
+    auto parsingBegin = Clock::now();
+    ogp::LoadedDomainAndProblemPtrs domainAndProblem;
+    {
+      ogp::MappedFile problemFile(pProblem.problemFile);
+      domainAndProblem = ogp::pddlToProblemOfLoadedDomain(problemFile.content(), pLoadedDomains);
+    }
+    pResult.parsingTimeInMs = _elapsedInMs(parsingBegin);
+    if (!domainAndProblem.domainPtr || !domainAndProblem.problemPtr)
+      throw std::runtime_error("The problem does not refer to a domain.");
+    const auto& domain = *domainAndProblem.domainPtr;
+
+    double totalPlanningTimeInMs = 0;
+    for (std::size_t i = 0; i < pOptions.nbOfWarmups + pOptions.nbOfRepeats; ++i)
+    {
+      auto problem = *domainAndProblem.problemPtr;
+      ogp::LookForAnActionOutputInfos lookForAnActionOutputInfos;
+      auto planningBegin = Clock::now();
+      auto plan = ogp::planForEveryGoals(problem, domain, {}, nullptr, nullptr, &lookForAnActionOutputInfos);
+      auto planningTimeInMs = _elapsedInMs(planningBegin);
+      if (i < pOptions.nbOfWarmups)
+        continue;
+
+      if (i == pOptions.nbOfWarmups || planningTimeInMs < pResult.minPlanningTimeInMs)
+        pResult.minPlanningTimeInMs = planningTimeInMs;
+      pResult.maxPlanningTimeInMs = std::max(pResult.maxPlanningTimeInMs, planningTimeInMs);
+      totalPlanningTimeInMs += planningTimeInMs;
+      pResult.planLength = plan.size();
+      pResult.stats = lookForAnActionOutputInfos.stats();
+    }
+    pResult.meanPlanningTimeInMs = totalPlanningTimeInMs / static_cast<double>(pOptions.nbOfRepeats);
+    pResult.status = pResult.planLength > 0 ? "solved" : "no_plan";
+  }
+  catch (const std::exception& e)
+  {
+    pResult.status = "error";
+    pResult.errorMessage = e.what();
+  }
+}
+
+
+std::string _csvField(const std::string& pStr)
+{
+  if (pStr.find_first_of(",\"\n\r") == std::string::npos)
+    return pStr;
+  std::string res = "\"";
+  for (char currChar : pStr)
+  {
+    if (currChar == '"')
+      res += '"';
+    res += currChar;
+  }
+  return res + "\"";
+}
+
+
+std::string _jsonStr(const std::string& pStr)
+{
+  std::string res = "\"";
+  for (char currChar : pStr)
+  {
+    switch (currChar)
+    {
+    case '"':
+      res += "\\\"";
+      break;
+    case '\\':
+      res += "\\\\";
+      break;
+    case '\n':
+      res += "\\n";
+      break;
+    case '\r':
+      res += "\\r";
+      break;
+    case '\t':
+      res += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(currChar) < 0x20)
+      {
+        std::ostringstream ss;
+        ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(currChar);
+        res += ss.str();
+      }
+      else
+      {
+        res += currChar;
+      }
+    }
+  }
+  return res + "\"";
+}
+
+
+/// Values of a result in the order of the columns of the report.
+std::vector<std::pair<std::string, std::string>> _resultColumns(const BatchProblem& pProblem,
+                                                                const BatchResult& pResult)
+{
+  auto allocations = pResult.stats.totalAllocations();
+  return {
+    {"domain", pProblem.domainFile},
+    {"problem", pProblem.problemFile},
+    {"status", pResult.status},
+    {"parsing_ms", _msToStr(pResult.parsingTimeInMs)},
+    {"planning_ms_min", _msToStr(pResult.minPlanningTimeInMs)},
+    {"planning_ms_mean", _msToStr(pResult.meanPlanningTimeInMs)},
+    {"planning_ms_max", _msToStr(pResult.maxPlanningTimeInMs)},
+    {"plan_length", std::to_string(pResult.planLength)},
+    {"candidate_actions", std::to_string(pResult.stats.nbOfCandidateActions)},
+    {"look_for_a_possible_effect_calls", std::to_string(pResult.stats.nbOfLookForAPossibleEffectCalls)},
+    {"plan_cost_lookaheads", std::to_string(pResult.stats.nbOfPlanCostLookaheads)},
+    {"problem_copies", std::to_string(pResult.stats.nbOfProblemCopies)},
+    {"condition_evaluations", std::to_string(pResult.stats.nbOfConditionEvaluations)},
+    {"events_fired", std::to_string(pResult.stats.nbOfEventsFired)},
+    {"allocations", std::to_string(allocations.nbOfAllocations)},
+    {"allocated_bytes", std::to_string(allocations.nbOfBytes)},
+    {"error", pResult.errorMessage}
+  };
+}
+
+
+void _writeCsvReport(std::ostream& pStream,
+                     const std::vector<BatchProblem>& pProblems,
+                     const std::vector<BatchResult>& pResults)
+{
+  for (std::size_t i = 0; i < pProblems.size(); ++i)
+  {
+    auto columns = _resultColumns(pProblems[i], pResults[i]);
+    if (i == 0)
+    {
+      for (std::size_t j = 0; j < columns.size(); ++j)
+        pStream << (j > 0 ? "," : "") << columns[j].first;
+      pStream << "\n";
+    }
+    for (std::size_t j = 0; j < columns.size(); ++j)
+      pStream << (j > 0 ? "," : "") << _csvField(columns[j].second);
+    pStream << "\n";
+  }
+}
+
+
+void _writeJsonReport(std::ostream& pStream,
+                      const std::vector<BatchProblem>& pProblems,
+                      const std::vector<BatchResult>& pResults,
+                      const BatchOptions& pOptions,
+                      double pWallTimeInMs)
+{
+  pStream << "{\n"
+          << "  \"threads\": " << pOptions.nbOfThreads << ",\n"
+          << "  \"repeat\": " << pOptions.nbOfRepeats << ",\n"
+          << "  \"warmup\": " << pOptions.nbOfWarmups << ",\n"
+          << "  \"stats_enabled\": " << (ogp::PlannerStats::isEnabled() ? "true" : "false") << ",\n"
+          << "  \"wall_ms\": " << _msToStr(pWallTimeInMs) << ",\n"
+          << "  \"problems\": [";
+  for (std::size_t i = 0; i < pProblems.size(); ++i)
+  {
+    pStream << (i > 0 ? ",\n" : "\n") << "    {";
+    auto columns = _resultColumns(pProblems[i], pResults[i]);
+    for (std::size_t j = 0; j < columns.size(); ++j)
+    {
+      pStream << (j > 0 ? ", " : "") << _jsonStr(columns[j].first) << ": ";
+      const auto& key = columns[j].first;
+      if (key == "domain" || key == "problem" || key == "status" || key == "error")
+        pStream << _jsonStr(columns[j].second);
+      else
+        pStream << columns[j].second;
+    }
+    pStream << "}";
+  }
+  pStream << "\n  ]\n}\n";
+}
+
+}
+
+
+std::vector<BatchProblem> listProblemsOfDirectory(const std::string& pDirectory)
+{
+  std::vector<BatchProblem> res;
+  const std::filesystem::path root(pDirectory);
+  for (const auto& currEntry : std::filesystem::recursive_directory_iterator(root))
+  {
+    if (!currEntry.is_regular_file() || currEntry.path().extension() != ".pddl")
+      continue;
+    auto fileName = currEntry.path().filename().string();
+    if (fileName.compare(0, 6, "domain") == 0)
+      continue;
+
+    for (auto currDirectory = currEntry.path().parent_path(); ; currDirectory = currDirectory.parent_path())
+    {
+      auto domainFile = currDirectory / "domain.pddl";
+      if (std::filesystem::exists(domainFile))
+      {
+        res.push_back(BatchProblem{domainFile.string(), currEntry.path().string()});
+        break;
+      }
+      if (currDirectory == root || !currDirectory.has_parent_path() || currDirectory == currDirectory.parent_path())
+        throw std::runtime_error("No domain.pddl found for the problem: " + currEntry.path().string());
+    }
+  }
+  std::sort(res.begin(), res.end(), [](const BatchProblem& pA, const BatchProblem& pB) {
+    return pA.problemFile < pB.problemFile;
+  });
+  return res;
+}
+
+
+std::vector<BatchProblem> readManifest(const std::string& pManifestFile)
+{
+  std::ifstream file(pManifestFile);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open the manifest: " + pManifestFile);
+  auto manifestDirectory = std::filesystem::path(pManifestFile).parent_path();
+  auto toPath = [&](const std::string& pPath) {
+    std::filesystem::path path(pPath);
+    return path.is_relative() ? (manifestDirectory / path).string() : pPath;
+  };
+
+  std::vector<BatchProblem> res;
+  std::string line;
+  std::size_t lineNumber = 0;
+  while (std::getline(file, line))
+  {
+    ++lineNumber;
+    std::istringstream lineStream(line);
+    std::string domainFile;
+    std::string problemFile;
+    if (!(lineStream >> domainFile) || domainFile[0] == '#')
+      continue;
+    if (!(lineStream >> problemFile))
+      throw std::runtime_error("Missing problem file at line " + std::to_string(lineNumber) + " of the manifest: " + pManifestFile);
+    res.push_back(BatchProblem{toPath(domainFile), toPath(problemFile)});
+  }
+  return res;
+}
+
+
+int runBatch(const std::vector<BatchProblem>& pProblems,
+             const BatchOptions& pOptions)
+{
+  if (pOptions.nbOfRepeats == 0)
+    throw std::runtime_error("The number of repeats has to be at least 1.");
+  auto wallBegin = Clock::now();
+
+  // Parse each domain once
+  std::map<std::string, std::map<std::string, ogp::Domain>> domainFileToLoadedDomains;
+  std::map<std::string, std::string> domainFileToError;
+  for (const auto& currProblem : pProblems)
+  {
+    if (domainFileToLoadedDomains.count(currProblem.domainFile) > 0 ||
+        domainFileToError.count(currProblem.domainFile) > 0)
+      continue;
+    try
+    {
+      std::map<std::string, ogp::Domain> loadedDomains;
+      ogp::MappedFile domainFile(currProblem.domainFile);
+      auto domain = ogp::pddlToDomain(domainFile.content(), loadedDomains, pOptions.nbOfParsingThreads,
+                                      pOptions.materializeDerivedPredicates);
+      auto domainName = domain.getName();
+      loadedDomains.emplace(domainName, std::move(domain));
+      domainFileToLoadedDomains.emplace(currProblem.domainFile, std::move(loadedDomains));
+    }
+    catch (const std::exception& e)
+    {
+      domainFileToError.emplace(currProblem.domainFile, std::string("Domain parsing failed: ") + e.what());
+    }
+  }
+
+  std::vector<BatchResult> results(pProblems.size());
+  std::atomic<std::size_t> nextProblemIndex{0};
+  auto solveProblems = [&]() {
+    for (auto i = nextProblemIndex++; i < pProblems.size(); i = nextProblemIndex++)
+    {
+      const auto& problem = pProblems[i];
+      auto itLoadedDomains = domainFileToLoadedDomains.find(problem.domainFile);
+      if (itLoadedDomains != domainFileToLoadedDomains.end())
+        _solve(results[i], problem, itLoadedDomains->second, pOptions);
+      else
+        results[i].errorMessage = domainFileToError.at(problem.domainFile);
+    }
+  };
+
+  auto nbOfThreads = std::max<std::size_t>(std::min(pOptions.nbOfThreads, pProblems.size()), 1);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < nbOfThreads; ++i)
+    threads.emplace_back(solveProblems);
+  solveProblems();
+  for (auto& currThread : threads)
+    currThread.join();
+  auto wallTimeInMs = _elapsedInMs(wallBegin);
+
+  if (pOptions.reportFile.empty())
+  {
+    if (pOptions.jsonReport)
+      _writeJsonReport(std::cout, pProblems, results, pOptions, wallTimeInMs);
+    else
+      _writeCsvReport(std::cout, pProblems, results);
+  }
+  else
+  {
+    std::ofstream reportFile(pOptions.reportFile);
+    if (!reportFile.is_open())
+      throw std::runtime_error("Could not open the file " + pOptions.reportFile);
+    if (pOptions.jsonReport)
+      _writeJsonReport(reportFile, pProblems, results, pOptions, wallTimeInMs);
+    else
+      _writeCsvReport(reportFile, pProblems, results);
+  }
+
+  auto nbOfSolvedProblems = std::count_if(results.begin(), results.end(), [](const BatchResult& pResult) {
+    return pResult.status == "solved";
+  });
+  std::cerr << nbOfSolvedProblems << "/" << pProblems.size() << " problems solved in " << _msToStr(wallTimeInMs) << " ms with "
+            << nbOfThreads << " threads (" << _msToStr(static_cast<double>(pProblems.size()) * 1000. / std::max(wallTimeInMs, 1e-3))
+            << " problems/s)." << std::endl;
+  return static_cast<std::size_t>(nbOfSolvedProblems) == pProblems.size() ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+#ifndef ORDEREDGOALSPLANNER_BIN_BATCHRUNNER_HPP
+#define ORDEREDGOALSPLANNER_BIN_BATCHRUNNER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+/// Problem to solve in a batch.
+struct BatchProblem
+{
+  std::string domainFile;
+  std::string problemFile;
+};
+
+
+/// Options of a batch of problems.
+struct BatchOptions
+{
+  /// Number of threads solving the problems in parallel.
+  std::size_t nbOfThreads = 1;
+  /// Number of times each problem is solved to measure the time.
+  std::size_t nbOfRepeats = 1;
+  /// Number of times each problem is solved before the measures.
+  std::size_t nbOfWarmups = 0;
+  /// Number of threads to parse each domain.
+  std::size_t nbOfParsingThreads = 1;
+  /// True to keep the derived predicates as facts in the world state instead of expanding them in the conditions.
+  bool materializeDerivedPredicates = false;
+  /// Write the report in JSON instead of CSV.
+  bool jsonReport = false;
+  /// File where to write the report, the report is written in the standard output if it is empty.
+  std::string reportFile;
+};
+
+
+/**
+ * @brief List the problems of a directory tree.<br/>
+ * Each PDDL file that is not a domain is a problem, its domain is the file "domain.pddl"
+ * of its directory or of the nearest parent directory.
+ * @param[in] pDirectory Root of the directory tree.
+ * @return The problems found, sorted by path.
+ */
+std::vector<BatchProblem> listProblemsOfDirectory(const std::string& pDirectory);
+
+/**
+ * @brief Read a manifest of problems.<br/>
+ * Each line contains the domain file and the problem file separated by spaces.
+ * The relative paths are relative to the directory of the manifest.
+ * The empty lines and the lines starting with '#' are ignored.
+ * @param[in] pManifestFile File of the manifest.
+ * @return The problems of the manifest.
+ */
+std::vector<BatchProblem> readManifest(const std::string& pManifestFile);
+
+/**
+ * @brief Solve a batch of problems and write a report with, for each problem, the time spent, the length of the plan
+ * and the stats of the planner.<br/>
+ * Each domain is parsed once and shared by all its problems.
+ * @param[in] pProblems Problems to solve.
+ * @param[in] pOptions Options of the batch.
+ * @return The exit code of the program, 0 if all the problems have a plan.
+ */
+int runBatch(const std::vector<BatchProblem>& pProblems,
+             const BatchOptions& pOptions);
+
+
+#endif // ORDEREDGOALSPLANNER_BIN_BATCHRUNNER_HPP
@@ -0,0 +1,463 @@
+#include "daemon.hpp"
+#include <functional>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <orderedgoalsplanner/types/actioninvocationwithgoal.hpp>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/types/setofcallbacks.hpp>
+#include <orderedgoalsplanner/util/mappedfile.hpp>
+#include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
+#include <orderedgoalsplanner/orderedgoalsplanner.hpp>
+#if defined(__unix__) || defined(__APPLE__)
+# define ORDEREDGOALSPLANNER_HAS_UNIX_SOCKET
+# include <cerrno>
+# include <csignal>
+# include <signal.h>
+# include <sys/socket.h>
+# include <sys/un.h>
+# include <unistd.h>
+#endif
+
+
+namespace
+{
+
+/// State of a client of the daemon.
+struct DaemonSession
+{
+  DaemonSession(const std::map<std::string, ogp::Domain>& pLoadedDomains,
+                const DaemonOptions& pOptions)
+    : loadedDomains(pLoadedDomains),
+      options(pOptions),
+      domainAndProblem()
+  {
+  }
+
+  /**
+   * @brief Handle a request.
+   * @param[in] pName Name of the request.
+   * @param[in] pPayload Payload of the request.
+   * @return The payload of the response. An exception is raised if the request failed.
+   */
+  std::string handle(const std::string& pName,
+                     const std::string& pPayload);
+
+  const std::map<std::string, ogp::Domain>& loadedDomains;
+  const DaemonOptions& options;
+  ogp::LoadedDomainAndProblemPtrs domainAndProblem;
+
+private:
+  ogp::ActionInvocationWithGoal _pddlToActionInvocation(const std::string& pStr) const;
+};
+
+
+std::string _trim(const std::string& pStr)
+{
+  auto begin = pStr.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos)
+    return "";
+  auto end = pStr.find_last_not_of(" \t\r\n");
+  return pStr.substr(begin, end - begin + 1);
+}
+
+
+ogp::ActionInvocationWithGoal DaemonSession::_pddlToActionInvocation(const std::string& pStr) const
+{
+  auto str = _trim(pStr);
+  if (str.size() < 2 || str.front() != '(' || str.back() != ')')
+    throw std::runtime_error("An action invocation has to be between parenthesis: \"" + str + "\"");
+  std::istringstream tokens(str.substr(1, str.size() - 2));
+  std::string actionId;
+  tokens >> actionId;
+  const auto& domain = *domainAndProblem.domainPtr;
+  const auto* actionPtr = domain.getActionPtr(actionId);
+  if (actionPtr == nullptr)
+    throw std::runtime_error("The action \"" + actionId + "\" is unknown");
+
+  std::map<ogp::Parameter, ogp::Entity> parameters;
+  std::string argument;
+  for (const auto& currParameter : actionPtr->parameters)
+  {
+    if (!(tokens >> argument))
+      throw std::runtime_error("Missing arguments in the action invocation: \"" + str + "\"");
+    parameters.emplace(currParameter, ogp::Entity::fromUsage(argument, domain.getOntology(),
+                                                             domainAndProblem.problemPtr->entities, {}));
+  }
+  if (tokens >> argument)
+    throw std::runtime_error("Too many arguments in the action invocation: \"" + str + "\"");
+  return ogp::ActionInvocationWithGoal(actionId, parameters, {}, 0);
+}
+
+
+std::string DaemonSession::handle(const std::string& pName,
+                                  const std::string& pPayload)
+{
+  if (pName == "problem")
+  {
+    domainAndProblem = ogp::pddlToProblemOfLoadedDomain(pPayload, loadedDomains);
+    if (!domainAndProblem.domainPtr || !domainAndProblem.problemPtr)
+      throw std::runtime_error("The problem does not refer to a domain.");
+    return "";
+  }
+  if (pName == "quit")
+    return "";
+  if (!domainAndProblem.problemPtr)
+    throw std::runtime_error("No problem, send a \"problem\" request first.");
+
+  const auto& domain = *domainAndProblem.domainPtr;
+  auto& problem = *domainAndProblem.problemPtr;
+  const ogp::SetOfCallbacks callbacks;
+  if (pName == "facts")
+  {
+    auto facts = _trim(pPayload);
+    std::size_t pos = 0;
+    problem.worldState.modifyFactsFromPddl(facts, pos, problem.goalStack, domain.getSetOfEvents(), callbacks,
+                                           domain.getOntology(), problem.entities, {});
+    if (pos < facts.size())
+      throw std::runtime_error("Unexpected character at position " + std::to_string(pos) + " of the facts.");
+    return "";
+  }
+  if (pName == "action_done")
+  {
+    ogp::notifyActionDone(problem, domain, callbacks, _pddlToActionInvocation(pPayload), {});
+    return "";
+  }
+  if (pName == "plan")
+  {
+    // Plan on a copy because the planner simulates the actions in the problem
+    auto problemCopy = problem;
+    return ogp::planToPddl(ogp::planForEveryGoals(problemCopy, domain, {}), domain);
+  }
+  throw std::runtime_error("Unknown request \"" + pName + "\".");
+}
+
+
+std::string _frame(const std::string& pName,
+                   const std::string& pPayload)
+{
+  return pName + " " + std::to_string(pPayload.size()) + "\n" + pPayload;
+}
+
+
+/**
+ * @brief Answer to the requests of a session until the end of the input or a "quit" request.
+ * @return False if the input is not well framed or if the session failed.
+ */
+bool _serveSession(std::istream& pInput,
+                   std::ostream& pOutput,
+                   const std::map<std::string, ogp::Domain>& pLoadedDomains,
+                   const DaemonOptions& pOptions)
+{
+  try
+  {
+    DaemonSession session(pLoadedDomains, pOptions);
+    std::string header;
+    while (std::getline(pInput, header))
+    {
+      std::istringstream headerStream(header);
+      std::string name;
+      std::size_t payloadSize = 0;
+      if (!(headerStream >> name >> payloadSize))
+      {
+        pOutput << _frame("error", "Bad header \"" + header + "\", expected \"<name> <payload_size>\".") << std::flush;
+        return false;
+      }
+      // The payload size comes from the client so it is checked before allocating anything
+      if (payloadSize > pOptions.maxPayloadSize)
+      {
+        pOutput << _frame("error", "The payload of " + std::to_string(payloadSize) + " bytes is bigger than the maximum of " +
+                          std::to_string(pOptions.maxPayloadSize) + " bytes.") << std::flush;
+        return false;
+      }
+      std::string payload(payloadSize, '\0');
+      if (payloadSize > 0 && !pInput.read(&payload[0], static_cast<std::streamsize>(payloadSize)))
+        return false;
+
+      std::string response;
+      try
+      {
+        response = _frame("ok", session.handle(name, payload));
+      }
+      catch (const std::exception& e)
+      {
+        response = _frame("error", e.what());
+      }
+      pOutput << response << std::flush;
+      if (name == "quit")
+        break;
+    }
+    return true;
+  }
+  catch (const std::exception& e)
+  {
+    pOutput << _frame("error", e.what()) << std::flush;
+  }
+  return false;
+}
+
+
+#ifdef ORDEREDGOALSPLANNER_HAS_UNIX_SOCKET
+/// Unbuffered stream buffer on a file descriptor.
+class FdStreamBuf : public std::streambuf
+{
+public:
+  explicit FdStreamBuf(int pFd)
+    : _fd(pFd)
+  {
+    setg(_inputBuffer, _inputBuffer, _inputBuffer);
+  }
+
+protected:
+  int_type underflow() override
+  {
+    ssize_t nbOfBytesRead = 0;
+    do
+      nbOfBytesRead = ::read(_fd, _inputBuffer, sizeof(_inputBuffer));
+    while (nbOfBytesRead < 0 && errno == EINTR);
+    if (nbOfBytesRead <= 0)
+      return traits_type::eof();
+    setg(_inputBuffer, _inputBuffer, _inputBuffer + nbOfBytesRead);
+    return traits_type::to_int_type(*gptr());
+  }
+
+  int_type overflow(int_type pChar) override
+  {
+    if (traits_type::eq_int_type(pChar, traits_type::eof()))
+      return traits_type::not_eof(pChar);
+    char character = traits_type::to_char_type(pChar);
+    return _write(&character, 1) ? pChar : traits_type::eof();
+  }
+
+  std::streamsize xsputn(const char* pStr, std::streamsize pSize) override
+  {
+    return _write(pStr, static_cast<std::size_t>(pSize)) ? pSize : 0;
+  }
+
+private:
+  int _fd;
+  char _inputBuffer[4096];
+
+  bool _write(const char* pStr, std::size_t pSize)
+  {
+    while (pSize > 0)
+    {
+      auto nbOfBytesWritten = ::write(_fd, pStr, pSize);
+      if (nbOfBytesWritten < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      pStr += nbOfBytesWritten;
+      pSize -= static_cast<std::size_t>(nbOfBytesWritten);
+    }
+    return true;
+  }
+};
+
+
+/// Set by SIGINT or SIGTERM to stop accepting the clients.
+volatile std::sig_atomic_t _stopRequested = 0;
+
+void _requestStop(int)
+{
+  _stopRequested = 1;
+}
+
+
+/// Threads of the sessions on the socket, with a maximum number of sessions at the same time.
+class SocketSessions
+{
+public:
+  explicit SocketSessions(std::size_t pMaxNbOfSessions)
+    : _maxNbOfSessions(pMaxNbOfSessions),
+      _mutex(),
+      _sessions()
+  {
+  }
+
+  ~SocketSessions() { stopAll(); }
+
+  /**
+   * @brief Serve a client in a new thread.<br/>
+   * The client is answered by an error and disconnected if the maximum number of sessions is reached.
+   * @param[in] pClientFd File descriptor of the client, it is closed at the end of the session.
+   * @param[in] pServe Function that answers to the requests of the client.
+   */
+  void start(int pClientFd,
+             const std::function<void(std::iostream&)>& pServe)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _joinFinishedSessions();
+    if (_sessions.size() >= _maxNbOfSessions)
+    {
+      FdStreamBuf streamBuf(pClientFd);
+      std::iostream stream(&streamBuf);
+      stream << _frame("error", "Too many sessions, the maximum is " + std::to_string(_maxNbOfSessions) + ".") << std::flush;
+      ::close(pClientFd);
+      return;
+    }
+
+    auto& session = _sessions.emplace_back();
+    session.clientFd = pClientFd;
+    // The sessions do not handle the stop signals, so that they interrupt the accept of the main thread
+    sigset_t stopSignals;
+    sigset_t previousSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, &previousSignals);
+    try
+    {
+      session.thread = std::thread([this, &session, pServe]() {
+        FdStreamBuf streamBuf(session.clientFd);
+        std::iostream stream(&streamBuf);
+        pServe(stream);
+        std::lock_guard<std::mutex> sessionLock(_mutex);
+        ::close(session.clientFd);
+        session.finished = true;
+      });
+    }
+    catch (const std::system_error&)
+    {
+      ::close(pClientFd);
+      _sessions.pop_back();
+    }
+    pthread_sigmask(SIG_SETMASK, &previousSignals, nullptr);
+  }
+
+  /// Disconnect the clients and wait for the end of their sessions.
+  void stopAll()
+  {
+    std::list<Session> sessions;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      // The reads of the sessions see the end of the input so the sessions end
+      for (auto& currSession : _sessions)
+        if (!currSession.finished)
+          ::shutdown(currSession.clientFd, SHUT_RDWR);
+      sessions.splice(sessions.end(), _sessions);
+    }
+    for (auto& currSession : sessions)
+      currSession.thread.join();
+  }
+
+private:
+  struct Session
+  {
+    std::thread thread;
+    int clientFd = -1;
+    /// True when the client is closed, the thread ends without taking the mutex again.
+    bool finished = false;
+  };
+
+  std::size_t _maxNbOfSessions;
+  std::mutex _mutex;
+  std::list<Session> _sessions;
+
+  /// Join the threads of the finished sessions, the mutex has to be locked.
+  void _joinFinishedSessions()
+  {
+    for (auto it = _sessions.begin(); it != _sessions.end(); )
+    {
+      if (it->finished)
+      {
+        it->thread.join();
+        it = _sessions.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+};
+
+
+int _serveSocket(const std::shared_ptr<const std::map<std::string, ogp::Domain>>& pLoadedDomainsPtr,
+                 const DaemonOptions& pOptions)
+{
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (pOptions.socketPath.size() >= sizeof(address.sun_path))
+    throw std::runtime_error("The socket path is too long: " + pOptions.socketPath);
+  pOptions.socketPath.copy(address.sun_path, pOptions.socketPath.size());
+
+  int serverFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (serverFd < 0)
+    throw std::runtime_error("Failed to create the socket.");
+  ::unlink(pOptions.socketPath.c_str());
+  if (::bind(serverFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0 ||
+      ::listen(serverFd, SOMAXCONN) < 0)
+  {
+    ::close(serverFd);
+    throw std::runtime_error("Failed to listen to the socket " + pOptions.socketPath);
+  }
+  // A client that disconnects before reading its response should not stop the daemon
+  std::signal(SIGPIPE, SIG_IGN);
+  // Without SA_RESTART the stop signals interrupt the accept
+  struct sigaction stopAction{};
+  stopAction.sa_handler = _requestStop;
+  sigemptyset(&stopAction.sa_mask);
+  ::sigaction(SIGINT, &stopAction, nullptr);
+  ::sigaction(SIGTERM, &stopAction, nullptr);
+
+  int res = 1;
+  {
+    SocketSessions sessions(pOptions.maxNbOfSessions);
+    while (true)
+    {
+      int clientFd = ::accept(serverFd, nullptr, nullptr);
+      if (clientFd < 0)
+      {
+        if (errno == EINTR && !_stopRequested)
+          continue;
+        if (_stopRequested)
+          res = 0;
+        break;
+      }
+      sessions.start(clientFd, [&pLoadedDomainsPtr, &pOptions](std::iostream& pStream) {
+        _serveSession(pStream, pStream, *pLoadedDomainsPtr, pOptions);
+      });
+    }
+    sessions.stopAll();
+  }
+  ::close(serverFd);
+  ::unlink(pOptions.socketPath.c_str());
+  return res;
+}
+#endif
+
+}
+
+
+int runDaemon(const std::string& pDomainFile,
+              const DaemonOptions& pOptions)
+{
+  auto loadedDomainsPtr = std::make_shared<std::map<std::string, ogp::Domain>>();
+  {
+    ogp::MappedFile domainFile(pDomainFile);
+    auto domain = ogp::pddlToDomain(domainFile.content(), *loadedDomainsPtr, pOptions.nbOfParsingThreads,
+                                    pOptions.materializeDerivedPredicates);
+    auto domainName = domain.getName();
+    loadedDomainsPtr->emplace(domainName, std::move(domain));
+  }
+
+  if (pOptions.socketPath.empty())
+    return _serveSession(std::cin, std::cout, *loadedDomainsPtr, pOptions) ? 0 : 1;
+#ifdef ORDEREDGOALSPLANNER_HAS_UNIX_SOCKET
+  return _serveSocket(loadedDomainsPtr, pOptions);
+#else
+  throw std::runtime_error("The Unix-domain sockets are not supported on this platform.");
+#endif
+}
@@ -0,0 +1,49 @@
+#ifndef ORDEREDGOALSPLANNER_BIN_DAEMON_HPP
+#define ORDEREDGOALSPLANNER_BIN_DAEMON_HPP
+
+#include <cstddef>
+#include <string>
+
+
+/// Options of the daemon.
+struct DaemonOptions
+{
+  /// Unix-domain socket to listen to, the standard input and output are used if it is empty.
+  std::string socketPath;
+  /// Number of threads to parse the domain.
+  std::size_t nbOfParsingThreads = 1;
+  /// True to keep the derived predicates as facts in the world state instead of expanding them in the conditions.
+  bool materializeDerivedPredicates = false;
+  /// Maximum size in bytes of the payload of a request, the session ends with an error for a bigger payload.
+  std::size_t maxPayloadSize = 64 * 1024 * 1024;
+  /// Maximum number of clients served at the same time on the socket, the other clients are answered by an error.
+  std::size_t maxNbOfSessions = 64;
+};
+
+
+/**
+ * @brief Parse a domain once then answer to a stream of requests on it.<br/>
+ * <br/>
+ * Each request and each response is a frame: a header line "<name> <payload_size>\n" followed by exactly
+ * payload_size bytes of payload.<br/>
+ * The requests are:<br/>
+ *  * "problem": set the PDDL problem of the payload as the problem of the session.<br/>
+ *  * "facts": add the PDDL facts of the payload to the world state, the facts in a "not" are removed.<br/>
+ *  * "action_done": notify that the PDDL action invocation of the payload (ex: "(move robot1 a b)") is done.<br/>
+ *  * "plan": answer the PDDL plan for every goals, the problem of the session is not modified.<br/>
+ *  * "quit": end the session.<br/>
+ * The response is named "ok" or "error", with the plan or the error message as payload.<br/>
+ * A request that is not well framed or whose payload is bigger than the maximum payload size is answered
+ * by an error and ends the session.<br/>
+ * Each session keeps its problem between the requests. On stdin there is only one session,
+ * on a socket each connection is a session handled by its own thread, up to the maximum number of sessions.<br/>
+ * On a socket, SIGINT and SIGTERM stop the daemon: the clients are disconnected and the threads are joined.
+ * @param[in] pDomainFile PDDL file of the domain.
+ * @param[in] pOptions Options of the daemon.
+ * @return The exit code of the program.
+ */
+int runDaemon(const std::string& pDomainFile,
+              const DaemonOptions& pOptions);
+
+
+#endif // ORDEREDGOALSPLANNER_BIN_DAEMON_HPP
@@ -1,39 +1,32 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/util/mappedfile.hpp>
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 #include <orderedgoalsplanner/util/serializer/serializeinpddl.hpp>
+#include <orderedgoalsplanner/util/trace.hpp>
 #include <orderedgoalsplanner/orderedgoalsplanner.hpp>
+#include "batchrunner.hpp"
+#include "daemon.hpp"
 
 using namespace ogp;
 
 namespace
 {
-std::string _getFileContent(const std::string& filePath)
-{
-  std::ifstream file(filePath);
-  if (!file.is_open()) {
-    throw std::runtime_error("Error: Could not open file " + filePath);
-  }
-
-  std::string res;
-  std::string line;
-  while (std::getline(file, line))
-    res += line + "\n";
-
-  file.close();
-  return res;
-}
-
 void printUsage() {
-  std::cout << "Usage: orderedgoalsplanner -d <domain_file> -p <problem_file> [--verbose] [-o <output_plan_file>]" << std::endl;
+  std::cout << "Usage: orderedgoalsplanner -d <domain_file> -p <problem_file> [--verbose] [--stats] [--trace <output_trace_file>] [-o <output_plan_file>] [-j <nb_of_parsing_threads>] [--materialize-derived]" << std::endl;
+  std::cout << "or" << std::endl;
+  std::cout << "Usage: orderedgoalsplanner <domain_file> <problem_file> [--verbose] [--stats] [--trace <output_trace_file>] [-o <output_plan_file>] [-j <nb_of_parsing_threads>] [--materialize-derived]" << std::endl;
   std::cout << "or" << std::endl;
-  std::cout << "Usage: orderedgoalsplanner <domain_file> <problem_file> [--verbose] [-o <output_plan_file>]" << std::endl;
+  std::cout << "Usage: orderedgoalsplanner --dp <directory_with_domain_pddl_and_problem_pddl_files_in_it> [--verbose] [--stats] [--trace <output_trace_file>] [-o <output_plan_file>] [-j <nb_of_parsing_threads>] [--materialize-derived]" << std::endl;
   std::cout << "or" << std::endl;
-  std::cout << "Usage: orderedgoalsplanner --dp <directory_with_domain_pddl_and_problem_pddl_files_in_it> [--verbose] [-o <output_plan_file>]" << std::endl;
+  std::cout << "Usage: orderedgoalsplanner --batch <directory_or_manifest_file> [--threads <nb_of_threads>] [--repeat <nb_of_repeats>] [--warmup <nb_of_warmups>] [--format csv|json] [-o <output_report_file>] [-j <nb_of_parsing_threads>] [--materialize-derived]" << std::endl;
+  std::cout << "or" << std::endl;
+  std::cout << "Usage: orderedgoalsplanner -d <domain_file> --daemon [--socket <unix_socket_file>] [--max-payload <nb_of_bytes>] [--max-sessions <nb_of_sessions>] [-j <nb_of_parsing_threads>] [--materialize-derived]" << std::endl;
 }
 
 }
@@ -45,7 +38,15 @@ int main(int argc, char* argv[])
   std::string problem_file;
   std::string domain_and_problem_directory;
   std::string output_plan_file;
+  std::string output_trace_file;
+  std::string batch_input;
+  BatchOptions batchOptions;
+  bool daemon = false;
+  DaemonOptions daemonOptions;
   bool verbose = false;
+  bool printStats = false;
+  std::size_t nbOfParsingThreads = 1;
+  bool materializeDerivedPredicates = false;
 
   for (int i = 1; i < argc; ++i) {
     std::string arg = argv[i];
@@ -58,8 +59,40 @@ int main(int argc, char* argv[])
       domain_and_problem_directory = argv[++i];
     } else if (arg == "-o" && i + 1 < argc) {
       output_plan_file = argv[++i];
+    } else if (arg == "--trace" && i + 1 < argc) {
+      output_trace_file = argv[++i];
+    } else if (arg == "-j" && i + 1 < argc) {
+      nbOfParsingThreads = static_cast<std::size_t>(std::stoul(argv[++i]));
+    } else if (arg == "--batch" && i + 1 < argc) {
+      batch_input = argv[++i];
+    } else if (arg == "--threads" && i + 1 < argc) {
+      batchOptions.nbOfThreads = static_cast<std::size_t>(std::stoul(argv[++i]));
+    } else if (arg == "--repeat" && i + 1 < argc) {
+      batchOptions.nbOfRepeats = static_cast<std::size_t>(std::stoul(argv[++i]));
+    } else if (arg == "--warmup" && i + 1 < argc) {
+      batchOptions.nbOfWarmups = static_cast<std::size_t>(std::stoul(argv[++i]));
+    } else if (arg == "--format" && i + 1 < argc) {
+      std::string format = argv[++i];
+      if (format != "csv" && format != "json") {
+        std::cerr << "Error: Unknown report format \"" << format << "\".\n";
+        printUsage();
+        return 1;
+      }
+      batchOptions.jsonReport = format == "json";
+    } else if (arg == "--daemon") {
+      daemon = true;
+    } else if (arg == "--socket" && i + 1 < argc) {
+      daemonOptions.socketPath = argv[++i];
+    } else if (arg == "--max-payload" && i + 1 < argc) {
+      daemonOptions.maxPayloadSize = static_cast<std::size_t>(std::stoull(argv[++i]));
+    } else if (arg == "--max-sessions" && i + 1 < argc) {
+      daemonOptions.maxNbOfSessions = static_cast<std::size_t>(std::stoull(argv[++i]));
+    } else if (arg == "--materialize-derived") {
+      materializeDerivedPredicates = true;
     } else if (arg == "--verbose") {
       verbose = true;
+    } else if (arg == "--stats") {
+      printStats = true;
     } else if (domain_file == "") {
       domain_file = arg;
     } else if (problem_file == "") {
@@ -70,6 +103,42 @@ int main(int argc, char* argv[])
     }
   }
 
+  if (!batch_input.empty()) {
+    batchOptions.nbOfParsingThreads = nbOfParsingThreads;
+    batchOptions.materializeDerivedPredicates = materializeDerivedPredicates;
+    batchOptions.reportFile = output_plan_file;
+    try {
+      auto problems = std::filesystem::is_directory(batch_input) ?
+            listProblemsOfDirectory(batch_input) : readManifest(batch_input);
+      if (problems.empty()) {
+        std::cerr << "Error: No problem found in \"" << batch_input << "\".\n";
+        return 1;
+      }
+      return runBatch(problems, batchOptions);
+    } catch (const std::exception& e) {
+      std::cerr << "Error: " << e.what() << std::endl;
+      return 1;
+    }
+  }
+
+  if (daemon) {
+    if (!domain_and_problem_directory.empty())
+      domain_file = domain_and_problem_directory + "/domain.pddl";
+    if (domain_file.empty()) {
+      std::cerr << "Error: Missing domain file in arguments.\n";
+      printUsage();
+      return 1;
+    }
+    daemonOptions.nbOfParsingThreads = nbOfParsingThreads;
+    daemonOptions.materializeDerivedPredicates = materializeDerivedPredicates;
+    try {
+      return runDaemon(domain_file, daemonOptions);
+    } catch (const std::exception& e) {
+      std::cerr << "Error: " << e.what() << std::endl;
+      return 1;
+    }
+  }
+
   if (!domain_and_problem_directory.empty()) {
     domain_file = domain_and_problem_directory + "/domain.pddl";
     problem_file = domain_and_problem_directory + "/problem.pddl";
@@ -85,15 +154,31 @@ int main(int argc, char* argv[])
     return 1;
   }
 
-  auto domainContent = _getFileContent(domain_file);
+  if (!output_trace_file.empty())
+    ogp::startTracing(output_trace_file);
+
+  // To also have the stats of the parsing
+  ogp::LookForAnActionOutputInfos lookForAnActionOutputInfos;
+  std::optional<ogp::PlannerStatsScope> plannerStatsScope;
+  if (printStats)
+    plannerStatsScope.emplace(&lookForAnActionOutputInfos.stats());
+
   std::map<std::string, ogp::Domain> loadedDomains;
-  auto domain = ogp::pddlToDomain(domainContent, loadedDomains);
-  loadedDomains.emplace(domain.getName(), std::move(domain));
+  {
+    ogp::MappedFile domainFile(domain_file);
+    auto domain = ogp::pddlToDomain(domainFile.content(), loadedDomains, nbOfParsingThreads, materializeDerivedPredicates);
+    auto domainName = domain.getName();
+    loadedDomains.emplace(domainName, std::move(domain));
+  }
   if (verbose)
     std::cout << "Parsing domain file \"" << domain_file << "\" done successfully." << std::endl;
 
-  auto problemContent = _getFileContent(problem_file);
-  ogp::DomainAndProblemPtrs domainAndProblemPtrs = ogp::pddlToProblem(problemContent, loadedDomains);
+  ogp::DomainAndProblemPtrs domainAndProblemPtrs;
+  {
+    ogp::MappedFile problemFile(problem_file);
+    domainAndProblemPtrs = ogp::pddlToProblem(problemFile.content(), loadedDomains);
+  }
+  auto& domain = *domainAndProblemPtrs.domainPtr;
   auto& problem = *domainAndProblemPtrs.problemPtr;
   if (verbose)
     std::cout << "Parsing problem file \"" << problem_file << "\" done successfully." << std::endl;
@@ -109,7 +194,28 @@ int main(int argc, char* argv[])
 
   if (verbose)
     std::cout << "Searching for a plan..." << std::endl;
-  std::string planStr = ogp::planToPddl(ogp::planForEveryGoals(problem, domain, {}), domain);
+  std::string planStr = ogp::planToPddl(ogp::planForEveryGoals(problem, domain, {}, nullptr, nullptr, &lookForAnActionOutputInfos), domain);
+  if (!output_trace_file.empty())
+  {
+    ogp::stopTracing();
+    if (verbose)
+      std::cout << "Trace wrote in " << output_trace_file << std::endl;
+  }
+
+  if (printStats)
+  {
+    plannerStatsScope.reset();
+    if (ogp::PlannerStats::isEnabled())
+    {
+      std::cerr << "Stats" << std::endl;
+      std::cerr << "=====" << std::endl;
+      std::cerr << lookForAnActionOutputInfos.stats().toStr() << std::endl;
+    }
+    else
+    {
+      std::cerr << "No stats: the library was built without ORDERED_GOALS_PLANNER_ENABLE_STATS." << std::endl;
+    }
+  }
 
 
   if (planStr == "")
@@ -1,6 +1,7 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_ORDEREDGOALSPLANNER_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_ORDEREDGOALSPLANNER_HPP
 
+#include <iosfwd>
 #include <list>
 #include <map>
 #include "util/api.hpp"
@@ -97,6 +98,7 @@ bool notifyActionDone(Problem& pProblem,
  * @param[in, out] pGlobalHistorical Historical more global (and with a smaller priority) than the one contained in the problem.<br/>
  * The historical is used to add diversity in the actions to do. In other words, it is to always do the same action if another action is pertinent too.
  * @param[out] pGoalsDonePtr List of goals satisfied during the plannification.
+ * @param[out] pLookForAnActionOutputInfosPtr Output to know informations (how many goals was solved, stats of the planner, ...)
  * @return List of all the actions to do with their parameters with values.
  */
 ORDEREDGOALSPLANNER_API
@@ -105,7 +107,8 @@ std::list<ActionInvocationWithGoal> planForEveryGoals(
     const Domain& pDomain,
     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
     Historical* pGlobalHistorical = nullptr,
-    std::list<Goal>* pGoalsDonePtr = nullptr);
+    std::list<Goal>* pGoalsDonePtr = nullptr,
+    LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr = nullptr);
 
 ORDEREDGOALSPLANNER_API
 ParallelPan parallelPlanForEveryGoals(
@@ -131,6 +134,12 @@ ORDEREDGOALSPLANNER_API
 std::string planToPddl(const std::list<ActionInvocationWithGoal>& pPlan,
                        const Domain& pDomain);
 
+/// Write a plan in PDDL in a stream, one action after the other.
+ORDEREDGOALSPLANNER_API
+void planToPddl(std::ostream& pOs,
+                const std::list<ActionInvocationWithGoal>& pPlan,
+                const Domain& pDomain);
+
 ORDEREDGOALSPLANNER_API
 std::string parallelPlanToPddl(const ParallelPan& pPlan,
                                const Domain& pDomain);
@@ -1,6 +1,7 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_ACTION_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_TYPES_ACTION_HPP
 
+#include <memory>
 #include <vector>
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/types/condition.hpp>
@@ -9,6 +10,7 @@
 
 namespace ogp
 {
+struct ConditionProgram;
 struct SetOfDerivedPredicates;
 
 
@@ -34,7 +36,8 @@ struct ORDEREDGOALSPLANNER_API Action
       canThisActionBeUsedByThePlanner(true),
       actionsSuccessionsWithoutInterestCache(),
       actionsPredecessorsCache(),
-      eventsPredecessorsCache()
+      eventsPredecessorsCache(),
+      preconditionProgramCache()
   {
   }
 
@@ -51,7 +54,8 @@ struct ORDEREDGOALSPLANNER_API Action
       canThisActionBeUsedByThePlanner(true),
       actionsSuccessionsWithoutInterestCache(),
       actionsPredecessorsCache(),
-      eventsPredecessorsCache()
+      eventsPredecessorsCache(),
+      preconditionProgramCache()
   {
   }
 
@@ -66,7 +70,8 @@ struct ORDEREDGOALSPLANNER_API Action
       canThisActionBeUsedByThePlanner(pAction.canThisActionBeUsedByThePlanner),
       actionsSuccessionsWithoutInterestCache(pAction.actionsSuccessionsWithoutInterestCache),
       actionsPredecessorsCache(pAction.actionsPredecessorsCache),
-      eventsPredecessorsCache(pAction.eventsPredecessorsCache)
+      eventsPredecessorsCache(pAction.eventsPredecessorsCache),
+      preconditionProgramCache(pAction.preconditionProgramCache)
   {
   }
 
@@ -83,6 +88,7 @@ struct ORDEREDGOALSPLANNER_API Action
     actionsSuccessionsWithoutInterestCache = pAction.actionsSuccessionsWithoutInterestCache;
     actionsPredecessorsCache = pAction.actionsPredecessorsCache;
     eventsPredecessorsCache = pAction.eventsPredecessorsCache;
+    preconditionProgramCache = pAction.preconditionProgramCache;
   }
 
   /// Check equality with another action.
@@ -107,6 +113,20 @@ struct ORDEREDGOALSPLANNER_API Action
                              const std::set<FactOptional>& pFactsFromCondition);
   void removePossibleSuccessionCache(const ActionId& pActionIdToRemove);
   std::string printSuccessionCache() const;
+  /// Compile the precondition in preconditionProgramCache.
+  void updatePreconditionProgramCache();
+
+  /**
+   * @brief Check if the precondition is true, with its compiled program if it is in the cache.
+   * @param[in] pWorldState World state to consider.
+   * @param[in, out] pParametersToPossibleArgumentsPtr Map of the parameters to their possible arguments.
+   * @return True if there is no precondition or if the precondition is satisfied.
+   */
+  bool isPreconditionTrue(const WorldState& pWorldState,
+                          std::map<Parameter, std::set<Entity>>* pParametersToPossibleArgumentsPtr = nullptr) const;
+
+  /// Check if the precondition can become true, with its compiled program if it is in the cache.
+  bool canPreconditionBecomeTrue(const WorldState& pWorldState) const;
 
   // TODO: remove that function?
   void throwIfNotValid(const SetOfFacts& pSetOfFact);
@@ -133,6 +153,8 @@ struct ORDEREDGOALSPLANNER_API Action
   std::set<ActionId> actionsSuccessionsWithoutInterestCache;
   std::set<ActionId> actionsPredecessorsCache;
   std::set<FullEventId> eventsPredecessorsCache;
+  /// Precondition compiled when the domain is updated.
+  std::shared_ptr<const ConditionProgram> preconditionProgramCache;
 
   // TODO: manage durations
   std::size_t duration() const { return 1; }
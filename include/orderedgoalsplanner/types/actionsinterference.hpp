@@ -0,0 +1,104 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_ACTIONSINTERFERENCE_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_TYPES_ACTIONSINTERFERENCE_HPP
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "../util/api.hpp"
+
+
+namespace ogp
+{
+struct Action;
+struct Entity;
+struct Parameter;
+
+
+/**
+ * Interference between two action schemas, computed without knowing the arguments of the actions.<br/>
+ * Two invocations of these actions can only interfere if their arguments satisfy all the parameter equalities of one alternative.
+ */
+struct ORDEREDGOALSPLANNER_API ActionsInterference
+{
+  enum class Kind
+  {
+    /// The actions never interfere.
+    NEVER,
+    /// The actions can interfere whatever their arguments.
+    ALWAYS,
+    /// The actions can interfere only if some parameter equalities are satisfied.
+    DEPENDS_ON_PARAMETERS
+  };
+
+  /// Parameter of one of the two actions or a constant.
+  struct Term
+  {
+    enum class Origin
+    {
+      FIRST_ACTION,
+      SECOND_ACTION,
+      CONSTANT
+    };
+
+    bool operator==(const Term& pOther) const { return origin == pOther.origin && value == pOther.value; }
+
+    Origin origin;
+    /// Name of the parameter, or value of the constant.
+    std::string value;
+  };
+
+  struct ParameterEquality
+  {
+    bool operator==(const ParameterEquality& pOther) const { return left == pOther.left && right == pOther.right; }
+
+    Term left;
+    Term right;
+  };
+
+  /// Predicates that an action reads in its precondition and that it modifies.
+  struct Predicates
+  {
+    /// True if the precondition has a shape for which the contradictions cannot be deduced from its facts.
+    bool canAlwaysInterfere = false;
+    std::set<std::string> conditionPredicates{};
+    std::set<std::string> modifiedPredicates{};
+  };
+
+  /**
+   * @brief Extract the predicates of an action that matter for the interferences.<br/>
+   * Two actions can only interfere if one modifies a predicate that the other reads or modifies,
+   * or if one of them can always interfere.
+   * @param[in] pAction Action to explore.
+   * @return The predicates of the action.
+   */
+  static Predicates extractPredicates(const Action& pAction);
+
+  /**
+   * @brief Compute the interference between two actions.
+   * @param[in] pFirstAction First action.
+   * @param[in] pSecondAction Second action.
+   * @return The interference between the two actions.
+   */
+  static ActionsInterference compute(const Action& pFirstAction,
+                                     const Action& pSecondAction);
+
+  /**
+   * @brief Check if two invocations of the actions can interfere.
+   * @param[in] pFirstArguments Arguments of the first action.
+   * @param[in] pSecondArguments Arguments of the second action.
+   * @return False if the invocations cannot interfere, true if they have to be compared with their filled conditions and effects.
+   */
+  bool canInterfere(const std::map<Parameter, Entity>& pFirstArguments,
+                    const std::map<Parameter, Entity>& pSecondArguments) const;
+
+  Kind kind = Kind::NEVER;
+  /// Alternatives of parameter equalities, only filled for Kind::DEPENDS_ON_PARAMETERS.
+  std::vector<std::vector<ParameterEquality>> equalitiesAlternatives{};
+};
+
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_TYPES_ACTIONSINTERFERENCE_HPP
@@ -9,6 +9,7 @@
 #include "../util/api.hpp"
 #include "factoptional.hpp"
 #include <orderedgoalsplanner/util/continueorbreak.hpp>
+#include <orderedgoalsplanner/util/functionref.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 
 namespace ogp
@@ -65,7 +66,7 @@ struct ORDEREDGOALSPLANNER_API Condition
    * @param[in] pFactCallback Callback called for each optional fact of the condition.
    * @param[in] pIsWrappingExpressionNegated Is the expression wrapping this call is negated.
    */
-  virtual ContinueOrBreak forAll(const std::function<ContinueOrBreak (const FactOptional&, bool)>& pFactCallback,
+  virtual ContinueOrBreak forAll(FunctionRef<ContinueOrBreak (const FactOptional&, bool)> pFactCallback,
                                  bool pIsWrappingExpressionNegated = false,
                                  bool pIgnoreFluent = false,
                                  bool pOnlyMandatoryFacts = false) const = 0;
@@ -85,7 +86,7 @@ struct ORDEREDGOALSPLANNER_API Condition
    * @return True if one callback returned true, false otherwise.
    */
   virtual bool findConditionCandidateFromFactFromEffect(
-      const std::function<bool (const FactOptional&)>& pDoesConditionFactMatchFactFromEffect,
+      FunctionRef<bool (const FactOptional&)> pDoesConditionFactMatchFactFromEffect,
       const WorldState& pWorldState,
       const Fact& pFactFromEffect,
       const std::map<Parameter, std::set<Entity>>& pFactFromEffectParameters,
@@ -99,7 +100,7 @@ struct ORDEREDGOALSPLANNER_API Condition
    * @param[in] pWorldState World state to consider.
    * @return False if one callback returned false, true otherwise.
    */
-  virtual bool untilFalse(const std::function<bool (const FactOptional&)>& pFactCallback,
+  virtual bool untilFalse(FunctionRef<bool (const FactOptional&)> pFactCallback,
                           const SetOfFacts& pSetOfFact) const = 0;
 
   /**
@@ -138,9 +139,11 @@ struct ORDEREDGOALSPLANNER_API Condition
   /**
    * @brief Convert this condition to a value.
    * @param[in] pSetOfFact Facts use to extract value of the facts.
+   * @param[in] pConditionParametersToArgumentPtr Parameters to replace by their argument before to extract the value.
    * @return The condition converted to a string value.
    */
-  virtual std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact) const = 0;
+  virtual std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact,
+                                          const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr = nullptr) const = 0;
 
   /**
    * @brief Create a copy of this condition with arguments filling (or not if pConditionParametersToArgumentPtr is nullptr).
@@ -222,18 +225,18 @@ struct ORDEREDGOALSPLANNER_API ConditionNode : public Condition
                        const std::map<Parameter, std::set<Entity>>* pOtherFactParametersPtr,
                        const std::vector<Parameter>& pConditionParameters,
                        bool pIsWrappingExpressionNegated) const override;
-  ContinueOrBreak forAll(const std::function<ContinueOrBreak (const FactOptional&, bool)>& pFactCallback,
+  ContinueOrBreak forAll(FunctionRef<ContinueOrBreak (const FactOptional&, bool)> pFactCallback,
                          bool pIsWrappingExpressionNegated,
                          bool pIgnoreFluent,
                          bool pOnlyMandatoryFacts) const override;
-  bool findConditionCandidateFromFactFromEffect(const std::function<bool (const FactOptional&)>& pDoesConditionFactMatchFactFromEffect,
+  bool findConditionCandidateFromFactFromEffect(FunctionRef<bool (const FactOptional&)> pDoesConditionFactMatchFactFromEffect,
                                                 const WorldState& pWorldState,
                                                 const Fact& pFactFromEffect,
                                                 const std::map<Parameter, std::set<Entity>>& pFactFromEffectParameters,
                                                 const std::map<Parameter, std::set<Entity>>* pFactFromEffectTmpParametersPtr,
                                                 const std::map<Parameter, std::set<Entity>>& pConditionParametersToPossibleArguments,
                                                 bool pIsWrappingExpressionNegated) const override;
-  bool untilFalse(const std::function<bool (const FactOptional&)>& pFactCallback,
+  bool untilFalse(FunctionRef<bool (const FactOptional&)> pFactCallback,
                   const SetOfFacts& pSetOfFact) const override;
   bool isTrue(const WorldState& pWorldState,
               const std::set<Fact>& pPunctualFacts,
@@ -246,7 +249,8 @@ struct ORDEREDGOALSPLANNER_API ConditionNode : public Condition
                      bool pIsWrappingExpressionNegated) const override;
   bool operator==(const Condition& pOther) const override;
 
-  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact) const override;
+  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact,
+                                  const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr) const override;
 
   std::unique_ptr<Condition> clone(const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr,
                                    bool pInvert,
@@ -288,13 +292,13 @@ struct ORDEREDGOALSPLANNER_API ConditionExists : public Condition
                        const std::map<Parameter, std::set<Entity>>* pOtherFactParametersPtr,
                        const std::vector<Parameter>& pConditionParameters,
                        bool pIsWrappingExpressionNegated) const override;
-  ContinueOrBreak forAll(const std::function<ContinueOrBreak (const FactOptional&, bool)>& pFactCallback,
+  ContinueOrBreak forAll(FunctionRef<ContinueOrBreak (const FactOptional&, bool)> pFactCallback,
                          bool pIsWrappingExpressionNegated,
                          bool pIgnoreFluent,
                          bool pOnlyMandatoryFacts) const override;
 
   bool findConditionCandidateFromFactFromEffect(
-      const std::function<bool (const FactOptional&)>& pDoesConditionFactMatchFactFromEffect,
+      FunctionRef<bool (const FactOptional&)> pDoesConditionFactMatchFactFromEffect,
       const WorldState& pWorldState,
       const Fact& pFactFromEffect,
       const std::map<Parameter, std::set<Entity>>& pFactFromEffectParameters,
@@ -302,7 +306,7 @@ struct ORDEREDGOALSPLANNER_API ConditionExists : public Condition
       const std::map<Parameter, std::set<Entity>>& pConditionParametersToPossibleArguments,
       bool pIsWrappingExpressionNegated) const override;
 
-  bool untilFalse(const std::function<bool (const FactOptional&)>&,
+  bool untilFalse(FunctionRef<bool (const FactOptional&)>,
                   const SetOfFacts&) const override { return true; } // TODO
   bool isTrue(const WorldState& pWorldState,
               const std::set<Fact>& pPunctualFacts,
@@ -315,7 +319,8 @@ struct ORDEREDGOALSPLANNER_API ConditionExists : public Condition
                      bool pIsWrappingExpressionNegated) const override;
   bool operator==(const Condition& pOther) const override;
 
-  std::optional<Entity> getFluent(const SetOfFacts&) const override { return {}; }
+  std::optional<Entity> getFluent(const SetOfFacts&,
+                                  const std::map<Parameter, Entity>*) const override { return {}; }
 
   std::unique_ptr<Condition> clone(const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr,
                                    bool pInvert,
@@ -356,13 +361,13 @@ struct ORDEREDGOALSPLANNER_API ConditionNot : public Condition
                        const std::map<Parameter, std::set<Entity>>* pOtherFactParametersPtr,
                        const std::vector<Parameter>& pConditionParameters,
                        bool pIsWrappingExpressionNegated) const override;
-  ContinueOrBreak forAll(const std::function<ContinueOrBreak (const FactOptional&, bool)>& pFactCallback,
+  ContinueOrBreak forAll(FunctionRef<ContinueOrBreak (const FactOptional&, bool)> pFactCallback,
                          bool pIsWrappingExpressionNegated,
                          bool pIgnoreFluent,
                          bool pOnlyMandatoryFacts) const override;
 
   bool findConditionCandidateFromFactFromEffect(
-      const std::function<bool (const FactOptional&)>& pDoesConditionFactMatchFactFromEffect,
+      FunctionRef<bool (const FactOptional&)> pDoesConditionFactMatchFactFromEffect,
       const WorldState& pWorldState,
       const Fact& pFactFromEffect,
       const std::map<Parameter, std::set<Entity>>& pFactFromEffectParameters,
@@ -370,7 +375,7 @@ struct ORDEREDGOALSPLANNER_API ConditionNot : public Condition
       const std::map<Parameter, std::set<Entity>>& pConditionParametersToPossibleArguments,
       bool pIsWrappingExpressionNegated) const override;
 
-  bool untilFalse(const std::function<bool (const FactOptional&)>& pFactCallback,
+  bool untilFalse(FunctionRef<bool (const FactOptional&)> pFactCallback,
                   const SetOfFacts& pSetOfFact) const override { return true; } // TODO
   bool isTrue(const WorldState& pWorldState,
               const std::set<Fact>& pPunctualFacts,
@@ -383,7 +388,8 @@ struct ORDEREDGOALSPLANNER_API ConditionNot : public Condition
                      bool pIsWrappingExpressionNegated) const override;
   bool operator==(const Condition& pOther) const override;
 
-  std::optional<Entity> getFluent(const SetOfFacts&) const override { return {}; }
+  std::optional<Entity> getFluent(const SetOfFacts&,
+                                  const std::map<Parameter, Entity>*) const override { return {}; }
 
   std::unique_ptr<Condition> clone(const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr,
                                    bool pInvert,
@@ -422,19 +428,19 @@ struct ORDEREDGOALSPLANNER_API ConditionFact : public Condition
                        const std::map<Parameter, std::set<Entity>>* pOtherFactParametersPtr,
                        const std::vector<Parameter>& pConditionParameters,
                        bool pIsWrappingExpressionNegated) const override;
-  ContinueOrBreak forAll(const std::function<ContinueOrBreak (const FactOptional&, bool)>& pFactCallback,
+  ContinueOrBreak forAll(FunctionRef<ContinueOrBreak (const FactOptional&, bool)> pFactCallback,
                          bool pIsWrappingExpressionNegated,
                          bool pIgnoreFluent,
                          bool pOnlyMandatoryFacts) const override;
   bool findConditionCandidateFromFactFromEffect(
-      const std::function<bool (const FactOptional&)>& pDoesConditionFactMatchFactFromEffect,
+      FunctionRef<bool (const FactOptional&)> pDoesConditionFactMatchFactFromEffect,
       const WorldState&,
       const Fact&,
       const std::map<Parameter, std::set<Entity>>&,
       const std::map<Parameter, std::set<Entity>>*,
       const std::map<Parameter, std::set<Entity>>&,
       bool pIsWrappingExpressionNegated) const override;
-  bool untilFalse(const std::function<bool (const FactOptional&)>& pFactCallback,
+  bool untilFalse(FunctionRef<bool (const FactOptional&)> pFactCallback,
                   const SetOfFacts&) const override { return pFactCallback(factOptional); }
   bool isTrue(const WorldState& pWorldState,
               const std::set<Fact>& pPunctualFacts,
@@ -447,7 +453,8 @@ struct ORDEREDGOALSPLANNER_API ConditionFact : public Condition
                      bool pIsWrappingExpressionNegated) const override;
   bool operator==(const Condition& pOther) const override;
 
-  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact) const override;
+  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact,
+                                  const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr) const override;
 
   std::unique_ptr<Condition> clone(const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr,
                                    bool pInvert,
@@ -486,16 +493,16 @@ struct ORDEREDGOALSPLANNER_API ConditionNumber : public Condition
                        const std::map<Parameter, std::set<Entity>>*,
                        const std::vector<Parameter>&,
                        bool) const override { return false; }
-  ContinueOrBreak forAll(const std::function<ContinueOrBreak (const FactOptional&, bool)>&, bool, bool, bool) const override { return ContinueOrBreak::CONTINUE; }
+  ContinueOrBreak forAll(FunctionRef<ContinueOrBreak (const FactOptional&, bool)>, bool, bool, bool) const override { return ContinueOrBreak::CONTINUE; }
   bool findConditionCandidateFromFactFromEffect(
-      const std::function<bool (const FactOptional&)>&,
+      FunctionRef<bool (const FactOptional&)>,
       const WorldState&,
       const Fact&,
       const std::map<Parameter, std::set<Entity>>&,
       const std::map<Parameter, std::set<Entity>>*,
       const std::map<Parameter, std::set<Entity>>&,
       bool) const override { return true; }
-  bool untilFalse(const std::function<bool (const FactOptional&)>&,
+  bool untilFalse(FunctionRef<bool (const FactOptional&)>,
                   const SetOfFacts&) const override { return true; }
   bool isTrue(const WorldState&,
               const std::set<Fact>&,
@@ -508,7 +515,8 @@ struct ORDEREDGOALSPLANNER_API ConditionNumber : public Condition
                      bool) const override  { return true; }
   bool operator==(const Condition& pOther) const override;
 
-  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact) const override;
+  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact,
+                                  const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr) const override;
 
   std::unique_ptr<Condition> clone(const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr,
                                    bool pInvert,
@@ -0,0 +1,94 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_CONDITIONPROGRAM_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_TYPES_CONDITIONPROGRAM_HPP
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+#include "../util/api.hpp"
+#include <orderedgoalsplanner/types/condition.hpp>
+#include <orderedgoalsplanner/types/factoptional.hpp>
+
+
+namespace ogp
+{
+struct WorldState;
+
+
+/**
+ * Condition compiled in a flat array of instructions, evaluated without virtual calls.<br/>
+ * The instructions are stored in preorder with the size of their sub-tree, so the evaluation keeps
+ * the short-circuits and the order of the tree, that fill the possible arguments of the parameters.<br/>
+ * The conjunctions, the disjunctions, the implications, the negations and the facts are compiled.
+ * The other parts of the condition (comparisons, exists, ...) are kept as a copy of their sub-tree.<br/>
+ * The program does not reference the condition it comes from, so it stays valid after a copy or a destruction of the condition.
+ */
+struct ORDEREDGOALSPLANNER_API ConditionProgram
+{
+  /**
+   * @brief Compile a condition.
+   * @param[in] pCondition Condition to compile.
+   */
+  ConditionProgram(const Condition& pCondition);
+
+  /// Same semantic as Condition::isTrue.
+  bool isTrue(const WorldState& pWorldState,
+              const std::set<Fact>& pPunctualFacts = {},
+              const std::set<Fact>& pRemovedFacts = {},
+              std::map<Parameter, std::set<Entity>>* pConditionParametersToPossibleArguments = nullptr,
+              bool* pCanBecomeTruePtr = nullptr,
+              bool pIsWrappingExpressionNegated = false) const;
+
+  /// Same semantic as Condition::canBecomeTrue.
+  bool canBecomeTrue(const WorldState& pWorldState,
+                     const std::vector<Parameter>& pParameters,
+                     bool pIsWrappingExpressionNegated = false) const;
+
+  /// Number of instructions of the program.
+  std::size_t size() const { return _instructions.size(); }
+
+private:
+  enum class OpCode : std::uint8_t
+  {
+    AND,
+    OR,
+    IMPLY,
+    NOT,
+    FACT,
+    SUB_CONDITION,
+    EMPTY
+  };
+
+  struct Instruction
+  {
+    OpCode opCode;
+    /// Index of the fact or of the sub condition of the instruction.
+    std::uint32_t slot;
+    /// Number of instructions of the sub-tree that starts with this instruction.
+    std::uint32_t size;
+  };
+
+  std::vector<Instruction> _instructions;
+  std::vector<FactOptional> _facts;
+  std::vector<std::unique_ptr<Condition>> _subConditions;
+
+  void _compile(const Condition* pConditionPtr);
+  bool _isTrue(std::size_t pIndex,
+               const WorldState& pWorldState,
+               const std::set<Fact>& pPunctualFacts,
+               const std::set<Fact>& pRemovedFacts,
+               std::map<Parameter, std::set<Entity>>* pConditionParametersToPossibleArguments,
+               bool* pCanBecomeTruePtr,
+               bool pIsWrappingExpressionNegated) const;
+  bool _canBecomeTrue(std::size_t pIndex,
+                      const WorldState& pWorldState,
+                      const std::vector<Parameter>& pParameters,
+                      bool pIsWrappingExpressionNegated) const;
+};
+
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_TYPES_CONDITIONPROGRAM_HPP
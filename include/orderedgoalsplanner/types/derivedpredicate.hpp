@@ -8,6 +8,8 @@
 
 namespace ogp
 {
+struct Axiom;
+
 
 struct ORDEREDGOALSPLANNER_API DerivedPredicate
 {
@@ -15,11 +17,18 @@ struct ORDEREDGOALSPLANNER_API DerivedPredicate
                    const std::string& pConditionStr,
                    const ogp::Ontology& pOntology);
 
+  /// Construct a derived predicate with a condition already parsed.
+  DerivedPredicate(const Predicate& pPredicate,
+                   std::unique_ptr<Condition> pCondition);
+
   /// Copy constructor.
   DerivedPredicate(const DerivedPredicate& pDerivedPredicate);
   /// Copy operator.
   void operator=(const DerivedPredicate& pDerivedPredicate);
 
+  /// Convert this derived predicate to an axiom that keeps the derived fact in the world state.
+  Axiom toAxiom() const;
+
   /// Predicate.
   Predicate predicate;
   /// Condition to put when this is used predicate.
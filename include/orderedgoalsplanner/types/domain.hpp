@@ -6,6 +6,8 @@
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/util/alias.hpp>
 #include <orderedgoalsplanner/types/action.hpp>
+#include <orderedgoalsplanner/types/actioninvocation.hpp>
+#include <orderedgoalsplanner/types/actionsinterference.hpp>
 #include <orderedgoalsplanner/types/condtionstovalue.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
 #include <orderedgoalsplanner/types/setofevents.hpp>
@@ -35,6 +37,22 @@ struct ORDEREDGOALSPLANNER_API Domain
          const SetOfConstFacts& pTimelessFacts = {},
          const std::string& pName = "domain");
 
+  /**
+   * @brief Construct a domain from actions and events that already have their succession caches (ex: loaded from a binary snapshot).<br/>
+   * The succession caches are kept as they are instead of being recomputed, only the precondition programs are compiled again.
+   * @param[in] pActions Map of action identifiers to action, with their succession caches.
+   * @param[in] pOntology Ontology of the domain.
+   * @param[in] pIdToSetOfEvents Sets of events with their succession caches, including the events of the materialized derived predicates.
+   * @param[in] pTimelessFacts Facts that are always true.
+   * @param[in] pName Name of the domain.
+   * @return The domain built.
+   */
+  static Domain fromActionsWithSuccessionCaches(const std::map<ActionId, Action>& pActions,
+                                                const Ontology& pOntology,
+                                                const std::map<SetOfEventsId, SetOfEvents>& pIdToSetOfEvents,
+                                                const SetOfConstFacts& pTimelessFacts,
+                                                const std::string& pName);
+
 
   // Actions
   // -------
@@ -69,6 +87,15 @@ struct ORDEREDGOALSPLANNER_API Domain
   /// All action identifiers of the actions without precondtion.
   const FactsToValue& actionsWithoutFactToAddInPrecondition() const { return _actionsWithoutFactToAddInPrecondition; }
 
+  /**
+   * @brief Check if two action invocations can interfere, from the interferences precomputed between the actions.
+   * @param[in] pFirstActionInvocation First action invocation.
+   * @param[in] pSecondActionInvocation Second action invocation.
+   * @return False if the actions can be done in parallel for sure, true if their filled conditions and effects have to be compared.
+   */
+  bool canActionsInterfere(const ActionInvocation& pFirstActionInvocation,
+                           const ActionInvocation& pSecondActionInvocation) const;
+
 
 
   // Events
@@ -118,6 +145,9 @@ struct ORDEREDGOALSPLANNER_API Domain
 
   static const std::string& getSetOfEventsIdFromConstructor();
 
+  /// Identifier of the set of events that keep up to date the facts of the materialized derived predicates.
+  static const std::string& getSetOfEventsIdFromDerivedPredicates();
+
 private:
   /// Universal unique identifier regenerated each time this object is modified.
   std::string _uuid;
@@ -130,6 +160,15 @@ private:
   ConditionsToValue _conditionsToActions;
   /// Set of action identifiers of the actions without precondtion.
   FactsToValue _actionsWithoutFactToAddInPrecondition;
+  /// Interference between the pairs of actions that can interfere, the first action identifier of the key is the smallest one.<br/>
+  /// The pairs of actions that never interfere are not stored.
+  std::map<std::pair<ActionId, ActionId>, ActionsInterference> _actionsInterferences;
+  /// Predicates read and modified by each action, to find the actions that share a predicate with it.
+  std::map<ActionId, ActionsInterference::Predicates> _actionToInterferencePredicates;
+  /// Predicate name to the actions that modify it.
+  std::map<std::string, std::set<ActionId>> _predicateToModifyingActions;
+  /// Predicate name to the actions that read it in their precondition.
+  std::map<std::string, std::set<ActionId>> _predicateToReadingActions;
   /// Map set of events identifiers to the set of events.
   std::map<SetOfEventsId, SetOfEvents> _setOfEvents;
   std::set<std::string> _requirements;
@@ -137,6 +176,14 @@ private:
   void _addAction(const ActionId& pActionId,
                   const Action& pAction);
 
+  /// Get the actions that share a predicate with an action, so the only ones that can interfere with it.
+  std::set<ActionId> _actionsSharingAPredicate(const ActionsInterference::Predicates& pPredicates) const;
+
+  void _addActionInterferences(const ActionId& pActionId,
+                               const Action& pAction);
+
+  void _removeActionInterferences(const ActionId& pActionId);
+
   void _updateSuccessions();
 };
 
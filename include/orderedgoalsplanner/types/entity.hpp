@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include "../util/api.hpp"
+#include "../util/util.hpp"
 #include "type.hpp"
 
 namespace ogp
@@ -14,10 +15,26 @@ struct SetOfEntities;
 struct SetOfTypes;
 
 
+/**
+ * An entity of a domain or of a problem.<br/>
+ * The type of the entity is not owned: it belongs to a SetOfTypes (usually the one of an Ontology inside a Domain).
+ * That set of types, or one of its copies, has to outlive the entity and all its copies.
+ */
 struct ORDEREDGOALSPLANNER_API Entity
 {
+  /**
+   * @brief Construct an entity.
+   * @param[in] pValue Value of the entity.
+   * @param[in] pType Type of the entity, not owned. It can be nullptr.<br/>
+   * It has to be a type of a SetOfTypes that outlives the entity, or SetOfTypes::numberType().
+   */
   Entity(const std::string& pValue,
-         const std::shared_ptr<Type>& pType);
+         const Type* pType);
+
+  /// Construct an entity holding a number, the string value is only the textual form of the number.
+  /// The type is not owned, see the constructor above.
+  Entity(const Number& pNumber,
+         const Type* pType);
 
   Entity(const Entity& pOther) = default;
   Entity(Entity&& pOther) noexcept;
@@ -32,6 +49,7 @@ struct ORDEREDGOALSPLANNER_API Entity
   static const std::string& anyEntityValue();
   static Entity createAnyEntity();
   static Entity createNumberEntity(const std::string& pNumber);
+  static Entity createNumberEntity(const Number& pNumber);
   static Entity fromDeclaration(const std::string& pStr,
                                 const SetOfTypes& pSetOfTypes);
 
@@ -46,9 +64,14 @@ struct ORDEREDGOALSPLANNER_API Entity
   Parameter toParameter() const;
   bool match(const Parameter& pParameter) const;
   bool isValidParameterAccordingToPossiblities(const std::vector<Parameter>& pParameter) const;
+  /// Set the value and keep the numeric value consistent with it.
+  void setValue(const std::string& pValue);
 
   std::string value;
-  std::shared_ptr<Type> type;
+  /// Type of the entity, owned by a SetOfTypes.
+  const Type* type;
+  /// Numeric value if the value is a number. It allows to do arithmetic and comparisons without parsing the value.
+  std::optional<Number> number;
 };
 
 } // !ogp
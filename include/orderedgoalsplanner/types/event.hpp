@@ -4,6 +4,7 @@
 #include <assert.h>
 #include <functional>
 #include <map>
+#include <memory>
 #include <vector>
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/types/condition.hpp>
@@ -12,6 +13,7 @@
 
 namespace ogp
 {
+struct ConditionProgram;
 
 /// Specification what is an event.
 struct ORDEREDGOALSPLANNER_API Event
@@ -29,7 +31,8 @@ struct ORDEREDGOALSPLANNER_API Event
       factsToModify(pEvent.factsToModify ? pEvent.factsToModify->clone(nullptr) : std::unique_ptr<WorldStateModification>()),
       goalsToAdd(pEvent.goalsToAdd),
       actionsPredecessorsCache(pEvent.actionsPredecessorsCache),
-      eventsPredecessorsCache(pEvent.eventsPredecessorsCache)
+      eventsPredecessorsCache(pEvent.eventsPredecessorsCache),
+      preconditionProgramCache(pEvent.preconditionProgramCache)
   {
     assert(precondition);
     assert(factsToModify || !goalsToAdd.empty());
@@ -39,6 +42,24 @@ struct ORDEREDGOALSPLANNER_API Event
                              const SetOfEventsId& pSetOfEventsIdOfThisEvent,
                              const EventId& pEventIdOfThisEvent);
   std::string printSuccessionCache() const;
+  /// Compile the precondition in preconditionProgramCache.
+  void updatePreconditionProgramCache();
+
+  /**
+   * @brief Check if the precondition is true, with its compiled program if it is in the cache.
+   * @param[in] pWorldState World state to consider.
+   * @param[in] pPunctualFacts Punctual facts raised right now.
+   * @param[in] pRemovedFacts Facts present in the world state but that should be consider as not present.
+   * @param[in, out] pParametersToPossibleArgumentsPtr Map of the parameters to their possible arguments.
+   * @return True if there is no precondition or if the precondition is satisfied.
+   */
+  bool isPreconditionTrue(const WorldState& pWorldState,
+                          const std::set<Fact>& pPunctualFacts,
+                          const std::set<Fact>& pRemovedFacts,
+                          std::map<Parameter, std::set<Entity>>* pParametersToPossibleArgumentsPtr) const;
+
+  /// Check if the precondition can become true, with its compiled program if it is in the cache.
+  bool canPreconditionBecomeTrue(const WorldState& pWorldState) const;
 
   /// Parameter names of this event.
   std::vector<Parameter> parameters;
@@ -54,6 +75,8 @@ struct ORDEREDGOALSPLANNER_API Event
 
   std::set<ActionId> actionsPredecessorsCache;
   std::set<FullEventId> eventsPredecessorsCache;
+  /// Precondition compiled when the domain is updated.
+  std::shared_ptr<const ConditionProgram> preconditionProgramCache;
 };
 
 
@@ -1,7 +1,9 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_FACT_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_FACT_HPP
 
+#include <iosfwd>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <optional>
@@ -17,7 +19,12 @@ struct Ontology;
 struct SetOfEntities;
 struct SetOfFacts;
 
-/// Knowledge that can be contained in a world.
+/**
+ * Knowledge that can be contained in a world.<br/>
+ * The predicate, the arguments and the fluent of a fact only point to their types. These types belong to the
+ * SetOfTypes of the ontology used to construct the fact, so this ontology (or the domain holding it) has to outlive
+ * the fact, its copies and the world states containing them.
+ */
 struct ORDEREDGOALSPLANNER_API Fact
 {
   /**
@@ -28,7 +35,7 @@ struct ORDEREDGOALSPLANNER_API Fact
    * @param[in] pBeginPos Begin position in pStr.
    * @param[out] pResPos End postion of the fact in pStr after the parsing.
    */
-  Fact(const std::string& pStr,
+  Fact(std::string_view pStr,
        bool pStrPddlFormated,
        const Ontology& pOntology,
        const SetOfEntities& pEntities,
@@ -47,6 +54,19 @@ struct ORDEREDGOALSPLANNER_API Fact
        const std::vector<Parameter>& pParameters,
        bool pIsOkIfFluentIsMissing = false);
 
+  /**
+   * @brief Construct a fact from parts already resolved.<br/>
+   * No validity check is done, it is meant to restore a fact that was valid when it was saved.
+   * @param[in] pPredicate Predicate of the fact, with the types already narrowed by the parameters.
+   * @param[in] pArguments Arguments of the fact.
+   * @param[in] pFluent Fluent of the fact.
+   * @param[in] pIsFluentNegated Is the fluent negated.
+   */
+  Fact(const Predicate& pPredicate,
+       std::vector<Entity>&& pArguments,
+       std::optional<Entity>&& pFluent,
+       bool pIsFluentNegated);
+
   /// Destruct the fact.
   ~Fact();
 
@@ -166,6 +186,11 @@ struct ORDEREDGOALSPLANNER_API Fact
   std::string toPddl(bool pInEffectContext,
                      bool pPrintAnyFluent = true) const;
 
+  /// Write this fact in PDDL in a stream, without intermediate string.
+  void toPddl(std::ostream& pOs,
+              bool pInEffectContext,
+              bool pPrintAnyFluent = true) const;
+
   /// Serialize this fact to a string.
   std::string toStr(bool pPrintAnyFluent = true) const;
 
@@ -181,7 +206,7 @@ struct ORDEREDGOALSPLANNER_API Fact
                       const std::vector<Parameter>& pParameters,
                       bool* pIsFactNegatedPtr = nullptr);
 
-  static Fact fromPddl(const std::string& pStr,
+  static Fact fromPddl(std::string_view pStr,
                        const Ontology& pOntology,
                        const SetOfEntities& pEntities,
                        const std::vector<Parameter>& pParameters,
@@ -271,8 +296,10 @@ struct ORDEREDGOALSPLANNER_API Fact
   void generateSignatureForAllUpperTypes(std::list<std::string>& pRes) const;
   void generateSignatureForSubAndUpperTypes(std::list<std::string>& pRes) const;
 
-  void setArgumentType(std::size_t pIndex, const std::shared_ptr<Type>& pType);
-  void setFluentType(const std::shared_ptr<Type>& pType);
+  /// Set the type of an argument. The type is not owned, it has to outlive the fact.
+  void setArgumentType(std::size_t pIndex, const Type* pType);
+  /// Set the type of the fluent. The type is not owned, it has to outlive the fact.
+  void setFluentType(const Type* pType);
   void setFluent(const std::optional<Entity>& pFluent);
   void setFluentValue(const std::string& pFluentStr);
 
@@ -1,7 +1,10 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_GOAL_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_GOAL_HPP
 
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <set>
 #include <string>
 #include <chrono>
 #include "condition.hpp"
@@ -45,10 +48,13 @@ struct ORDEREDGOALSPLANNER_API Goal
   /// Clone the goal.
   std::unique_ptr<Goal> clone() const;
 
-  /// Set start of inactive time, if not already set. (inactive = not in top of the goals stack)
-  void setInactiveSinceIfNotAlreadySet(const std::unique_ptr<std::chrono::steady_clock::time_point>& pInactiveSince);
+  /**
+   * @brief Set start of inactive time, if not already set. (inactive = not in top of the goals stack)
+   * @param pInactiveSince Start of inactive time.
+   * @return True if the start of inactive time has been set by this call.
+   */
+  bool setInactiveSinceIfNotAlreadySet(const std::unique_ptr<std::chrono::steady_clock::time_point>& pInactiveSince);
 
-  // TODO: Optimize by having to lazy current time value!
   /**
    * @brief Check if the goal is inactive for too long.
    * @param pNow Current time.
@@ -56,11 +62,19 @@ struct ORDEREDGOALSPLANNER_API Goal
    */
   bool isInactiveForTooLong(const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow) const;
 
+  /**
+   * Get the time from which the goal is inactive for too long.<br/>
+   * There is no value if the goal cannot be inactive for too long yet.
+   * There is no value either if the goal is inactive for too long as soon as it is inactive (max time to keep inactive equal to 0),
+   * because such a goal is checked without waiting for a deadline.
+   */
+  std::optional<std::chrono::steady_clock::time_point> getInactivityDeadline() const;
+
   /// Notify that the gaol is active. (so in top of the goals stack)
   void notifyActivity();
 
-  /// Get the time when this goal became incative. It is a null pointer if the goal is active.
-  const std::unique_ptr<std::chrono::steady_clock::time_point>& getInactiveSince() const { return _inactiveSince; }
+  /// Get the time when this goal became incative. There is no value if the goal is active.
+  const std::optional<std::chrono::steady_clock::time_point>& getInactiveSince() const { return _inactiveSince; }
 
   /// Convert this goal to a string.
   std::string toStr() const;
@@ -77,8 +91,8 @@ struct ORDEREDGOALSPLANNER_API Goal
   /// Get a const reference of the optional fact contained in this goal.
   const Condition& objective() const { return *_objective; }
 
-  /// Get a reference of the optional fact contained in this goal.
-  Condition& objective() { return *_objective; }
+  /// Get a reference of the optional fact contained in this goal. The objective can be modified so the cache of its satisfaction is reset.
+  Condition& objective() { _satisfactionCache = SatisfactionCache(); return *_objective; }
 
   /// Get the group identifier of this goal. It can be empty if the goal does not belong to a group.
   const std::string& getGoalGroupId() const { return _goalGroupId; }
@@ -118,8 +132,8 @@ private:
    * A goal is inactive if the there is a not satisfied goal upper in the stack of goals of a problem.
    */
   int _maxTimeToKeepInactive;
-  /// Time when this goal became inactive. It is a null pointer if the goal is active.
-  std::unique_ptr<std::chrono::steady_clock::time_point> _inactiveSince;
+  /// Time when this goal became inactive. There is no value if the goal is active.
+  std::optional<std::chrono::steady_clock::time_point> _inactiveSince;
   /// Know if the goal will be kept in the goals stack, when we succeded or failed to satisfy it.
   bool _isPersistentIfSkipped;
   /// Know if the goal will be removed from the goals stack after the first time we try to satisfy it.
@@ -131,6 +145,21 @@ private:
   std::set<std::string> _cacheOfEventsIdThatCanSatisfyThisGoal;
   std::set<ActionId> _cacheOfActionsPredecessors;
   std::set<FullEventId> _cacheOfEventsPredecessors;
+
+  /// Satisfaction of the objective in a world state, managed by WorldState::isGoalSatisfied.
+  struct SatisfactionCache
+  {
+    /// Names of the predicates of the objective. The satisfaction can only change if a fact of these predicates is modified.
+    std::optional<std::set<std::string>> watchedPredicateNames{};
+    /// History of the world state where the satisfaction was evaluated, 0 if it was never evaluated.
+    std::uint64_t worldStateHistoryId = 0;
+    /// Version of the world state where the satisfaction is known.
+    std::uint64_t worldStateVersion = 0;
+    bool isSatisfied = false;
+  };
+  mutable SatisfactionCache _satisfactionCache;
+
+  friend struct WorldState;
 };
 
 } // !ogp
@@ -1,9 +1,13 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_GOALSTACK_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_GOALSTACK_HPP
 
+#include <chrono>
+#include <functional>
 #include <set>
 #include <map>
 #include <memory>
+#include <queue>
+#include <vector>
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/types/fact.hpp>
 #include <orderedgoalsplanner/types/goal.hpp>
@@ -211,6 +215,15 @@ private:
   std::map<int, std::vector<Goal>> _goals{};
   /// Current active goal.
   const Goal* _currentGoalPtr = nullptr;
+  /**
+   * Min-heap of the inactivity deadlines of the goals.<br/>
+   * It allows to know without iterating on the goals if a goal can be inactive for too long.
+   * It can contain the deadline of a goal that has been removed or that is active again, so it is rebuilt after a removal of the expired goals.
+   * The goals with a max time to keep inactive of 0 are not in it, they are removed as soon as they are inactive.
+   */
+  std::priority_queue<std::chrono::steady_clock::time_point,
+                      std::vector<std::chrono::steady_clock::time_point>,
+                      std::greater<std::chrono::steady_clock::time_point>> _inactivityDeadlines{};
 
   void _removeNoStackableGoalsAndNotifyGoalsChanged(
       const WorldState& pWorldState,
@@ -243,6 +256,15 @@ private:
   /// Get the priority of the goal in top of the stack.
   int _getCurrentPriority(const WorldState& pWorldState) const;
 
+  /// Know if the earliest inactivity deadline is reached, so if a goal can be inactive for too long.
+  bool _canAGoalBeInactiveForTooLong(const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow) const;
+
+  /// Add the inactivity deadline of a goal, if it has one.
+  void _addInactivityDeadline(const Goal& pGoal);
+
+  /// Rebuild the inactivity deadlines from the goals.
+  void _refreshInactivityDeadlines();
+
 
   /**
    * @brief Remove no stackable goals.
@@ -24,6 +24,14 @@ struct ORDEREDGOALSPLANNER_API Historical
    */
   void notifyActionDone(const ActionId& pActionId);
 
+  /**
+   * @brief Set the number of time that an action has already been done (ex: to restore a saved historical).
+   * @param pActionId Action identifier.
+   * @param pNbOfTimes Number of time that the action has already been done. 0 forgets the action.
+   */
+  void setNbOfTimeAnActionHasAlreadyBeenDone(const ActionId& pActionId,
+                                             std::size_t pNbOfTimes);
+
   /**
    * @brief Has an action already been done.
    * @param pActionId Action identifier.
@@ -38,6 +46,9 @@ struct ORDEREDGOALSPLANNER_API Historical
    */
   std::size_t getNbOfTimeAnActionHasAlreadyBeenDone(const ActionId& pActionId) const;
 
+  /// Get the number of time that each action has already been done.
+  std::map<ActionId, std::size_t> getActionsAlreadyDone() const;
+
 private:
   /// Mutex to proect this struct.
   std::shared_ptr<std::mutex> _mutexPtr;
@@ -46,6 +57,9 @@ private:
 
   // Notify that an action finished.
   void _notifyActionDone(const ActionId& pActionId);
+  // Set the number of time that an action has already been done.
+  void _setNbOfTimeAnActionHasAlreadyBeenDone(const ActionId& pActionId,
+                                              std::size_t pNbOfTimes);
   // Has an action already been done.
   bool _hasActionAlreadyBeenDone(const ActionId& pActionId) const;
   // Get the number of time that an action has already been done.
@@ -6,6 +6,7 @@
 #include <set>
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/types/goal.hpp>
+#include <orderedgoalsplanner/types/plannerstats.hpp>
 
 
 namespace ogp
@@ -32,6 +33,9 @@ struct LookForAnActionOutputInfos
   std::size_t nbOfSatisfiedGoals() const { return _goalsSatisfied.size(); }
   bool isFirstGoalInSuccess() const { return _firstGoalInSuccess && *_firstGoalInSuccess; }
   void moveGoalsDone(std::list<Goal>& pGoals) { pGoals = std::move(_goalsSatisfied); }
+  /// Work done by the planner while these informations were filled.
+  PlannerStats& stats() { return _stats; }
+  const PlannerStats& stats() const { return _stats; }
 
 private:
   PlannerStepType _type;
@@ -39,6 +43,7 @@ private:
   std::list<Goal> _goalsSatisfied;
   std::set<const Goal*> _persistentGoalsSatisfied;
   std::optional<bool> _firstGoalInSuccess;
+  PlannerStats _stats;
 };
 
 } // !ogp
@@ -11,10 +11,18 @@ struct Entity;
 struct SetOfTypes;
 
 
+/// Parameter of an action, of an event, of a predicate or of a quantified expression.
 struct ORDEREDGOALSPLANNER_API Parameter
 {
+  /**
+   * @brief Construct a parameter.
+   * @param[in] pName Name of the parameter (ex: "?r").
+   * @param[in] pType Type of the parameter, not owned. It can be nullptr.<br/>
+   * The parameter only points to it, so the SetOfTypes that contains this type has to live longer than the
+   * parameter and its copies.
+   */
   Parameter(const std::string& pName,
-            const std::shared_ptr<Type>& pType);
+            const Type* pType);
 
   Parameter(const Parameter& pOther) = default;
   Parameter(Parameter&& pOther) noexcept;
@@ -28,13 +36,14 @@ struct ORDEREDGOALSPLANNER_API Parameter
 
   static Parameter fromStr(const std::string& pStr,
                            const SetOfTypes& pSetOfTypes);
-  static Parameter fromType(const std::shared_ptr<Type>& pType);
+  static Parameter fromType(const Type* pType);
   std::string toStr() const;
   Entity toEntity() const;
   bool isAParameterToFill() const;
 
   std::string name;
-  std::shared_ptr<Type> type;
+  /// Type of the parameter, owned by a SetOfTypes.
+  const Type* type;
 };
 
 } // !ogp
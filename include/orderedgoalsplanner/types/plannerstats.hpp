@@ -0,0 +1,116 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_PLANNERSTATS_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_TYPES_PLANNERSTATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include "../util/api.hpp"
+
+
+namespace ogp
+{
+
+/// Phase of the planner, to know where the allocations are done.
+enum class PlannerPhase
+{
+  OTHER,
+  PARSING,
+  DOMAIN_PREPROCESSING,
+  CACHE_REFRESH,
+  PLANNING,
+  LOOKAHEAD,
+  PROBLEM_COPY,
+  EVENT_PROPAGATION,
+  PARALLELISATION
+};
+
+/// Number of values of PlannerPhase.
+constexpr std::size_t nbOfPlannerPhases = 9;
+
+ORDEREDGOALSPLANNER_API
+std::string plannerPhaseToStr(PlannerPhase pPlannerPhase);
+
+
+/// Allocations done in a phase of the planner.
+struct ORDEREDGOALSPLANNER_API PhaseAllocations
+{
+  std::size_t nbOfAllocations = 0;
+  std::size_t nbOfBytes = 0;
+};
+
+
+/**
+ * Counters of the work done by the planner, to understand why a planning call was slow.<br/>
+ * The counters are only incremented if the library is built with ORDERED_GOALS_PLANNER_ENABLE_STATS,
+ * otherwise they are compiled to nothing and they stay to 0.
+ */
+struct ORDEREDGOALSPLANNER_API PlannerStats
+{
+  /// True if the library is built to count the work done by the planner.
+  static bool isEnabled();
+  /// True if the library is built to count the allocations of each phase of the planner.
+  static bool isAllocationAccountingEnabled();
+
+  /// Add the counters of another stats.
+  void add(const PlannerStats& pOther);
+
+  /// Ratio of the goal caches that were already up to date, between 0 and 1.
+  double goalCacheHitRate() const;
+  /// Ratio of the world state caches that were already up to date, between 0 and 1.
+  double worldStateCacheHitRate() const;
+
+  /// Allocations done in a phase of the planner.
+  const PhaseAllocations& allocations(PlannerPhase pPlannerPhase) const { return allocationsPerPhase[static_cast<std::size_t>(pPlannerPhase)]; }
+  /// Allocations done in all the phases of the planner.
+  PhaseAllocations totalAllocations() const;
+
+  /// Print the counters, one per line.
+  std::string toStr() const;
+
+  /// Number of actions examined to find the first action for a goal.
+  std::size_t nbOfCandidateActions = 0;
+  /// Number of searches of an effect that can satisfy a goal.
+  std::size_t nbOfLookForAPossibleEffectCalls = 0;
+  /// Maximum depth of recursion of the searches of an effect that can satisfy a goal.
+  std::size_t maxLookForAPossibleEffectDepth = 0;
+  /// Number of plan costs extracted to compare the potential next actions.
+  std::size_t nbOfPlanCostLookaheads = 0;
+  /// Number of copies of the problem done by the planner.
+  std::size_t nbOfProblemCopies = 0;
+  /// Number of nodes of conditions evaluated.
+  std::size_t nbOfConditionEvaluations = 0;
+  /// Number of events applied.
+  std::size_t nbOfEventsFired = 0;
+  std::size_t nbOfGoalCacheHits = 0;
+  std::size_t nbOfGoalCacheMisses = 0;
+  std::size_t nbOfWorldStateCacheHits = 0;
+  std::size_t nbOfWorldStateCacheMisses = 0;
+  /// Allocations done in each phase of the planner, only filled with ORDERED_GOALS_PLANNER_ENABLE_ALLOCATION_STATS.
+  std::array<PhaseAllocations, nbOfPlannerPhases> allocationsPerPhase{};
+};
+
+
+/**
+ * Record the work done by the planner in the current thread in some stats during the lifetime of this object.<br/>
+ * It is useful to also record the work done outside of the planning functions, like the parsing.<br/>
+ * If stats are already recorded, the work done is also added to them at the destruction of this object.
+ * It does nothing if the library is built without ORDERED_GOALS_PLANNER_ENABLE_STATS.
+ */
+class ORDEREDGOALSPLANNER_API PlannerStatsScope
+{
+public:
+  explicit PlannerStatsScope(PlannerStats* pStatsPtr);
+  ~PlannerStatsScope();
+
+  PlannerStatsScope(const PlannerStatsScope&) = delete;
+  PlannerStatsScope& operator=(const PlannerStatsScope&) = delete;
+
+private:
+  PlannerStats* _statsPtr;
+  PlannerStats* _previousStatsPtr;
+};
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_TYPES_PLANNERSTATS_HPP
@@ -3,6 +3,7 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "../util/api.hpp"
 #include "parameter.hpp"
@@ -13,12 +14,23 @@ namespace ogp
 
 struct ORDEREDGOALSPLANNER_API Predicate
 {
-  Predicate(const std::string& pStr,
+  Predicate(std::string_view pStr,
             bool pStrPddlFormated,
             const SetOfTypes& pSetOfTypes,
             std::size_t pBeginPos = 0,
             std::size_t* pResPos = nullptr);
 
+  /**
+   * @brief Construct a predicate from its parts.
+   * @param[in] pName Name of the predicate.
+   * @param[in] pParameters Argument types of the predicate.
+   * @param[in] pFluent Fluent type of the predicate, not owned. Like the types of the parameters, it has to belong
+   * to a SetOfTypes that outlives the predicate.
+   */
+  Predicate(const std::string& pName,
+            const std::vector<Parameter>& pParameters,
+            const Type* pFluent = nullptr);
+
   std::string toPddl() const;
   std::string toStr() const;
 
@@ -30,7 +42,7 @@ struct ORDEREDGOALSPLANNER_API Predicate
   /// Argument types of the predicate.
   std::vector<Parameter> parameters;
   /// Fluent type of the predicate.
-  std::shared_ptr<Type> fluent;
+  const Type* fluent;
 };
 
 } // !ogp
@@ -10,7 +10,7 @@ namespace ogp
 
 struct ORDEREDGOALSPLANNER_API SetOfConstFacts
 {
-  static SetOfConstFacts fromPddl(const std::string& pStr,
+  static SetOfConstFacts fromPddl(std::string_view pStr,
                                   std::size_t& pPos,
                                   const Ontology& pOntology,
                                   const SetOfEntities& pEntities) {
@@ -11,6 +11,7 @@ namespace ogp
 {
 struct Condition;
 struct Predicate;
+struct SetOfEvents;
 
 
 struct ORDEREDGOALSPLANNER_API SetOfDerivedPredicates
@@ -22,11 +23,36 @@ struct ORDEREDGOALSPLANNER_API SetOfDerivedPredicates
 
   const Predicate* nameToPredicatePtr(const std::string& pPredicateName) const;
 
+  /**
+   * @brief Get the condition to put in place of a derived predicate.
+   * @param[in] pFactOptional Fact that can be a derived predicate.
+   * @return The condition of the derived predicate filled with the arguments of the fact, or nothing if the fact is
+   * not a derived predicate or if the derived predicates are materialized.
+   */
   std::unique_ptr<Condition> optFactToConditionPtr(const FactOptional& pFactOptional) const;
 
+  /**
+   * @brief Set if the derived predicates are materialized.<br/>
+   * If they are, the derived predicates are not expanded in the conditions of the actions,
+   * they are kept as facts in the world state by events that are triggered when the facts they depend on change.
+   * It has to be set before the construction of the domain.
+   * @param[in] pMaterialized True to materialize the derived predicates.
+   */
+  void setMaterialized(bool pMaterialized) { _isMaterialized = pMaterialized; }
+
+  /// True if the derived predicates are kept as facts in the world state.
+  bool isMaterialized() const { return _isMaterialized; }
+
+  /// Get the events that keep up to date the facts of the derived predicates.
+  SetOfEvents toSetOfEvents(const Ontology& pOntology) const;
+
+  /// Derived predicates by name.
+  const std::map<std::string, DerivedPredicate>& derivedPredicates() const { return _nameToDerivedPredicate; }
+
 
 private:
   std::map<std::string, DerivedPredicate> _nameToDerivedPredicate;
+  bool _isMaterialized;
 };
 
 } // namespace ogp
@@ -33,6 +33,9 @@ struct ORDEREDGOALSPLANNER_API SetOfEntities
 
   bool empty() const { return _valueToEntity.empty(); }
 
+  /// Entities by value.
+  const std::map<std::string, Entity>& entities() const { return _valueToEntity; }
+
 private:
   std::map<std::string, Entity> _valueToEntity;
   std::map<std::string, std::set<Entity>> _typeNameToEntities;
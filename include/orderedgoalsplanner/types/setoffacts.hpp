@@ -2,11 +2,13 @@
 #define INCLUDE_ORDEREDGOALSPLANNER_SETOFFACTS_HPP
 
 #include "../util/api.hpp"
+#include "../util/util.hpp"
 #include <list>
 #include <map>
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <sstream>
 
@@ -22,8 +24,12 @@ struct SetOfEntities;
 struct ORDEREDGOALSPLANNER_API SetOfFacts
 {
   SetOfFacts();
+  SetOfFacts(const SetOfFacts& pOther);
+  SetOfFacts(SetOfFacts&& pOther) = default;
+  SetOfFacts& operator=(const SetOfFacts& pOther);
+  SetOfFacts& operator=(SetOfFacts&& pOther) = default;
 
-  static SetOfFacts fromPddl(const std::string& pStr,
+  static SetOfFacts fromPddl(std::string_view pStr,
                              std::size_t& pPos,
                              const Ontology& pOntology,
                              const SetOfEntities& pEntities,
@@ -31,6 +37,9 @@ struct ORDEREDGOALSPLANNER_API SetOfFacts
 
   std::string toPddl(std::size_t pIdentation, bool pPrintTimeLessFactsToo) const;
 
+  /// Write the facts in PDDL in a stream, one fact after the other.
+  void toPddl(std::ostream& pOs, std::size_t pIdentation, bool pPrintTimeLessFactsToo) const;
+
   void add(const Fact& pFact,
            bool pCanBeRemoved = true);
 
@@ -86,8 +95,57 @@ struct ORDEREDGOALSPLANNER_API SetOfFacts
   SetOfFactIterator find(const Fact& pFact,
                          bool pIgnoreFluent = false) const;
 
+  /// View on a range of the facts sorted by the value of their numeric fluent.
+  class NumericRange {
+     public:
+         using MultimapIterator = std::multimap<double, const Fact*>::const_iterator;
+
+         NumericRange(MultimapIterator pBegin,
+                      MultimapIterator pEnd)
+           : _begin(pBegin),
+             _end(pEnd)
+         {}
+
+         // The methods are defined in the source file because Fact is incomplete here.
+         class Iterator {
+             MultimapIterator iter;
+
+         public:
+             Iterator(MultimapIterator it) : iter(it) {}
+
+             const Fact& operator*() const;
+             Iterator& operator++();
+             bool operator==(const Iterator& other) const;
+             bool operator!=(const Iterator& other) const;
+         };
+
+         Iterator begin() const { return Iterator(_begin); }
+         Iterator end() const { return Iterator(_end); }
+         bool empty() const { return begin() == end(); }
+         std::string toStr() const;
+
+     private:
+         MultimapIterator _begin;
+         MultimapIterator _end;
+  };
+
   const std::map<Fact, bool>& facts() const { return _facts; }
 
+  /**
+   * @brief Find the facts with a numeric fluent in a range of values.<br/>
+   * It is a range scan on a sorted index so it costs O(log n + k).<br/>
+   * The returned view is invalidated by any modification of this set of facts.
+   * @param[in] pFact Fact to consider for the signature. Its arguments and its fluent are not considered.
+   * @param[in] pNumber Bound of the range.
+   * @param[in] pBoolSuperiorOrInferior True to look for the values superior to pNumber, false for the inferior values.
+   * @param[in] pCanBeEqual True if the range includes pNumber.
+   * @return The facts of the same signature with a numeric fluent in the range.
+   */
+  NumericRange findInNumericRange(const Fact& pFact,
+                                  const Number& pNumber,
+                                  bool pBoolSuperiorOrInferior,
+                                  bool pCanBeEqual) const;
+
   /**
    * @brief Get the value of a fact in the world state.
    * @param[in] pFact Fact to extract the value.
@@ -117,17 +175,25 @@ private:
     ParameterToValues(std::size_t pNbOfArgs)
      : all(),
        argIdToArgValueToValues(pNbOfArgs),
-       fluentValueToValues()
+       fluentValueToValues(),
+       numericFluentToValues()
     {
     }
     std::list<Fact> all;
     std::vector<std::map<std::string, std::list<Fact>>> argIdToArgValueToValues;
     std::map<std::string, std::list<Fact>> fluentValueToValues;
+    /// Facts sorted by the value of their numeric fluent, for the range conditions.<br/>
+    /// The pointers are on the keys of _facts so they are rebound when the set of facts is copied.
+    std::multimap<double, const Fact*> numericFluentToValues;
   };
   std::map<std::string, ParameterToValues> _signatureToLists;
+  /// Empty index to return an empty range for the unknown signatures.
+  static const std::multimap<double, const Fact*> _emptyNumericIndex;
 
   bool _erase(const Fact& pValue);
 
+  void _rebindNumericIndexesToOwnFacts();
+
   // TODO: can be static
   void _removeAValueForList(std::list<Fact>& pList,
                             const Fact& pValue) const;
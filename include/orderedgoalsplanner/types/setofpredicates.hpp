@@ -5,6 +5,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <string_view>
 #include "predicate.hpp"
 
 namespace ogp
@@ -24,10 +25,10 @@ struct ORDEREDGOALSPLANNER_API SetOfPredicates
   static SetOfPredicates fromStr(const std::string& pStr,
                                  const SetOfTypes& pSetOfTypes);
 
-  static SetOfPredicates fromPddl(const std::string& pStr,
+  static SetOfPredicates fromPddl(std::string_view pStr,
                                   std::size_t& pPos,
                                   const SetOfTypes& pSetOfTypes,
-                                  const std::shared_ptr<Type>& pDefaultFluent = {});
+                                  const Type* pDefaultFluent = nullptr);
 
   void addAll(const SetOfPredicates& pOther);
   void addPredicate(const Predicate& pPredicate);
@@ -39,6 +40,9 @@ struct ORDEREDGOALSPLANNER_API SetOfPredicates
   std::string toStr() const;
 
   bool empty() const { return _nameToPredicate.empty(); }
+
+  /// Predicates by name.
+  const std::map<std::string, Predicate>& predicates() const { return _nameToPredicate; }
   bool hasPredicateOfPddlType(PredicatePddlType pTypeFilter) const;
 
 private:
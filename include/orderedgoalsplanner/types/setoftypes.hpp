@@ -20,16 +20,19 @@ struct ORDEREDGOALSPLANNER_API SetOfTypes
                const std::string& pParentType = "");
   void addTypesFromPddl(const std::string& pStr);
 
-  std::shared_ptr<Type> nameToType(const std::string& pName) const;
-  static std::shared_ptr<Type> numberType();
+  const Type* nameToType(const std::string& pName) const;
+  static const Type* numberType();
 
   std::list<std::string> typesToStrs() const;
   std::string toStr(std::size_t pIdentation = 0) const;
   bool empty() const;
 
+  /// Types without parent. The other types are reachable from their sub-types.
+  const std::list<std::shared_ptr<Type>>& rootTypes() const { return _types; }
+
 private:
   std::list<std::shared_ptr<Type>> _types;
-  std::map<std::string, std::shared_ptr<Type>> _nameToType;
+  std::map<std::string, Type*> _nameToType;
 };
 
 } // namespace ogp
@@ -9,10 +9,15 @@
 namespace ogp
 {
 
+/**
+ * A type of entities and of parameters.<br/>
+ * The types are owned by the SetOfTypes that creates them, and live as long as this set of types or one of its copies.
+ * So the entities, the parameters and the facts only keep a pointer to their type, that is cheap to copy.
+ */
 struct ORDEREDGOALSPLANNER_API Type
 {
   Type(const std::string& pName,
-       const std::shared_ptr<Type>& pParent = {});
+       const Type* pParent = nullptr);
 
   Type(const Type& pOther) = default;
   Type(Type&& pOther) noexcept = delete;
@@ -25,11 +30,13 @@ struct ORDEREDGOALSPLANNER_API Type
 
   bool operator<(const Type& pOther) const;
 
-  static std::shared_ptr<Type> getSmallerType(const std::shared_ptr<Type>& pType1,
-                                              const std::shared_ptr<Type>& pType2);
+  static const Type* getSmallerType(const Type* pType1,
+                                    const Type* pType2);
 
   const std::string name;
-  const std::shared_ptr<Type> parent;
+  /// Parent type, not owned.
+  const Type* const parent;
+  /// Sub-types, owned by this type.
   std::list<std::shared_ptr<Type>> subTypes;
 };
 
@@ -2,14 +2,17 @@
 #define INCLUDE_ORDEREDGOALSPLANNER_TYPES_WORLDSTATE_HPP
 
 #include <chrono>
+#include <cstdint>
 #include <list>
 #include <map>
 #include <memory>
 #include <set>
+#include <string_view>
 #include <orderedgoalsplanner/types/fact.hpp>
 #include <orderedgoalsplanner/types/factstovalue.hpp>
 #include <orderedgoalsplanner/types/setoffacts.hpp>
 #include <orderedgoalsplanner/util/alias.hpp>
+#include <orderedgoalsplanner/util/functionref.hpp>
 #include <orderedgoalsplanner/util/observableunsafe.hpp>
 #include "../util/api.hpp"
 
@@ -43,7 +46,14 @@ struct ORDEREDGOALSPLANNER_API WorldState
 
   void operator=(const WorldState& pOther);
 
-  bool modifyFactsFromPddl(const std::string& pStr,
+  /**
+   * @brief Add or remove the facts of a PDDL list (ex: content of the init section of a problem).
+   * @param[in] pStr String containing the PDDL facts. It can be a view on a memory mapped file.
+   * @param[in, out] pPos Begin position of the facts in pStr, set to the position of the closing parenthesis at the end.
+   * Each fact is inserted as soon as it is parsed. The events, the callbacks and the goals are notified once, after the last fact.
+   * @return True if some facts were modified.
+   */
+  bool modifyFactsFromPddl(std::string_view pStr,
                            std::size_t& pPos,
                            GoalStack& pGoalStack,
                            const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
@@ -154,6 +164,24 @@ struct ORDEREDGOALSPLANNER_API WorldState
                    const SetOfEntities& pEntities,
                    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow);
 
+  /**
+   * @brief Apply the events of a set of events for every arguments that satisfy their precondition.<br/>
+   * The events are usually tried only when a fact of their precondition changes, so the facts deduced from the absence
+   * of other facts (ex: a materialized derived predicate on a "not") are only known after this evaluation.
+   * @param[in] pSetOfEventsId Identifier of the set of events to evaluate.
+   * @param[out] pGoalStack Goal stacks that need to be refreshed.
+   * @param[in] pSetOfEvents events to apply indirect modifications according to the events.
+   * @param[in] pNow Current time.
+   * @return True if some facts were modified.
+   */
+  bool applyEventsOfASet(const SetOfEventsId& pSetOfEventsId,
+                         GoalStack& pGoalStack,
+                         const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
+                         const SetOfCallbacks& pCallbacks,
+                         const Ontology& pOntology,
+                         const SetOfEntities& pEntities,
+                         const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow);
+
   /**
    * @brief Modify the world state.
    * @param[in] pWsModifPtr Modification to do.
@@ -161,6 +189,7 @@ struct ORDEREDGOALSPLANNER_API WorldState
    * For example the current goal of the stack can be satisfied now and so maybe it should be removed from the goal stack.
    * @param[in] pSetOfEvents events to apply indirect modifications according to the events.
    * @param[in] pNow Current time.
+   * @param[in] pParametersToArgumentPtr Parameters of the modification to replace by their argument.
    */
   bool modify(const WorldStateModification* pWsModifPtr,
               GoalStack& pGoalStack,
@@ -169,7 +198,8 @@ struct ORDEREDGOALSPLANNER_API WorldState
               const Ontology& pOntology,
               const SetOfEntities& pEntities,
               const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
-              bool pCanFactsBeRemoved = true);
+              bool pCanFactsBeRemoved = true,
+              const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr);
 
   /**
    * @brief Set the facts of the world.
@@ -238,7 +268,8 @@ struct ORDEREDGOALSPLANNER_API WorldState
 
   /**
    * @brief Check if a goal is satisfied.<br/>
-   * A goal is satisfied if his internal objective condition is satisfied and if the goal is enabled.
+   * A goal is satisfied if his internal objective condition is satisfied and if the goal is enabled.<br/>
+   * The result is cached in the goal, and the objective is evaluated again only if a fact of one of its predicates was modified.
    * @param[in] pGoal Goal to check.
    * @return True if the goal is satisfied.
    */
@@ -251,7 +282,7 @@ struct ORDEREDGOALSPLANNER_API WorldState
    * @param[in] pParametersToConsiderAsAnyValue Parameters to consider as "any value" if there possible values (set of string) is empty.
    * @param[in] pParametersToConsiderAsAnyValuePtr Other parameters to consider as "any value" if there possible values (set of string) is empty.
    */
-  void iterateOnMatchingFactsWithoutFluentConsideration(const std::function<bool (const Fact&)>& pCallback,
+  void iterateOnMatchingFactsWithoutFluentConsideration(FunctionRef<bool (const Fact&)> pCallback,
                                                         const Fact& pFact,
                                                         const std::map<Parameter, std::set<Entity>>& pParametersToConsiderAsAnyValue,
                                                         const std::map<Parameter, std::set<Entity>>* pParametersToConsiderAsAnyValuePtr = nullptr) const;
@@ -263,7 +294,7 @@ struct ORDEREDGOALSPLANNER_API WorldState
    * @param[in] pParametersToConsiderAsAnyValue Parameters to consider as "any value" if there possible values (set of string) is empty.
    * @param[in] pParametersToConsiderAsAnyValuePtr Other parameters to consider as "any value" if there possible values (set of string) is empty.
    */
-  void iterateOnMatchingFacts(const std::function<bool (const Fact&)>& pValueCallback,
+  void iterateOnMatchingFacts(FunctionRef<bool (const Fact&)> pValueCallback,
                               const Fact& pFact,
                               const std::map<Parameter, std::set<Entity>>& pParametersToConsiderAsAnyValue,
                               const std::map<Parameter, std::set<Entity>>* pParametersToConsiderAsAnyValuePtr = nullptr) const;
@@ -278,6 +309,17 @@ private:
   /// Facts of the world state.
   SetOfFacts _factsMapping;
   std::unique_ptr<WorldStateCache> _cache;
+  /// Identifier of the history of the facts. A new identifier is taken when the facts are copied or reset.
+  std::uint64_t _historyId;
+  /// Number of modifications of the facts in this history.
+  std::uint64_t _version;
+  /// Predicate name to the version of the last modification of a fact of this predicate in this history.
+  std::map<std::string, std::uint64_t> _predicateNameToVersion;
+
+  /// Start a new history of modifications.
+  void _resetHistory();
+  /// Notify that a fact of a predicate has been modified.
+  void _notifyPredicateModified(const std::string& pPredicateName);
 
   /// Stored what changed.
   struct WhatChanged
@@ -344,6 +386,7 @@ private:
    * @brief Modify the world state without event deduction and raising a notification.
    * @param[out] pWhatChanged Get what changed.
    * @param[in] pWsModifPtr Modification to do.
+   * @param[in] pParametersToArgumentPtr Parameters of the modification to replace by their argument.
    * @param[out] pGoalStack Goal stacks that need to be refreshed.<br/>
    * For example the current goal of the stack can be satisfied now and so maybe it should be removed from the goal stack.
    * @param[in] pSetOfEvents events to apply indirect modifications according to the events.
@@ -351,6 +394,7 @@ private:
    */
   void _modify(WhatChanged& pWhatChanged,
                const WorldStateModification* pWsModifPtr,
+               const std::map<Parameter, Entity>* pParametersToArgumentPtr,
                GoalStack& pGoalStack,
                const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
                const SetOfCallbacks& pCallbacks,
@@ -8,6 +8,7 @@
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/util/alias.hpp>
 #include <orderedgoalsplanner/util/continueorbreak.hpp>
+#include <orderedgoalsplanner/util/functionref.hpp>
 
 namespace ogp
 {
@@ -89,18 +90,28 @@ struct ORDEREDGOALSPLANNER_API WorldStateModification
    * @brief Iterate over all the optional facts with fact value resolution according to the world state.
    * @param[in] pFactCallback Callback called for each optional fact of this object.
    * @param[in] pSetOfFact Facts to use to extract value of the facts.
+   * @param[in] pParametersToArgumentPtr Parameters to replace by their argument in the facts given to the callback.<br/>
+   * It avoids to clone this object to apply it with some arguments.
    */
-  virtual void forAll(const std::function<void (const FactOptional&)>& pFactCallback,
-                      const SetOfFacts& pSetOfFact) const = 0;
+  virtual void forAll(FunctionRef<void (const FactOptional&)> pFactCallback,
+                      const SetOfFacts& pSetOfFact,
+                      const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr) const = 0;
 
-  virtual ContinueOrBreak forAllThatCanBeModified(const std::function<ContinueOrBreak (const FactOptional&)>& pFactCallback) const = 0;
+  /**
+   * @brief Iterate over the optional facts that this object can modify.
+   * @param[in] pFactCallback Callback called for each optional fact that can be modified.
+   * @param[in] pParametersToArgumentPtr Parameters to replace by their argument in the facts given to the callback.
+   * @return BREAK if the callback stopped the iteration.
+   */
+  virtual ContinueOrBreak forAllThatCanBeModified(FunctionRef<ContinueOrBreak (const FactOptional&)> pFactCallback,
+                                                  const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr) const = 0;
 
   /**
    * @brief Iterate over all the optional facts that can be accessible.
    * @param[in] pFactCallback Callback called for each optional fact that can be accessible.
    * @param[in] pSetOfFact Facts to use to extract value of the facts.
    */
-  virtual void iterateOverAllAccessibleFacts(const std::function<void (const FactOptional&)>& pFactCallback,
+  virtual void iterateOverAllAccessibleFacts(FunctionRef<void (const FactOptional&)> pFactCallback,
                                              const SetOfFacts& pSetOfFact) const = 0;
 
   /**
@@ -108,7 +119,7 @@ struct ORDEREDGOALSPLANNER_API WorldStateModification
    * @param[in] pFactCallback Callback called for each optional fact of this object.
    * @param[in] pSetOfFact Facts to use to extract value of the facts.
    */
-  virtual bool forAllUntilTrue(const std::function<bool (const FactOptional&)>& pFactCallback,
+  virtual bool forAllUntilTrue(FunctionRef<bool (const FactOptional&)> pFactCallback,
                                const SetOfFacts& pSetOfFact) const = 0;
 
   /**
@@ -118,12 +129,12 @@ struct ORDEREDGOALSPLANNER_API WorldStateModification
    * @param[in] pWorldState World state use to extract value of the facts.
    * @param[in] pFromDeductionId Identifier of the deduction holding the world state modification.
    */
-  virtual bool canSatisfyObjective(const std::function<bool (const FactOptional&, std::map<Parameter, std::set<Entity>>*, const std::function<bool (const std::map<Parameter, std::set<Entity>>&)>&)>& pFactCallback,
+  virtual bool canSatisfyObjective(FunctionRef<bool (const FactOptional&, std::map<Parameter, std::set<Entity>>*, FunctionRef<bool (const std::map<Parameter, std::set<Entity>>&)>)> pFactCallback,
                                    std::map<Parameter, std::set<Entity>>& pParameters,
                                    const WorldState& pWorldState,
                                    const std::string& pFromDeductionId) const = 0;
 
-  virtual bool iterateOnSuccessions(const std::function<bool (const Successions&, const FactOptional&, std::map<Parameter, std::set<Entity>>*, const std::function<bool (const std::map<Parameter, std::set<Entity>>&)>&)>& pCallback,
+  virtual bool iterateOnSuccessions(FunctionRef<bool (const Successions&, const FactOptional&, std::map<Parameter, std::set<Entity>>*, FunctionRef<bool (const std::map<Parameter, std::set<Entity>>&)>)> pCallback,
                                     std::map<Parameter, std::set<Entity>>& pParameters,
                                     const WorldState& pWorldState,
                                     bool pCanSatisfyThisGoal,
@@ -143,9 +154,11 @@ struct ORDEREDGOALSPLANNER_API WorldStateModification
   /**
    * @brief Convert this world state modification to a value.
    * @param[in] pWorldState World state use to extract value of the facts.
+   * @param[in] pParametersToArgumentPtr Parameters to replace by their argument before to extract the value.
    * @return The world state modification converted to a string value.
    */
-  virtual std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact) const = 0;
+  virtual std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact,
+                                          const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr) const = 0;
 
   /// Convert this world state modification to an optional fact if possible.
   virtual const FactOptional* getOptionalFact() const = 0;
@@ -157,8 +170,16 @@ struct ORDEREDGOALSPLANNER_API WorldStateModification
    */
   virtual std::unique_ptr<WorldStateModification> clone(const std::map<Parameter, Entity>* pParametersToArgumentPtr) const = 0;
 
+  /**
+   * @brief Check if this object can modify some optional facts in another way than them.
+   * @param[in] pFactsOpt Optional facts to check.
+   * @param[in] pParametersPtr Parameters that can match any argument.
+   * @param[in] pParametersToArgumentPtr Parameters of this object to replace by their argument before the check.
+   * @return True if there is a contradiction.
+   */
   virtual bool hasAContradictionWith(const std::set<FactOptional>& pFactsOpt,
-                                     std::list<Parameter>* pParametersPtr = nullptr) const = 0;
+                                     std::list<Parameter>* pParametersPtr = nullptr,
+                                     const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr) const = 0;
 };
 
 
@@ -1,12 +1,87 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_ARITHMETICEVALUATOR_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_ARITHMETICEVALUATOR_HPP
 
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "api.hpp"
+#include "util.hpp"
 
 namespace ogp
 {
 
+/// Arithmetic expression compiled once in a small bytecode, to be evaluated many times.
+struct ORDEREDGOALSPLANNER_API ArithmeticExpression
+{
+  /**
+   * @brief Compile an arithmetic expression.<br/>
+   * It supports the integers, the floats, +, -, *, /, the unary minus, the parenthesis
+   * and the variables written as ${name}.
+   * @param[in] pText Text containing the expression.
+   * @param[in] pBeginPos Position of the beginning of the expression in the text.
+   * @param[out] pEndPosPtr If not null, it is set to the position just after the expression.
+   * @return The compiled expression. An exception is raised if the expression is not valid.
+   */
+  static ArithmeticExpression compile(const std::string& pText,
+                                      std::size_t pBeginPos = 0,
+                                      std::size_t* pEndPosPtr = nullptr);
+
+  /**
+   * @brief Evaluate an expression while it is parsed, without compiling it.<br/>
+   * It is for the one-shot evaluations, an expression evaluated many times should be compiled.
+   * @param[in] pText Text containing the expression. It cannot have variables.
+   * @param[in] pBeginPos Position of the beginning of the expression in the text.
+   * @param[out] pEndPosPtr If not null, it is set to the position just after the expression.
+   * @return The result. An exception is raised if the expression is not valid.
+   */
+  static Number interpret(const std::string& pText,
+                          std::size_t pBeginPos = 0,
+                          std::size_t* pEndPosPtr = nullptr);
+
+  /// Names of the variables of the expression, the index of a variable is its slot.
+  const std::vector<std::string>& variables() const { return _variables; }
+
+  /**
+   * @brief Evaluate the expression.
+   * @param[in] pVariableValues Values of the variables, indexed by their slot.
+   * @return The result. It is an int if only ints are involved.
+   */
+  Number evaluate(const std::vector<Number>& pVariableValues = {}) const;
+
+private:
+  enum class OpCode : std::uint8_t
+  {
+    PUSH_CONSTANT,
+    PUSH_VARIABLE,
+    PLUS,
+    MINUS,
+    MULTIPLY,
+    DIVIDE,
+    NEGATE
+  };
+
+  struct Instruction
+  {
+    OpCode opCode;
+    std::size_t operand;
+  };
+
+  template <typename TBackend>
+  struct Parser;
+  struct Compiler;
+  struct Interpreter;
+
+  static Number _applyBinaryOperator(OpCode pOpCode,
+                                     const Number& pLeft,
+                                     const Number& pRight);
+
+  std::vector<Instruction> _instructions;
+  std::vector<Number> _constants;
+  std::vector<std::string> _variables;
+  std::size_t _maxStackSize = 0;
+};
+
+
 ORDEREDGOALSPLANNER_API
 int evalute(const std::string& pText,
             std::size_t pBeginPos = 0);
@@ -15,6 +90,10 @@ ORDEREDGOALSPLANNER_API
 std::string evaluteToStr(const std::string& pText,
                          std::size_t pBeginPos = 0);
 
+/// Convert the result of an evaluation to a string, with the shortest representation for the floats.
+ORDEREDGOALSPLANNER_API
+std::string evaluationResultToStr(const Number& pNumber);
+
 }
 
 #endif // INCLUDE_ORDEREDGOALSPLANNER_ARITHMETICEVALUATOR_HPP
@@ -0,0 +1,48 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_UTIL_FUNCTIONREF_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_UTIL_FUNCTIONREF_HPP
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace ogp
+{
+
+template <typename Signature>
+struct FunctionRef;
+
+/**
+ * Non-owning reference to a callable, to pass callbacks without the allocation and the type erasure of std::function.<br/>
+ * The referenced callable has to outlive the FunctionRef, so it is meant for parameters of functions and it should not be stored.
+ */
+template <typename Result, typename... Args>
+struct FunctionRef<Result (Args...)>
+{
+  template <typename Callable,
+            typename = std::enable_if_t<!std::is_same<std::decay_t<Callable>, FunctionRef>::value &&
+                                        std::is_invocable_r<Result, Callable&, Args...>::value>>
+  FunctionRef(Callable&& pCallable) noexcept
+    : _callablePtr(const_cast<void*>(static_cast<const void*>(std::addressof(pCallable)))),
+      _invoke([](void* pCallablePtr, Args... pArgs) -> Result {
+        auto& callable = *static_cast<std::add_pointer_t<Callable>>(pCallablePtr);
+        if constexpr (std::is_void<Result>::value)
+          callable(std::forward<Args>(pArgs)...);
+        else
+          return callable(std::forward<Args>(pArgs)...);
+      })
+  {
+  }
+
+  Result operator()(Args... pArgs) const
+  {
+    return _invoke(_callablePtr, std::forward<Args>(pArgs)...);
+  }
+
+private:
+  void* _callablePtr;
+  Result (*_invoke)(void*, Args...);
+};
+
+}
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_UTIL_FUNCTIONREF_HPP
@@ -0,0 +1,50 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_UTIL_MAPPEDFILE_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_UTIL_MAPPEDFILE_HPP
+
+#include "api.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace ogp
+{
+
+/**
+ * Read-only content of a file mapped in memory.<br/>
+ * On the platforms without mmap the file is read in one allocation of the file size.
+ */
+struct ORDEREDGOALSPLANNER_API MappedFile
+{
+  /**
+   * @brief Map a file in memory.
+   * @param[in] pFilePath Path of the file to map.
+   * An exception is raised if the file cannot be opened.
+   */
+  MappedFile(const std::string& pFilePath);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& pOther) noexcept;
+  MappedFile& operator=(MappedFile&& pOther) noexcept;
+
+  /// Content of the file. It is valid as long as this object is alive.
+  std::string_view content() const { return std::string_view(_data, _size); }
+
+  /// Size of the file in bytes.
+  std::size_t size() const { return _size; }
+
+private:
+  const char* _data;
+  std::size_t _size;
+  /// Buffer used when the file cannot be mapped.
+  std::string _buffer;
+
+  void _release();
+};
+
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_UTIL_MAPPEDFILE_HPP
@@ -0,0 +1,168 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_UTIL_PLANVALIDATOR_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_UTIL_PLANVALIDATOR_HPP
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include "api.hpp"
+#include <orderedgoalsplanner/types/actioninvocationwithgoal.hpp>
+#include <orderedgoalsplanner/types/factoptional.hpp>
+#include <orderedgoalsplanner/types/parallelplan.hpp>
+
+
+namespace ogp
+{
+struct Condition;
+struct Domain;
+struct Problem;
+struct WorldStateModification;
+
+
+/// Result of the validation of a plan.
+struct ORDEREDGOALSPLANNER_API PlanValidation
+{
+  /// Action done while its precondition was not satisfied.
+  struct PreconditionFailure
+  {
+    /// Index of the step in the plan.
+    std::size_t stepIndex;
+    /// Index of the action in the step.
+    std::size_t actionIndex;
+    /// Parts of the precondition that were not satisfied.
+    std::vector<FactOptional> unsatisfiedFacts;
+  };
+
+  /// Actions of the same step with effects that contradict each other.
+  struct EffectConflict
+  {
+    /// Index of the step in the plan.
+    std::size_t stepIndex;
+    /// Index in the step of the first action of the conflict.
+    std::size_t firstActionIndex;
+    /// Index in the step of the second action of the conflict.
+    std::size_t secondActionIndex;
+    /// Fact added by one action and removed by the other one.
+    Fact fact;
+  };
+
+  /// True if all the preconditions and all the goals are satisfied, without conflicting effects.
+  bool isValid() const;
+
+  std::vector<PreconditionFailure> preconditionFailures{};
+  std::vector<EffectConflict> effectConflicts{};
+  /// For each goal of the problem, from the highest priority, true if it is satisfied at the end of the plan.
+  std::vector<bool> goalsSatisfied{};
+};
+
+
+/**
+ * Validator of plans for a problem, meant to check a lot of plans quickly.<br/>
+ * The actions are grounded once in lists of fact identifiers and simulated on a bitset of the facts.
+ * Only the conjunctions of facts are handled in the preconditions and in the goals, and only the
+ * additions, the removals and the assignments of facts are handled in the effects, an exception is raised otherwise.
+ * The events, the callbacks and the goals added by the actions are not simulated.<br/>
+ * The actions grounded are cached, so a validator should not be shared between threads.
+ */
+struct ORDEREDGOALSPLANNER_API PlanValidator
+{
+  /**
+   * @brief Construct a validator.
+   * @param[in] pProblem Problem giving the initial world state and the goals to satisfy.
+   * @param[in] pDomain Domain containing the actions. It has to outlive the validator.
+   */
+  PlanValidator(const Problem& pProblem,
+                const Domain& pDomain);
+
+  /**
+   * @brief Validate a parallel plan.<br/>
+   * The preconditions of the actions of a step are checked on the state at the beginning of the step,
+   * the actions of a step with conflicting effects are reported, then the effects of the step are applied.
+   * @param[in] pPlan Plan to validate.
+   * @return The result of the validation.
+   */
+  PlanValidation validate(const ParallelPan& pPlan);
+
+  /**
+   * @brief Validate a sequential plan.
+   * @param[in] pPlan Plan to validate.
+   * @return The result of the validation.
+   */
+  PlanValidation validate(const std::list<ActionInvocationWithGoal>& pPlan);
+
+  /**
+   * @brief Validate several parallel plans.
+   * @param[in] pPlans Plans to validate.
+   * @return The result of the validation of each plan.
+   */
+  std::vector<PlanValidation> validate(const std::vector<ParallelPan>& pPlans);
+
+private:
+  enum class LiteralKind : std::uint8_t
+  {
+    PRESENT,
+    ABSENT,
+    GROUP_NOT_EMPTY,
+    GROUP_EMPTY
+  };
+
+  struct Literal
+  {
+    LiteralKind kind;
+    /// Identifier of the fact, or of the group of the facts of a fluent for the group kinds.
+    std::size_t id;
+  };
+
+  enum class EffectKind : std::uint8_t
+  {
+    ADD,
+    REMOVE,
+    CLEAR_GROUP
+  };
+
+  struct Effect
+  {
+    EffectKind kind;
+    std::size_t id;
+  };
+
+  struct GroundAction
+  {
+    std::vector<Literal> precondition;
+    /// Fact of each literal of the precondition, to report the failures.
+    std::vector<FactOptional> preconditionFacts;
+    std::vector<Effect> effects;
+  };
+
+  const Domain& _domain;
+  std::map<Fact, std::size_t> _factToId;
+  /// Fact of each identifier, they point to the keys of _factToId.
+  std::vector<const Fact*> _factIdToFact;
+  /// Group of each fact, it is the same for all the values of a fluent.
+  std::vector<std::size_t> _factIdToGroupId;
+  std::map<Fact, std::size_t> _groupToId;
+  std::vector<std::vector<std::size_t>> _groupIdToFactIds;
+  std::vector<std::size_t> _initialFactIds;
+  std::vector<std::vector<Literal>> _goals;
+  std::map<ActionId, std::map<std::map<Parameter, Entity>, GroundAction>> _actionIdToParametersToGroundAction;
+
+  std::size_t _factId(const Fact& pFact);
+  std::size_t _groupId(const Fact& pFact);
+  void _compileCondition(std::vector<Literal>& pLiterals,
+                         std::vector<FactOptional>* pFactsPtr,
+                         const Condition& pCondition);
+  void _compileEffect(std::vector<Effect>& pEffects,
+                      const WorldStateModification& pWsModification);
+  const GroundAction& _groundAction(const ActionInvocation& pActionInvocation);
+  void _addEffectConflicts(std::vector<PlanValidation::EffectConflict>& pEffectConflicts,
+                           std::size_t pStepIndex,
+                           const std::vector<const GroundAction*>& pStep) const;
+  PlanValidation _validate(const std::vector<std::vector<const ActionInvocation*>>& pSteps);
+};
+
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_UTIL_PLANVALIDATOR_HPP
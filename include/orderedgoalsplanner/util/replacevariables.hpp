@@ -3,16 +3,63 @@
 
 #include "api.hpp"
 #include <map>
+#include <optional>
 #include <string>
+#include <vector>
+#include "arithmeticevaluator.hpp"
 
 namespace ogp
 {
 
+/**
+ * @brief Replace the ${variables} of a text and evaluate its `arithmetic expressions`.<br/>
+ * The compiled form of the text is cached, so a text filled many times is parsed only once.
+ * @param[in, out] pStr Text to fill.
+ * @param[in] pVariablesToValue Values of the variables. The unknown variables are kept as they are.
+ */
 ORDEREDGOALSPLANNER_API
 void replaceVariables(std::string& pStr,
                       const std::map<std::string, std::string>& pVariablesToValue);
 
 
+/**
+ * Text with ${variables} and `arithmetic expressions`, parsed once to be filled many times.<br/>
+ * The expressions whose variables are not all numbers are substituted as text then interpreted.
+ */
+struct ORDEREDGOALSPLANNER_API CompiledTemplate
+{
+  CompiledTemplate(const std::string& pStr);
+
+  /**
+   * @brief Fill the template.
+   * @param[in] pVariablesToValue Values of the variables. The unknown variables are kept as they are.
+   * @return The filled text.
+   */
+  std::string apply(const std::map<std::string, std::string>& pVariablesToValue) const;
+
+private:
+  CompiledTemplate() = default;
+
+  struct Part
+  {
+    /// Text to copy, name of the variable, or source of the expression.
+    std::string text;
+    bool isVariable = false;
+    bool isExpression = false;
+    /// Empty for an expression that cannot be compiled.
+    std::optional<ArithmeticExpression> expression;
+  };
+  std::vector<Part> _parts;
+
+  static std::string _substituteAndInterpret(const std::string& pExpression,
+                                             const std::map<std::string, std::string>& pVariablesToValue);
+
+  void _addTextWithVariables(const std::string& pStr,
+                             std::size_t pBeginPos,
+                             std::size_t pEndPos);
+};
+
+
 }
 
 #endif // INCLUDE_ORDEREDGOALSPLANNER_UTIL_REPLACEVARIABLES_HPP
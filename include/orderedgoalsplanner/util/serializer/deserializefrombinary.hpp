@@ -0,0 +1,40 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_DESERIALIZEFROMBINARY_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_DESERIALIZEFROMBINARY_HPP
+
+#include <map>
+#include <string>
+#include <string_view>
+#include "deserializefrompddl.hpp"
+
+namespace ogp
+{
+struct Domain;
+
+
+/**
+ * @brief Load a domain from a binary snapshot.<br/>
+ * The succession caches are restored from the snapshot instead of being recomputed.
+ * The snapshot is decoded into the domain objects, it is not used in place.<br/>
+ * An exception is raised if the snapshot has another format version or if it is corrupted.
+ * @param[in] pData Snapshot created by domainToBinary. It can be a view on a memory mapped file.
+ * @return The domain loaded.
+ */
+Domain binaryToDomain(std::string_view pData);
+
+/**
+ * @brief Load a problem from a binary snapshot.<br/>
+ * An exception is raised if the snapshot has another format version or if it is corrupted.<br/>
+ * The goals are restored without their start of inactive time (see problemToBinary), so an inactive goal
+ * counts its inactive time again from the first refresh of the goal stack with a time point.
+ * @param[in] pData Snapshot created by problemToBinary. It can be a view on a memory mapped file.
+ * @param[in] pLoadedDomains Domains already loaded. The domain of the problem has to be inside.
+ * @return The domain and the problem loaded.
+ */
+DomainAndProblemPtrs binaryToProblem(std::string_view pData,
+                                     const std::map<std::string, Domain>& pLoadedDomains);
+
+} // End of namespace ogp
+
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_DESERIALIZEFROMBINARY_HPP
@@ -4,6 +4,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ogp
@@ -25,14 +26,55 @@ struct DomainAndProblemPtrs
   std::unique_ptr<Problem> problemPtr;
 };
 
-Domain pddlToDomain(const std::string& pStr,
-                    const std::map<std::string, Domain>& pPreviousDomains);
+/// Problem with a non-owning pointer to its domain, see pddlToProblemOfLoadedDomain.
+struct LoadedDomainAndProblemPtrs
+{
+  /// Domain of the problem, not owned. It points to one of the loaded domains given to the parser.
+  const Domain* domainPtr = nullptr;
+  std::unique_ptr<Problem> problemPtr;
+};
 
-DomainAndProblemPtrs pddlToProblem(const std::string& pStr,
+/**
+ * @brief Parse a PDDL domain.
+ * @param[in] pStr PDDL content of the domain.
+ * @param[in] pPreviousDomains Domains already loaded.
+ * @param[in] pNbOfParsingThreads Number of threads to parse the actions, the events and the axioms.<br/>
+ * With more than 1 thread, these blocks are parsed once the types, constants and predicates of the file are known
+ * and they are added to the domain in the order of the file. 0 means the number of hardware threads.
+ * @param[in] pMaterializeDerivedPredicates True to keep the derived predicates as facts in the world state instead of
+ * expanding them in the conditions. See SetOfDerivedPredicates::setMaterialized.
+ * @return The domain parsed.
+ */
+Domain pddlToDomain(std::string_view pStr,
+                    const std::map<std::string, Domain>& pPreviousDomains,
+                    std::size_t pNbOfParsingThreads = 1,
+                    bool pMaterializeDerivedPredicates = false);
+
+/**
+ * @brief Parse a PDDL problem.
+ * @param[in] pStr PDDL content of the problem. It can be a view on a memory mapped file.
+ * @param[in] pPreviousDomains Domains already loaded. The domain of the problem is copied from one of them.<br/>
+ * The facts of the init section are inserted as soon as they are parsed. The events are deduced once, after the whole init section.<br/>
+ * If the derived predicates of the domain are materialized, they are all evaluated once after the init section.
+ * @return The domain and the problem parsed.
+ */
+DomainAndProblemPtrs pddlToProblem(std::string_view pStr,
                                    const std::map<std::string, Domain>& pPreviousDomains);
 
+/**
+ * @brief Parse a PDDL problem without copying its domain.<br/>
+ * Same as pddlToProblem, but the returned domain pointer refers to the domain inside pLoadedDomains.<br/>
+ * The problem keeps pointers to the timeless facts and to the types of this domain, so the domain has to stay
+ * in pLoadedDomains, unmodified, as long as the problem or one of its copies is used.
+ * @param[in] pStr PDDL content of the problem. It can be a view on a memory mapped file.
+ * @param[in] pLoadedDomains Domains already loaded. The domain of the problem has to be inside.
+ * @return The problem parsed and a non-owning pointer to its domain.
+ */
+LoadedDomainAndProblemPtrs pddlToProblemOfLoadedDomain(std::string_view pStr,
+                                                       const std::map<std::string, Domain>& pLoadedDomains);
+
 
-std::unique_ptr<Condition> pddlToCondition(const std::string& pStr,
+std::unique_ptr<Condition> pddlToCondition(std::string_view pStr,
                                            std::size_t& pPos,
                                            const Ontology& pOntology,
                                            const SetOfEntities& pEntities,
@@ -56,7 +98,7 @@ std::unique_ptr<Goal> strToGoal(const std::string& pStr,
                                 int pMaxTimeToKeepInactive = -1,
                                 const std::string& pGoalGroupId = "");
 
-std::unique_ptr<WorldStateModification> pddlToWsModification(const std::string& pStr,
+std::unique_ptr<WorldStateModification> pddlToWsModification(std::string_view pStr,
                                                              std::size_t& pPos,
                                                              const Ontology& pOntology,
                                                              const SetOfEntities& pEntities,
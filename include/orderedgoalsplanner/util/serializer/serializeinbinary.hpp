@@ -0,0 +1,35 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_SERIALIZEINBINARY_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_SERIALIZEINBINARY_HPP
+
+#include <string>
+
+namespace ogp
+{
+struct Domain;
+struct Problem;
+
+
+/**
+ * @brief Create a binary snapshot of a domain already built.<br/>
+ * The snapshot is versioned and has a checksum, it can be written in a file and mapped in memory to be loaded.
+ * @param[in] pDomain Domain to save.
+ * @return The snapshot.
+ */
+std::string domainToBinary(const Domain& pDomain);
+
+/**
+ * @brief Create a binary snapshot of a problem.<br/>
+ * The start of inactive time of the goals is not saved: it is a steady clock time point, that has no meaning
+ * in another process.
+ * @param[in] pProblem Problem to save.
+ * @param[in] pDomain Domain of the problem.
+ * @return The snapshot.
+ */
+std::string problemToBinary(const Problem& pProblem,
+                            const Domain& pDomain);
+
+} // End of namespace ogp
+
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_SERIALIZEINBINARY_HPP
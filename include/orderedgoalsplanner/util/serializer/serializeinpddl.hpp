@@ -1,6 +1,7 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_SERIALIZEINPDDL_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_SERIALIZEINPDDL_HPP
 
+#include <iosfwd>
 #include <string>
 
 namespace ogp
@@ -12,9 +13,18 @@ struct Problem;
 
 std::string domainToPddl(const Domain& pDomain);
 
+/// Write the domain in PDDL directly in a stream (a file, a socket buffer, ...).
+void domainToPddl(std::ostream& pOs,
+                  const Domain& pDomain);
+
 std::string problemToPddl(const Problem& pProblem,
                           const Domain& pDomain);
 
+/// Write the problem in PDDL directly in a stream (a file, a socket buffer, ...).
+void problemToPddl(std::ostream& pOs,
+                   const Problem& pProblem,
+                   const Domain& pDomain);
+
 
 std::string conditionToPddl(const Condition& pCondition,
                             std::size_t pIdentation);
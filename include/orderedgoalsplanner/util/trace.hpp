@@ -0,0 +1,55 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_UTIL_TRACE_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_UTIL_TRACE_HPP
+
+#include <cstddef>
+#include <string>
+#include "api.hpp"
+
+
+namespace ogp
+{
+
+/**
+ * @brief Start to write the phases of the planner (parsing, refreshes of the caches, goal resolutions, lookaheads, ...)
+ * in a file, in the Chrome trace event format.<br/>
+ * The file can be opened with chrome://tracing or https://ui.perfetto.dev to see where the time was spent.<br/>
+ * If a trace is already written, it is stopped first.
+ * @param[in] pFilePath Path of the file to write.
+ */
+ORDEREDGOALSPLANNER_API
+void startTracing(const std::string& pFilePath);
+
+/// Stop to write the phases of the planner and close the trace file.
+ORDEREDGOALSPLANNER_API
+void stopTracing();
+
+/// True if the phases of the planner are written in a trace file.
+ORDEREDGOALSPLANNER_API
+bool isTracing();
+
+
+/// Write the lifetime of this object as a span in the trace file, if the tracing is started.
+struct ORDEREDGOALSPLANNER_API TraceSpan
+{
+  /**
+   * @brief Construct a span.
+   * @param[in] pName Name of the span. It has to be a string literal, it is not escaped.
+   */
+  explicit TraceSpan(const char* pName);
+  ~TraceSpan();
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+  const char* _name;
+  /// Identifier of the tracing when the span began.
+  std::size_t _tracingId;
+  /// Begin of the span in microseconds of the steady clock, negative if the tracing is not started.
+  long long _beginInUs;
+};
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_UTIL_TRACE_HPP
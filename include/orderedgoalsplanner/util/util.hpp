@@ -26,6 +26,9 @@ using Number = std::variant<int, float>;
 // Function to convert a string to either an int or a float and store it in a variant
 Number stringToNumber(const std::string& str);
 
+// Same as stringToNumber but it returns an empty optional instead of throwing if the string is not a number
+std::optional<Number> tryToConvertToNumber(const std::string& pStr);
+
 // Overloaded operator for addition of two Number objects
 Number operator+(const Number& lhs, const Number& rhs);
 
@@ -38,6 +41,9 @@ Number operator*(const Number& lhs, const Number& rhs);
 // Overloaded operator for equality comparison of two Number objects
 bool operator==(const Number& lhs, const Number& rhs);
 
+// Value of a Number promoted to double, to compare an int and a float by their values
+double numberToDouble(const Number& pNumber);
+
 // Function to convert a Number to a std::string
 std::string numberToString(const Number& num);
 
@@ -75,6 +81,12 @@ bool compIntNb(const std::string& pNb1Str,
                bool pBoolSuperiorOrInferior,
                bool pCanBeEqual);
 
+ORDEREDGOALSPLANNER_API
+bool compIntNb(const Entity& pNb1,
+               const Number& pNb2,
+               bool pBoolSuperiorOrInferior,
+               bool pCanBeEqual);
+
 ORDEREDGOALSPLANNER_API
 std::string incrementLastNumberUntilAConditionIsSatisfied(
     const std::string& pStr,
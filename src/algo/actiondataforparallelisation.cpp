@@ -27,39 +27,11 @@ const Condition* ActionDataForParallelisation::getConditionWithoutParameterPtr()
 }
 
 
-const WorldStateModification* ActionDataForParallelisation::getWorldStateModificationAtStartWithoutParameterPtr()
+const std::map<Parameter, Entity>* ActionDataForParallelisation::getParametersToArgumentPtr() const
 {
-  if (!action.effect.worldStateModificationAtStart)
-    return nullptr;
   if (actionInvWithGoal.actionInvocation.parameters.empty())
-    return &*action.effect.worldStateModificationAtStart;
-  if (!worldStateModificationAtStartWithParameterFilled)
-    worldStateModificationAtStartWithParameterFilled = action.effect.worldStateModificationAtStart->clone(&actionInvWithGoal.actionInvocation.parameters);
-  return &*worldStateModificationAtStartWithParameterFilled;
-}
-
-
-const WorldStateModification* ActionDataForParallelisation::getWorldStateModificationWithoutParameterPtr()
-{
-  if (!action.effect.worldStateModification)
     return nullptr;
-  if (actionInvWithGoal.actionInvocation.parameters.empty())
-    return &*action.effect.worldStateModification;
-  if (!worldStateModificationWithParameterFilled)
-    worldStateModificationWithParameterFilled = action.effect.worldStateModification->clone(&actionInvWithGoal.actionInvocation.parameters);
-  return &*worldStateModificationWithParameterFilled;
-}
-
-
-const WorldStateModification* ActionDataForParallelisation::getPotentialWorldStateModificationWithoutParameterPtr()
-{
-  if (!action.effect.potentialWorldStateModification)
-    return nullptr;
-  if (actionInvWithGoal.actionInvocation.parameters.empty())
-    return &*action.effect.potentialWorldStateModification;
-  if (!potentialWorldStateModificationWithParameterFilled)
-    potentialWorldStateModificationWithParameterFilled = action.effect.potentialWorldStateModification->clone(&actionInvWithGoal.actionInvocation.parameters);
-  return &*potentialWorldStateModificationWithParameterFilled;
+  return &actionInvWithGoal.actionInvocation.parameters;
 }
 
 
@@ -68,19 +40,20 @@ const std::set<FactOptional>& ActionDataForParallelisation::getAllOptFactsThatCa
   if (!factsThatCanBeModifiedPtr)
   {
     factsThatCanBeModifiedPtr = std::make_unique<std::set<FactOptional>>();
-    auto addWmToRes = [&](const WorldStateModification* pWmPtr)
+    const auto* parametersToArgumentPtr = getParametersToArgumentPtr();
+    auto addWmToRes = [&](const std::unique_ptr<WorldStateModification>& pWmPtr)
     {
       if (pWmPtr)
       {
         pWmPtr->forAllThatCanBeModified([&](const FactOptional& pFactOptional) {
             factsThatCanBeModifiedPtr->insert(pFactOptional);
             return ContinueOrBreak::CONTINUE;
-        });
+        }, parametersToArgumentPtr);
       }
     };
-    addWmToRes(getWorldStateModificationAtStartWithoutParameterPtr());
-    addWmToRes(getWorldStateModificationWithoutParameterPtr());
-    addWmToRes(getPotentialWorldStateModificationWithoutParameterPtr());
+    addWmToRes(action.effect.worldStateModificationAtStart);
+    addWmToRes(action.effect.worldStateModification);
+    addWmToRes(action.effect.potentialWorldStateModification);
   }
   return *factsThatCanBeModifiedPtr;
 }
@@ -88,23 +61,22 @@ const std::set<FactOptional>& ActionDataForParallelisation::getAllOptFactsThatCa
 
 bool ActionDataForParallelisation::hasAContradictionWithAnEffect(const std::set<FactOptional>& pFactsOpt)
 {
-  auto* effectPtr = getWorldStateModificationAtStartWithoutParameterPtr();
-  if (effectPtr != nullptr && effectPtr->hasAContradictionWith(pFactsOpt))
-    return true;
-
-  effectPtr = getWorldStateModificationWithoutParameterPtr();
-  if (effectPtr != nullptr && effectPtr->hasAContradictionWith(pFactsOpt))
-    return true;
-
-  effectPtr = getPotentialWorldStateModificationWithoutParameterPtr();
-  if (effectPtr != nullptr && effectPtr->hasAContradictionWith(pFactsOpt))
-    return true;
+  const auto* parametersToArgumentPtr = getParametersToArgumentPtr();
+  for (const auto* currEffectPtr : {&action.effect.worldStateModificationAtStart,
+                                    &action.effect.worldStateModification,
+                                    &action.effect.potentialWorldStateModification})
+    if (*currEffectPtr && (*currEffectPtr)->hasAContradictionWith(pFactsOpt, nullptr, parametersToArgumentPtr))
+      return true;
   return false;
 }
 
 
-bool ActionDataForParallelisation::canBeInParallel(ActionDataForParallelisation& pOther)
+bool ActionDataForParallelisation::canBeInParallel(ActionDataForParallelisation& pOther,
+                                                   const Domain& pDomain)
 {
+  if (!pDomain.canActionsInterfere(actionInvWithGoal.actionInvocation, pOther.actionInvWithGoal.actionInvocation))
+    return true;
+
   const auto& effectFacts = getAllOptFactsThatCanBeModified();
   auto* otherConditionPtr = pOther.getConditionWithoutParameterPtr();
   if (otherConditionPtr != nullptr && otherConditionPtr->hasAContradictionWith(effectFacts))
@@ -122,10 +94,11 @@ bool ActionDataForParallelisation::canBeInParallel(ActionDataForParallelisation&
 }
 
 
-bool ActionDataForParallelisation::canBeInParallelOfList(std::list<ActionDataForParallelisation>& pOthers)
+bool ActionDataForParallelisation::canBeInParallelOfList(std::list<ActionDataForParallelisation>& pOthers,
+                                                         const Domain& pDomain)
 {
   for (auto& currOther : pOthers)
-    if (!canBeInParallel(currOther))
+    if (!canBeInParallel(currOther, pDomain))
       return false;
   return true;
 }
@@ -157,23 +130,22 @@ std::list<Goal> extractSatisfiedGoals(
       if (conditionPtr != nullptr && !conditionPtr->isTrue(pProblem.worldState))
         return {};
 
-      auto* worldStateModificationAtStartWithoutParameterPtr = currAction.getWorldStateModificationAtStartWithoutParameterPtr();
-      if (worldStateModificationAtStartWithoutParameterPtr != nullptr)
-        pProblem.worldState.modify(worldStateModificationAtStartWithoutParameterPtr, pProblem.goalStack, setOfEvents,
-                                   callbacks, ontology, pProblem.entities, pNow);
+      const auto* parametersToArgumentPtr = currAction.getParametersToArgumentPtr();
+      const auto& effect = currAction.action.effect;
+      if (effect.worldStateModificationAtStart)
+        pProblem.worldState.modify(&*effect.worldStateModificationAtStart, pProblem.goalStack, setOfEvents,
+                                   callbacks, ontology, pProblem.entities, pNow, true, parametersToArgumentPtr);
       actionsInParallel.emplace_back(&currAction);
 
       bool somethingChanged = false;
 
-      const auto* worldStateModificationWithoutParameterPtr = currAction.getWorldStateModificationWithoutParameterPtr();
-      if (worldStateModificationWithoutParameterPtr != nullptr)
-        somethingChanged = pProblem.worldState.modify(worldStateModificationWithoutParameterPtr, pProblem.goalStack, setOfEvents,
-                                                      callbacks, ontology, pProblem.entities, pNow);
+      if (effect.worldStateModification)
+        somethingChanged = pProblem.worldState.modify(&*effect.worldStateModification, pProblem.goalStack, setOfEvents,
+                                                      callbacks, ontology, pProblem.entities, pNow, true, parametersToArgumentPtr);
 
-      const auto* potentialWorldStateModificationWithoutParameterPtr = currAction.getPotentialWorldStateModificationWithoutParameterPtr();
-      if (potentialWorldStateModificationWithoutParameterPtr != nullptr)
-        somethingChanged = pProblem.worldState.modify(potentialWorldStateModificationWithoutParameterPtr, pProblem.goalStack, setOfEvents,
-                                                      callbacks, ontology, pProblem.entities, pNow) || somethingChanged;
+      if (effect.potentialWorldStateModification)
+        somethingChanged = pProblem.worldState.modify(&*effect.potentialWorldStateModification, pProblem.goalStack, setOfEvents,
+                                                      callbacks, ontology, pProblem.entities, pNow, true, parametersToArgumentPtr) || somethingChanged;
 
       if (!somethingChanged)
         return {};
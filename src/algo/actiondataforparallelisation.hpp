@@ -10,6 +10,7 @@ namespace ogp
 {
 struct Action;
 struct Condition;
+struct Domain;
 struct FactOptional;
 struct Problem;
 struct WorldStateModification;
@@ -19,28 +20,28 @@ struct ActionDataForParallelisation
 {
   ActionDataForParallelisation(const Action& pAction, ActionInvocationWithGoal&& pActionInvWithGoal);
 
+  /// Get the precondition with the parameters replaced by their argument.
   const Condition* getConditionWithoutParameterPtr();
 
-  const WorldStateModification* getWorldStateModificationAtStartWithoutParameterPtr();
-
-  const WorldStateModification* getWorldStateModificationWithoutParameterPtr();
-
-  const WorldStateModification* getPotentialWorldStateModificationWithoutParameterPtr();
+  /// Get the parameters to give with the effects of the action to replace them by their argument, nullptr if there is none.
+  const std::map<Parameter, Entity>* getParametersToArgumentPtr() const;
 
   const std::set<FactOptional>& getAllOptFactsThatCanBeModified();
 
   bool hasAContradictionWithAnEffect(const std::set<FactOptional>& pFactsOpt);
 
-  bool canBeInParallel(ActionDataForParallelisation& pOther);
+  /// Check if two actions can be in parallel, the filled conditions and effects are only compared if the domain cannot decide it.
+  bool canBeInParallel(ActionDataForParallelisation& pOther,
+                       const Domain& pDomain);
 
-  bool canBeInParallelOfList(std::list<ActionDataForParallelisation>& pOthers);
+  bool canBeInParallelOfList(std::list<ActionDataForParallelisation>& pOthers,
+                             const Domain& pDomain);
 
   const Action& action;
   ActionInvocationWithGoal actionInvWithGoal;
+  /// The effects are read with the parameters to argument map instead, but Condition::isTrue can only bind
+  /// the parameters to possible arguments so the precondition is cloned once with its arguments.
   std::unique_ptr<Condition> conditionWithParameterFilled;
-  std::unique_ptr<WorldStateModification> worldStateModificationAtStartWithParameterFilled;
-  std::unique_ptr<WorldStateModification> worldStateModificationWithParameterFilled;
-  std::unique_ptr<WorldStateModification> potentialWorldStateModificationWithParameterFilled;
   std::unique_ptr<std::set<FactOptional>> factsThatCanBeModifiedPtr;
 };
 
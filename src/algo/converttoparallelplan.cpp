@@ -1,6 +1,10 @@
 #include "converttoparallelplan.hpp"
+#include <algorithm>
+#include <iterator>
 #include <list>
+#include <map>
 #include <set>
+#include <vector>
 #include <orderedgoalsplanner/types/action.hpp>
 #include <orderedgoalsplanner/types/actioninvocationwithgoal.hpp>
 #include <orderedgoalsplanner/types/actionstodoinparallel.hpp>
@@ -9,9 +13,11 @@
 #include <orderedgoalsplanner/types/problem.hpp>
 #include <orderedgoalsplanner/types/setofcallbacks.hpp>
 #include <orderedgoalsplanner/types/worldstate.hpp>
+#include <orderedgoalsplanner/util/trace.hpp>
 #include <orderedgoalsplanner/orderedgoalsplanner.hpp>
 #include "actiondataforparallelisation.hpp"
 #include "notifyactiondone.hpp"
+#include "../util/plannerstatsrecorder.hpp"
 
 namespace ogp
 {
@@ -35,6 +41,203 @@ void _notifyActionsDoneAndRemoveCorrespondingGoals(std::list<Goal>& pGoals,
     pGoals.remove(currGoal);
 }
 
+
+bool _canBeTheSameFact(const Fact& pFact1,
+                       const Fact& pFact2)
+{
+  if (pFact1.name() != pFact2.name() ||
+      pFact1.arguments().size() != pFact2.arguments().size())
+    return false;
+  for (std::size_t i = 0; i < pFact1.arguments().size(); ++i)
+  {
+    const auto& arg1 = pFact1.arguments()[i];
+    const auto& arg2 = pFact2.arguments()[i];
+    if (arg1.value != arg2.value && !arg1.isAParameterToFill() && !arg2.isAParameterToFill())
+      return false;
+  }
+  return true;
+}
+
+
+/// Two actions are dependent if they interfere or if the first one can produce a fact needed by the condition of the second one.
+bool _areDependent(ActionDataForParallelisation& pPreviousAction,
+                   ActionDataForParallelisation& pAction,
+                   const Domain& pDomain)
+{
+  if (!pPreviousAction.canBeInParallel(pAction, pDomain))
+    return true;
+
+  const auto* conditionPtr = pAction.getConditionWithoutParameterPtr();
+  if (conditionPtr == nullptr)
+    return false;
+  const auto& effectFacts = pPreviousAction.getAllOptFactsThatCanBeModified();
+  bool res = false;
+  conditionPtr->forAll([&](const FactOptional& pFactOptional, bool) {
+    for (const auto& currEffectFact : effectFacts)
+    {
+      if (_canBeTheSameFact(currEffectFact.fact, pFactOptional.fact))
+      {
+        res = true;
+        return ContinueOrBreak::BREAK;
+      }
+    }
+    return ContinueOrBreak::CONTINUE;
+  });
+  return res;
+}
+
+
+/// Names of the predicates read or written by an action, to only compare the actions that can interfere.
+std::set<std::string> _predicatesTouched(ActionDataForParallelisation& pAction)
+{
+  std::set<std::string> res;
+  // The names of the predicates do not depend on the arguments, so the precondition is read without its arguments
+  const auto& conditionPtr = pAction.action.precondition;
+  if (conditionPtr)
+    conditionPtr->forAll([&](const FactOptional& pFactOptional, bool) {
+      res.insert(pFactOptional.fact.name());
+      return ContinueOrBreak::CONTINUE;
+    });
+  for (const auto& currEffectFact : pAction.getAllOptFactsThatCanBeModified())
+    res.insert(currEffectFact.fact.name());
+  return res;
+}
+
+
+/**
+ * Put the actions of a run of actions for the same goal in layers.<br/>
+ * The layer of an action is just after the highest layer of the previous actions it depends on.
+ * The dependencies are only looked for between the actions that touch a common predicate.
+ */
+std::list<std::list<ActionDataForParallelisation>> _toLayers(std::list<std::list<ActionDataForParallelisation>>& pPlan,
+                                                             std::list<std::list<ActionDataForParallelisation>>::iterator pRunBegin,
+                                                             std::list<std::list<ActionDataForParallelisation>>::iterator pRunEnd,
+                                                             const Domain& pDomain)
+{
+  std::vector<ActionDataForParallelisation*> actions;
+  std::vector<std::size_t> actionLayers;
+  std::map<std::string, std::vector<std::size_t>> predicateToActions;
+  std::size_t nbOfLayers = 0;
+
+  for (auto it = pRunBegin; it != pRunEnd; ++it)
+  {
+    auto& currAction = it->front();
+    auto predicates = _predicatesTouched(currAction);
+
+    std::set<std::size_t> actionsToCheck;
+    for (const auto& currPredicate : predicates)
+    {
+      auto& actionsOfPredicate = predicateToActions[currPredicate];
+      actionsToCheck.insert(actionsOfPredicate.begin(), actionsOfPredicate.end());
+      actionsOfPredicate.push_back(actions.size());
+    }
+
+    std::size_t layer = 0;
+    for (auto itPrevious = actionsToCheck.rbegin(); itPrevious != actionsToCheck.rend(); ++itPrevious)
+      if (actionLayers[*itPrevious] + 1 > layer &&
+          _areDependent(*actions[*itPrevious], currAction, pDomain))
+        layer = actionLayers[*itPrevious] + 1;
+
+    actions.push_back(&currAction);
+    actionLayers.push_back(layer);
+    nbOfLayers = std::max(nbOfLayers, layer + 1);
+  }
+
+  std::vector<std::list<ActionDataForParallelisation>> layers(nbOfLayers);
+  std::size_t actionIndex = 0;
+  for (auto it = pRunBegin; it != pRunEnd; ++it, ++actionIndex)
+  {
+    auto& layer = layers[actionLayers[actionIndex]];
+    layer.splice(layer.end(), *it);
+  }
+  pPlan.erase(pRunBegin, pRunEnd);
+  return std::list<std::list<ActionDataForParallelisation>>(std::make_move_iterator(layers.begin()),
+                                                            std::make_move_iterator(layers.end()));
+}
+
+
+/**
+ * Remove from a step the actions whose precondition is false at the beginning of the step.<br/>
+ * The dependencies of the layers do not see the facts added by the events, so they are checked here on the simulated world state.
+ * @param[in, out] pStep Step to check.
+ * @param[in] pWorldState World state at the beginning of the step.
+ * @param[in] pKeepTheFirstAction True to keep the first action even if its precondition is false, like in the sequential plan.
+ * @return The removed actions.
+ */
+std::list<ActionDataForParallelisation> _extractActionsWithAFalsePrecondition(std::list<ActionDataForParallelisation>& pStep,
+                                                                               const WorldState& pWorldState,
+                                                                               bool pKeepTheFirstAction)
+{
+  std::list<ActionDataForParallelisation> res;
+  auto it = pStep.begin();
+  if (pKeepTheFirstAction && it != pStep.end())
+    ++it;
+  while (it != pStep.end())
+  {
+    const auto* conditionPtr = it->getConditionWithoutParameterPtr();
+    if (conditionPtr != nullptr && !conditionPtr->isTrue(pWorldState))
+      res.splice(res.end(), pStep, it++);
+    else
+      ++it;
+  }
+  return res;
+}
+
+
+/// Apply the effects of the actions of a step to a world state, with the events that they trigger.
+void _applyStepEffects(WorldState& pWorldState,
+                       GoalStack& pGoalStack,
+                       const std::list<ActionDataForParallelisation>& pStep,
+                       const Domain& pDomain,
+                       const SetOfEntities& pEntities,
+                       const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
+{
+  const SetOfCallbacks callbacks;
+  const auto& setOfEvents = pDomain.getSetOfEvents();
+  const auto& ontology = pDomain.getOntology();
+  for (const auto& currAction : pStep)
+  {
+    const auto* parametersToArgumentPtr = currAction.getParametersToArgumentPtr();
+    const auto& effect = currAction.action.effect;
+    for (const auto* currEffectPtr : {&effect.worldStateModificationAtStart, &effect.worldStateModification, &effect.potentialWorldStateModification})
+      if (*currEffectPtr)
+        pWorldState.modify(&**currEffectPtr, pGoalStack, setOfEvents, callbacks, ontology, pEntities, pNow,
+                           true, parametersToArgumentPtr);
+  }
+}
+
+
+/// Check if a step has an action done for a goal.
+bool _isForAGoal(const std::list<ActionDataForParallelisation>& pStep)
+{
+  for (const auto& currAction : pStep)
+    if (currAction.actionInvWithGoal.fromGoal)
+      return true;
+  return false;
+}
+
+
+/// Put back the actions of some steps in their order of the sequential plan, one action per step.
+std::list<std::list<ActionDataForParallelisation>> _toSequentialPlan(std::list<std::list<ActionDataForParallelisation>>& pSteps,
+                                                                     const std::map<const ActionDataForParallelisation*, std::size_t>& pActionToIndex)
+{
+  std::vector<std::list<ActionDataForParallelisation>> actions(pActionToIndex.size());
+  for (auto& currStep : pSteps)
+  {
+    while (!currStep.empty())
+    {
+      auto& actionList = actions[pActionToIndex.at(&currStep.front())];
+      actionList.splice(actionList.end(), currStep, currStep.begin());
+    }
+  }
+
+  std::list<std::list<ActionDataForParallelisation>> res;
+  for (auto& currActionList : actions)
+    if (!currActionList.empty())
+      res.emplace_back(std::move(currActionList));
+  return res;
+}
+
 }
 
 
@@ -46,11 +249,14 @@ ParallelPan toParallelPlan
  std::list<Goal>& pGoals,
  const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
 {
+  TraceSpan traceSpan("toParallelPlan");
+  ORDEREDGOALSPLANNER_ALLOCATION_PHASE(PARALLELISATION);
   const auto& actions = pDomain.actions();
   std::list<std::list<ActionDataForParallelisation>> currentRes;
   const SetOfCallbacks callbacks;
 
   // Connvert list of actions to a list of list of actions
+  std::map<const ActionDataForParallelisation*, std::size_t> actionToIndex;
   while (!pSequentialPlan.empty())
   {
     ActionInvocationWithGoal& actionInvWithGoal = pSequentialPlan.front();
@@ -59,68 +265,90 @@ ParallelPan toParallelPlan
       throw std::runtime_error("ActionId \"" + actionInvWithGoal.actionInvocation.actionId + "\" not found in algorithm to manaage parralelisation");
     std::list<ActionDataForParallelisation> actionInASubList;
     actionInASubList.emplace_back(itAction->second, std::move(actionInvWithGoal));
+    actionToIndex.emplace(&actionInASubList.front(), actionToIndex.size());
     currentRes.emplace_back(std::move(actionInASubList));
     pSequentialPlan.pop_front();
   }
 
-  for (auto itPlanStep = currentRes.begin(); itPlanStep != currentRes.end(); ++itPlanStep)
+  // Put each run of consecutive actions done for the same goal in layers.
+  // The preconditions of a step are checked on the world state at the beginning of the step, with the effects of the events,
+  // because the dependencies between the actions do not see the events. Only the world state is copied for it.
+  // The actions of a step with a false precondition are postponed and layered again.
+  WorldState worldState(pProblem.worldState);
+  GoalStack goalStackOfWorldState;
+  std::list<std::list<ActionDataForParallelisation>> parallelPlan;
+  while (!currentRes.empty())
   {
-    const Goal* goalPtr = nullptr;
-    for (ActionDataForParallelisation& currActionTmpData : *itPlanStep)
-    {
-      notifyActionStarted(pProblem, pDomain, callbacks, currActionTmpData.actionInvWithGoal, pNow);
-      if (goalPtr == nullptr && currActionTmpData.actionInvWithGoal.fromGoal)
-        goalPtr = &*currActionTmpData.actionInvWithGoal.fromGoal;
-    }
-    if (goalPtr == nullptr)
-      continue;
-    auto& goal = *goalPtr;
+    auto itRunEnd = currentRes.begin();
+    const auto& fromGoal = itRunEnd->front().actionInvWithGoal.fromGoal;
+    ++itRunEnd;
+    if (fromGoal)
+      while (itRunEnd != currentRes.end() &&
+             itRunEnd->front().actionInvWithGoal.fromGoal &&
+             *itRunEnd->front().actionInvWithGoal.fromGoal == *fromGoal)
+        ++itRunEnd;
 
-    auto itPlanStepCandidate = itPlanStep;
-    ++itPlanStepCandidate;
-    while (itPlanStepCandidate != currentRes.end())
+    auto layers = _toLayers(currentRes, currentRes.begin(), itRunEnd, pDomain);
+    bool isFirstLayer = true;
+    while (!layers.empty())
     {
-      if (!itPlanStepCandidate->empty())
+      auto& layer = layers.front();
+      auto actionsToPostpone = _extractActionsWithAFalsePrecondition(layer, worldState, isFirstLayer);
+      isFirstLayer = false;
+      if (!actionsToPostpone.empty())
+      {
+        std::list<std::list<ActionDataForParallelisation>> actionsToLayerAgain;
+        actionsToLayerAgain.emplace_back(std::move(actionsToPostpone));
+        actionsToLayerAgain.splice(actionsToLayerAgain.end(), layers, std::next(layers.begin()), layers.end());
+        currentRes.splice(currentRes.begin(), _toSequentialPlan(actionsToLayerAgain, actionToIndex));
+      }
+      if (layer.empty())
+      {
+        layers.pop_front();
+        continue;
+      }
+
+      _applyStepEffects(worldState, goalStackOfWorldState, layer, pDomain, pProblem.entities, pNow);
+      bool isForAGoal = _isForAGoal(layer);
+      parallelPlan.splice(parallelPlan.end(), layers, layers.begin());
+
+      if (pParalleliseOnyFirstStep && isForAGoal)
       {
-        auto& actionInvocationCand = itPlanStepCandidate->front();
-        if (!actionInvocationCand.actionInvWithGoal.fromGoal ||
-            *actionInvocationCand.actionInvWithGoal.fromGoal != goal)
-          break;
-        if (actionInvocationCand.canBeInParallelOfList(*itPlanStep))
-        {
-          const Condition* conditionWithoutParameterPtr = actionInvocationCand.getConditionWithoutParameterPtr();
-          if (conditionWithoutParameterPtr == nullptr ||
-              conditionWithoutParameterPtr->isTrue(pProblem.worldState))
-          {
-            auto tmpProblem = pProblem;
-            notifyActionStarted(tmpProblem, pDomain, callbacks, actionInvocationCand.actionInvWithGoal, pNow);
-            notifyActionDone(tmpProblem, pDomain, callbacks, actionInvocationCand.actionInvWithGoal, pNow);
-            auto remainingGoals = pGoals;
-            _notifyActionsDoneAndRemoveCorrespondingGoals(remainingGoals, *itPlanStep, tmpProblem, pDomain, callbacks, pNow);
-
-            auto itNextInPlan = itPlanStep;
-            ++itNextInPlan;
-            auto goalsCand = extractSatisfiedGoals(tmpProblem, pDomain, itNextInPlan, currentRes, &actionInvocationCand, pNow);
-            if (goalsCand == remainingGoals)
-            {
-              notifyActionStarted(pProblem, pDomain, callbacks, actionInvocationCand.actionInvWithGoal, pNow);
-              itPlanStep->emplace_back(std::move(actionInvocationCand));
-              itPlanStepCandidate = currentRes.erase(itPlanStepCandidate);
-              continue;
-            }
-          }
-        }
+        // Only the first step done for a goal is wanted, the other actions stay sequential
+        parallelPlan.splice(parallelPlan.end(), _toSequentialPlan(layers, actionToIndex));
+        parallelPlan.splice(parallelPlan.end(), currentRes);
+        break;
       }
-      ++itPlanStepCandidate;
     }
+  }
 
+  // The goals satisfied by the parallel plan are validated once, at the end.
+  // The sequential plan is kept if they are not the goals satisfied by the sequential plan.
+  {
+    auto problemForParallelPlan = pProblem;
+    if (extractSatisfiedGoals(problemForParallelPlan, pDomain, parallelPlan.begin(), parallelPlan, nullptr, pNow) != pGoals)
+      parallelPlan = _toSequentialPlan(parallelPlan, actionToIndex);
+  }
+
+  // Notify the problem of the steps like if they were done
+  for (auto& currStep : parallelPlan)
+  {
+    bool isForAGoal = false;
+    for (auto& currActionTmpData : currStep)
+    {
+      notifyActionStarted(pProblem, pDomain, callbacks, currActionTmpData.actionInvWithGoal, pNow);
+      if (currActionTmpData.actionInvWithGoal.fromGoal)
+        isForAGoal = true;
+    }
+    if (!isForAGoal)
+      continue;
     if (pParalleliseOnyFirstStep)
       break;
-    _notifyActionsDoneAndRemoveCorrespondingGoals(pGoals, *itPlanStep, pProblem, pDomain, callbacks, pNow);
+    _notifyActionsDoneAndRemoveCorrespondingGoals(pGoals, currStep, pProblem, pDomain, callbacks, pNow);
   }
 
   ParallelPan res;
-  for (auto& currResStep : currentRes)
+  for (auto& currResStep : parallelPlan)
   {
     ActionsToDoInParallel subRes;
     for (auto& currActionTmpData : currResStep)
@@ -132,5 +360,4 @@ ParallelPan toParallelPlan
 }
 
 
-
 } // End of namespace ogp
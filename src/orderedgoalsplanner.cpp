@@ -4,12 +4,14 @@
 #include <optional>
 #include <orderedgoalsplanner/types/parallelplan.hpp>
 #include <orderedgoalsplanner/types/setofevents.hpp>
+#include <orderedgoalsplanner/util/trace.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 #include "types/factsalreadychecked.hpp"
 #include "types/treeofalreadydonepaths.hpp"
 #include "algo/actiondataforparallelisation.hpp"
 #include "algo/converttoparallelplan.hpp"
 #include "algo/notifyactiondone.hpp"
+#include "util/plannerstatsrecorder.hpp"
 
 namespace ogp
 {
@@ -36,6 +38,15 @@ PossibleEffect _merge(PossibleEffect pEff1,
   return PossibleEffect::NOT_SATISFIED;
 }
 
+
+/// Copy a problem to simulate the next steps of a plan.
+Problem _copyProblem(const Problem& pProblem)
+{
+  ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfProblemCopies);
+  ORDEREDGOALSPLANNER_ALLOCATION_PHASE(PROBLEM_COPY);
+  return pProblem;
+}
+
 struct PlanCost
 {
   bool success = true;
@@ -644,7 +655,7 @@ bool _doesStatisfyTheGoal(std::map<Parameter, std::set<Entity>>& pParameters,
 {
   auto checkObjectiveCallback = [&](const FactOptional& pFactOptional,
       std::map<Parameter, std::set<Entity>>* pParametersToModifyInPlacePtr,
-      const std::function<bool (const std::map<Parameter, std::set<Entity>>&)>& pCheckValidity) -> bool
+      FunctionRef<bool (const std::map<Parameter, std::set<Entity>>&)> pCheckValidity) -> bool
   {
     if (_doesConditionMatchAnOptionalFact(pParameters, pFactOptional, pParametersToModifyInPlacePtr, pContext))
     {
@@ -681,6 +692,7 @@ bool _lookForAPossibleEffect(PotentialNextActionParametersWithTmpData& pParamete
                              FactsAlreadyChecked& pFactsAlreadychecked,
                              const std::string& pFromDeductionId)
 {
+  ORDEREDGOALSPLANNER_STATS_LOOK_FOR_A_POSSIBLE_EFFECT_SCOPE();
   bool canSatisfyThisGoal = pContext.goal.canDeductionSatisfyThisGoal(pFromDeductionId);
   if (canSatisfyThisGoal &&
       pContext.goal.isASimpleFactObjective())
@@ -699,7 +711,7 @@ bool _lookForAPossibleEffect(PotentialNextActionParametersWithTmpData& pParamete
   auto successionsCallback = [&](const Successions& pSuccessions,
                                  const ogp::FactOptional& pFactOptional,
                                  std::map<Parameter, std::set<Entity>>* pParametersToModifyInPlacePtr,
-                                 const std::function<bool (const std::map<Parameter, std::set<Entity>>&)>& pCheckValidity) {
+                                 FunctionRef<bool (const std::map<Parameter, std::set<Entity>>&)> pCheckValidity) {
     auto possibleEffect = PossibleEffect::NOT_SATISFIED;
     std::map<Parameter, std::set<Entity>> newPossibleParentParameters;
     std::map<Parameter, std::set<Entity>> newPossibleTmpParentParameters;
@@ -777,6 +789,9 @@ PlanCost _extractPlanCost(
     LookForAnActionOutputInfos& pLookForAnActionOutputInfos,
     const ActionPtrWithGoal* pPreviousActionPtr)
 {
+  ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfPlanCostLookaheads);
+  TraceSpan traceSpan("lookahead");
+  ORDEREDGOALSPLANNER_ALLOCATION_PHASE(LOOKAHEAD);
   PlanCost res;
   std::set<std::string> actionAlreadyInPlan;
   bool shouldBreak = false;
@@ -839,7 +854,7 @@ bool _isMoreOptimalNextAction(
     PlanCost newCost;
     bool nextStepIsAnEvent = pNewPotentialNextAction.parametersWithData.nextStepIsAnEvent(pDataRelatedToOptimisation.parameterToEntitiesFromEvent);
     {
-      auto localProblem1 = pProblem;
+      auto localProblem1 = _copyProblem(pProblem);
       bool goalChanged = false;
       LookForAnActionOutputInfos lookForAnActionOutputInfos;
       updateProblemForNextPotentialPlannerResult(localProblem1, goalChanged, oneStepOfPlannerResult1, pDomain, now, nullptr, &lookForAnActionOutputInfos);
@@ -850,7 +865,7 @@ bool _isMoreOptimalNextAction(
 
     if (!pPotentialNextActionComparisonCacheOpt)
     {
-      auto localProblem2 = pProblem;
+      auto localProblem2 = _copyProblem(pProblem);
       bool goalChanged = false;
       LookForAnActionOutputInfos lookForAnActionOutputInfos;
       updateProblemForNextPotentialPlannerResult(localProblem2, goalChanged, oneStepOfPlannerResult2, pDomain, now, nullptr, &lookForAnActionOutputInfos);
@@ -923,6 +938,7 @@ ActionId _findFirstActionForAGoal(
       auto* newTreePtr = pTreeOfAlreadyDonePath.getNextActionTreeIfNotAnExistingLeaf(currActionId);
       if (newTreePtr != nullptr) // To skip leaf of already seen path
       {
+        ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfCandidateActions);
         FactsAlreadyChecked factsAlreadyChecked;
         auto newPotRes = PotentialNextAction(currActionId, action);
         DataRelatedToOptimisation dataRelatedToOptimisation;
@@ -930,7 +946,7 @@ ActionId _findFirstActionForAGoal(
         if (_lookForAPossibleEffect(newPotRes.parametersWithData, dataRelatedToOptimisation, *newTreePtr,
                                     action.effect.worldStateModification, action.effect.potentialWorldStateModification,
                                     context, factsAlreadyChecked, currActionId) &&
-            (!action.precondition || action.precondition->isTrue(pProblem.worldState, {}, {}, &newPotRes.parametersWithData.parameters)))
+            action.isPreconditionTrue(pProblem.worldState, &newPotRes.parametersWithData.parameters))
         {
           while (true)
           {
@@ -963,6 +979,7 @@ bool _goalToPlanRec(
     int pPriority,
     const ActionPtrWithGoal* pPreviousActionPtr)
 {
+  TraceSpan traceSpan("goalToPlanRec");
   pProblem.worldState.refreshCacheIfNeeded(pDomain);
   TreeOfAlreadyDonePath treeOfAlreadyDonePath;
 
@@ -993,7 +1010,7 @@ bool _goalToPlanRec(
       ++itAlreadyFoundAction->second;
     }
 
-    auto problemForPlanCost = pProblem;
+    auto problemForPlanCost = _copyProblem(pProblem);
     bool goalChanged = false;
 
     auto* potActionPtr = pDomain.getActionPtr(potentialRes->actionInvocation.actionId);
@@ -1053,6 +1070,8 @@ std::list<ActionInvocationWithGoal> planForMoreImportantGoalPossible(Problem& pP
                                                                      const Historical* pGlobalHistorical,
                                                                      LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr)
 {
+  ORDEREDGOALSPLANNER_STATS_SCOPE(pLookForAnActionOutputInfosPtr != nullptr ? &pLookForAnActionOutputInfosPtr->stats() : nullptr);
+  ORDEREDGOALSPLANNER_ALLOCATION_PHASE(PLANNING);
   return _planForMoreImportantGoalPossible(pProblem, pDomain, pTryToDoMoreOptimalSolution, pNow,
                                            pGlobalHistorical, pLookForAnActionOutputInfosPtr, nullptr);
 }
@@ -1066,7 +1085,7 @@ ActionsToDoInParallel actionsToDoInParallelNow(
 {
   pProblem.goalStack.refreshIfNeeded(pDomain);
   std::list<Goal> goalsDone;
-  auto problemForPlanResolution = pProblem;
+  auto problemForPlanResolution = _copyProblem(pProblem);
   auto sequentialPlan = planForEveryGoals(problemForPlanResolution, pDomain, pNow, pGlobalHistorical, &goalsDone);
   auto parallelPlan = toParallelPlan(sequentialPlan, true, pProblem, pDomain, goalsDone, pNow);
   if (!parallelPlan.actionsToDoInParallel.empty())
@@ -1087,12 +1106,11 @@ void notifyActionStarted(Problem& pProblem,
   {
     if (itAction->second.effect.worldStateModificationAtStart)
     {
-      auto worldStateModificationAtStart = itAction->second.effect.worldStateModificationAtStart->clone(&pActionInvocationWithGoal.actionInvocation.parameters);
       auto& setOfEvents = pDomain.getSetOfEvents();
       const auto& ontology = pDomain.getOntology();
-      if (worldStateModificationAtStart)
-        pProblem.worldState.modify(&*worldStateModificationAtStart, pProblem.goalStack, setOfEvents,
-                                   pCallbacks, ontology, pProblem.entities, pNow);
+      pProblem.worldState.modify(&*itAction->second.effect.worldStateModificationAtStart, pProblem.goalStack, setOfEvents,
+                                 pCallbacks, ontology, pProblem.entities, pNow, true,
+                                 &pActionInvocationWithGoal.actionInvocation.parameters);
     }
   }
 }
@@ -1105,6 +1123,7 @@ bool notifyActionDone(Problem& pProblem,
                       const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
                       LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr)
 {
+  ORDEREDGOALSPLANNER_STATS_SCOPE(pLookForAnActionOutputInfosPtr != nullptr ? &pLookForAnActionOutputInfosPtr->stats() : nullptr);
   const auto& actions = pDomain.actions();
   auto itAction = actions.find(pOnStepOfPlannerResult.actionInvocation.actionId);
   if (itAction != actions.end())
@@ -1128,12 +1147,16 @@ std::list<ActionInvocationWithGoal> planForEveryGoals(
     const Domain& pDomain,
     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
     Historical* pGlobalHistorical,
-    std::list<Goal>* pGoalsDonePtr)
+    std::list<Goal>* pGoalsDonePtr,
+    LookForAnActionOutputInfos* pLookForAnActionOutputInfosPtr)
 {
   const bool tryToDoMoreOptimalSolution = true;
   std::map<std::string, std::size_t> actionAlreadyInPlan;
   std::list<ActionInvocationWithGoal> res;
-  LookForAnActionOutputInfos lookForAnActionOutputInfos;
+  LookForAnActionOutputInfos localLookForAnActionOutputInfos;
+  auto& lookForAnActionOutputInfos = pLookForAnActionOutputInfosPtr != nullptr ? *pLookForAnActionOutputInfosPtr : localLookForAnActionOutputInfos;
+  ORDEREDGOALSPLANNER_STATS_SCOPE(&lookForAnActionOutputInfos.stats());
+  ORDEREDGOALSPLANNER_ALLOCATION_PHASE(PLANNING);
   while (!pProblem.goalStack.goals().empty())
   {
     auto subPlan = _planForMoreImportantGoalPossible(pProblem, pDomain, tryToDoMoreOptimalSolution,
@@ -1177,7 +1200,7 @@ ParallelPan parallelPlanForEveryGoals(
   pProblem.goalStack.refreshIfNeeded(pDomain);
 
   std::list<Goal> goalsDone;
-  auto problemForPlanResolution = pProblem;
+  auto problemForPlanResolution = _copyProblem(pProblem);
   auto sequentialPlan = planForEveryGoals(problemForPlanResolution, pDomain, pNow, pGlobalHistorical, &goalsDone);
   return toParallelPlan(sequentialPlan, false, pProblem, pDomain, goalsDone, pNow);
 }
@@ -1224,15 +1247,25 @@ std::string parallelPlanToStr(const ParallelPan& pPlan)
 std::string planToPddl(const std::list<ActionInvocationWithGoal>& pPlan,
                        const Domain& pDomain)
 {
-  std::size_t step = 0;
   std::stringstream ss;
+  planToPddl(ss, pPlan, pDomain);
+  return ss.str();
+}
+
+
+void planToPddl(std::ostream& pOs,
+                const std::list<ActionInvocationWithGoal>& pPlan,
+                const Domain& pDomain)
+{
+  std::size_t step = 0;
+  auto previousFill = pOs.fill('0');
   for (const auto& currActionInvocationWithGoal : pPlan)
   {
-    ss << std::setw(2) << std::setfill('0') << step << ": ";
+    pOs << std::setw(2) << step << ": ";
     ++step;
-    ss << currActionInvocationWithGoal.actionInvocation.toPddl(pDomain) << "\n";
+    pOs << currActionInvocationWithGoal.actionInvocation.toPddl(pDomain) << "\n";
   }
-  return ss.str();
+  pOs.fill(previousFill);
 }
 
 
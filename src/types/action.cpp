@@ -1,4 +1,5 @@
 #include <orderedgoalsplanner/types/action.hpp>
+#include <orderedgoalsplanner/types/conditionprogram.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 
 namespace ogp
@@ -53,6 +54,12 @@ void Action::updateSuccessionCache(const Domain& pDomain,
     effect.worldStateModification->updateSuccesions(pDomain, containerId, pFactsFromCondition);
   if (effect.potentialWorldStateModification)
     effect.potentialWorldStateModification->updateSuccesions(pDomain, containerId, pFactsFromCondition);
+  updatePreconditionProgramCache();
+}
+
+void Action::updatePreconditionProgramCache()
+{
+  preconditionProgramCache = precondition ? std::make_shared<const ConditionProgram>(*precondition) : nullptr;
 }
 
 void Action::removePossibleSuccessionCache(const ActionId& pActionIdToRemove)
@@ -64,6 +71,27 @@ void Action::removePossibleSuccessionCache(const ActionId& pActionIdToRemove)
 }
 
 
+bool Action::isPreconditionTrue(const WorldState& pWorldState,
+                                std::map<Parameter, std::set<Entity>>* pParametersToPossibleArgumentsPtr) const
+{
+  if (!precondition)
+    return true;
+  if (preconditionProgramCache)
+    return preconditionProgramCache->isTrue(pWorldState, {}, {}, pParametersToPossibleArgumentsPtr);
+  return precondition->isTrue(pWorldState, {}, {}, pParametersToPossibleArgumentsPtr);
+}
+
+
+bool Action::canPreconditionBecomeTrue(const WorldState& pWorldState) const
+{
+  if (!precondition)
+    return true;
+  if (preconditionProgramCache)
+    return preconditionProgramCache->canBecomeTrue(pWorldState, parameters);
+  return precondition->canBecomeTrue(pWorldState, parameters);
+}
+
+
 std::string Action::printSuccessionCache() const
 {
   std::string res;
@@ -0,0 +1,295 @@
+#include <orderedgoalsplanner/types/actionsinterference.hpp>
+#include <algorithm>
+#include <optional>
+#include <set>
+#include <orderedgoalsplanner/types/action.hpp>
+#include <orderedgoalsplanner/types/condition.hpp>
+#include "worldstatemodificationprivate.hpp"
+
+namespace ogp
+{
+namespace
+{
+
+/// Fact of an action schema with the parameters of the quantifiers that wrap it.
+struct LiftedFact
+{
+  const Fact* factPtr;
+  std::set<std::string> quantifiedParameters;
+};
+
+
+bool _isAComparison(ConditionNodeType pNodeType)
+{
+  return pNodeType == ConditionNodeType::EQUALITY ||
+      pNodeType == ConditionNodeType::SUPERIOR || pNodeType == ConditionNodeType::SUPERIOR_OR_EQUAL ||
+      pNodeType == ConditionNodeType::INFERIOR || pNodeType == ConditionNodeType::INFERIOR_OR_EQUAL;
+}
+
+
+/**
+ * @brief Get the facts of a condition that can have a contradiction with an effect.
+ * @param[out] pRes Facts found.
+ * @param[in] pCondition Condition to explore.
+ * @param[in] pQuantifiedParameters Parameters of the quantifiers that wrap the condition.
+ * @return False if the condition has a shape for which the contradictions cannot be deduced from its facts.
+ */
+bool _extractConditionFacts(std::vector<LiftedFact>& pRes,
+                            const Condition& pCondition,
+                            const std::set<std::string>& pQuantifiedParameters)
+{
+  if (const auto* nodePtr = pCondition.fcNodePtr())
+  {
+    if (nodePtr->nodeType == ConditionNodeType::AND ||
+        nodePtr->nodeType == ConditionNodeType::OR ||
+        nodePtr->nodeType == ConditionNodeType::IMPLY)
+      return (!nodePtr->leftOperand || _extractConditionFacts(pRes, *nodePtr->leftOperand, pQuantifiedParameters)) &&
+          (!nodePtr->rightOperand || _extractConditionFacts(pRes, *nodePtr->rightOperand, pQuantifiedParameters));
+
+    if (_isAComparison(nodePtr->nodeType) && nodePtr->leftOperand && nodePtr->rightOperand)
+    {
+      if (const auto* leftFactPtr = nodePtr->leftOperand->fcFactPtr())
+      {
+        pRes.push_back(LiftedFact{&leftFactPtr->factOptional.fact, pQuantifiedParameters});
+        return true;
+      }
+    }
+    return false;
+  }
+
+  if (const auto* existsPtr = pCondition.fcExistsPtr())
+  {
+    if (!existsPtr->condition)
+      return true;
+    auto quantifiedParameters = pQuantifiedParameters;
+    quantifiedParameters.insert(existsPtr->parameter.name);
+    if (existsPtr->condition->fcFactPtr() != nullptr)
+      return _extractConditionFacts(pRes, *existsPtr->condition, quantifiedParameters);
+    const auto* subNodePtr = existsPtr->condition->fcNodePtr();
+    if (subNodePtr != nullptr && subNodePtr->leftOperand && subNodePtr->rightOperand &&
+        (subNodePtr->nodeType == ConditionNodeType::AND ||
+         subNodePtr->nodeType == ConditionNodeType::OR ||
+         subNodePtr->nodeType == ConditionNodeType::IMPLY))
+      return _extractConditionFacts(pRes, *existsPtr->condition, quantifiedParameters);
+    return false;
+  }
+
+  if (const auto* notPtr = pCondition.fcNotPtr())
+    return !notPtr->condition || _extractConditionFacts(pRes, *notPtr->condition, pQuantifiedParameters);
+
+  if (const auto* factPtr = pCondition.fcFactPtr())
+    pRes.push_back(LiftedFact{&factPtr->factOptional.fact, pQuantifiedParameters});
+  return true;
+}
+
+
+/// Get the facts that can be modified by a world state modification.
+void _extractModifiedFacts(std::vector<LiftedFact>& pRes,
+                           const WorldStateModification& pWsModification,
+                           const std::set<std::string>& pQuantifiedParameters)
+{
+  if (const auto* nodePtr = toWmNode(pWsModification))
+  {
+    if (nodePtr->nodeType == WorldStateModificationNodeType::AND)
+    {
+      if (nodePtr->leftOperand)
+        _extractModifiedFacts(pRes, *nodePtr->leftOperand, pQuantifiedParameters);
+      if (nodePtr->rightOperand)
+        _extractModifiedFacts(pRes, *nodePtr->rightOperand, pQuantifiedParameters);
+    }
+    else if (nodePtr->nodeType == WorldStateModificationNodeType::FOR_ALL && nodePtr->rightOperand)
+    {
+      auto quantifiedParameters = pQuantifiedParameters;
+      if (nodePtr->parameterOpt)
+        quantifiedParameters.insert(nodePtr->parameterOpt->name);
+      _extractModifiedFacts(pRes, *nodePtr->rightOperand, quantifiedParameters);
+    }
+    else if ((nodePtr->nodeType == WorldStateModificationNodeType::ASSIGN ||
+              nodePtr->nodeType == WorldStateModificationNodeType::INCREASE ||
+              nodePtr->nodeType == WorldStateModificationNodeType::DECREASE ||
+              nodePtr->nodeType == WorldStateModificationNodeType::MULTIPLY) && nodePtr->leftOperand)
+    {
+      if (const auto* leftFactPtr = toWmFact(*nodePtr->leftOperand))
+        pRes.push_back(LiftedFact{&leftFactPtr->factOptional.fact, pQuantifiedParameters});
+    }
+    return;
+  }
+
+  if (const auto* factPtr = toWmFact(pWsModification))
+    pRes.push_back(LiftedFact{&factPtr->factOptional.fact, pQuantifiedParameters});
+}
+
+
+std::vector<LiftedFact> _extractModifiedFacts(const Action& pAction)
+{
+  std::vector<LiftedFact> res;
+  for (const auto* wsModificationPtr : {pAction.effect.worldStateModificationAtStart.get(),
+                                        pAction.effect.worldStateModification.get(),
+                                        pAction.effect.potentialWorldStateModification.get()})
+    if (wsModificationPtr != nullptr)
+      _extractModifiedFacts(res, *wsModificationPtr, {});
+  return res;
+}
+
+
+/// Convert an argument of a fact to a term, or return nothing if the argument can be any value.
+std::optional<ActionsInterference::Term> _toTerm(const Entity& pArgument,
+                                                 const LiftedFact& pLiftedFact,
+                                                 const Action& pAction,
+                                                 ActionsInterference::Term::Origin pOrigin)
+{
+  if (pArgument.isAnyValue() || pLiftedFact.quantifiedParameters.count(pArgument.value) > 0)
+    return {};
+  if (pArgument.isAParameterToFill())
+  {
+    for (const auto& currParameter : pAction.parameters)
+      if (currParameter.name == pArgument.value)
+        return ActionsInterference::Term{pOrigin, pArgument.value};
+    return {};
+  }
+  return ActionsInterference::Term{ActionsInterference::Term::Origin::CONSTANT, pArgument.value};
+}
+
+
+/**
+ * @brief Find the parameter equalities needed to have the same fact from a fact of each action.
+ * @return False if the facts can never be the same.
+ */
+bool _unify(std::vector<ActionsInterference::ParameterEquality>& pRes,
+            const LiftedFact& pFirstFact,
+            const Action& pFirstAction,
+            const LiftedFact& pSecondFact,
+            const Action& pSecondAction)
+{
+  const auto& firstArguments = pFirstFact.factPtr->arguments();
+  const auto& secondArguments = pSecondFact.factPtr->arguments();
+  if (pFirstFact.factPtr->name() != pSecondFact.factPtr->name() ||
+      firstArguments.size() != secondArguments.size())
+    return false;
+
+  for (std::size_t i = 0; i < firstArguments.size(); ++i)
+  {
+    auto firstTerm = _toTerm(firstArguments[i], pFirstFact, pFirstAction, ActionsInterference::Term::Origin::FIRST_ACTION);
+    auto secondTerm = _toTerm(secondArguments[i], pSecondFact, pSecondAction, ActionsInterference::Term::Origin::SECOND_ACTION);
+    if (!firstTerm || !secondTerm)
+      continue;
+    if (firstTerm->origin == ActionsInterference::Term::Origin::CONSTANT &&
+        secondTerm->origin == ActionsInterference::Term::Origin::CONSTANT)
+    {
+      if (firstTerm->value != secondTerm->value)
+        return false;
+      continue;
+    }
+    pRes.push_back(ActionsInterference::ParameterEquality{std::move(*firstTerm), std::move(*secondTerm)});
+  }
+  return true;
+}
+
+
+const std::string* _termValue(const ActionsInterference::Term& pTerm,
+                              const std::map<Parameter, Entity>& pFirstArguments,
+                              const std::map<Parameter, Entity>& pSecondArguments)
+{
+  if (pTerm.origin == ActionsInterference::Term::Origin::CONSTANT)
+    return &pTerm.value;
+  const auto& arguments = pTerm.origin == ActionsInterference::Term::Origin::FIRST_ACTION ? pFirstArguments : pSecondArguments;
+  auto it = arguments.find(Parameter(pTerm.value, {})); // Parameters are sorted by name
+  if (it == arguments.end() || it->second.isAnyValue())
+    return nullptr;
+  return &it->second.value;
+}
+
+}
+
+
+ActionsInterference::Predicates ActionsInterference::extractPredicates(const Action& pAction)
+{
+  Predicates res;
+  std::vector<LiftedFact> conditionFacts;
+  if (pAction.precondition && !_extractConditionFacts(conditionFacts, *pAction.precondition, {}))
+    res.canAlwaysInterfere = true;
+  for (const auto& currFact : conditionFacts)
+    res.conditionPredicates.insert(currFact.factPtr->name());
+  for (const auto& currFact : _extractModifiedFacts(pAction))
+    res.modifiedPredicates.insert(currFact.factPtr->name());
+  return res;
+}
+
+
+ActionsInterference ActionsInterference::compute(const Action& pFirstAction,
+                                                 const Action& pSecondAction)
+{
+  ActionsInterference res;
+  std::vector<LiftedFact> firstConditionFacts;
+  std::vector<LiftedFact> secondConditionFacts;
+  if ((pFirstAction.precondition && !_extractConditionFacts(firstConditionFacts, *pFirstAction.precondition, {})) ||
+      (pSecondAction.precondition && !_extractConditionFacts(secondConditionFacts, *pSecondAction.precondition, {})))
+  {
+    res.kind = Kind::ALWAYS;
+    return res;
+  }
+  auto firstModifiedFacts = _extractModifiedFacts(pFirstAction);
+  auto secondModifiedFacts = _extractModifiedFacts(pSecondAction);
+
+  // A condition or an effect of an action can be contradicted by an effect of the other action
+  auto addAlternatives = [&](const std::vector<LiftedFact>& pFirstFacts,
+                             const std::vector<LiftedFact>& pSecondFacts) {
+    for (const auto& currFirstFact : pFirstFacts)
+    {
+      for (const auto& currSecondFact : pSecondFacts)
+      {
+        std::vector<ParameterEquality> equalities;
+        if (!_unify(equalities, currFirstFact, pFirstAction, currSecondFact, pSecondAction))
+          continue;
+        if (equalities.empty())
+        {
+          res.kind = Kind::ALWAYS;
+          return;
+        }
+        if (std::find(res.equalitiesAlternatives.begin(), res.equalitiesAlternatives.end(), equalities) == res.equalitiesAlternatives.end())
+          res.equalitiesAlternatives.push_back(std::move(equalities));
+      }
+    }
+  };
+  addAlternatives(firstConditionFacts, secondModifiedFacts);
+  if (res.kind != Kind::ALWAYS)
+    addAlternatives(firstModifiedFacts, secondModifiedFacts);
+  if (res.kind != Kind::ALWAYS)
+    addAlternatives(firstModifiedFacts, secondConditionFacts);
+
+  if (res.kind == Kind::ALWAYS)
+    res.equalitiesAlternatives.clear();
+  else if (!res.equalitiesAlternatives.empty())
+    res.kind = Kind::DEPENDS_ON_PARAMETERS;
+  return res;
+}
+
+
+bool ActionsInterference::canInterfere(const std::map<Parameter, Entity>& pFirstArguments,
+                                       const std::map<Parameter, Entity>& pSecondArguments) const
+{
+  if (kind != Kind::DEPENDS_ON_PARAMETERS)
+    return kind == Kind::ALWAYS;
+
+  for (const auto& currAlternative : equalitiesAlternatives)
+  {
+    bool allEqualitiesSatisfied = true;
+    for (const auto& currEquality : currAlternative)
+    {
+      const auto* leftValuePtr = _termValue(currEquality.left, pFirstArguments, pSecondArguments);
+      const auto* rightValuePtr = _termValue(currEquality.right, pFirstArguments, pSecondArguments);
+      // An unknown value can be equal to anything
+      if (leftValuePtr != nullptr && rightValuePtr != nullptr && *leftValuePtr != *rightValuePtr)
+      {
+        allEqualitiesSatisfied = false;
+        break;
+      }
+    }
+    if (allEqualitiesSatisfied)
+      return true;
+  }
+  return false;
+}
+
+
+} // !ogp
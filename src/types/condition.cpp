@@ -5,14 +5,28 @@
 #include <orderedgoalsplanner/types/worldstate.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 #include "expressionParsed.hpp"
+#include "../util/plannerstatsrecorder.hpp"
 
 namespace ogp
 {
 namespace
 {
 
+/// Get the fact with its parameters replaced by their argument, without copy if there is nothing to replace.
+const Fact& _withArguments(std::optional<Fact>& pFactWithArgumentsStorage,
+                           const Fact& pFact,
+                           const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr)
+{
+  if (pConditionParametersToArgumentPtr == nullptr || pConditionParametersToArgumentPtr->empty() ||
+      !pFact.hasAParameter())
+    return pFact;
+  pFactWithArgumentsStorage.emplace(pFact);
+  pFactWithArgumentsStorage->replaceArguments(*pConditionParametersToArgumentPtr);
+  return *pFactWithArgumentsStorage;
+}
+
 
-bool _forEachValueUntil(const std::function<bool (const Entity&)>& pValueCallback,
+bool _forEachValueUntil(FunctionRef<bool (const Entity&)> pValueCallback,
                         bool pUntilValue,
                         const Condition& pCondition,
                         const WorldState& pWorldState,
@@ -30,8 +44,7 @@ bool _forEachValueUntil(const std::function<bool (const Entity&)>& pValueCallbac
   unfoldMapWithSet(paramPossibilities, *pParametersPtr);
   for (auto& currParamPoss : paramPossibilities)
   {
-    auto condToExtractValue = pCondition.clone(&currParamPoss);
-    auto fluentOpt = condToExtractValue->getFluent(setOfFacts);
+    auto fluentOpt = pCondition.getFluent(setOfFacts, &currParamPoss);
     if (fluentOpt && pValueCallback(*fluentOpt) == pUntilValue)
       return pUntilValue;
   }
@@ -54,7 +67,7 @@ bool _forEachValueUntil(const std::function<bool (const Entity&)>& pValueCallbac
 }
 
 
-void _forEach(const std::function<void (const Entity&, const Fact*)>& pValueCallback,
+void _forEach(FunctionRef<void (const Entity&, const Fact*)> pValueCallback,
               const Condition& pCondition,
               const WorldState& pWorldState,
               const std::map<Parameter, std::set<Entity>>* pParametersPtr)
@@ -72,8 +85,7 @@ void _forEach(const std::function<void (const Entity&, const Fact*)>& pValueCall
   unfoldMapWithSet(paramPossibilities, *pParametersPtr);
   for (auto& currParamPoss : paramPossibilities)
   {
-    auto factToExtractValue = pCondition.clone(&currParamPoss);
-    auto fluentOpt = factToExtractValue->getFluent(setOfFacts);
+    auto fluentOpt = pCondition.getFluent(setOfFacts, &currParamPoss);
     if (fluentOpt)
       pValueCallback(*fluentOpt, nullptr);
   }
@@ -257,7 +269,7 @@ void _existsExtractPossRec(std::map<Parameter, std::set<Entity>>& pLocalParamToV
 bool Condition::isOptFactMandatory(const FactOptional& pFactOptional,
                                    bool pIgnoreFluent) const
 {
-  bool res;
+  bool res = false;
   forAll([&](const FactOptional& pFactOptionalFromCond, bool pIgnoreFluentFromCond) {
     if (pFactOptional.isFactNegated == pFactOptionalFromCond.isFactNegated)
     {
@@ -357,7 +369,7 @@ bool ConditionNode::containsFactOpt(const FactOptional& pFactOptional,
 }
 
 
-ContinueOrBreak ConditionNode::forAll(const std::function<ContinueOrBreak (const FactOptional&, bool)>& pFactCallback,
+ContinueOrBreak ConditionNode::forAll(FunctionRef<ContinueOrBreak (const FactOptional&, bool)> pFactCallback,
                                       bool pIsWrappingExpressionNegated,
                                       bool pIgnoreFluent,
                                       bool pOnlyMandatoryFacts) const
@@ -376,7 +388,7 @@ ContinueOrBreak ConditionNode::forAll(const std::function<ContinueOrBreak (const
 
 
 bool ConditionNode::findConditionCandidateFromFactFromEffect(
-    const std::function<bool (const FactOptional&)>& pDoesConditionFactMatchFactFromEffect,
+    FunctionRef<bool (const FactOptional&)> pDoesConditionFactMatchFactFromEffect,
     const WorldState& pWorldState,
     const Fact& pFactFromEffect,
     const std::map<Parameter, std::set<Entity>>& pFactFromEffectParameters,
@@ -453,7 +465,7 @@ bool ConditionNode::findConditionCandidateFromFactFromEffect(
 
 
 
-bool ConditionNode::untilFalse(const std::function<bool (const FactOptional&)>& pFactCallback,
+bool ConditionNode::untilFalse(FunctionRef<bool (const FactOptional&)> pFactCallback,
                                const SetOfFacts& pSetOfFact) const
 {
   if (nodeType == ConditionNodeType::AND || nodeType == ConditionNodeType::OR|| nodeType == ConditionNodeType::IMPLY)
@@ -493,6 +505,7 @@ bool ConditionNode::isTrue(const WorldState& pWorldState,
                            bool* pCanBecomeTruePtr,
                            bool pIsWrappingExpressionNegated) const
 {
+  ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfConditionEvaluations);
   if (nodeType == ConditionNodeType::AND)
   {
     bool canBecomeTrue = false;
@@ -597,13 +610,28 @@ bool ConditionNode::isTrue(const WorldState& pWorldState,
         if (rightNbPtr != nullptr)
         {
           const auto& factsMapping = pWorldState.factsMapping();
+          if (pConditionParametersToPossibleArguments != nullptr && leftFact.hasAParameter(true))
+          {
+            // Bind the parameters from a range scan on the numeric values.
+            // A negation is the complementary range, for example "not >" is "<=".
+            bool superior = canBeSuperior(nodeType) != pIsWrappingExpressionNegated;
+            bool equal = canBeEqual(nodeType) != pIsWrappingExpressionNegated;
+            bool res = false;
+            std::map<Parameter, std::set<Entity>> newParameters;
+            for (const auto& currWsFact : factsMapping.findInNumericRange(leftFact, rightNbPtr->nb, superior, equal))
+              if (leftFact.isInOtherFact(currWsFact, true, &newParameters, pConditionParametersToPossibleArguments, nullptr, nullptr, true))
+                res = true;
+            applyNewParams(*pConditionParametersToPossibleArguments, newParameters);
+            return res;
+          }
+
           auto leftFactMatchingInWs = factsMapping.find(leftFact);
           for (const auto& currWsFact : leftFactMatchingInWs)
           {
             if (currWsFact.fluent() &&
                 leftFact.areEqualWithoutFluentConsideration(currWsFact))
             {
-              bool res = compIntNb(currWsFact.fluent()->value, rightNbPtr->nb,
+              bool res = compIntNb(*currWsFact.fluent(), rightNbPtr->nb,
                                    canBeSuperior(nodeType), canBeEqual(nodeType));
               if (!pIsWrappingExpressionNegated)
                 return res;
@@ -667,18 +695,19 @@ bool ConditionNode::operator==(const Condition& pOther) const
       _areEqual(rightOperand, otherNodePtr->rightOperand);
 }
 
-std::optional<Entity> ConditionNode::getFluent(const SetOfFacts& pSetOfFact) const
+std::optional<Entity> ConditionNode::getFluent(const SetOfFacts& pSetOfFact,
+                                               const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr) const
 {
   if (nodeType == ConditionNodeType::PLUS)
   {
-    auto leftValue = leftOperand->getFluent(pSetOfFact);
-    auto rightValue = rightOperand->getFluent(pSetOfFact);
+    auto leftValue = leftOperand->getFluent(pSetOfFact, pConditionParametersToArgumentPtr);
+    auto rightValue = rightOperand->getFluent(pSetOfFact, pConditionParametersToArgumentPtr);
     return plusIntOrStr(leftValue, rightValue);
   }
   if (nodeType == ConditionNodeType::MINUS)
   {
-    auto leftValue = leftOperand->getFluent(pSetOfFact);
-    auto rightValue = rightOperand->getFluent(pSetOfFact);
+    auto leftValue = leftOperand->getFluent(pSetOfFact, pConditionParametersToArgumentPtr);
+    auto rightValue = rightOperand->getFluent(pSetOfFact, pConditionParametersToArgumentPtr);
     return minusIntOrStr(leftValue, rightValue);
   }
   return {};
@@ -791,7 +820,7 @@ bool ConditionExists::containsFactOpt(const FactOptional& pFactOptional,
   return condition && condition->containsFactOpt(pFactOptional, pFactParameters, pOtherFactParametersPtr, pConditionParameters, pIsWrappingExpressionNegated);
 }
 
-ContinueOrBreak ConditionExists::forAll(const std::function<ContinueOrBreak (const FactOptional&, bool)>& pFactCallback,
+ContinueOrBreak ConditionExists::forAll(FunctionRef<ContinueOrBreak (const FactOptional&, bool)> pFactCallback,
                                         bool pIsWrappingExpressionNegated,
                                         bool pIgnoreFluent,
                                         bool pOnlyMandatoryFacts) const
@@ -804,7 +833,7 @@ ContinueOrBreak ConditionExists::forAll(const std::function<ContinueOrBreak (con
 
 
 bool ConditionExists::findConditionCandidateFromFactFromEffect(
-    const std::function<bool (const FactOptional&)>& pDoesConditionFactMatchFactFromEffect,
+    FunctionRef<bool (const FactOptional&)> pDoesConditionFactMatchFactFromEffect,
     const WorldState& pWorldState,
     const Fact& pFactFromEffect,
     const std::map<Parameter, std::set<Entity>>& pFactFromEffectParameters,
@@ -838,6 +867,7 @@ bool ConditionExists::isTrue(const WorldState& pWorldState,
                              bool*,
                              bool pIsWrappingExpressionNegated) const
 {
+  ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfConditionEvaluations);
   if (condition)
   {
     std::map<Parameter, std::set<Entity>> localParamToValue{{parameter, {}}};
@@ -967,7 +997,7 @@ bool ConditionNot::containsFactOpt(const FactOptional& pFactOptional,
 }
 
 
-ContinueOrBreak ConditionNot::forAll(const std::function<ContinueOrBreak (const FactOptional&, bool)>& pFactCallback,
+ContinueOrBreak ConditionNot::forAll(FunctionRef<ContinueOrBreak (const FactOptional&, bool)> pFactCallback,
                                      bool pIsWrappingExpressionNegated,
                                      bool pIgnoreFluent,
                                      bool pOnlyMandatoryFacts) const
@@ -980,7 +1010,7 @@ ContinueOrBreak ConditionNot::forAll(const std::function<ContinueOrBreak (const
 
 
 bool ConditionNot::findConditionCandidateFromFactFromEffect(
-    const std::function<bool (const FactOptional&)>& pDoesConditionFactMatchFactFromEffect,
+    FunctionRef<bool (const FactOptional&)> pDoesConditionFactMatchFactFromEffect,
     const WorldState& pWorldState,
     const Fact& pFactFromEffect,
     const std::map<Parameter, std::set<Entity>>& pFactFromEffectParameters,
@@ -1003,6 +1033,7 @@ bool ConditionNot::isTrue(const WorldState& pWorldState,
                           bool* pCanBecomeTruePtr,
                           bool pIsWrappingExpressionNegated) const
 {
+  ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfConditionEvaluations);
   if (condition)
     return condition->isTrue(pWorldState, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments, pCanBecomeTruePtr, !pIsWrappingExpressionNegated);
   return !pIsWrappingExpressionNegated;
@@ -1066,7 +1097,7 @@ bool ConditionFact::containsFactOpt(const FactOptional& pFactOptional,
   return false;
 }
 
-ContinueOrBreak ConditionFact::forAll(const std::function<ContinueOrBreak (const FactOptional&, bool)>& pFactCallback,
+ContinueOrBreak ConditionFact::forAll(FunctionRef<ContinueOrBreak (const FactOptional&, bool)> pFactCallback,
                                       bool pIsWrappingExpressionNegated,
                                       bool pIgnoreFluent,
                                       bool) const
@@ -1081,7 +1112,7 @@ ContinueOrBreak ConditionFact::forAll(const std::function<ContinueOrBreak (const
 
 
 bool ConditionFact::findConditionCandidateFromFactFromEffect(
-    const std::function<bool (const FactOptional&)>& pDoesConditionFactMatchFactFromEffect,
+    FunctionRef<bool (const FactOptional&)> pDoesConditionFactMatchFactFromEffect,
     const WorldState&,
     const Fact&,
     const std::map<Parameter, std::set<Entity>>&,
@@ -1103,6 +1134,7 @@ bool ConditionFact::isTrue(const WorldState& pWorldState,
                            bool* pCanBecomeTruePtr,
                            bool pIsWrappingExpressionNegated) const
 {
+  ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfConditionEvaluations);
   bool res = pWorldState.isOptionalFactSatisfiedInASpecificContext(factOptional, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments, nullptr, pCanBecomeTruePtr);
   if (!pIsWrappingExpressionNegated)
     return res;
@@ -1126,9 +1158,11 @@ bool ConditionFact::operator==(const Condition& pOther) const
       factOptional == otherFactPtr->factOptional;
 }
 
-std::optional<Entity> ConditionFact::getFluent(const SetOfFacts& pSetOfFact) const
+std::optional<Entity> ConditionFact::getFluent(const SetOfFacts& pSetOfFact,
+                                               const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr) const
 {
-  return pSetOfFact.getFactFluent(factOptional.fact);
+  std::optional<Fact> factWithArgumentsStorage;
+  return pSetOfFact.getFactFluent(_withArguments(factWithArgumentsStorage, factOptional.fact, pConditionParametersToArgumentPtr));
 }
 
 std::unique_ptr<Condition> ConditionFact::clone(const std::map<Parameter, Entity>* pConditionParametersToArgumentPtr,
@@ -1177,9 +1211,10 @@ bool ConditionNumber::operator==(const Condition& pOther) const
       nb == otherNbPtr->nb;
 }
 
-std::optional<Entity> ConditionNumber::getFluent(const SetOfFacts&) const
+std::optional<Entity> ConditionNumber::getFluent(const SetOfFacts&,
+                                                 const std::map<Parameter, Entity>*) const
 {
-  return Entity::createNumberEntity(toStr(nullptr, true));
+  return Entity::createNumberEntity(nb);
 }
 
 std::unique_ptr<Condition> ConditionNumber::clone(const std::map<Parameter, Entity>*,
@@ -0,0 +1,239 @@
+#include <orderedgoalsplanner/types/conditionprogram.hpp>
+#include <orderedgoalsplanner/types/worldstate.hpp>
+#include "../util/plannerstatsrecorder.hpp"
+
+namespace ogp
+{
+
+
+ConditionProgram::ConditionProgram(const Condition& pCondition)
+  : _instructions(),
+    _facts(),
+    _subConditions()
+{
+  _compile(&pCondition);
+}
+
+
+bool ConditionProgram::isTrue(const WorldState& pWorldState,
+                              const std::set<Fact>& pPunctualFacts,
+                              const std::set<Fact>& pRemovedFacts,
+                              std::map<Parameter, std::set<Entity>>* pConditionParametersToPossibleArguments,
+                              bool* pCanBecomeTruePtr,
+                              bool pIsWrappingExpressionNegated) const
+{
+  return _isTrue(0, pWorldState, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments,
+                 pCanBecomeTruePtr, pIsWrappingExpressionNegated);
+}
+
+
+bool ConditionProgram::canBecomeTrue(const WorldState& pWorldState,
+                                     const std::vector<Parameter>& pParameters,
+                                     bool pIsWrappingExpressionNegated) const
+{
+  return _canBecomeTrue(0, pWorldState, pParameters, pIsWrappingExpressionNegated);
+}
+
+
+void ConditionProgram::_compile(const Condition* pConditionPtr)
+{
+  const auto index = _instructions.size();
+  if (pConditionPtr == nullptr)
+  {
+    _instructions.push_back(Instruction{OpCode::EMPTY, 0, 1});
+    return;
+  }
+
+  if (const auto* nodePtr = pConditionPtr->fcNodePtr())
+  {
+    if (nodePtr->nodeType == ConditionNodeType::AND ||
+        nodePtr->nodeType == ConditionNodeType::OR ||
+        nodePtr->nodeType == ConditionNodeType::IMPLY)
+    {
+      auto opCode = nodePtr->nodeType == ConditionNodeType::AND ? OpCode::AND :
+                    nodePtr->nodeType == ConditionNodeType::OR ? OpCode::OR : OpCode::IMPLY;
+      _instructions.push_back(Instruction{opCode, 0, 0});
+      _compile(nodePtr->leftOperand.get());
+      _compile(nodePtr->rightOperand.get());
+      _instructions[index].size = static_cast<std::uint32_t>(_instructions.size() - index);
+      return;
+    }
+  }
+  else if (const auto* notPtr = pConditionPtr->fcNotPtr())
+  {
+    _instructions.push_back(Instruction{OpCode::NOT, 0, 0});
+    _compile(notPtr->condition.get());
+    _instructions[index].size = static_cast<std::uint32_t>(_instructions.size() - index);
+    return;
+  }
+  else if (const auto* factPtr = pConditionPtr->fcFactPtr())
+  {
+    _instructions.push_back(Instruction{OpCode::FACT, static_cast<std::uint32_t>(_facts.size()), 1});
+    _facts.push_back(factPtr->factOptional);
+    return;
+  }
+
+  _instructions.push_back(Instruction{OpCode::SUB_CONDITION, static_cast<std::uint32_t>(_subConditions.size()), 1});
+  _subConditions.push_back(pConditionPtr->clone());
+}
+
+
+bool ConditionProgram::_isTrue(std::size_t pIndex,
+                               const WorldState& pWorldState,
+                               const std::set<Fact>& pPunctualFacts,
+                               const std::set<Fact>& pRemovedFacts,
+                               std::map<Parameter, std::set<Entity>>* pConditionParametersToPossibleArguments,
+                               bool* pCanBecomeTruePtr,
+                               bool pIsWrappingExpressionNegated) const
+{
+  const auto& instruction = _instructions[pIndex];
+  const auto leftIndex = pIndex + 1;
+  switch (instruction.opCode)
+  {
+  case OpCode::AND:
+  {
+    ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfConditionEvaluations);
+    bool canBecomeTrue = false;
+    if (pCanBecomeTruePtr == nullptr)
+      pCanBecomeTruePtr = &canBecomeTrue;
+
+    const auto rightIndex = leftIndex + _instructions[leftIndex].size;
+    const bool hasLeft = _instructions[leftIndex].opCode != OpCode::EMPTY;
+    const bool hasRight = _instructions[rightIndex].opCode != OpCode::EMPTY;
+    if (hasLeft && !_isTrue(leftIndex, pWorldState, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments, pCanBecomeTruePtr, pIsWrappingExpressionNegated))
+    {
+      // Sometimes for negation of fact with parameter we need to check in the inverse order
+      if (*pCanBecomeTruePtr)
+      {
+        if (hasRight && !_isTrue(rightIndex, pWorldState, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments, pCanBecomeTruePtr, pIsWrappingExpressionNegated))
+          return false;
+        return _isTrue(leftIndex, pWorldState, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments, pCanBecomeTruePtr, pIsWrappingExpressionNegated);
+      }
+      return false;
+    }
+    if (hasRight && !_isTrue(rightIndex, pWorldState, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments, pCanBecomeTruePtr, pIsWrappingExpressionNegated))
+      return false;
+    return !pIsWrappingExpressionNegated;
+  }
+  case OpCode::OR:
+  {
+    ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfConditionEvaluations);
+    bool canBecomeTrue = false;
+    if (pCanBecomeTruePtr == nullptr)
+      pCanBecomeTruePtr = &canBecomeTrue;
+
+    const auto rightIndex = leftIndex + _instructions[leftIndex].size;
+    if (_instructions[leftIndex].opCode != OpCode::EMPTY &&
+        _isTrue(leftIndex, pWorldState, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments, pCanBecomeTruePtr, pIsWrappingExpressionNegated))
+      return true;
+    return _instructions[rightIndex].opCode != OpCode::EMPTY &&
+        _isTrue(rightIndex, pWorldState, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments, pCanBecomeTruePtr, pIsWrappingExpressionNegated);
+  }
+  case OpCode::IMPLY:
+  {
+    ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfConditionEvaluations);
+    bool canBecomeTrue = false;
+    if (pCanBecomeTruePtr == nullptr)
+      pCanBecomeTruePtr = &canBecomeTrue;
+
+    const auto rightIndex = leftIndex + _instructions[leftIndex].size;
+    if (_instructions[leftIndex].opCode != OpCode::EMPTY &&
+        _isTrue(leftIndex, pWorldState, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments, pCanBecomeTruePtr, pIsWrappingExpressionNegated))
+    {
+      if (_instructions[rightIndex].opCode != OpCode::EMPTY &&
+          !_isTrue(rightIndex, pWorldState, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments, pCanBecomeTruePtr, pIsWrappingExpressionNegated))
+        return false;
+    }
+    return true;
+  }
+  case OpCode::NOT:
+  {
+    ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfConditionEvaluations);
+    if (_instructions[leftIndex].opCode != OpCode::EMPTY)
+      return _isTrue(leftIndex, pWorldState, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments, pCanBecomeTruePtr, !pIsWrappingExpressionNegated);
+    return !pIsWrappingExpressionNegated;
+  }
+  case OpCode::FACT:
+  {
+    ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfConditionEvaluations);
+    bool res = pWorldState.isOptionalFactSatisfiedInASpecificContext(_facts[instruction.slot], pPunctualFacts, pRemovedFacts,
+                                                                     pConditionParametersToPossibleArguments, nullptr, pCanBecomeTruePtr);
+    if (!pIsWrappingExpressionNegated)
+      return res;
+    return !res;
+  }
+  case OpCode::SUB_CONDITION:
+    return _subConditions[instruction.slot]->isTrue(pWorldState, pPunctualFacts, pRemovedFacts, pConditionParametersToPossibleArguments,
+                                                    pCanBecomeTruePtr, pIsWrappingExpressionNegated);
+  case OpCode::EMPTY:
+    break;
+  }
+  return !pIsWrappingExpressionNegated;
+}
+
+
+bool ConditionProgram::_canBecomeTrue(std::size_t pIndex,
+                                      const WorldState& pWorldState,
+                                      const std::vector<Parameter>& pParameters,
+                                      bool pIsWrappingExpressionNegated) const
+{
+  const auto& instruction = _instructions[pIndex];
+  const auto leftIndex = pIndex + 1;
+  switch (instruction.opCode)
+  {
+  case OpCode::AND:
+  {
+    const auto rightIndex = leftIndex + _instructions[leftIndex].size;
+    if (_instructions[leftIndex].opCode != OpCode::EMPTY &&
+        !_canBecomeTrue(leftIndex, pWorldState, pParameters, pIsWrappingExpressionNegated))
+      return pIsWrappingExpressionNegated;
+    if (_instructions[rightIndex].opCode != OpCode::EMPTY &&
+        !_canBecomeTrue(rightIndex, pWorldState, pParameters, pIsWrappingExpressionNegated))
+      return pIsWrappingExpressionNegated;
+    return true;
+  }
+  case OpCode::OR:
+  {
+    const auto rightIndex = leftIndex + _instructions[leftIndex].size;
+    if (_instructions[leftIndex].opCode != OpCode::EMPTY &&
+        _canBecomeTrue(leftIndex, pWorldState, pParameters, pIsWrappingExpressionNegated))
+      return !pIsWrappingExpressionNegated;
+    if (_instructions[rightIndex].opCode != OpCode::EMPTY &&
+        _canBecomeTrue(rightIndex, pWorldState, pParameters, pIsWrappingExpressionNegated))
+      return !pIsWrappingExpressionNegated;
+    return pIsWrappingExpressionNegated;
+  }
+  case OpCode::IMPLY:
+  {
+    const auto rightIndex = leftIndex + _instructions[leftIndex].size;
+    if (_instructions[leftIndex].opCode != OpCode::EMPTY &&
+        !_canBecomeTrue(leftIndex, pWorldState, pParameters, pIsWrappingExpressionNegated))
+      return !pIsWrappingExpressionNegated;
+    if (_instructions[rightIndex].opCode != OpCode::EMPTY &&
+        !_canBecomeTrue(rightIndex, pWorldState, pParameters, pIsWrappingExpressionNegated))
+      return pIsWrappingExpressionNegated;
+    return true;
+  }
+  case OpCode::NOT:
+  {
+    if (_instructions[leftIndex].opCode != OpCode::EMPTY)
+      return _canBecomeTrue(leftIndex, pWorldState, pParameters, !pIsWrappingExpressionNegated);
+    return true;
+  }
+  case OpCode::FACT:
+  {
+    bool res = pWorldState.canFactOptBecomeTrue(_facts[instruction.slot], pParameters);
+    if (!pIsWrappingExpressionNegated)
+      return res;
+    return !res;
+  }
+  case OpCode::SUB_CONDITION:
+    return _subConditions[instruction.slot]->canBecomeTrue(pWorldState, pParameters, pIsWrappingExpressionNegated);
+  case OpCode::EMPTY:
+    break;
+  }
+  return true;
+}
+
+
+} // !ogp
@@ -1,4 +1,5 @@
 #include <orderedgoalsplanner/types/derivedpredicate.hpp>
+#include <orderedgoalsplanner/types/axiom.hpp>
 #include <orderedgoalsplanner/types/setofentities.hpp>
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 
@@ -22,6 +23,14 @@ DerivedPredicate::DerivedPredicate(const Predicate& pPredicate,
 }
 
 
+DerivedPredicate::DerivedPredicate(const Predicate& pPredicate,
+                                   std::unique_ptr<Condition> pCondition)
+  : predicate(pPredicate),
+    condition(std::move(pCondition))
+{
+}
+
+
 DerivedPredicate::DerivedPredicate(const DerivedPredicate& pDerivedPredicate)
   : predicate(pDerivedPredicate.predicate),
     condition(pDerivedPredicate.condition->clone())
@@ -35,4 +44,24 @@ void DerivedPredicate::operator=(const DerivedPredicate& pDerivedPredicate)
 }
 
 
+Axiom DerivedPredicate::toAxiom() const
+{
+  std::vector<Parameter> vars;
+  std::vector<Entity> arguments;
+  for (const auto& currParam : predicate.parameters)
+  {
+    vars.emplace_back(currParam);
+    arguments.emplace_back(currParam.name, currParam.type);
+  }
+  std::optional<Entity> fluent;
+  if (predicate.fluent)
+  {
+    auto fluentParameter = Parameter::fromType(predicate.fluent);
+    fluent.emplace(fluentParameter.name, fluentParameter.type);
+    vars.emplace_back(std::move(fluentParameter));
+  }
+  return Axiom(condition->clone(), Fact(predicate, std::move(arguments), std::move(fluent), false), vars);
+}
+
+
 } // !ogp
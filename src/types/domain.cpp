@@ -1,7 +1,9 @@
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/condition.hpp>
 #include <orderedgoalsplanner/types/worldstate.hpp>
+#include <orderedgoalsplanner/util/trace.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
+#include "../util/plannerstatsrecorder.hpp"
 #include "../util/uuid.hpp"
 #include "expressionParsed.hpp"
 
@@ -200,6 +202,10 @@ Domain::Domain()
     _actions(),
     _conditionsToActions(),
     _actionsWithoutFactToAddInPrecondition(),
+    _actionsInterferences(),
+    _actionToInterferencePredicates(),
+    _predicateToModifyingActions(),
+    _predicateToReadingActions(),
     _setOfEvents(),
     _requirements()
 {
@@ -219,6 +225,10 @@ Domain::Domain(const std::map<ActionId, Action>& pActions,
     _actions(),
     _conditionsToActions(),
     _actionsWithoutFactToAddInPrecondition(),
+    _actionsInterferences(),
+    _actionToInterferencePredicates(),
+    _predicateToModifyingActions(),
+    _predicateToReadingActions(),
     _setOfEvents(pIdToSetOfEvents),
     _requirements()
 {
@@ -228,10 +238,49 @@ Domain::Domain(const std::map<ActionId, Action>& pActions,
   if (!pSetOfEvents.empty())
     _setOfEvents.emplace(getSetOfEventsIdFromConstructor(), pSetOfEvents);
 
+  const auto& derivedPredicates = _ontology.derivedPredicates;
+  if (derivedPredicates.isMaterialized() && !derivedPredicates.derivedPredicates().empty())
+    _setOfEvents[getSetOfEventsIdFromDerivedPredicates()] = derivedPredicates.toSetOfEvents(_ontology);
+
   _updateSuccessions();
 }
 
 
+Domain Domain::fromActionsWithSuccessionCaches(const std::map<ActionId, Action>& pActions,
+                                               const Ontology& pOntology,
+                                               const std::map<SetOfEventsId, SetOfEvents>& pIdToSetOfEvents,
+                                               const SetOfConstFacts& pTimelessFacts,
+                                               const std::string& pName)
+{
+  Domain res;
+  res._uuid = generateUuid();
+  res._name = pName;
+  res._ontology = pOntology;
+  res._timelessFacts = pTimelessFacts;
+  res._setOfEvents = pIdToSetOfEvents;
+
+  for (const auto& currAction : pActions)
+  {
+    res._addAction(currAction.first, currAction.second);
+    auto it = res._actions.find(currAction.first);
+    if (it == res._actions.end())
+      continue;
+    // The effects keep their successions when they are cloned, but not the action
+    Action& action = it->second;
+    action.actionsSuccessionsWithoutInterestCache = currAction.second.actionsSuccessionsWithoutInterestCache;
+    action.actionsPredecessorsCache = currAction.second.actionsPredecessorsCache;
+    action.eventsPredecessorsCache = currAction.second.eventsPredecessorsCache;
+    if (action.canThisActionBeUsedByThePlanner)
+      action.updatePreconditionProgramCache();
+  }
+
+  for (auto& currSetOfEvents : res._setOfEvents)
+    for (auto& currEvent : currSetOfEvents.second.events())
+      currEvent.second.updatePreconditionProgramCache();
+  return res;
+}
+
+
 void Domain::addAction(const ActionId& pActionId,
                        const Action& pAction)
 {
@@ -275,6 +324,7 @@ void Domain::_addAction(const ActionId& pActionId,
 
   if (!hasAddedAFact)
     _actionsWithoutFactToAddInPrecondition.addValueWithoutFact(pActionId);
+  _addActionInterferences(pActionId, action);
 }
 
 void Domain::removeAction(const ActionId& pActionId)
@@ -289,11 +339,116 @@ void Domain::removeAction(const ActionId& pActionId)
     _conditionsToActions.erase(pActionId);
   else
     _actionsWithoutFactToAddInPrecondition.erase(pActionId);
+  _removeActionInterferences(pActionId);
 
   _actions.erase(it);
   _updateSuccessions();
 }
 
+bool Domain::canActionsInterfere(const ActionInvocation& pFirstActionInvocation,
+                                 const ActionInvocation& pSecondActionInvocation) const
+{
+  bool isSwapped = pSecondActionInvocation.actionId < pFirstActionInvocation.actionId;
+  const auto& firstActionInvocation = isSwapped ? pSecondActionInvocation : pFirstActionInvocation;
+  const auto& secondActionInvocation = isSwapped ? pFirstActionInvocation : pSecondActionInvocation;
+  auto itFirstPredicates = _actionToInterferencePredicates.find(firstActionInvocation.actionId);
+  auto itSecondPredicates = _actionToInterferencePredicates.find(secondActionInvocation.actionId);
+  if (itFirstPredicates == _actionToInterferencePredicates.end() ||
+      itSecondPredicates == _actionToInterferencePredicates.end() ||
+      itFirstPredicates->second.canAlwaysInterfere ||
+      itSecondPredicates->second.canAlwaysInterfere)
+    return true;
+  auto it = _actionsInterferences.find(std::make_pair(firstActionInvocation.actionId, secondActionInvocation.actionId));
+  if (it == _actionsInterferences.end())
+    return false;
+  return it->second.canInterfere(firstActionInvocation.parameters, secondActionInvocation.parameters);
+}
+
+
+std::set<ActionId> Domain::_actionsSharingAPredicate(const ActionsInterference::Predicates& pPredicates) const
+{
+  std::set<ActionId> res;
+  auto addActions = [&](const std::map<std::string, std::set<ActionId>>& pPredicateToActions,
+                        const std::set<std::string>& pPredicateNames) {
+    for (const auto& currPredicateName : pPredicateNames)
+    {
+      auto it = pPredicateToActions.find(currPredicateName);
+      if (it != pPredicateToActions.end())
+        res.insert(it->second.begin(), it->second.end());
+    }
+  };
+  addActions(_predicateToModifyingActions, pPredicates.modifiedPredicates);
+  addActions(_predicateToReadingActions, pPredicates.modifiedPredicates);
+  addActions(_predicateToModifyingActions, pPredicates.conditionPredicates);
+  return res;
+}
+
+
+void Domain::_addActionInterferences(const ActionId& pActionId,
+                                     const Action& pAction)
+{
+  auto& predicates = _actionToInterferencePredicates[pActionId];
+  predicates = ActionsInterference::extractPredicates(pAction);
+  for (const auto& currPredicateName : predicates.modifiedPredicates)
+    _predicateToModifyingActions[currPredicateName].insert(pActionId);
+  for (const auto& currPredicateName : predicates.conditionPredicates)
+    _predicateToReadingActions[currPredicateName].insert(pActionId);
+  if (predicates.canAlwaysInterfere)
+    return;
+
+  // Only the row of the new action is computed, the other pairs are not impacted
+  for (const auto& currOtherActionId : _actionsSharingAPredicate(predicates))
+  {
+    auto itOtherPredicates = _actionToInterferencePredicates.find(currOtherActionId);
+    auto itOtherAction = _actions.find(currOtherActionId);
+    if (itOtherPredicates == _actionToInterferencePredicates.end() ||
+        itOtherPredicates->second.canAlwaysInterfere ||
+        itOtherAction == _actions.end())
+      continue;
+    bool isSwapped = currOtherActionId < pActionId;
+    const auto& firstActionId = isSwapped ? currOtherActionId : pActionId;
+    const auto& secondActionId = isSwapped ? pActionId : currOtherActionId;
+    auto interference = isSwapped ? ActionsInterference::compute(itOtherAction->second, pAction) :
+                                    ActionsInterference::compute(pAction, itOtherAction->second);
+    if (interference.kind != ActionsInterference::Kind::NEVER)
+      _actionsInterferences.emplace(std::make_pair(firstActionId, secondActionId), std::move(interference));
+  }
+}
+
+
+void Domain::_removeActionInterferences(const ActionId& pActionId)
+{
+  auto itPredicates = _actionToInterferencePredicates.find(pActionId);
+  if (itPredicates == _actionToInterferencePredicates.end())
+    return;
+  const auto& predicates = itPredicates->second;
+
+  for (const auto& currOtherActionId : _actionsSharingAPredicate(predicates))
+  {
+    if (currOtherActionId < pActionId)
+      _actionsInterferences.erase(std::make_pair(currOtherActionId, pActionId));
+    else
+      _actionsInterferences.erase(std::make_pair(pActionId, currOtherActionId));
+  }
+
+  auto removeFromIndex = [&](std::map<std::string, std::set<ActionId>>& pPredicateToActions,
+                             const std::set<std::string>& pPredicateNames) {
+    for (const auto& currPredicateName : pPredicateNames)
+    {
+      auto it = pPredicateToActions.find(currPredicateName);
+      if (it == pPredicateToActions.end())
+        continue;
+      it->second.erase(pActionId);
+      if (it->second.empty())
+        pPredicateToActions.erase(it);
+    }
+  };
+  removeFromIndex(_predicateToModifyingActions, predicates.modifiedPredicates);
+  removeFromIndex(_predicateToReadingActions, predicates.conditionPredicates);
+  _actionToInterferencePredicates.erase(itPredicates);
+}
+
+
 const Action* Domain::getActionPtr(const ActionId& pActionId) const
 {
   auto it = _actions.find(pActionId);
@@ -389,6 +544,8 @@ void Domain::addRequirement(const std::string& pRequirement)
 
 void Domain::_updateSuccessions()
 {
+  TraceSpan traceSpan("Domain::_updateSuccessions");
+  ORDEREDGOALSPLANNER_ALLOCATION_PHASE(DOMAIN_PREPROCESSING);
   std::map<ActionId, ActionWithConditionAndFactFacts> actionTmpData;
   std::map<FullEventId, EventWithTmpData> eventTmpData;
 
@@ -528,5 +685,12 @@ const std::string& Domain::getSetOfEventsIdFromConstructor()
 }
 
 
+const std::string& Domain::getSetOfEventsIdFromDerivedPredicates()
+{
+  static const std::string setOfEventsIdFromDerivedPredicates = "soe_from_derived_predicates";
+  return setOfEventsIdFromDerivedPredicates;
+}
+
+
 
 } // !ogp
@@ -15,21 +15,32 @@ const std::string _anyValue = "*";
 }
 
 Entity::Entity(const std::string& pValue,
-               const std::shared_ptr<Type>& pType)
+               const Type* pType)
  : value(pValue),
-   type(pType)
+   type(pType),
+   number(tryToConvertToNumber(pValue))
+{
+}
+
+Entity::Entity(const Number& pNumber,
+               const Type* pType)
+ : value(numberToString(pNumber)),
+   type(pType),
+   number(pNumber)
 {
 }
 
 Entity::Entity(Entity&& pOther) noexcept
   : value(std::move(pOther.value)),
-    type(pOther.type) {
+    type(pOther.type),
+    number(pOther.number) {
 }
 
 
 Entity& Entity::operator=(Entity&& pOther) noexcept {
     value = std::move(pOther.value);
     type = pOther.type;
+    number = pOther.number;
     return *this;
 }
 
@@ -70,6 +81,12 @@ Entity Entity::createNumberEntity(const std::string& pNumber)
 }
 
 
+Entity Entity::createNumberEntity(const Number& pNumber)
+{
+  return Entity(pNumber, SetOfTypes::numberType());
+}
+
+
 Entity Entity::fromDeclaration(const std::string& pStr,
                                const SetOfTypes& pSetOfTypes)
 {
@@ -175,5 +192,12 @@ bool Entity::isValidParameterAccordingToPossiblities(const std::vector<Parameter
 }
 
 
+void Entity::setValue(const std::string& pValue)
+{
+  value = pValue;
+  number = tryToConvertToNumber(pValue);
+}
+
+
 
 } // !ogp
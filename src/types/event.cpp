@@ -1,4 +1,5 @@
 #include <orderedgoalsplanner/types/event.hpp>
+#include <orderedgoalsplanner/types/conditionprogram.hpp>
 
 namespace ogp
 {
@@ -13,7 +14,8 @@ Event::Event(std::unique_ptr<Condition> pPrecondition,
     factsToModify(pFactsToModify ? std::move(pFactsToModify) : std::unique_ptr<WorldStateModification>()),
     goalsToAdd(pGoalsToAdd),
     actionsPredecessorsCache(),
-    eventsPredecessorsCache()
+    eventsPredecessorsCache(),
+    preconditionProgramCache()
 {
   assert(precondition);
   assert(factsToModify || !goalsToAdd.empty());
@@ -31,6 +33,35 @@ void Event::updateSuccessionCache(const Domain& pDomain,
   auto optionalFactsToIgnore = precondition ? precondition->getAllOptFacts() : std::set<FactOptional>();
   if (factsToModify)
     factsToModify->updateSuccesions(pDomain, containerId, optionalFactsToIgnore);
+  updatePreconditionProgramCache();
+}
+
+void Event::updatePreconditionProgramCache()
+{
+  preconditionProgramCache = precondition ? std::make_shared<const ConditionProgram>(*precondition) : nullptr;
+}
+
+
+bool Event::isPreconditionTrue(const WorldState& pWorldState,
+                               const std::set<Fact>& pPunctualFacts,
+                               const std::set<Fact>& pRemovedFacts,
+                               std::map<Parameter, std::set<Entity>>* pParametersToPossibleArgumentsPtr) const
+{
+  if (!precondition)
+    return true;
+  if (preconditionProgramCache)
+    return preconditionProgramCache->isTrue(pWorldState, pPunctualFacts, pRemovedFacts, pParametersToPossibleArgumentsPtr);
+  return precondition->isTrue(pWorldState, pPunctualFacts, pRemovedFacts, pParametersToPossibleArgumentsPtr);
+}
+
+
+bool Event::canPreconditionBecomeTrue(const WorldState& pWorldState) const
+{
+  if (!precondition)
+    return true;
+  if (preconditionProgramCache)
+    return preconditionProgramCache->canBecomeTrue(pWorldState, parameters);
+  return precondition->canBecomeTrue(pWorldState, parameters);
 }
 
 std::string Event::printSuccessionCache() const
@@ -1,4 +1,5 @@
 #include "expressionParsed.hpp"
+#include "expressionParsedView.hpp"
 #include <stdexcept>
 #include <orderedgoalsplanner/types/factoptional.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
@@ -196,7 +197,7 @@ ExpressionParsed ExpressionParsed::fromStr(const std::string& pStr,
 }
 
 
-ExpressionParsed ExpressionParsed::fromPddl(const std::string& pStr,
+ExpressionParsed ExpressionParsed::fromPddl(std::string_view pStr,
                                             std::size_t& pPos,
                                             bool pCanHaveFollowingExpression)
 {
@@ -225,7 +226,7 @@ ExpressionParsed ExpressionParsed::fromPddl(const std::string& pStr,
       {
         if (inName)
         {
-          res.name = pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
+          res.name = std::string(pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos));
           if (res.name.empty())
           {
             res = fromPddl(pStr, pPos, pCanHaveFollowingExpression);
@@ -282,21 +283,13 @@ ExpressionParsed ExpressionParsed::fromPddl(const std::string& pStr,
   return res;
 }
 
-void ExpressionParsed::skipSpaces(const std::string& pStr,
+void ExpressionParsed::skipSpaces(std::string_view pStr,
                                   std::size_t& pPos)
 {
-  auto strSize = pStr.size();
-  while (pPos < strSize)
-  {
-    if (pStr[pPos] == ';')
-       ExpressionParsed::moveUntilEndOfLine(pStr, pPos);
-    else if (pStr[pPos] != ' ' && pStr[pPos] != '\n' && pStr[pPos] != '\t')
-      break;
-    ++pPos;
-  }
+  ExpressionParsedView::skipSpaces(pStr, pPos);
 }
 
-void ExpressionParsed::skipSpacesWithTagExtraction(const std::string& pStr,
+void ExpressionParsed::skipSpacesWithTagExtraction(std::string_view pStr,
                                                    std::size_t& pPos)
 {
   auto strSize = pStr.size();
@@ -311,20 +304,14 @@ void ExpressionParsed::skipSpacesWithTagExtraction(const std::string& pStr,
 }
 
 
-void ExpressionParsed::moveUntilEndOfLine(const std::string& pStr,
+void ExpressionParsed::moveUntilEndOfLine(std::string_view pStr,
                                           std::size_t& pPos)
 {
-  auto strSize = pStr.size();
-  while (pPos < strSize)
-  {
-    if (pStr[pPos] == '\n')
-      break;
-    ++pPos;
-  }
+  ExpressionParsedView::moveUntilEndOfLine(pStr, pPos);
 }
 
 
-void ExpressionParsed::moveUntilEndOfLineWithTagExtraction(const std::string& pStr,
+void ExpressionParsed::moveUntilEndOfLineWithTagExtraction(std::string_view pStr,
                                                            std::size_t& pPos)
 {
   auto strSize = pStr.size();
@@ -341,7 +328,7 @@ void ExpressionParsed::moveUntilEndOfLineWithTagExtraction(const std::string& pS
     {
       if (beginPos)
       {
-        tags.insert(pStr.substr(*beginPos, pPos - *beginPos));
+        tags.emplace(pStr.substr(*beginPos, pPos - *beginPos));
         beginPos.reset();
       }
     }
@@ -349,7 +336,7 @@ void ExpressionParsed::moveUntilEndOfLineWithTagExtraction(const std::string& pS
     {
       if (beginPos)
       {
-        tags.insert(pStr.substr(*beginPos, pPos - *beginPos));
+        tags.emplace(pStr.substr(*beginPos, pPos - *beginPos));
         beginPos.reset();
       }
       break;
@@ -358,11 +345,11 @@ void ExpressionParsed::moveUntilEndOfLineWithTagExtraction(const std::string& pS
   }
 
   if (beginPos)
-    tags.insert(pStr.substr(*beginPos, strSize - *beginPos));
+    tags.emplace(pStr.substr(*beginPos, strSize - *beginPos));
 }
 
 
-void ExpressionParsed::moveUntilClosingParenthesis(const std::string& pStr,
+void ExpressionParsed::moveUntilClosingParenthesis(std::string_view pStr,
                                                    std::size_t& pPos)
 {
   auto strSize = pStr.size();
@@ -375,7 +362,7 @@ void ExpressionParsed::moveUntilClosingParenthesis(const std::string& pStr,
 }
 
 
-std::string ExpressionParsed::parseToken(const std::string& pStr,
+std::string ExpressionParsed::parseToken(std::string_view pStr,
                                          std::size_t& pPos)
 {
   std::size_t beginOfTokenPos = pPos;
@@ -383,41 +370,16 @@ std::string ExpressionParsed::parseToken(const std::string& pStr,
   if (res.empty())
   {
     auto strSize = pStr.size();
-    throw std::runtime_error("Empty token in str " + pStr.substr(beginOfTokenPos, strSize - beginOfTokenPos));
+    throw std::runtime_error("Empty token in str " + std::string(pStr.substr(beginOfTokenPos, strSize - beginOfTokenPos)));
   }
   return res;
 }
 
 
-std::string ExpressionParsed::parseTokenThatCanBeEmpty(const std::string& pStr,
+std::string ExpressionParsed::parseTokenThatCanBeEmpty(std::string_view pStr,
                                                        std::size_t& pPos)
 {
-  auto strSize = pStr.size();
-  skipSpaces(pStr, pPos);
-  std::string res = "";
-  std::size_t beginOfTokenPos = pPos;
-  while (pPos < strSize)
-  {
-    if (pStr[pPos] == ';')
-    {
-      res = pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
-      ExpressionParsed::moveUntilEndOfLine(pStr, pPos);
-      ++pPos;
-      return res;
-    }
-
-    if (isEndOfTokenSeparator(pStr[pPos]))
-    {
-      res = pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
-      break;
-    }
-    ++pPos;
-  }
-  if (res.empty())
-  {
-    res = pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
-  }
-  return res;
+  return std::string(ExpressionParsedView::parseTokenThatCanBeEmpty(pStr, pPos));
 }
 
 
@@ -5,6 +5,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ogp
@@ -41,29 +42,29 @@ struct ExpressionParsed
   static ExpressionParsed fromStr(const std::string& pStr,
                                   std::size_t& pPos);
 
-  static ExpressionParsed fromPddl(const std::string& pStr,
+  static ExpressionParsed fromPddl(std::string_view pStr,
                                    std::size_t& pPos,
                                    bool pCanHaveFollowingExpression);
 
-  static void skipSpaces(const std::string& pStr,
+  static void skipSpaces(std::string_view pStr,
                          std::size_t& pPos);
 
-  void skipSpacesWithTagExtraction(const std::string& pStr,
+  void skipSpacesWithTagExtraction(std::string_view pStr,
                                    std::size_t& pPos);
 
-  static void moveUntilEndOfLine(const std::string& pStr,
+  static void moveUntilEndOfLine(std::string_view pStr,
                                  std::size_t& pPos);
 
-  void moveUntilEndOfLineWithTagExtraction(const std::string& pStr,
+  void moveUntilEndOfLineWithTagExtraction(std::string_view pStr,
                                            std::size_t& pPos);
 
-  static void moveUntilClosingParenthesis(const std::string& pStr,
+  static void moveUntilClosingParenthesis(std::string_view pStr,
                                           std::size_t& pPos);
 
-  static std::string parseToken(const std::string& pStr,
+  static std::string parseToken(std::string_view pStr,
                                 std::size_t& pPos);
 
-  static std::string parseTokenThatCanBeEmpty(const std::string& pStr,
+  static std::string parseTokenThatCanBeEmpty(std::string_view pStr,
                                               std::size_t& pPos);
 
   static bool isEndOfTokenSeparator(char pChar);
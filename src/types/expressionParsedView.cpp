@@ -0,0 +1,153 @@
+#include "expressionParsedView.hpp"
+#include <stdexcept>
+#include <string>
+#include "../util/parsingarena.hpp"
+
+namespace ogp
+{
+
+namespace
+{
+
+bool _isEndOfTokenSeparator(char pChar)
+{
+  return pChar == ' ' || pChar == '\n' || pChar == ')' || pChar == '(';
+}
+
+void _addArgument(ExpressionParsedView& pExpression,
+                  ExpressionParsedView*& pLastArgument,
+                  ExpressionParsedView* pArgument)
+{
+  if (pLastArgument == nullptr)
+    pExpression.firstArgument = pArgument;
+  else
+    pLastArgument->nextArgument = pArgument;
+  pLastArgument = pArgument;
+  ++pExpression.nbOfArguments;
+}
+
+}
+
+
+const ExpressionParsedView* ExpressionParsedView::lastArgument() const
+{
+  const ExpressionParsedView* res = firstArgument;
+  while (res != nullptr && res->nextArgument != nullptr)
+    res = res->nextArgument;
+  return res;
+}
+
+
+ExpressionParsedView* ExpressionParsedView::fromPddl(std::string_view pStr,
+                                                     std::size_t& pPos,
+                                                     ParsingArena& pArena)
+{
+  auto* res = pArena.make<ExpressionParsedView>();
+  auto strSize = pStr.size();
+  skipSpaces(pStr, pPos);
+  if (pPos >= strSize)
+    return res;
+
+  if (pStr[pPos] == '(')
+  {
+    ++pPos;
+    skipSpaces(pStr, pPos);
+    std::size_t beginOfTokenPos = pPos;
+    ExpressionParsedView* lastArgument = nullptr;
+
+    bool inName = true;
+    while (pPos < strSize)
+    {
+      if (pStr[pPos] == ';')
+      {
+        skipSpaces(pStr, pPos);
+        beginOfTokenPos = pPos;
+      }
+
+      if (!inName || _isEndOfTokenSeparator(pStr[pPos]))
+      {
+        if (inName)
+        {
+          res->name = pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
+          if (res->name.empty())
+            return fromPddl(pStr, pPos, pArena);
+          skipSpaces(pStr, pPos);
+          inName = false;
+          continue;
+        }
+
+        if (pStr[pPos] == ')')
+        {
+          ++pPos;
+          break;
+        }
+
+        auto prePos = pPos;
+        _addArgument(*res, lastArgument, fromPddl(pStr, pPos, pArena));
+        if (pPos > prePos)
+          continue;
+      }
+      ++pPos;
+    }
+  }
+  else
+  {
+    std::size_t beginOfTokenPos = pPos;
+    res->name = parseTokenThatCanBeEmpty(pStr, pPos);
+    if (res->name.empty())
+      throw std::runtime_error("Empty token in str " + std::string(pStr.substr(beginOfTokenPos)));
+  }
+
+  skipSpaces(pStr, pPos);
+  return res;
+}
+
+
+void ExpressionParsedView::skipSpaces(std::string_view pStr,
+                                      std::size_t& pPos)
+{
+  auto strSize = pStr.size();
+  while (pPos < strSize)
+  {
+    if (pStr[pPos] == ';')
+      moveUntilEndOfLine(pStr, pPos);
+    else if (pStr[pPos] != ' ' && pStr[pPos] != '\n' && pStr[pPos] != '\t')
+      break;
+    ++pPos;
+  }
+}
+
+
+void ExpressionParsedView::moveUntilEndOfLine(std::string_view pStr,
+                                              std::size_t& pPos)
+{
+  auto endOfLinePos = pStr.find('\n', pPos);
+  pPos = endOfLinePos != std::string_view::npos ? endOfLinePos : pStr.size();
+}
+
+
+std::string_view ExpressionParsedView::parseTokenThatCanBeEmpty(std::string_view pStr,
+                                                                std::size_t& pPos)
+{
+  auto strSize = pStr.size();
+  skipSpaces(pStr, pPos);
+  std::size_t beginOfTokenPos = pPos;
+  while (pPos < strSize)
+  {
+    if (pStr[pPos] == ';')
+    {
+      auto res = pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
+      moveUntilEndOfLine(pStr, pPos);
+      ++pPos;
+      return res;
+    }
+
+    if (_isEndOfTokenSeparator(pStr[pPos]))
+      break;
+    ++pPos;
+  }
+  return pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
+}
+
+
+} // !ogp
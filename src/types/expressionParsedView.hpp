@@ -0,0 +1,55 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_EXPRESSION_PARSED_VIEW_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_EXPRESSION_PARSED_VIEW_HPP
+
+#include <cstddef>
+#include <string_view>
+
+namespace ogp
+{
+class ParsingArena;
+
+
+/**
+ * Light version of ExpressionParsed for the PDDL format.<br/>
+ * The names are views over the source buffer and the nodes are allocated in a ParsingArena,
+ * so that parsing a big list of facts does not allocate per token.<br/>
+ * The source buffer and the arena have to outlive the parsed tree.
+ */
+struct ExpressionParsedView
+{
+  std::string_view name;
+  ExpressionParsedView* firstArgument = nullptr;
+  ExpressionParsedView* nextArgument = nullptr;
+  std::size_t nbOfArguments = 0;
+
+  bool empty() const { return name.empty(); }
+
+  /// Get the last argument or nullptr if there is no argument.
+  const ExpressionParsedView* lastArgument() const;
+
+  /**
+   * @brief Parse a PDDL expression without following expression (ex: "(pred a b)", "(not (pred a))", "a").
+   * @param[in] pStr Source buffer.
+   * @param[in, out] pPos Position where to start the parsing, set to the position after the expression at the end.
+   * @param[in] pArena Arena where to allocate the nodes.
+   * @return Root of the parsed expression, allocated in pArena.
+   */
+  static ExpressionParsedView* fromPddl(std::string_view pStr,
+                                        std::size_t& pPos,
+                                        ParsingArena& pArena);
+
+  static void skipSpaces(std::string_view pStr,
+                         std::size_t& pPos);
+
+  static void moveUntilEndOfLine(std::string_view pStr,
+                                 std::size_t& pPos);
+
+  static std::string_view parseTokenThatCanBeEmpty(std::string_view pStr,
+                                                   std::size_t& pPos);
+};
+
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_EXPRESSION_PARSED_VIEW_HPP
@@ -3,6 +3,8 @@
 #include <memory>
 #include <assert.h>
 #include <optional>
+#include <ostream>
+#include <sstream>
 #include <stdexcept>
 #include <orderedgoalsplanner/types/factoptional.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
@@ -10,6 +12,8 @@
 #include <orderedgoalsplanner/types/setoffacts.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 #include "expressionParsed.hpp"
+#include "expressionParsedView.hpp"
+#include "../util/parsingarena.hpp"
 
 namespace ogp
 {
@@ -73,7 +77,7 @@ bool _isInside(const Entity& pEntity,
 
 }
 
-Fact::Fact(const std::string& pStr,
+Fact::Fact(std::string_view pStr,
            bool pStrPddlFormated,
            const Ontology& pOntology,
            const SetOfEntities& pEntities,
@@ -92,73 +96,98 @@ Fact::Fact(const std::string& pStr,
   std::size_t pos = pBeginPos;
   try
   {
-    auto expressionParsed = pStrPddlFormated ?
-        ExpressionParsed::fromPddl(pStr, pos, false) :
-        ExpressionParsed::fromStr(pStr, pos);
-    if (!pStrPddlFormated)
+    if (pStrPddlFormated)
     {
-      if (!expressionParsed.name.empty() && expressionParsed.name[0] == '!')
+      // The PDDL facts can be numerous (ex: init section of a problem) so they are parsed without copying the tokens
+      thread_local ParsingArena arena;
+      arena.reset();
+      const auto* expressionParsedPtr = ExpressionParsedView::fromPddl(pStr, pos, arena);
+      if (expressionParsedPtr->name == "not" && expressionParsedPtr->nbOfArguments == 1)
       {
         if (pIsFactNegatedPtr != nullptr)
            *pIsFactNegatedPtr = true;
-        _name = expressionParsed.name.substr(1, expressionParsed.name.size() - 1);
+        expressionParsedPtr = expressionParsedPtr->firstArgument;
       }
-      else
+
+      const auto* expressionParsedForArgumentsPtr = expressionParsedPtr;
+      if (expressionParsedPtr->name == "=" && expressionParsedPtr->nbOfArguments == 2)
       {
-        _name = expressionParsed.name;
+        auto fluentStr = std::string(expressionParsedPtr->lastArgument()->name);
+        if (fluentStr == getUndefinedValue().value)
+        {
+          if (pIsFactNegatedPtr != nullptr)
+             *pIsFactNegatedPtr = true;
+          _fluent.emplace(Entity::createAnyEntity());
+        }
+        else
+        {
+          _fluent.emplace(Entity::fromUsage(fluentStr, pOntology, pEntities, pParameters));
+        }
+        expressionParsedForArgumentsPtr = expressionParsedPtr->firstArgument;
       }
+      _name = std::string(expressionParsedForArgumentsPtr->name);
+
+      for (auto* currArgumentPtr = expressionParsedForArgumentsPtr->firstArgument;
+           currArgumentPtr != nullptr; currArgumentPtr = currArgumentPtr->nextArgument)
+        _arguments.push_back(Entity::fromUsage(std::string(currArgumentPtr->name), pOntology, pEntities, pParameters));
     }
     else
     {
-      if (expressionParsed.name == "not" && expressionParsed.arguments.size() == 1)
+      auto expressionParsed = ExpressionParsed::fromStr(std::string(pStr), pos);
+      if (!expressionParsed.name.empty() && expressionParsed.name[0] == '!')
       {
         if (pIsFactNegatedPtr != nullptr)
            *pIsFactNegatedPtr = true;
-        expressionParsed = expressionParsed.arguments.back().clone();
+        _name = expressionParsed.name.substr(1, expressionParsed.name.size() - 1);
+      }
+      else
+      {
+        _name = expressionParsed.name;
       }
-      _name = expressionParsed.name;
-    }
 
-    _isFluentNegated = expressionParsed.isValueNegated;
-    auto* expressionParsedForArgumentsPtr = &expressionParsed;
-    if (_name == "=" && expressionParsed.arguments.size() == 2)
-    {
-      auto fluentStr = expressionParsed.arguments.back().name;
-      if (fluentStr == getUndefinedValue().value)
+      _isFluentNegated = expressionParsed.isValueNegated;
+      auto* expressionParsedForArgumentsPtr = &expressionParsed;
+      if (_name == "=" && expressionParsed.arguments.size() == 2)
       {
-        if (pIsFactNegatedPtr != nullptr)
-           *pIsFactNegatedPtr = true;
-        _fluent.emplace(Entity::createAnyEntity());
+        auto fluentStr = expressionParsed.arguments.back().name;
+        if (fluentStr == getUndefinedValue().value)
+        {
+          if (pIsFactNegatedPtr != nullptr)
+             *pIsFactNegatedPtr = true;
+          _fluent.emplace(Entity::createAnyEntity());
+        }
+        else
+        {
+          _fluent.emplace(Entity::fromUsage(fluentStr, pOntology, pEntities, pParameters));
+        }
+        expressionParsedForArgumentsPtr = &expressionParsed.arguments.front();
+        _name = expressionParsedForArgumentsPtr->name;
       }
-      else
+      else if (expressionParsed.value != "")
       {
-        _fluent.emplace(Entity::fromUsage(fluentStr, pOntology, pEntities, pParameters));
+        _fluent.emplace(Entity::fromUsage(expressionParsed.value, pOntology, pEntities, pParameters));
       }
-      expressionParsedForArgumentsPtr = &expressionParsed.arguments.front();
-      _name = expressionParsedForArgumentsPtr->name;
-    }
-    else if (expressionParsed.value != "")
-    {
-      _fluent.emplace(Entity::fromUsage(expressionParsed.value, pOntology, pEntities, pParameters));
-    }
-
-    for (auto& currArgument : expressionParsedForArgumentsPtr->arguments)
-      _arguments.push_back(Entity::fromUsage(currArgument.name, pOntology, pEntities, pParameters));
 
+      for (auto& currArgument : expressionParsedForArgumentsPtr->arguments)
+        _arguments.push_back(Entity::fromUsage(currArgument.name, pOntology, pEntities, pParameters));
+    }
 
-    predicate = pOntology.predicates.nameToPredicate(_name);
+    // The facts of the materialized derived predicates are in the world state too
+    const auto* derivedPredicatePtr = pOntology.derivedPredicates.nameToPredicatePtr(_name);
+    predicate = derivedPredicatePtr != nullptr && pOntology.predicates.nameToPredicatePtr(_name) == nullptr ?
+          *derivedPredicatePtr : pOntology.predicates.nameToPredicate(_name);
     _finalizeInisilizationAndValidityChecks(pOntology, pEntities, pIsOkIfFluentIsMissing);
     _resetFactSignatureCache();
     if (pResPos != nullptr)
     {
       if (pos <= pBeginPos)
-        throw std::runtime_error("Failed to parse a fact in str " + pStr.substr(pBeginPos, pStr.size() - pBeginPos));
+        throw std::runtime_error("Failed to parse a fact in str " + std::string(pStr.substr(pBeginPos)));
       *pResPos = pos;
     }
   }
   catch (const std::exception& e)
   {
-    throw std::runtime_error(std::string(e.what()) + ". The exception was thrown while parsing fact: \"" + pStr + "\"");
+    throw std::runtime_error(std::string(e.what()) + ". The exception was thrown while parsing fact: \"" + std::string(pStr) + "\"");
   }
 }
 
@@ -197,6 +226,21 @@ Fact::Fact(const std::string& pName,
 }
 
 
+Fact::Fact(const Predicate& pPredicate,
+           std::vector<Entity>&& pArguments,
+           std::optional<Entity>&& pFluent,
+           bool pIsFluentNegated)
+  : predicate(pPredicate),
+    _name(pPredicate.name),
+    _arguments(std::move(pArguments)),
+    _fluent(std::move(pFluent)),
+    _isFluentNegated(pIsFluentNegated),
+    _factSignature()
+{
+  _resetFactSignatureCache();
+}
+
+
 Fact::~Fact()
 {
 }
@@ -562,26 +606,42 @@ void Fact::replaceArguments(const std::map<Parameter, std::set<Entity>>& pCurren
 std::string Fact::toPddl(bool pInEffectContext,
                          bool pPrintAnyFluent) const
 {
-  std::string res = "(" + _name;
-  if (!_arguments.empty())
+  std::ostringstream ss;
+  toPddl(ss, pInEffectContext, pPrintAnyFluent);
+  return ss.str();
+}
+
+void Fact::toPddl(std::ostream& pOs,
+                  bool pInEffectContext,
+                  bool pPrintAnyFluent) const
+{
+  auto writeCall = [&]() {
+    pOs << '(' << _name;
+    for (const auto& currArgument : _arguments)
+      pOs << ' ' << currArgument.value;
+    pOs << ')';
+  };
+
+  if (!_fluent || (!pPrintAnyFluent && _fluent->isAnyValue()))
   {
-    res += " ";
-    _entitiesToValueStr(res, _arguments, " ");
+    writeCall();
+    return;
   }
-  res += ")";
-  if (_fluent)
+
+  if (_isFluentNegated && pInEffectContext)
+    throw std::runtime_error("Fluent should not be negated in effect: " + toStr(pPrintAnyFluent));
+  auto writeFluentCall = [&]() {
+    pOs << (pInEffectContext ? "(assign " : "(= ");
+    writeCall();
+    pOs << ' ' << _fluent->value << ')';
+  };
+  writeFluentCall();
+  if (_isFluentNegated)
   {
-    if (!pPrintAnyFluent && _fluent->isAnyValue())
-      return res;
-    res = (pInEffectContext ? "(assign " : "(= ") + res + " " + _fluent->value + ")";
-    if (_isFluentNegated)
-    {
-      if (pInEffectContext)
-        throw std::runtime_error("Fluent should not be negated in effect: " + toStr(pPrintAnyFluent));
-      res += "(not " + res + ")";
-    }
+    pOs << "(not ";
+    writeFluentCall();
+    pOs << ')';
   }
-  return res;
 }
 
 std::string Fact::toStr(bool pPrintAnyFluent) const
@@ -616,7 +676,7 @@ Fact Fact::fromStr(const std::string& pStr,
 }
 
 
-Fact Fact::fromPddl(const std::string& pStr,
+Fact Fact::fromPddl(std::string_view pStr,
                     const Ontology& pOntology,
                     const SetOfEntities& pEntities,
                     const std::vector<Parameter>& pParameters,
@@ -637,13 +697,13 @@ bool Fact::replaceSomeArgumentsByAny(const std::vector<Parameter>& pArgumentsToR
     {
       if (currFactParam.value == currParam.name)
       {
-        currFactParam.value = Entity::anyEntityValue();
+        currFactParam.setValue(Entity::anyEntityValue());
         res = true;
       }
     }
     if (_fluent && _fluent->value == currParam.name)
     {
-      _fluent->value = Entity::anyEntityValue();
+      _fluent->setValue(Entity::anyEntityValue());
       res = true;
     }
   }
@@ -889,7 +949,7 @@ void Fact::generateSignatureForAllSubTypes(std::list<std::string>& pRes) const
       for (const auto& currSubType : currArg.type->subTypes)
       {
         auto fact = *this;
-        fact.setArgumentType(i, currSubType);
+        fact.setArgumentType(i, currSubType.get());
         fact.generateSignatureForAllSubTypes(pRes);
       }
     }
@@ -901,7 +961,7 @@ void Fact::generateSignatureForAllSubTypes(std::list<std::string>& pRes) const
     for (const auto& currSubType : _fluent->type->subTypes)
     {
       auto fact = *this;
-      fact.setFluentType(currSubType);
+      fact.setFluentType(currSubType.get());
       fact.generateSignatureForAllSubTypes(pRes);
     }
   }
@@ -959,7 +1019,7 @@ void Fact::generateSignatureForSubAndUpperTypes(std::list<std::string>& pRes) co
         for (const auto& currSubType : currArg.type->subTypes)
         {
           auto fact = *this;
-          fact.setArgumentType(i, currSubType);
+          fact.setArgumentType(i, currSubType.get());
           fact.generateSignatureForAllSubTypes(pRes);
         }
       }
@@ -983,7 +1043,7 @@ void Fact::generateSignatureForSubAndUpperTypes(std::list<std::string>& pRes) co
       for (const auto& currSubType : _fluent->type->subTypes)
       {
         auto fact = *this;
-        fact.setFluentType(currSubType);
+        fact.setFluentType(currSubType.get());
         fact.generateSignatureForAllSubTypes(pRes);
       }
     }
@@ -1002,13 +1062,13 @@ void Fact::generateSignatureForSubAndUpperTypes(std::list<std::string>& pRes) co
 
 
 
-void Fact::setArgumentType(std::size_t pIndex, const std::shared_ptr<Type>& pType)
+void Fact::setArgumentType(std::size_t pIndex, const Type* pType)
 {
   _arguments[pIndex].type = pType;
   _resetFactSignatureCache();
 }
 
-void Fact::setFluentType(const std::shared_ptr<Type>& pType)
+void Fact::setFluentType(const Type* pType)
 {
   if (_fluent)
   {
@@ -1027,7 +1087,7 @@ void Fact::setFluent(const std::optional<Entity>& pFluent)
 void Fact::setFluentValue(const std::string& pFluentStr)
 {
   if (_fluent)
-    _fluent->value = pFluentStr;
+    _fluent->setValue(pFluentStr);
   else
     _fluent = Entity(pFluentStr, predicate.fluent);
   _resetFactSignatureCache();
@@ -4,6 +4,7 @@
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 #include <orderedgoalsplanner/util/serializer/serializeinpddl.hpp>
+#include "../util/plannerstatsrecorder.hpp"
 
 namespace ogp
 {
@@ -23,7 +24,8 @@ Goal::Goal(std::unique_ptr<Condition> pObjective,
     _cacheOfActionsThatCanSatisfyThisGoal(),
     _cacheOfEventsIdThatCanSatisfyThisGoal(),
     _cacheOfActionsPredecessors(),
-    _cacheOfEventsPredecessors()
+    _cacheOfEventsPredecessors(),
+    _satisfactionCache()
 {
   assert(_objective);
 }
@@ -34,7 +36,7 @@ Goal::Goal(const Goal& pOther,
            const std::string* pGoalGroupIdPtr)
   : _objective(pOther._objective->clone(pParametersPtr)),
     _maxTimeToKeepInactive(pOther._maxTimeToKeepInactive),
-    _inactiveSince(pOther._inactiveSince ? std::make_unique<std::chrono::steady_clock::time_point>(*pOther._inactiveSince) : std::unique_ptr<std::chrono::steady_clock::time_point>()),
+    _inactiveSince(pOther._inactiveSince),
     _isPersistentIfSkipped(pOther._isPersistentIfSkipped),
     _oneStepTowards(pOther._oneStepTowards),
     _goalGroupId(pGoalGroupIdPtr != nullptr ? *pGoalGroupIdPtr : pOther._goalGroupId),
@@ -42,8 +44,14 @@ Goal::Goal(const Goal& pOther,
     _cacheOfActionsThatCanSatisfyThisGoal(pOther._cacheOfActionsThatCanSatisfyThisGoal),
     _cacheOfEventsIdThatCanSatisfyThisGoal(pOther._cacheOfEventsIdThatCanSatisfyThisGoal),
     _cacheOfActionsPredecessors(pOther._cacheOfActionsPredecessors),
-    _cacheOfEventsPredecessors(pOther._cacheOfEventsPredecessors)
+    _cacheOfEventsPredecessors(pOther._cacheOfEventsPredecessors),
+    _satisfactionCache()
 {
+  // The parameters do not change the predicates of the objective, but they can change its satisfaction
+  if (pParametersPtr == nullptr)
+    _satisfactionCache = pOther._satisfactionCache;
+  else
+    _satisfactionCache.watchedPredicateNames = pOther._satisfactionCache.watchedPredicateNames;
 }
 
 
@@ -64,10 +72,7 @@ void Goal::operator=(const Goal& pOther)
 {
   _objective = pOther._objective->clone();
   _maxTimeToKeepInactive = pOther._maxTimeToKeepInactive;
-  if (pOther._inactiveSince)
-    _inactiveSince = std::make_unique<std::chrono::steady_clock::time_point>(*pOther._inactiveSince);
-  else
-    _inactiveSince.reset();
+  _inactiveSince = pOther._inactiveSince;
   _isPersistentIfSkipped = pOther._isPersistentIfSkipped;
   _oneStepTowards = pOther._oneStepTowards;
   _goalGroupId = pOther._goalGroupId;
@@ -76,6 +81,7 @@ void Goal::operator=(const Goal& pOther)
   _cacheOfEventsIdThatCanSatisfyThisGoal = pOther._cacheOfEventsIdThatCanSatisfyThisGoal;
   _cacheOfActionsPredecessors = pOther._cacheOfActionsPredecessors;
   _cacheOfEventsPredecessors = pOther._cacheOfEventsPredecessors;
+  _satisfactionCache = pOther._satisfactionCache;
 }
 
 bool Goal::operator==(const Goal& pOther) const
@@ -97,21 +103,34 @@ std::unique_ptr<Goal> Goal::clone() const
   return std::make_unique<Goal>(*this);
 }
 
-void Goal::setInactiveSinceIfNotAlreadySet(const std::unique_ptr<std::chrono::steady_clock::time_point>& pInactiveSince)
+bool Goal::setInactiveSinceIfNotAlreadySet(const std::unique_ptr<std::chrono::steady_clock::time_point>& pInactiveSince)
 {
   if (!_inactiveSince && pInactiveSince)
-    _inactiveSince = std::make_unique<std::chrono::steady_clock::time_point>(*pInactiveSince);
+  {
+    _inactiveSince = *pInactiveSince;
+    return true;
+  }
+  return false;
 }
 
 
 bool Goal::isInactiveForTooLong(const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow) const
 {
-  if (_maxTimeToKeepInactive < 0)
-    return false;
   if (_maxTimeToKeepInactive == 0)
     return true;
-  return _inactiveSince && pNow &&
-      std::chrono::duration_cast<std::chrono::seconds>(*pNow - *_inactiveSince).count() > _maxTimeToKeepInactive;
+  auto deadline = getInactivityDeadline();
+  return deadline && pNow && *pNow >= *deadline;
+}
+
+
+std::optional<std::chrono::steady_clock::time_point> Goal::getInactivityDeadline() const
+{
+  if (_maxTimeToKeepInactive <= 0)
+    return {};
+  // The goal is inactive for too long when the number of whole seconds of inactivity exceeds the maximum
+  if (_inactiveSince)
+    return *_inactiveSince + std::chrono::seconds(_maxTimeToKeepInactive + 1);
+  return {};
 }
 
 void Goal::notifyActivity()
@@ -149,7 +168,11 @@ bool Goal::isASimpleFactObjective() const
 void Goal::refreshIfNeeded(const Domain& pDomain)
 {
   if (_uuidOfLastDomainUsedForCache == pDomain.getUuid())
+  {
+    ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfGoalCacheHits);
     return;
+  }
+  ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfGoalCacheMisses);
   _uuidOfLastDomainUsedForCache = pDomain.getUuid();
 
   ConditionsToValue conditionsToValue;
@@ -6,15 +6,27 @@
 #include <orderedgoalsplanner/types/setofevents.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 #include <orderedgoalsplanner/types/lookforanactionoutputinfos.hpp>
+#include <orderedgoalsplanner/util/trace.hpp>
+#include "../util/plannerstatsrecorder.hpp"
 
 
 namespace ogp
 {
+namespace
+{
+/// A goal with a max time to keep inactive of 0 is removed as soon as it is inactive, without waiting for a deadline.
+bool _isRemovedAsSoonAsInactive(const Goal& pGoal)
+{
+  return pGoal.getMaxTimeToKeepInactive() == 0;
+}
+}
+
 
 GoalStack::GoalStack(const GoalStack& pOther)
   : onGoalsChanged(),
     _goals(pOther._goals),
-    _currentGoalPtr(nullptr)
+    _currentGoalPtr(nullptr),
+    _inactivityDeadlines(pOther._inactivityDeadlines)
 {
 }
 
@@ -22,6 +34,7 @@ GoalStack& GoalStack::operator=(const GoalStack& pOther)
 {
   _goals = pOther._goals;
   _currentGoalPtr = nullptr;
+  _inactivityDeadlines = pOther._inactivityDeadlines;
   return *this;
 }
 
@@ -80,6 +93,7 @@ bool GoalStack::_iterateOnGoalsAndRemoveNonPersistent(
   if (pLookForAnActionOutputInfosPtr != nullptr)
     pLookForAnActionOutputInfosPtr->setType(PlannerStepType::FINISHED_ON_SUCCESS);
 
+  const bool canAGoalBeInactiveForTooLong = _canAGoalBeInactiveForTooLong(pNow);
   bool isCurrentlyActiveGoal = true;
   for (auto itGoalsGroup = _goals.end(); itGoalsGroup != _goals.begin(); )
   {
@@ -87,7 +101,9 @@ bool GoalStack::_iterateOnGoalsAndRemoveNonPersistent(
     for (auto itGoal = itGoalsGroup->second.begin(); itGoal != itGoalsGroup->second.end(); )
     {
       // If the goal was inactive for too long we remove it
-      if (!isCurrentlyActiveGoal && itGoal->isInactiveForTooLong(pNow))
+      if (!isCurrentlyActiveGoal &&
+          (canAGoalBeInactiveForTooLong || _isRemovedAsSoonAsInactive(*itGoal)) &&
+          itGoal->isInactiveForTooLong(pNow))
       {
         itGoal = itGoalsGroup->second.erase(itGoal);
         res = true;
@@ -102,6 +118,8 @@ bool GoalStack::_iterateOnGoalsAndRemoveNonPersistent(
         {
           if (pLookForAnActionOutputInfosPtr != nullptr)
             pLookForAnActionOutputInfosPtr->setType(PlannerStepType::IN_PROGRESS);
+          if (canAGoalBeInactiveForTooLong)
+            _refreshInactivityDeadlines();
           return res;
         }
         isCurrentlyActiveGoal = false;
@@ -126,7 +144,8 @@ bool GoalStack::_iterateOnGoalsAndRemoveNonPersistent(
 
       if (itGoal->isPersistent())
       {
-        itGoal->setInactiveSinceIfNotAlreadySet(pNow);
+        if (itGoal->setInactiveSinceIfNotAlreadySet(pNow))
+          _addInactivityDeadline(*itGoal);
         ++itGoal;
       }
       else
@@ -144,6 +163,8 @@ bool GoalStack::_iterateOnGoalsAndRemoveNonPersistent(
   // then we do not consider anymore the previously activited goal as an activated goal
   if (!isCurrentlyActiveGoal)
     _currentGoalPtr = nullptr;
+  if (canAGoalBeInactiveForTooLong)
+    _refreshInactivityDeadlines();
   return res;
 }
 
@@ -167,6 +188,31 @@ int GoalStack::_getCurrentPriority(const WorldState& pWorldState) const
 }
 
 
+bool GoalStack::_canAGoalBeInactiveForTooLong(const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow) const
+{
+  if (_inactivityDeadlines.empty())
+    return false;
+  return pNow && *pNow >= _inactivityDeadlines.top();
+}
+
+
+void GoalStack::_addInactivityDeadline(const Goal& pGoal)
+{
+  auto deadline = pGoal.getInactivityDeadline();
+  if (deadline)
+    _inactivityDeadlines.push(*deadline);
+}
+
+
+void GoalStack::_refreshInactivityDeadlines()
+{
+  _inactivityDeadlines = decltype(_inactivityDeadlines)();
+  for (const auto& currGoalsGroup : _goals)
+    for (const Goal& currGoal : currGoalsGroup.second)
+      _addInactivityDeadline(currGoal);
+}
+
+
 
 
 std::string GoalStack::getCurrentGoalStr() const
@@ -208,6 +254,7 @@ void GoalStack::setGoals(const std::map<int, std::vector<Goal>>& pGoals,
     _currentGoalPtr = nullptr;
     {
       _goals = pGoals;
+      _refreshInactivityDeadlines();
       onGoalsChanged(_goals);
     }
     if (_removeNoStackableGoals(pWorldState, pNow))
@@ -257,6 +304,8 @@ bool GoalStack::_addGoals(const std::map<int, std::vector<Goal>>& pGoals,
   {
     auto& existingGoals = _goals[currGoals.first];
     existingGoals.insert(existingGoals.begin(), currGoals.second.begin(), currGoals.second.end());
+    for (const auto& currGoal : currGoals.second)
+      _addInactivityDeadline(currGoal);
     goalChanged = true;
   }
   if (goalChanged)
@@ -273,6 +322,7 @@ void GoalStack::pushFrontGoal(const Goal& pGoal,
   {
     auto& existingGoals = _goals[pPriority];
     existingGoals.insert(existingGoals.begin(), pGoal);
+    _addInactivityDeadline(pGoal);
     onGoalsChanged(_goals);
   }
   if (_removeNoStackableGoals(pWorldState, pNow))
@@ -287,6 +337,7 @@ void GoalStack::pushBackGoal(const Goal& pGoal,
   {
     auto& existingGoals = _goals[pPriority];
     existingGoals.push_back(pGoal);
+    _addInactivityDeadline(pGoal);
     onGoalsChanged(_goals);
   }
   if (_removeNoStackableGoals(pWorldState, pNow))
@@ -349,6 +400,7 @@ void GoalStack::clearGoals(const WorldState& pWorldState,
     return;
 
   _goals.clear();
+  _refreshInactivityDeadlines();
   _removeNoStackableGoals(pWorldState, pNow);
   onGoalsChanged(_goals);
 }
@@ -410,6 +462,8 @@ std::map<int, std::vector<Goal>> GoalStack::getNotSatisfiedGoals(const WorldStat
 
 void GoalStack::refreshIfNeeded(const Domain& pDomain)
 {
+  TraceSpan traceSpan("GoalStack::refreshIfNeeded");
+  ORDEREDGOALSPLANNER_ALLOCATION_PHASE(CACHE_REFRESH);
   for (auto& currGoalsGroup : _goals)
     for (Goal& currGoal : currGoalsGroup.second)
       currGoal.refreshIfNeeded(pDomain);
@@ -481,6 +535,7 @@ bool GoalStack::_removeNoStackableGoals(const WorldState& pWorldState,
 {
   bool res = false;
   bool firstGoal = true;
+  const bool canAGoalBeInactiveForTooLong = _canAGoalBeInactiveForTooLong(pNow);
   for (auto itGoalsGroup = _goals.end(); itGoalsGroup != _goals.begin(); )
   {
     --itGoalsGroup;
@@ -499,9 +554,11 @@ bool GoalStack::_removeNoStackableGoals(const WorldState& pWorldState,
         continue;
       }
 
-      if (!itGoal->isInactiveForTooLong(pNow))
+      if ((!canAGoalBeInactiveForTooLong && !_isRemovedAsSoonAsInactive(*itGoal)) ||
+          !itGoal->isInactiveForTooLong(pNow))
       {
-        itGoal->setInactiveSinceIfNotAlreadySet(pNow);
+        if (itGoal->setInactiveSinceIfNotAlreadySet(pNow))
+          _addInactivityDeadline(*itGoal);
         ++itGoal;
       }
       else
@@ -515,6 +572,8 @@ bool GoalStack::_removeNoStackableGoals(const WorldState& pWorldState,
       itGoalsGroup = _goals.erase(itGoalsGroup);
   }
 
+  if (canAGoalBeInactiveForTooLong)
+    _refreshInactivityDeadlines();
   return res;
 }
 
@@ -31,6 +31,31 @@ void Historical::_notifyActionDone(const ActionId& pActionId)
 }
 
 
+void Historical::setNbOfTimeAnActionHasAlreadyBeenDone(const ActionId& pActionId,
+                                                       std::size_t pNbOfTimes)
+{
+  if (_mutexPtr)
+  {
+    std::lock_guard<std::mutex> lock(*_mutexPtr);
+    _setNbOfTimeAnActionHasAlreadyBeenDone(pActionId, pNbOfTimes);
+  }
+  else
+  {
+    _setNbOfTimeAnActionHasAlreadyBeenDone(pActionId, pNbOfTimes);
+  }
+}
+
+
+void Historical::_setNbOfTimeAnActionHasAlreadyBeenDone(const ActionId& pActionId,
+                                                        std::size_t pNbOfTimes)
+{
+  if (pNbOfTimes == 0)
+    _actionToNumberOfTimeAleardyDone.erase(pActionId);
+  else
+    _actionToNumberOfTimeAleardyDone[pActionId] = pNbOfTimes;
+}
+
+
 bool Historical::hasActionAlreadyBeenDone(const ActionId& pActionId) const
 {
   if (_mutexPtr)
@@ -51,6 +76,16 @@ std::size_t Historical::getNbOfTimeAnActionHasAlreadyBeenDone(const ActionId& pA
   return _getNbOfTimeAnActionHasAlreadyBeenDone(pActionId);
 }
 
+std::map<ActionId, std::size_t> Historical::getActionsAlreadyDone() const
+{
+  if (_mutexPtr)
+  {
+    std::lock_guard<std::mutex> lock(*_mutexPtr);
+    return _actionToNumberOfTimeAleardyDone;
+  }
+  return _actionToNumberOfTimeAleardyDone;
+}
+
 bool Historical::_hasActionAlreadyBeenDone(const ActionId& pActionId) const
 {
   return _actionToNumberOfTimeAleardyDone.count(pActionId) > 0;
@@ -9,7 +9,8 @@ LookForAnActionOutputInfos::LookForAnActionOutputInfos()
    _nbOfNonPersistentGoalsNotSatisfied(0),
    _goalsSatisfied(),
    _persistentGoalsSatisfied(),
-   _firstGoalInSuccess()
+   _firstGoalInSuccess(),
+   _stats()
 {
 }
 
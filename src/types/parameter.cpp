@@ -10,7 +10,7 @@ namespace ogp
 
 
 Parameter::Parameter(const std::string& pName,
-                     const std::shared_ptr<Type>& pType)
+                     const Type* pType)
   : name(pName),
     type(pType)
 {
@@ -63,7 +63,7 @@ Parameter Parameter::fromStr(const std::string& pStr,
   throw std::runtime_error("\"" + pStr + "\" parameter should declare a type");
 }
 
-Parameter Parameter::fromType(const std::shared_ptr<Type>& pType)
+Parameter Parameter::fromType(const Type* pType)
 {
   return Parameter("?" + pType->name, pType);
 }
@@ -0,0 +1,210 @@
+#include <orderedgoalsplanner/types/plannerstats.hpp>
+#include <algorithm>
+#include "../util/plannerstatsrecorder.hpp"
+
+
+namespace ogp
+{
+namespace
+{
+
+double _hitRate(std::size_t pNbOfHits, std::size_t pNbOfMisses)
+{
+  auto nbOfAccesses = pNbOfHits + pNbOfMisses;
+  if (nbOfAccesses == 0)
+    return 0.;
+  return static_cast<double>(pNbOfHits) / static_cast<double>(nbOfAccesses);
+}
+
+#ifdef ORDEREDGOALSPLANNER_ENABLE_STATS
+thread_local std::size_t _lookForAPossibleEffectDepth = 0;
+#endif
+
+}
+
+
+std::string plannerPhaseToStr(PlannerPhase pPlannerPhase)
+{
+  switch (pPlannerPhase)
+  {
+  case PlannerPhase::OTHER:
+    return "other";
+  case PlannerPhase::PARSING:
+    return "parsing";
+  case PlannerPhase::DOMAIN_PREPROCESSING:
+    return "domain preprocessing";
+  case PlannerPhase::CACHE_REFRESH:
+    return "cache refresh";
+  case PlannerPhase::PLANNING:
+    return "planning";
+  case PlannerPhase::LOOKAHEAD:
+    return "lookahead";
+  case PlannerPhase::PROBLEM_COPY:
+    return "problem copy";
+  case PlannerPhase::EVENT_PROPAGATION:
+    return "event propagation";
+  case PlannerPhase::PARALLELISATION:
+    return "parallelisation";
+  }
+  return "";
+}
+
+
+bool PlannerStats::isEnabled()
+{
+#ifdef ORDEREDGOALSPLANNER_ENABLE_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+bool PlannerStats::isAllocationAccountingEnabled()
+{
+#ifdef ORDEREDGOALSPLANNER_ENABLE_ALLOCATION_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+void PlannerStats::add(const PlannerStats& pOther)
+{
+  nbOfCandidateActions += pOther.nbOfCandidateActions;
+  nbOfLookForAPossibleEffectCalls += pOther.nbOfLookForAPossibleEffectCalls;
+  maxLookForAPossibleEffectDepth = std::max(maxLookForAPossibleEffectDepth, pOther.maxLookForAPossibleEffectDepth);
+  nbOfPlanCostLookaheads += pOther.nbOfPlanCostLookaheads;
+  nbOfProblemCopies += pOther.nbOfProblemCopies;
+  nbOfConditionEvaluations += pOther.nbOfConditionEvaluations;
+  nbOfEventsFired += pOther.nbOfEventsFired;
+  nbOfGoalCacheHits += pOther.nbOfGoalCacheHits;
+  nbOfGoalCacheMisses += pOther.nbOfGoalCacheMisses;
+  nbOfWorldStateCacheHits += pOther.nbOfWorldStateCacheHits;
+  nbOfWorldStateCacheMisses += pOther.nbOfWorldStateCacheMisses;
+  for (std::size_t i = 0; i < nbOfPlannerPhases; ++i)
+  {
+    allocationsPerPhase[i].nbOfAllocations += pOther.allocationsPerPhase[i].nbOfAllocations;
+    allocationsPerPhase[i].nbOfBytes += pOther.allocationsPerPhase[i].nbOfBytes;
+  }
+}
+
+
+double PlannerStats::goalCacheHitRate() const
+{
+  return _hitRate(nbOfGoalCacheHits, nbOfGoalCacheMisses);
+}
+
+
+double PlannerStats::worldStateCacheHitRate() const
+{
+  return _hitRate(nbOfWorldStateCacheHits, nbOfWorldStateCacheMisses);
+}
+
+
+PhaseAllocations PlannerStats::totalAllocations() const
+{
+  PhaseAllocations res;
+  for (const auto& currAllocations : allocationsPerPhase)
+  {
+    res.nbOfAllocations += currAllocations.nbOfAllocations;
+    res.nbOfBytes += currAllocations.nbOfBytes;
+  }
+  return res;
+}
+
+
+std::string PlannerStats::toStr() const
+{
+  auto hitRateToStr = [](double pHitRate) {
+    return std::to_string(static_cast<int>(pHitRate * 100. + 0.5)) + "%";
+  };
+  std::string res = "candidate actions: " + std::to_string(nbOfCandidateActions) + "\n" +
+      "look for a possible effect calls: " + std::to_string(nbOfLookForAPossibleEffectCalls) + "\n" +
+      "look for a possible effect max depth: " + std::to_string(maxLookForAPossibleEffectDepth) + "\n" +
+      "plan cost lookaheads: " + std::to_string(nbOfPlanCostLookaheads) + "\n" +
+      "problem copies: " + std::to_string(nbOfProblemCopies) + "\n" +
+      "condition evaluations: " + std::to_string(nbOfConditionEvaluations) + "\n" +
+      "events fired: " + std::to_string(nbOfEventsFired) + "\n" +
+      "goal cache hits: " + std::to_string(nbOfGoalCacheHits) + "/" + std::to_string(nbOfGoalCacheHits + nbOfGoalCacheMisses) +
+      " (" + hitRateToStr(goalCacheHitRate()) + ")\n" +
+      "world state cache hits: " + std::to_string(nbOfWorldStateCacheHits) + "/" + std::to_string(nbOfWorldStateCacheHits + nbOfWorldStateCacheMisses) +
+      " (" + hitRateToStr(worldStateCacheHitRate()) + ")";
+  if (isAllocationAccountingEnabled())
+  {
+    auto allocationsToStr = [](const PhaseAllocations& pAllocations) {
+      return std::to_string(pAllocations.nbOfAllocations) + " (" + std::to_string(pAllocations.nbOfBytes) + " bytes)";
+    };
+    res += "\nallocations: " + allocationsToStr(totalAllocations());
+    for (std::size_t i = 0; i < nbOfPlannerPhases; ++i)
+      if (allocationsPerPhase[i].nbOfAllocations > 0)
+        res += "\n  " + plannerPhaseToStr(static_cast<PlannerPhase>(i)) + ": " + allocationsToStr(allocationsPerPhase[i]);
+  }
+  return res;
+}
+
+
+#ifdef ORDEREDGOALSPLANNER_ENABLE_STATS
+
+PlannerStats*& currentPlannerStatsPtr()
+{
+  thread_local PlannerStats* res = nullptr;
+  return res;
+}
+
+
+PlannerStatsScope::PlannerStatsScope(PlannerStats* pStatsPtr)
+  : _statsPtr(nullptr),
+    _previousStatsPtr(currentPlannerStatsPtr())
+{
+  if (pStatsPtr != nullptr && pStatsPtr != _previousStatsPtr)
+  {
+    _statsPtr = pStatsPtr;
+    currentPlannerStatsPtr() = pStatsPtr;
+  }
+}
+
+
+PlannerStatsScope::~PlannerStatsScope()
+{
+  if (_statsPtr == nullptr)
+    return;
+  currentPlannerStatsPtr() = _previousStatsPtr;
+  if (_previousStatsPtr != nullptr)
+    _previousStatsPtr->add(*_statsPtr);
+}
+
+
+LookForAPossibleEffectDepthScope::LookForAPossibleEffectDepthScope()
+{
+  ++_lookForAPossibleEffectDepth;
+  if (auto* statsPtr = currentPlannerStatsPtr())
+  {
+    ++statsPtr->nbOfLookForAPossibleEffectCalls;
+    statsPtr->maxLookForAPossibleEffectDepth = std::max(statsPtr->maxLookForAPossibleEffectDepth, _lookForAPossibleEffectDepth);
+  }
+}
+
+
+LookForAPossibleEffectDepthScope::~LookForAPossibleEffectDepthScope()
+{
+  --_lookForAPossibleEffectDepth;
+}
+
+#else
+
+PlannerStatsScope::PlannerStatsScope(PlannerStats*)
+  : _statsPtr(nullptr),
+    _previousStatsPtr(nullptr)
+{
+}
+
+
+PlannerStatsScope::~PlannerStatsScope()
+{
+}
+
+#endif // ORDEREDGOALSPLANNER_ENABLE_STATS
+
+} // !ogp
@@ -25,7 +25,7 @@ void _parametersToStr(std::string& pStr,
 
 }
 
-Predicate::Predicate(const std::string& pStr,
+Predicate::Predicate(std::string_view pStr,
                      bool pStrPddlFormated,
                      const SetOfTypes& pSetOfTypes,
                      std::size_t pBeginPos,
@@ -37,7 +37,7 @@ Predicate::Predicate(const std::string& pStr,
   std::size_t pos = pBeginPos;
   auto expressionParsed = pStrPddlFormated ?
         ExpressionParsed::fromPddl(pStr, pos, true) :
-        ExpressionParsed::fromStr(pStr, pos);
+        ExpressionParsed::fromStr(std::string(pStr), pos);
 
   name = expressionParsed.name;
   for (auto& currArg : expressionParsed.arguments)
@@ -53,12 +53,22 @@ Predicate::Predicate(const std::string& pStr,
   if (pResPos != nullptr)
   {
     if (pos <= pBeginPos)
-      throw std::runtime_error("Failed to parse a predicate in str " + pStr.substr(pBeginPos, pStr.size() - pBeginPos));
+      throw std::runtime_error("Failed to parse a predicate in str " + std::string(pStr.substr(pBeginPos)));
     *pResPos = pos;
   }
 }
 
 
+Predicate::Predicate(const std::string& pName,
+                     const std::vector<Parameter>& pParameters,
+                     const Type* pFluent)
+  : name(pName),
+    parameters(pParameters),
+    fluent(pFluent)
+{
+}
+
+
 std::string Predicate::toPddl() const
 {
   std::string res = "(" + name;
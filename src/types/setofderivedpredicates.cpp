@@ -1,12 +1,17 @@
 #include <orderedgoalsplanner/types/setofderivedpredicates.hpp>
 #include <orderedgoalsplanner/types/derivedpredicate.hpp>
+#include <orderedgoalsplanner/types/axiom.hpp>
+#include <orderedgoalsplanner/types/event.hpp>
+#include <orderedgoalsplanner/types/setofentities.hpp>
+#include <orderedgoalsplanner/types/setofevents.hpp>
 
 
 namespace ogp
 {
 
 SetOfDerivedPredicates::SetOfDerivedPredicates()
-    : _nameToDerivedPredicate()
+    : _nameToDerivedPredicate(),
+      _isMaterialized(false)
 {
 }
 
@@ -33,6 +38,8 @@ const Predicate* SetOfDerivedPredicates::nameToPredicatePtr(const std::string& p
 
 std::unique_ptr<Condition> SetOfDerivedPredicates::optFactToConditionPtr(const FactOptional& pFactOptional) const
 {
+  if (_isMaterialized)
+    return {};
   auto it = _nameToDerivedPredicate.find(pFactOptional.fact.name());
   if (it != _nameToDerivedPredicate.end())
   {
@@ -42,4 +49,14 @@ std::unique_ptr<Condition> SetOfDerivedPredicates::optFactToConditionPtr(const F
   return {};
 }
 
+
+SetOfEvents SetOfDerivedPredicates::toSetOfEvents(const Ontology& pOntology) const
+{
+  SetOfEvents res;
+  for (const auto& currNameToDerivedPredicate : _nameToDerivedPredicate)
+    for (auto& currEvent : currNameToDerivedPredicate.second.toAxiom().toEvents(pOntology, {}))
+      res.add(currEvent, currNameToDerivedPredicate.first);
+  return res;
+}
+
 } // !ogp
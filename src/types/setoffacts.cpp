@@ -41,9 +41,18 @@ void _addFluentToExactCall(std::string& pRes,
     pRes += pFact.fluent()->value;
   }
 }
+
+
+bool _hasANumericFluentToIndex(const Fact& pFact)
+{
+  return pFact.fluent() && pFact.fluent()->number && !pFact.isValueNegated();
+}
+
 }
 
 
+const std::multimap<double, const Fact*> SetOfFacts::_emptyNumericIndex;
+
 
 SetOfFacts::SetOfFacts()
  : _facts(),
@@ -54,7 +63,31 @@ SetOfFacts::SetOfFacts()
 }
 
 
-SetOfFacts SetOfFacts::fromPddl(const std::string& pStr,
+SetOfFacts::SetOfFacts(const SetOfFacts& pOther)
+ : _facts(pOther._facts),
+   _exactCallToListsOpt(pOther._exactCallToListsOpt),
+   _exactCallWithoutFluentToListsOpt(pOther._exactCallWithoutFluentToListsOpt),
+   _signatureToLists(pOther._signatureToLists)
+{
+  _rebindNumericIndexesToOwnFacts();
+}
+
+
+SetOfFacts& SetOfFacts::operator=(const SetOfFacts& pOther)
+{
+  if (this != &pOther)
+  {
+    _facts = pOther._facts;
+    _exactCallToListsOpt = pOther._exactCallToListsOpt;
+    _exactCallWithoutFluentToListsOpt = pOther._exactCallWithoutFluentToListsOpt;
+    _signatureToLists = pOther._signatureToLists;
+    _rebindNumericIndexesToOwnFacts();
+  }
+  return *this;
+}
+
+
+SetOfFacts SetOfFacts::fromPddl(std::string_view pStr,
                                 std::size_t& pPos,
                                 const Ontology& pOntology,
                                 const SetOfEntities& pEntities,
@@ -79,7 +112,15 @@ SetOfFacts SetOfFacts::fromPddl(const std::string& pStr,
 
 std::string SetOfFacts::toPddl(std::size_t pIdentation, bool pPrintTimeLessFactsToo) const
 {
-  std::string res;
+  std::ostringstream ss;
+  toPddl(ss, pIdentation, pPrintTimeLessFactsToo);
+  return ss.str();
+}
+
+
+void SetOfFacts::toPddl(std::ostream& pOs, std::size_t pIdentation, bool pPrintTimeLessFactsToo) const
+{
+  const std::string identationStr(pIdentation, ' ');
   bool firstIteration = true;
   for (auto& currFact : _facts)
   {
@@ -88,10 +129,10 @@ std::string SetOfFacts::toPddl(std::size_t pIdentation, bool pPrintTimeLessFacts
     if (firstIteration)
       firstIteration = false;
     else
-      res += "\n";
-    res += std::string(pIdentation, ' ') + currFact.first.toPddl(false, true);
+      pOs << '\n';
+    pOs << identationStr;
+    currFact.first.toPddl(pOs, false, true);
   }
-  return res;
 }
 
 
@@ -141,6 +182,8 @@ void SetOfFacts::add(const Fact& pFact,
       else
         parameterToValues.fluentValueToValues[""].emplace_back(pFact);
     }
+    if (insertionResult.second && _hasANumericFluentToIndex(pFact))
+      parameterToValues.numericFluentToValues.emplace(numberToDouble(*pFact.fluent()->number), &insertionResult.first->first);
   }
 }
 
@@ -152,7 +195,11 @@ bool SetOfFacts::erase(const Fact& pFact)
 
   auto factIt = find(pFact);
   for (const auto& currFact : factIt)
-    return _erase(currFact);
+  {
+    // Copy the fact because _erase removes it from the lists that own currFact.
+    const Fact factToErase = currFact;
+    return _erase(factToErase);
+  }
   return false;
 }
 
@@ -221,6 +268,18 @@ bool SetOfFacts::_erase(const Fact& pFact)
             if (listOfValues.empty())
                parameterToValues.fluentValueToValues.erase(fluentKey);
           }
+          if (_hasANumericFluentToIndex(pFact))
+          {
+            auto range = parameterToValues.numericFluentToValues.equal_range(numberToDouble(*pFact.fluent()->number));
+            for (auto itNumericValue = range.first; itNumericValue != range.second; ++itNumericValue)
+            {
+              if (itNumericValue->second == &it->first)
+              {
+                parameterToValues.numericFluentToValues.erase(itNumericValue);
+                break;
+              }
+            }
+          }
         }
       }
       else
@@ -254,6 +313,49 @@ std::string SetOfFacts::SetOfFactIterator::toStr() const
 }
 
 
+const Fact& SetOfFacts::NumericRange::Iterator::operator*() const
+{
+  return *iter->second;
+}
+
+
+SetOfFacts::NumericRange::Iterator& SetOfFacts::NumericRange::Iterator::operator++()
+{
+  ++iter;
+  return *this;
+}
+
+
+bool SetOfFacts::NumericRange::Iterator::operator==(const Iterator& other) const
+{
+  return iter == other.iter;
+}
+
+
+bool SetOfFacts::NumericRange::Iterator::operator!=(const Iterator& other) const
+{
+  return iter != other.iter;
+}
+
+
+std::string SetOfFacts::NumericRange::toStr() const
+{
+  std::stringstream ss;
+  ss << "[";
+  bool firstElt = true;
+  for (const Fact& currElt : *this)
+  {
+    if (firstElt)
+      firstElt = false;
+    else
+      ss << ", ";
+    ss << currElt;
+  }
+  ss << "]";
+  return ss.str();
+}
+
+
 void SetOfFacts::clear()
 {
   _facts.clear();
@@ -340,6 +442,27 @@ typename SetOfFacts::SetOfFactIterator SetOfFacts::find(const Fact& pFact,
   return SetOfFactIterator(exactMatchPtr);
 }
 
+SetOfFacts::NumericRange SetOfFacts::findInNumericRange(const Fact& pFact,
+                                                       const Number& pNumber,
+                                                       bool pBoolSuperiorOrInferior,
+                                                       bool pCanBeEqual) const
+{
+  auto itParameterToValues = _signatureToLists.find(pFact.factSignature());
+  if (itParameterToValues == _signatureToLists.end())
+    return NumericRange(_emptyNumericIndex.end(), _emptyNumericIndex.end());
+
+  const auto& numericFluentToValues = itParameterToValues->second.numericFluentToValues;
+  auto bound = numberToDouble(pNumber);
+  auto itBegin = numericFluentToValues.begin();
+  auto itEnd = numericFluentToValues.end();
+  if (pBoolSuperiorOrInferior)
+    itBegin = pCanBeEqual ? numericFluentToValues.lower_bound(bound) : numericFluentToValues.upper_bound(bound);
+  else
+    itEnd = pCanBeEqual ? numericFluentToValues.upper_bound(bound) : numericFluentToValues.lower_bound(bound);
+  return NumericRange(itBegin, itEnd);
+}
+
+
 std::optional<Entity> SetOfFacts::getFactFluent(const ogp::Fact& pFact) const
 {
   auto factMatchingInWs = find(pFact, true);
@@ -386,6 +509,15 @@ void SetOfFacts::extractPotentialArgumentsOfAFactParameter(
 }
 
 
+void SetOfFacts::_rebindNumericIndexesToOwnFacts()
+{
+  // The copied indexes still point to the facts of the other set of facts.
+  for (auto& currSignatureToLists : _signatureToLists)
+    for (auto& currNumericValue : currSignatureToLists.second.numericFluentToValues)
+      currNumericValue.second = &_facts.find(*currNumericValue.second)->first;
+}
+
+
 void SetOfFacts::_removeAValueForList(std::list<Fact>& pList,
                                      const Fact& pValue) const
 {
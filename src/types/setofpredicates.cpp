@@ -26,10 +26,10 @@ SetOfPredicates SetOfPredicates::fromStr(const std::string& pStr,
 }
 
 
-SetOfPredicates SetOfPredicates::fromPddl(const std::string& pStr,
+SetOfPredicates SetOfPredicates::fromPddl(std::string_view pStr,
                                           std::size_t& pPos,
                                           const SetOfTypes& pSetOfTypes,
-                                          const std::shared_ptr<Type>& pDefaultFluent)
+                                          const Type* pDefaultFluent)
 {
   auto strSize = pStr.size();
   ExpressionParsed::skipSpaces(pStr, pPos);
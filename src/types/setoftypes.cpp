@@ -10,7 +10,7 @@ namespace ogp
 namespace
 {
 const std::string _numberTypeName = "number";
-const std::shared_ptr<Type> _numberType = std::make_shared<Type>(_numberTypeName);
+Type _numberType(_numberTypeName);
 
 void _removeAfterSemicolon(std::string& str) {
     size_t pos = str.find(';');
@@ -25,7 +25,7 @@ SetOfTypes::SetOfTypes()
     : _types(),
       _nameToType()
 {
-  _nameToType[_numberTypeName] = _numberType;
+  _nameToType[_numberTypeName] = &_numberType;
 }
 
 
@@ -42,7 +42,7 @@ void SetOfTypes::addType(const std::string& pTypeToAdd,
   if (pParentType == "")
   {
     _types.push_back(std::make_shared<Type>(pTypeToAdd));
-    _nameToType[pTypeToAdd] = _types.back();
+    _nameToType[pTypeToAdd] = _types.back().get();
     return;
   }
 
@@ -55,7 +55,7 @@ void SetOfTypes::addType(const std::string& pTypeToAdd,
 
   auto type = std::make_shared<Type>(pTypeToAdd, it->second);
   it->second->subTypes.push_back(type);
-  _nameToType[pTypeToAdd] = it->second->subTypes.back();
+  _nameToType[pTypeToAdd] = it->second->subTypes.back().get();
 }
 
 
@@ -90,7 +90,7 @@ void SetOfTypes::addTypesFromPddl(const std::string& pStr)
   }
 }
 
-std::shared_ptr<Type> SetOfTypes::nameToType(const std::string& pName) const
+const Type* SetOfTypes::nameToType(const std::string& pName) const
 {
   auto it = _nameToType.find(pName);
   if (it != _nameToType.end())
@@ -98,9 +98,9 @@ std::shared_ptr<Type> SetOfTypes::nameToType(const std::string& pName) const
   throw std::runtime_error("\"" + pName + "\" is not a valid type name");
 }
 
-std::shared_ptr<Type> SetOfTypes::numberType()
+const Type* SetOfTypes::numberType()
 {
-  return _numberType;
+  return &_numberType;
 }
 
 
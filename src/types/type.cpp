@@ -5,7 +5,7 @@ namespace ogp
 {
 
 Type::Type(const std::string& pName,
-           const std::shared_ptr<Type>& pParent)
+           const Type* pParent)
     : name(pName),
       parent(pParent),
       subTypes()
@@ -56,8 +56,8 @@ bool Type::operator<(const Type& pOther) const
 }
 
 
-std::shared_ptr<Type> Type::getSmallerType(const std::shared_ptr<Type>& pType1,
-                                           const std::shared_ptr<Type>& pType2)
+const Type* Type::getSmallerType(const Type* pType1,
+                                 const Type* pType2)
 {
   if (!pType1)
     return pType2;
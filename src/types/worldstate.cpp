@@ -1,21 +1,30 @@
 #include <orderedgoalsplanner/types/worldstate.hpp>
+#include <algorithm>
+#include <atomic>
 #include <list>
 #include <orderedgoalsplanner/types/goalstack.hpp>
+#include <orderedgoalsplanner/types/ontology.hpp>
 #include <orderedgoalsplanner/types/actioninvocationwithgoal.hpp>
 #include <orderedgoalsplanner/types/setofcallbacks.hpp>
+#include <orderedgoalsplanner/types/setofentities.hpp>
 #include <orderedgoalsplanner/types/setoffacts.hpp>
 #include <orderedgoalsplanner/types/setofevents.hpp>
 #include <orderedgoalsplanner/types/worldstatemodification.hpp>
+#include <orderedgoalsplanner/util/trace.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 #include "expressionParsed.hpp"
+#include "expressionParsedView.hpp"
 #include "worldstatecache.hpp"
+#include "../util/plannerstatsrecorder.hpp"
 
 namespace ogp
 {
 
 namespace
 {
+/// Next identifier of a history of facts. 0 is kept to mean that there is no history.
+std::atomic<std::uint64_t> _nextHistoryId{1};
 
 bool _isNegatedFactCompatibleWithFacts(
     const Fact& pNegatedFact,
@@ -38,7 +47,10 @@ WorldState::WorldState(const SetOfFacts* pFactsPtr)
     onFactsAdded(),
     onFactsRemoved(),
     _factsMapping(pFactsPtr != nullptr ? *pFactsPtr : SetOfFacts()),
-    _cache(std::make_unique<WorldStateCache>(*this))
+    _cache(std::make_unique<WorldStateCache>(*this)),
+    _historyId(_nextHistoryId++),
+    _version(0),
+    _predicateNameToVersion()
 {
 }
 
@@ -49,7 +61,10 @@ WorldState::WorldState(const WorldState& pOther)
     onFactsAdded(),
     onFactsRemoved(),
     _factsMapping(pOther._factsMapping),
-    _cache(std::make_unique<WorldStateCache>(*this, *pOther._cache))
+    _cache(std::make_unique<WorldStateCache>(*this, *pOther._cache)),
+    _historyId(_nextHistoryId++),
+    _version(0),
+    _predicateNameToVersion()
 {
 }
 
@@ -63,10 +78,11 @@ void WorldState::operator=(const WorldState& pOther)
 {
   _factsMapping = pOther._factsMapping;
   _cache = std::make_unique<WorldStateCache>(*this, *pOther._cache);
+  _resetHistory();
 }
 
 
-bool WorldState::modifyFactsFromPddl(const std::string& pStr,
+bool WorldState::modifyFactsFromPddl(std::string_view pStr,
                                      std::size_t& pPos,
                                      GoalStack& pGoalStack,
                                      const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
@@ -77,7 +93,7 @@ bool WorldState::modifyFactsFromPddl(const std::string& pStr,
                                      bool pCanFactsBeRemoved)
 {
   auto strSize = pStr.size();
-  ExpressionParsed::skipSpaces(pStr, pPos);
+  ExpressionParsedView::skipSpaces(pStr, pPos);
   WhatChanged whatChanged;
 
   while (pPos < strSize && pStr[pPos] != ')')
@@ -91,6 +107,7 @@ bool WorldState::modifyFactsFromPddl(const std::string& pStr,
                 pOntology, pEntities, pNow, pCanFactsBeRemoved);
   }
 
+  // The events are deduced only once all the facts are there, so that they do not see a partial state
   pGoalStack._removeNoStackableGoalsAndNotifyGoalsChanged(*this, pNow);
   bool goalChanged = false;
   _notifyWhatChanged(whatChanged, goalChanged, pGoalStack, pSetOfEvents, pCallbacks,
@@ -112,17 +129,7 @@ void WorldState::applyEffect(const std::map<Parameter, Entity>& pParameters,
   const bool canFactsBeRemoved = true;
   WhatChanged whatChanged;
   if (pEffect)
-  {
-    if (pParameters.empty())
-    {
-      _modify(whatChanged, &*pEffect, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved);
-    }
-    else
-    {
-      auto effect = pEffect->clone(&pParameters);
-      _modify(whatChanged, &*effect, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved);
-    }
-  }
+    _modify(whatChanged, &*pEffect, &pParameters, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved);
 
   _notifyWhatChanged(whatChanged, pGoalChanged, pGoalStack, pSetOfEvents,
                      pCallbacks, pOntology, pEntities, pNow);
@@ -198,6 +205,64 @@ bool WorldState::removeFacts(const FACTS& pFacts,
 }
 
 
+bool WorldState::applyEventsOfASet(const SetOfEventsId& pSetOfEventsId,
+                                   GoalStack& pGoalStack,
+                                   const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
+                                   const SetOfCallbacks& pCallbacks,
+                                   const Ontology& pOntology,
+                                   const SetOfEntities& pEntities,
+                                   const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
+{
+  auto itSetOfEvents = pSetOfEvents.find(pSetOfEventsId);
+  if (itSetOfEvents == pSetOfEvents.end())
+    return false;
+
+  const bool canFactsBeRemoved = true;
+  WhatChanged whatChanged;
+  bool goalChanged = false;
+  for (const auto& currEventIdToEvent : itSetOfEvents->second.events())
+  {
+    const Event& currEvent = currEventIdToEvent.second;
+    // No changed fact gives the possible arguments, so all the entities of the parameter types are tried
+    std::map<Parameter, std::set<Entity>> parametersToValues;
+    for (const auto& currParam : currEvent.parameters)
+    {
+      auto& values = parametersToValues[currParam];
+      if (!currParam.type)
+        continue;
+      auto* constantsPtr = pOntology.constants.typeNameToEntities(currParam.type->name);
+      if (constantsPtr != nullptr)
+        values.insert(constantsPtr->begin(), constantsPtr->end());
+      auto* entitiesPtr = pEntities.typeNameToEntities(currParam.type->name);
+      if (entitiesPtr != nullptr)
+        values.insert(entitiesPtr->begin(), entitiesPtr->end());
+    }
+    std::list<std::map<Parameter, Entity>> parametersToValuePoss;
+    if (parametersToValues.empty())
+      parametersToValuePoss.emplace_back();
+    else
+      unfoldMapWithSet(parametersToValuePoss, parametersToValues);
+
+    for (const auto& currParamsPoss : parametersToValuePoss)
+    {
+      const auto* paramsPossPtr = currParamsPoss.empty() ? nullptr : &currParamsPoss;
+      if (currEvent.precondition && !currEvent.precondition->clone(paramsPossPtr)->isTrue(*this))
+        continue;
+      if (currEvent.factsToModify)
+        _modify(whatChanged, &*currEvent.factsToModify, paramsPossPtr, pGoalStack, pSetOfEvents, pCallbacks,
+                pOntology, pEntities, pNow, canFactsBeRemoved);
+      if (pGoalStack.addGoals(currEvent.goalsToAdd, *this, pNow))
+        goalChanged = true;
+    }
+  }
+
+  pGoalStack._removeNoStackableGoalsAndNotifyGoalsChanged(*this, pNow);
+  _notifyWhatChanged(whatChanged, goalChanged, pGoalStack, pSetOfEvents, pCallbacks,
+                     pOntology, pEntities, pNow);
+  return whatChanged.hasFactsToModifyInTheWorldForSure();
+}
+
+
 template<typename FACTS>
 void WorldState::_addFacts(WhatChanged& pWhatChanged,
                            const FACTS& pFacts,
@@ -278,6 +343,7 @@ void WorldState::_addAFact(WhatChanged& pWhatChanged,
     pWhatChanged.addedFacts.insert(pFact);
     _factsMapping.add(pFact, pCanFactsBeRemoved);
     _cache->notifyAboutANewFact(pFact);
+    _notifyPredicateModified(pFact.name());
   }
 }
 
@@ -296,10 +362,12 @@ void WorldState::_removeAFact(WhatChanged& pWhatChanged,
   pWhatChanged.removedFacts.insert(pFact);
   _factsMapping.erase(pFact);
   _cache->clear();
+  _notifyPredicateModified(pFact.name());
 }
 
 void WorldState::_modify(WhatChanged& pWhatChanged,
                          const WorldStateModification* pWsModifPtr,
+                         const std::map<Parameter, Entity>* pParametersToArgumentPtr,
                          GoalStack& pGoalStack,
                          const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
                          const SetOfCallbacks& pCallbacks,
@@ -320,7 +388,7 @@ void WorldState::_modify(WhatChanged& pWhatChanged,
       factsToRemove.emplace_back(pFactOptional.fact);
     else
       factsToAdd.emplace_back(pFactOptional.fact);
-  }, _factsMapping);
+  }, _factsMapping, pParametersToArgumentPtr);
 
   _addFacts(pWhatChanged, factsToAdd, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, pCanFactsBeRemoved);
   _removeFacts(pWhatChanged, factsToRemove);
@@ -335,10 +403,11 @@ bool WorldState::modify(const WorldStateModification* pWsModifPtr,
                         const Ontology& pOntology,
                         const SetOfEntities& pEntities,
                         const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
-                        bool pCanFactsBeRemoved)
+                        bool pCanFactsBeRemoved,
+                        const std::map<Parameter, Entity>* pParametersToArgumentPtr)
 {
   WhatChanged whatChanged;
-  _modify(whatChanged, pWsModifPtr, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, pCanFactsBeRemoved);
+  _modify(whatChanged, pWsModifPtr, pParametersToArgumentPtr, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, pCanFactsBeRemoved);
   bool goalChanged = false;
   _notifyWhatChanged(whatChanged, goalChanged, pGoalStack, pSetOfEvents, pCallbacks,
                      pOntology, pEntities, pNow);
@@ -358,6 +427,7 @@ void WorldState::setFacts(const std::set<Fact>& pFacts,
   for (const auto& currFact : pFacts)
     _factsMapping.add(currFact);
   _cache->clear();
+  _resetHistory();
   WhatChanged whatChanged;
   pGoalStack._removeNoStackableGoalsAndNotifyGoalsChanged(*this, pNow);
   bool goalChanged = false;
@@ -519,12 +589,43 @@ bool WorldState::isOptionalFactSatisfiedInASpecificContext(const FactOptional& p
 
 bool WorldState::isGoalSatisfied(const Goal& pGoal) const
 {
-  return pGoal.objective().isTrue(*this);
+  auto& satisfactionCache = pGoal._satisfactionCache;
+  if (!satisfactionCache.watchedPredicateNames)
+  {
+    satisfactionCache.watchedPredicateNames.emplace();
+    pGoal.objective().forAll([&](const FactOptional& pFactOptional, bool) {
+      satisfactionCache.watchedPredicateNames->insert(pFactOptional.fact.name());
+      return ContinueOrBreak::CONTINUE;
+    });
+  }
+  else if (satisfactionCache.worldStateHistoryId == _historyId)
+  {
+    bool aWatchedPredicateIsModified = false;
+    for (const auto& currPredicateName : *satisfactionCache.watchedPredicateNames)
+    {
+      auto it = _predicateNameToVersion.find(currPredicateName);
+      if (it != _predicateNameToVersion.end() && it->second > satisfactionCache.worldStateVersion)
+      {
+        aWatchedPredicateIsModified = true;
+        break;
+      }
+    }
+    if (!aWatchedPredicateIsModified)
+    {
+      satisfactionCache.worldStateVersion = _version;
+      return satisfactionCache.isSatisfied;
+    }
+  }
+
+  satisfactionCache.isSatisfied = pGoal.objective().isTrue(*this);
+  satisfactionCache.worldStateHistoryId = _historyId;
+  satisfactionCache.worldStateVersion = _version;
+  return satisfactionCache.isSatisfied;
 }
 
 
 void WorldState::iterateOnMatchingFactsWithoutFluentConsideration
-(const std::function<bool (const Fact&)>& pValueCallback,
+(FunctionRef<bool (const Fact&)> pValueCallback,
  const Fact& pFact,
  const std::map<Parameter, std::set<Entity>>& pParametersToConsiderAsAnyValue,
  const std::map<Parameter, std::set<Entity>>* pParametersToConsiderAsAnyValuePtr) const
@@ -538,7 +639,7 @@ void WorldState::iterateOnMatchingFactsWithoutFluentConsideration
 
 
 void WorldState::iterateOnMatchingFacts
-(const std::function<bool (const Fact&)>& pValueCallback,
+(FunctionRef<bool (const Fact&)> pValueCallback,
  const Fact& pFact,
  const std::map<Parameter, std::set<Entity>>& pParametersToConsiderAsAnyValue,
  const std::map<Parameter, std::set<Entity>>* pParametersToConsiderAsAnyValuePtr) const
@@ -554,6 +655,8 @@ void WorldState::iterateOnMatchingFacts
 
 void WorldState::refreshCacheIfNeeded(const Domain& pDomain)
 {
+  TraceSpan traceSpan("WorldState::refreshCacheIfNeeded");
+  ORDEREDGOALSPLANNER_ALLOCATION_PHASE(CACHE_REFRESH);
   _cache->refreshIfNeeded(pDomain, _factsMapping.facts());
 }
 
@@ -564,6 +667,20 @@ const SetOfFacts& WorldState::removableFacts() const
 }
 
 
+void WorldState::_resetHistory()
+{
+  _historyId = _nextHistoryId++;
+  _version = 0;
+  _predicateNameToVersion.clear();
+}
+
+
+void WorldState::_notifyPredicateModified(const std::string& pPredicateName)
+{
+  _predicateNameToVersion[pPredicateName] = ++_version;
+}
+
+
 bool WorldState::_tryToApplyEvent(std::set<EventId>& pEventsAlreadyApplied,
                                   WhatChanged& pWhatChanged,
                                   bool& pGoalChanged,
@@ -591,8 +708,7 @@ bool WorldState::_tryToApplyEvent(std::set<EventId>& pEventsAlreadyApplied,
         std::map<Parameter, std::set<Entity>> parametersToValues;
         for (const auto& currParam : currEvent.parameters)
           parametersToValues[currParam];
-        if (!currEvent.precondition || currEvent.precondition->isTrue(*this, pWhatChanged.punctualFacts, pWhatChanged.removedFacts,
-                                                                      &parametersToValues))
+        if (currEvent.isPreconditionTrue(*this, pWhatChanged.punctualFacts, pWhatChanged.removedFacts, &parametersToValues))
         {
           if (currEvent.factsToModify)
           {
@@ -603,10 +719,7 @@ bool WorldState::_tryToApplyEvent(std::set<EventId>& pEventsAlreadyApplied,
               if (!parametersToValuePoss.empty())
               {
                 for (const auto& currParamsPoss : parametersToValuePoss)
-                {
-                  auto factsToModify = currEvent.factsToModify->clone(&currParamsPoss);
-                  _modify(pWhatChanged, &*factsToModify, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved);
-                }
+                  _modify(pWhatChanged, &*currEvent.factsToModify, &currParamsPoss, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved);
               }
               else
               {
@@ -620,16 +733,17 @@ bool WorldState::_tryToApplyEvent(std::set<EventId>& pEventsAlreadyApplied,
                     return false;
                   }, optFactPtr->fact, parametersToValues);
                   for (auto& currFactToRemove : factsToRemove)
-                    _modify(pWhatChanged, &*strToWsModification("!" + currFactToRemove->toStr(), pOntology, pEntities, {}), // Optimize to construct WorldStateModification without passing by a string
+                    _modify(pWhatChanged, &*strToWsModification("!" + currFactToRemove->toStr(), pOntology, pEntities, {}), nullptr, // Optimize to construct WorldStateModification without passing by a string
                             pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved);
                 }
               }
             }
             else
             {
-              _modify(pWhatChanged, &*currEvent.factsToModify, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved);
+              _modify(pWhatChanged, &*currEvent.factsToModify, nullptr, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved);
             }
           }
+          ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfEventsFired);
           if (pGoalStack.addGoals(currEvent.goalsToAdd, *this, pNow))
             pGoalChanged = true;
           somethingChanged = true;
@@ -681,6 +795,8 @@ void WorldState::_notifyWhatChanged(WhatChanged& pWhatChanged,
 {
   if (pWhatChanged.somethingChanged())
   {
+    TraceSpan traceSpan("eventPropagation");
+    ORDEREDGOALSPLANNER_ALLOCATION_PHASE(EVENT_PROPAGATION);
     // manage the events
     std::map<SetOfEventsId, std::set<EventId>> soeToEventsAlreadyApplied;
     std::set<CallbackId> callbackAlreadyCalled;
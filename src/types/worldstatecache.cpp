@@ -2,6 +2,7 @@
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/worldstate.hpp>
 #include "factsalreadychecked.hpp"
+#include "../util/plannerstatsrecorder.hpp"
 
 
 namespace ogp
@@ -66,7 +67,11 @@ void WorldStateCache::refreshIfNeeded(const Domain& pDomain,
                                       const std::map<Fact, bool>& pFacts)
 {
   if (_uuidOfLastDomainUsed == pDomain.getUuid())
+  {
+    ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfWorldStateCacheHits);
     return;
+  }
+  ORDEREDGOALSPLANNER_STATS_INCREMENT(nbOfWorldStateCacheMisses);
   _uuidOfLastDomainUsed = pDomain.getUuid();
 
   for (int i = 0; i < 2; ++i) // 2 times to have all the accessible facts
@@ -98,7 +103,7 @@ void WorldStateCache::_feedAccessibleFactsFromSetOfActions(const FactsToValue::C
     if (itAction != actions.end())
     {
       const Action& action = itAction->second;
-      if (!action.precondition || action.precondition->canBecomeTrue(_worldState, action.parameters))
+      if (action.canPreconditionBecomeTrue(_worldState))
       {
         if (action.effect.worldStateModification)
           _feedAccessibleFactsFromDeduction(*action.effect.worldStateModification, action.parameters,
@@ -123,7 +128,7 @@ void WorldStateCache::_feedAccessibleFactsFromSetOfEvents(const FactsToValue::Co
     if (itEvent != pAllEvents.end())
     {
       const Event& event = itEvent->second;
-      if (!event.precondition || event.precondition->canBecomeTrue(_worldState, event.parameters))
+      if (event.canPreconditionBecomeTrue(_worldState))
         _feedAccessibleFactsFromDeduction(*event.factsToModify, event.parameters,
                                           pDomain, pFactsAlreadychecked);
     }
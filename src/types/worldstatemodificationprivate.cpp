@@ -60,6 +60,20 @@ bool _isOkWithLocalParameters(const std::map<Parameter, std::set<Entity>>& pLoca
   return true;
 }
 
+
+/// Get the optional fact with its parameters replaced by their argument, without copy if there is nothing to replace.
+const FactOptional& _withArguments(std::optional<FactOptional>& pFactWithArgumentsStorage,
+                                   const FactOptional& pFactOptional,
+                                   const std::map<Parameter, Entity>* pParametersToArgumentPtr)
+{
+  if (pParametersToArgumentPtr == nullptr || pParametersToArgumentPtr->empty() ||
+      !pFactOptional.fact.hasAParameter())
+    return pFactOptional;
+  pFactWithArgumentsStorage.emplace(pFactOptional);
+  pFactWithArgumentsStorage->fact.replaceArguments(*pParametersToArgumentPtr);
+  return *pFactWithArgumentsStorage;
+}
+
 }
 
 
@@ -113,15 +127,16 @@ std::string WorldStateModificationNode::toStr(bool pPrintAnyFluent) const
 }
 
 
-void WorldStateModificationNode::forAll(const std::function<void (const FactOptional&)>& pFactCallback,
-                                        const SetOfFacts& pSetOfFact) const
+void WorldStateModificationNode::forAll(FunctionRef<void (const FactOptional&)> pFactCallback,
+                                        const SetOfFacts& pSetOfFact,
+                                        const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
 {
   if (nodeType == WorldStateModificationNodeType::AND)
   {
     if (leftOperand)
-      leftOperand->forAll(pFactCallback, pSetOfFact);
+      leftOperand->forAll(pFactCallback, pSetOfFact, pParametersToArgumentPtr);
     if (rightOperand)
-      rightOperand->forAll(pFactCallback, pSetOfFact);
+      rightOperand->forAll(pFactCallback, pSetOfFact, pParametersToArgumentPtr);
   }
   else if (nodeType == WorldStateModificationNodeType::ASSIGN && leftOperand && rightOperand)
   {
@@ -129,17 +144,19 @@ void WorldStateModificationNode::forAll(const std::function<void (const FactOpti
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setFluent(rightOperand->getFluent(pSetOfFact));
+      if (pParametersToArgumentPtr != nullptr)
+        factToCheck.fact.replaceArguments(*pParametersToArgumentPtr);
+      factToCheck.fact.setFluent(rightOperand->getFluent(pSetOfFact, pParametersToArgumentPtr));
       return pFactCallback(factToCheck);
     }
   }
-  else if (nodeType == WorldStateModificationNodeType::FOR_ALL)
+  else if (nodeType == WorldStateModificationNodeType::FOR_ALL && rightOperand)
   {
-    _forAllInstruction(
-          [&](const WorldStateModification& pWsModification)
+    _forAllInstructionWithArguments(
+          [&](const std::map<Parameter, Entity>& pParametersToArgument)
     {
-      pWsModification.forAll(pFactCallback, pSetOfFact);
-    }, pSetOfFact);
+      rightOperand->forAll(pFactCallback, pSetOfFact, &pParametersToArgument);
+    }, pSetOfFact, pParametersToArgumentPtr);
   }
   else if (nodeType == WorldStateModificationNodeType::INCREASE && leftOperand && rightOperand)
   {
@@ -147,7 +164,10 @@ void WorldStateModificationNode::forAll(const std::function<void (const FactOpti
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setFluent(plusIntOrStr(leftOperand->getFluent(pSetOfFact), rightOperand->getFluent(pSetOfFact)));
+      if (pParametersToArgumentPtr != nullptr)
+        factToCheck.fact.replaceArguments(*pParametersToArgumentPtr);
+      factToCheck.fact.setFluent(plusIntOrStr(leftOperand->getFluent(pSetOfFact, pParametersToArgumentPtr),
+                                              rightOperand->getFluent(pSetOfFact, pParametersToArgumentPtr)));
       return pFactCallback(factToCheck);
     }
   }
@@ -157,7 +177,10 @@ void WorldStateModificationNode::forAll(const std::function<void (const FactOpti
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setFluent(minusIntOrStr(leftOperand->getFluent(pSetOfFact), rightOperand->getFluent(pSetOfFact)));
+      if (pParametersToArgumentPtr != nullptr)
+        factToCheck.fact.replaceArguments(*pParametersToArgumentPtr);
+      factToCheck.fact.setFluent(minusIntOrStr(leftOperand->getFluent(pSetOfFact, pParametersToArgumentPtr),
+                                               rightOperand->getFluent(pSetOfFact, pParametersToArgumentPtr)));
       return pFactCallback(factToCheck);
     }
   }
@@ -167,32 +190,36 @@ void WorldStateModificationNode::forAll(const std::function<void (const FactOpti
     if (leftFactPtr != nullptr)
     {
       auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setFluent(multiplyNbOrStr(leftOperand->getFluent(pSetOfFact), rightOperand->getFluent(pSetOfFact)));
+      if (pParametersToArgumentPtr != nullptr)
+        factToCheck.fact.replaceArguments(*pParametersToArgumentPtr);
+      factToCheck.fact.setFluent(multiplyNbOrStr(leftOperand->getFluent(pSetOfFact, pParametersToArgumentPtr),
+                                                 rightOperand->getFluent(pSetOfFact, pParametersToArgumentPtr)));
       return pFactCallback(factToCheck);
     }
   }
 }
 
 
-ContinueOrBreak WorldStateModificationNode::forAllThatCanBeModified(const std::function<ContinueOrBreak (const FactOptional&)>& pFactCallback) const
+ContinueOrBreak WorldStateModificationNode::forAllThatCanBeModified(FunctionRef<ContinueOrBreak (const FactOptional&)> pFactCallback,
+                                                                    const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
 {
   ContinueOrBreak res = ContinueOrBreak::CONTINUE;
   if (nodeType == WorldStateModificationNodeType::AND)
   {
     if (leftOperand)
-      res = leftOperand->forAllThatCanBeModified(pFactCallback);
+      res = leftOperand->forAllThatCanBeModified(pFactCallback, pParametersToArgumentPtr);
     if (rightOperand && res == ContinueOrBreak::CONTINUE)
-      res = rightOperand->forAllThatCanBeModified(pFactCallback);
+      res = rightOperand->forAllThatCanBeModified(pFactCallback, pParametersToArgumentPtr);
   }
   else if (nodeType == WorldStateModificationNodeType::ASSIGN && leftOperand)
   {
     auto* leftFactPtr = toWmFact(*leftOperand);
     if (leftFactPtr != nullptr)
-      return pFactCallback(leftFactPtr->factOptional);
+      return leftFactPtr->forAllThatCanBeModified(pFactCallback, pParametersToArgumentPtr);
   }
   else if (nodeType == WorldStateModificationNodeType::FOR_ALL && rightOperand)
   {
-    return rightOperand->forAllThatCanBeModified(pFactCallback);
+    return rightOperand->forAllThatCanBeModified(pFactCallback, pParametersToArgumentPtr);
   }
   else if ((nodeType == WorldStateModificationNodeType::INCREASE ||
             nodeType == WorldStateModificationNodeType::DECREASE ||
@@ -200,14 +227,14 @@ ContinueOrBreak WorldStateModificationNode::forAllThatCanBeModified(const std::f
   {
     auto* leftFactPtr = toWmFact(*leftOperand);
     if (leftFactPtr != nullptr)
-      return pFactCallback(leftFactPtr->factOptional);
+      return leftFactPtr->forAllThatCanBeModified(pFactCallback, pParametersToArgumentPtr);
   }
   return res;
 }
 
 
 void WorldStateModificationNode::iterateOverAllAccessibleFacts(
-    const std::function<void (const FactOptional&)>& pFactCallback,
+    FunctionRef<void (const FactOptional&)> pFactCallback,
     const SetOfFacts& pSetOfFact) const
 {
   if (nodeType == WorldStateModificationNodeType::AND)
@@ -270,7 +297,7 @@ void WorldStateModificationNode::iterateOverAllAccessibleFacts(
 }
 
 
-bool WorldStateModificationNode::forAllUntilTrue(const std::function<bool (const FactOptional&)>& pFactCallback,
+bool WorldStateModificationNode::forAllUntilTrue(FunctionRef<bool (const FactOptional&)> pFactCallback,
                                                  const SetOfFacts& pSetOfFact) const
 {
   if (nodeType == WorldStateModificationNodeType::AND)
@@ -337,7 +364,7 @@ bool WorldStateModificationNode::forAllUntilTrue(const std::function<bool (const
 }
 
 
-bool WorldStateModificationNode::canSatisfyObjective(const std::function<bool (const FactOptional&, std::map<Parameter, std::set<Entity>>*, const std::function<bool (const std::map<Parameter, std::set<Entity>>&)>&)>& pFactCallback,
+bool WorldStateModificationNode::canSatisfyObjective(FunctionRef<bool (const FactOptional&, std::map<Parameter, std::set<Entity>>*, FunctionRef<bool (const std::map<Parameter, std::set<Entity>>&)>)> pFactCallback,
                                                      std::map<Parameter, std::set<Entity>>& pParameters,
                                                      const WorldState& pWorldState,
                                                      const std::string& pFromDeductionId) const
@@ -418,7 +445,7 @@ bool WorldStateModificationNode::canSatisfyObjective(const std::function<bool (c
 }
 
 
-bool WorldStateModificationNode::iterateOnSuccessions(const std::function<bool (const Successions&, const FactOptional&, std::map<Parameter, std::set<Entity>>*, const std::function<bool (const std::map<Parameter, std::set<Entity>>&)>&)>& pCallback,
+bool WorldStateModificationNode::iterateOnSuccessions(FunctionRef<bool (const Successions&, const FactOptional&, std::map<Parameter, std::set<Entity>>*, FunctionRef<bool (const std::map<Parameter, std::set<Entity>>&)>)> pCallback,
                                                       std::map<Parameter, std::set<Entity>>& pParameters,
                                                       const WorldState& pWorldState,
                                                       bool pCanSatisfyThisGoal,
@@ -623,25 +650,26 @@ bool WorldStateModificationNode::operator==(const WorldStateModification& pOther
 }
 
 
-std::optional<Entity> WorldStateModificationNode::getFluent(const SetOfFacts& pSetOfFact) const
+std::optional<Entity> WorldStateModificationNode::getFluent(const SetOfFacts& pSetOfFact,
+                                                            const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
 {
   if (nodeType == WorldStateModificationNodeType::PLUS)
   {
-    auto leftValue = leftOperand->getFluent(pSetOfFact);
-    auto rightValue = rightOperand->getFluent(pSetOfFact);
+    auto leftValue = leftOperand->getFluent(pSetOfFact, pParametersToArgumentPtr);
+    auto rightValue = rightOperand->getFluent(pSetOfFact, pParametersToArgumentPtr);
     return plusIntOrStr(leftValue, rightValue);
   }
   if (nodeType == WorldStateModificationNodeType::MINUS)
   {
-    auto leftValue = leftOperand->getFluent(pSetOfFact);
-    auto rightValue = rightOperand->getFluent(pSetOfFact);
+    auto leftValue = leftOperand->getFluent(pSetOfFact, pParametersToArgumentPtr);
+    auto rightValue = rightOperand->getFluent(pSetOfFact, pParametersToArgumentPtr);
     return minusIntOrStr(leftValue, rightValue);
   }
   return {};
 }
 
 
-void WorldStateModificationNode::_forAllInstruction(const std::function<void (const WorldStateModification &)>& pCallback,
+void WorldStateModificationNode::_forAllInstruction(FunctionRef<void (const WorldStateModification &)> pCallback,
                                                     const SetOfFacts& pSetOfFact) const
 {
   if (leftOperand && rightOperand && parameterOpt)
@@ -665,14 +693,43 @@ void WorldStateModificationNode::_forAllInstruction(const std::function<void (co
 }
 
 
+void WorldStateModificationNode::_forAllInstructionWithArguments(FunctionRef<void (const std::map<Parameter, Entity>&)> pCallback,
+                                                                 const SetOfFacts& pSetOfFact,
+                                                                 const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
+{
+  if (leftOperand && parameterOpt)
+  {
+    auto* leftFactPtr = toWmFact(*leftOperand);
+    if (leftFactPtr != nullptr)
+    {
+      std::optional<FactOptional> factWithArgumentsStorage;
+      const auto& leftFactOptional = _withArguments(factWithArgumentsStorage, leftFactPtr->factOptional, pParametersToArgumentPtr);
+      std::set<Entity> parameterValues;
+      pSetOfFact.extractPotentialArgumentsOfAFactParameter(parameterValues, leftFactOptional.fact, parameterOpt->name);
+      if (!parameterValues.empty())
+      {
+        auto parametersToArgument = pParametersToArgumentPtr != nullptr ? *pParametersToArgumentPtr : std::map<Parameter, Entity>();
+        auto& parameterArgument = parametersToArgument.insert_or_assign(*parameterOpt, *parameterValues.begin()).first->second;
+        for (const auto& paramValue : parameterValues)
+        {
+          parameterArgument = paramValue;
+          pCallback(parametersToArgument);
+        }
+      }
+    }
+  }
+}
+
+
 bool WorldStateModificationNode::hasAContradictionWith(const std::set<FactOptional>& pFactsOpt,
-                                                       std::list<Parameter>* pParametersPtr) const
+                                                       std::list<Parameter>* pParametersPtr,
+                                                       const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
 {
   if (nodeType == WorldStateModificationNodeType::AND)
   {
-    if (leftOperand && leftOperand->hasAContradictionWith(pFactsOpt, pParametersPtr))
+    if (leftOperand && leftOperand->hasAContradictionWith(pFactsOpt, pParametersPtr, pParametersToArgumentPtr))
       return true;
-    if (rightOperand && rightOperand->hasAContradictionWith(pFactsOpt, pParametersPtr))
+    if (rightOperand && rightOperand->hasAContradictionWith(pFactsOpt, pParametersPtr, pParametersToArgumentPtr))
       return true;
   }
   else if ((nodeType == WorldStateModificationNodeType::ASSIGN ||
@@ -682,14 +739,18 @@ bool WorldStateModificationNode::hasAContradictionWith(const std::set<FactOption
   {
     auto* leftFactPtr = toWmFact(*leftOperand);
     if (leftFactPtr != nullptr)
+    {
+      std::optional<FactOptional> factWithArgumentsStorage;
+      const auto& leftFactOptional = _withArguments(factWithArgumentsStorage, leftFactPtr->factOptional, pParametersToArgumentPtr);
       for (const auto& currFactOpt : pFactsOpt)
-        if (leftFactPtr->factOptional.fact.areEqualWithoutFluentConsideration(currFactOpt.fact))
+        if (leftFactOptional.fact.areEqualWithoutFluentConsideration(currFactOpt.fact))
           return true;
+    }
   }
   else if (nodeType == WorldStateModificationNodeType::FOR_ALL && rightOperand)
   {
     auto parameters = addParameter(pParametersPtr, parameterOpt);
-    return rightOperand->hasAContradictionWith(pFactsOpt, &parameters);
+    return rightOperand->hasAContradictionWith(pFactsOpt, &parameters, pParametersToArgumentPtr);
   }
   return false;
 }
@@ -701,15 +762,34 @@ bool WorldStateModificationFact::operator==(const WorldStateModification& pOther
       factOptional == otherFactPtr->factOptional;
 }
 
-std::optional<Entity> WorldStateModificationFact::getFluent(const SetOfFacts& pSetOfFact) const
+void WorldStateModificationFact::forAll(FunctionRef<void (const FactOptional&)> pFactCallback,
+                                        const SetOfFacts&,
+                                        const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
+{
+  std::optional<FactOptional> factWithArgumentsStorage;
+  pFactCallback(_withArguments(factWithArgumentsStorage, factOptional, pParametersToArgumentPtr));
+}
+
+std::optional<Entity> WorldStateModificationFact::getFluent(const SetOfFacts& pSetOfFact,
+                                                            const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
+{
+  std::optional<FactOptional> factWithArgumentsStorage;
+  return pSetOfFact.getFactFluent(_withArguments(factWithArgumentsStorage, factOptional, pParametersToArgumentPtr).fact);
+}
+
+ContinueOrBreak WorldStateModificationFact::forAllThatCanBeModified(FunctionRef<ContinueOrBreak (const FactOptional&)> pFactCallback,
+                                                                    const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
 {
-  return pSetOfFact.getFactFluent(factOptional.fact);
+  std::optional<FactOptional> factWithArgumentsStorage;
+  return pFactCallback(_withArguments(factWithArgumentsStorage, factOptional, pParametersToArgumentPtr));
 }
 
 bool WorldStateModificationFact::hasAContradictionWith(const std::set<FactOptional>& pFactsOpt,
-                                                       std::list<Parameter>* pParametersPtr) const
+                                                       std::list<Parameter>* pParametersPtr,
+                                                       const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
 {
-  return factOptional.hasAContradictionWith(pFactsOpt, pParametersPtr, false);
+  std::optional<FactOptional> factWithArgumentsStorage;
+  return _withArguments(factWithArgumentsStorage, factOptional, pParametersToArgumentPtr).hasAContradictionWith(pFactsOpt, pParametersPtr, false);
 }
 
 
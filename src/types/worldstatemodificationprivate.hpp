@@ -80,20 +80,22 @@ struct WorldStateModificationNode : public WorldStateModification
       rightOperand->replaceArgument(pOldFact, pNewFact);
   }
 
-  void forAll(const std::function<void (const FactOptional&)>& pFactCallback,
-              const SetOfFacts& pSetOfFact) const override;
+  void forAll(FunctionRef<void (const FactOptional&)> pFactCallback,
+              const SetOfFacts& pSetOfFact,
+              const std::map<Parameter, Entity>* pParametersToArgumentPtr) const override;
 
-  ContinueOrBreak forAllThatCanBeModified(const std::function<ContinueOrBreak (const FactOptional&)>& pFactCallback) const override;
+  ContinueOrBreak forAllThatCanBeModified(FunctionRef<ContinueOrBreak (const FactOptional&)> pFactCallback,
+                                          const std::map<Parameter, Entity>* pParametersToArgumentPtr) const override;
 
-  void iterateOverAllAccessibleFacts(const std::function<void (const FactOptional&)>& pFactCallback,
+  void iterateOverAllAccessibleFacts(FunctionRef<void (const FactOptional&)> pFactCallback,
                                      const SetOfFacts& pSetOfFact) const;
-  bool forAllUntilTrue(const std::function<bool (const FactOptional&)>& pFactCallback,
+  bool forAllUntilTrue(FunctionRef<bool (const FactOptional&)> pFactCallback,
                        const SetOfFacts& pSetOfFact) const override;
-  bool canSatisfyObjective(const std::function<bool (const FactOptional&, std::map<Parameter, std::set<Entity>>*, const std::function<bool (const std::map<Parameter, std::set<Entity>>&)>&)>& pFactCallback,
+  bool canSatisfyObjective(FunctionRef<bool (const FactOptional&, std::map<Parameter, std::set<Entity>>*, FunctionRef<bool (const std::map<Parameter, std::set<Entity>>&)>)> pFactCallback,
                            std::map<Parameter, std::set<Entity>>& pParameters,
                            const WorldState& pWorldState,
                            const std::string& pFromDeductionId) const override;
-  bool iterateOnSuccessions(const std::function<bool (const Successions&, const FactOptional&, std::map<Parameter, std::set<Entity>>*, const std::function<bool (const std::map<Parameter, std::set<Entity>>&)>&)>& pCallback,
+  bool iterateOnSuccessions(FunctionRef<bool (const Successions&, const FactOptional&, std::map<Parameter, std::set<Entity>>*, FunctionRef<bool (const std::map<Parameter, std::set<Entity>>&)>)> pCallback,
                             std::map<Parameter, std::set<Entity>>& pParameters,
                             const WorldState& pWorldState,
                             bool pCanSatisfyThisGoal,
@@ -107,7 +109,8 @@ struct WorldStateModificationNode : public WorldStateModification
 
   bool operator==(const WorldStateModification& pOther) const override;
 
-  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact) const override;
+  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact,
+                                  const std::map<Parameter, Entity>* pParametersToArgumentPtr) const override;
 
   const FactOptional* getOptionalFact() const override
   {
@@ -126,7 +129,12 @@ struct WorldStateModificationNode : public WorldStateModification
   }
 
   bool hasAContradictionWith(const std::set<FactOptional>& pFactsOpt,
-                             std::list<Parameter>* pParametersPtr) const override;
+                             std::list<Parameter>* pParametersPtr,
+                             const std::map<Parameter, Entity>* pParametersToArgumentPtr) const override;
+
+  /// Successions of this node, to save and restore them without calling updateSuccesions.
+  const Successions& successions() const { return _successions; }
+  Successions& successions() { return _successions; }
 
 
   WorldStateModificationNodeType nodeType;
@@ -137,8 +145,11 @@ struct WorldStateModificationNode : public WorldStateModification
 private:
   Successions _successions;
 
-  void _forAllInstruction(const std::function<void (const WorldStateModification&)>& pCallback,
+  void _forAllInstruction(FunctionRef<void (const WorldStateModification&)> pCallback,
                           const SetOfFacts& pSetOfFact) const;
+  void _forAllInstructionWithArguments(FunctionRef<void (const std::map<Parameter, Entity>&)> pCallback,
+                                       const SetOfFacts& pSetOfFact,
+                                       const std::map<Parameter, Entity>* pParametersToArgumentPtr) const;
 };
 
 
@@ -170,21 +181,23 @@ struct WorldStateModificationFact : public WorldStateModification
     factOptional.fact.replaceArgument(pOld, pNew);
   }
 
-  void forAll(const std::function<void (const FactOptional&)>& pFactCallback,
-              const SetOfFacts&) const override { pFactCallback(factOptional); }
+  void forAll(FunctionRef<void (const FactOptional&)> pFactCallback,
+              const SetOfFacts&,
+              const std::map<Parameter, Entity>* pParametersToArgumentPtr) const override;
 
-  ContinueOrBreak forAllThatCanBeModified(const std::function<ContinueOrBreak (const FactOptional&)>& pFactCallback) const override { return pFactCallback(factOptional); }
+  ContinueOrBreak forAllThatCanBeModified(FunctionRef<ContinueOrBreak (const FactOptional&)> pFactCallback,
+                                          const std::map<Parameter, Entity>* pParametersToArgumentPtr) const override;
 
-  void iterateOverAllAccessibleFacts(const std::function<void (const FactOptional&)>& pFactCallback,
+  void iterateOverAllAccessibleFacts(FunctionRef<void (const FactOptional&)> pFactCallback,
                                      const SetOfFacts&) const override { pFactCallback(factOptional); }
 
 
-  bool forAllUntilTrue(const std::function<bool (const FactOptional&)>& pFactCallback, const SetOfFacts&) const override
+  bool forAllUntilTrue(FunctionRef<bool (const FactOptional&)> pFactCallback, const SetOfFacts&) const override
   {
     return pFactCallback(factOptional);
   }
 
-  bool canSatisfyObjective(const std::function<bool (const FactOptional&, std::map<Parameter, std::set<Entity>>*, const std::function<bool (const std::map<Parameter, std::set<Entity>>&)>&)>& pFactCallback,
+  bool canSatisfyObjective(FunctionRef<bool (const FactOptional&, std::map<Parameter, std::set<Entity>>*, FunctionRef<bool (const std::map<Parameter, std::set<Entity>>&)>)> pFactCallback,
                            std::map<Parameter, std::set<Entity>>&,
                            const WorldState&,
                            const std::string&) const override
@@ -192,7 +205,7 @@ struct WorldStateModificationFact : public WorldStateModification
     return pFactCallback(factOptional, nullptr, [](const std::map<Parameter, std::set<Entity>>&){ return true; });
   }
 
-  bool iterateOnSuccessions(const std::function<bool (const Successions&, const FactOptional&, std::map<Parameter, std::set<Entity>>*, const std::function<bool (const std::map<Parameter, std::set<Entity>>&)>&)>& pCallback,
+  bool iterateOnSuccessions(FunctionRef<bool (const Successions&, const FactOptional&, std::map<Parameter, std::set<Entity>>*, FunctionRef<bool (const std::map<Parameter, std::set<Entity>>&)>)> pCallback,
                             std::map<Parameter, std::set<Entity>>&,
                             const WorldState&,
                             bool pCanSatisfyThisGoal,
@@ -228,7 +241,8 @@ struct WorldStateModificationFact : public WorldStateModification
 
   bool operator==(const WorldStateModification& pOther) const override;
 
-  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact) const override;
+  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact,
+                                  const std::map<Parameter, Entity>* pParametersToArgumentPtr) const override;
 
   const FactOptional* getOptionalFact() const override
   {
@@ -245,7 +259,12 @@ struct WorldStateModificationFact : public WorldStateModification
   }
 
   bool hasAContradictionWith(const std::set<FactOptional>& pFactsOpt,
-                             std::list<Parameter>* pParametersPtr) const override;
+                             std::list<Parameter>* pParametersPtr,
+                             const std::map<Parameter, Entity>* pParametersToArgumentPtr) const override;
+
+  /// Successions of this fact, to save and restore them without calling updateSuccesions.
+  const Successions& successions() const { return _successions; }
+  Successions& successions() { return _successions; }
 
   FactOptional factOptional;
 
@@ -273,18 +292,20 @@ struct WorldStateModificationNumber : public WorldStateModification
 
   void replaceArgument(const Entity&,
                        const Entity&) override {}
-  void forAll(const std::function<void (const FactOptional&)>&,
-              const SetOfFacts&) const override {}
-  ContinueOrBreak forAllThatCanBeModified(const std::function<ContinueOrBreak (const FactOptional&)>&) const override { return ContinueOrBreak::CONTINUE; }
-  void iterateOverAllAccessibleFacts(const std::function<void (const FactOptional&)>&,
+  void forAll(FunctionRef<void (const FactOptional&)>,
+              const SetOfFacts&,
+              const std::map<Parameter, Entity>*) const override {}
+  ContinueOrBreak forAllThatCanBeModified(FunctionRef<ContinueOrBreak (const FactOptional&)>,
+                                          const std::map<Parameter, Entity>*) const override { return ContinueOrBreak::CONTINUE; }
+  void iterateOverAllAccessibleFacts(FunctionRef<void (const FactOptional&)>,
                                      const SetOfFacts&) const override {}
-  bool forAllUntilTrue(const std::function<bool (const FactOptional&)>&,
+  bool forAllUntilTrue(FunctionRef<bool (const FactOptional&)>,
                        const SetOfFacts&) const override { return false; }
-  bool canSatisfyObjective(const std::function<bool (const FactOptional&, std::map<Parameter, std::set<Entity>>*, const std::function<bool (const std::map<Parameter, std::set<Entity>>&)>&)>&,
+  bool canSatisfyObjective(FunctionRef<bool (const FactOptional&, std::map<Parameter, std::set<Entity>>*, FunctionRef<bool (const std::map<Parameter, std::set<Entity>>&)>)>,
                            std::map<Parameter, std::set<Entity>>&,
                            const WorldState&,
                            const std::string&) const override { return false; }
-  bool iterateOnSuccessions(const std::function<bool (const Successions&, const FactOptional&, std::map<Parameter, std::set<Entity>>*, const std::function<bool (const std::map<Parameter, std::set<Entity>>&)>&)>&,
+  bool iterateOnSuccessions(FunctionRef<bool (const Successions&, const FactOptional&, std::map<Parameter, std::set<Entity>>*, FunctionRef<bool (const std::map<Parameter, std::set<Entity>>&)>)>,
                             std::map<Parameter, std::set<Entity>>&,
                             const WorldState&,
                             bool,
@@ -298,9 +319,10 @@ struct WorldStateModificationNumber : public WorldStateModification
 
   bool operator==(const WorldStateModification& pOther) const override;
 
-  std::optional<Entity> getFluent(const SetOfFacts&) const override
+  std::optional<Entity> getFluent(const SetOfFacts&,
+                                  const std::map<Parameter, Entity>*) const override
   {
-    return Entity::createNumberEntity(toStr(true));
+    return Entity::createNumberEntity(_nb);
   }
 
   const FactOptional* getOptionalFact() const override
@@ -314,7 +336,8 @@ struct WorldStateModificationNumber : public WorldStateModification
   }
 
   bool hasAContradictionWith(const std::set<FactOptional>&,
-                             std::list<Parameter>*) const override { return false; }
+                             std::list<Parameter>*,
+                             const std::map<Parameter, Entity>*) const override { return false; }
 
   const Number& getNb() const { return _nb; }
 
@@ -0,0 +1,73 @@
+#include "plannerstatsrecorder.hpp"
+
+#ifdef ORDEREDGOALSPLANNER_ENABLE_ALLOCATION_STATS
+#include <cstdlib>
+#include <new>
+
+
+namespace ogp
+{
+namespace
+{
+thread_local PlannerPhase _currentPlannerPhase = PlannerPhase::OTHER;
+
+void _countAllocation(std::size_t pSize)
+{
+  if (auto* statsPtr = currentPlannerStatsPtr())
+  {
+    auto& allocations = statsPtr->allocationsPerPhase[static_cast<std::size_t>(_currentPlannerPhase)];
+    ++allocations.nbOfAllocations;
+    allocations.nbOfBytes += pSize;
+  }
+}
+
+}
+
+
+AllocationPhaseScope::AllocationPhaseScope(PlannerPhase pPlannerPhase)
+  : _previousPlannerPhase(_currentPlannerPhase)
+{
+  _currentPlannerPhase = pPlannerPhase;
+}
+
+
+AllocationPhaseScope::~AllocationPhaseScope()
+{
+  _currentPlannerPhase = _previousPlannerPhase;
+}
+
+} // !ogp
+
+
+// The replaceable allocation functions are hooked to count the allocations of the planner.
+// The array and the nothrow versions of the standard library call these ones.
+
+void* operator new(std::size_t pSize)
+{
+  ogp::_countAllocation(pSize);
+  if (pSize == 0)
+    pSize = 1;
+  while (true)
+  {
+    if (void* res = std::malloc(pSize))
+      return res;
+    auto newHandler = std::get_new_handler();
+    if (newHandler == nullptr)
+      throw std::bad_alloc();
+    newHandler();
+  }
+}
+
+
+void operator delete(void* pPtr) noexcept
+{
+  std::free(pPtr);
+}
+
+
+void operator delete(void* pPtr, std::size_t) noexcept
+{
+  std::free(pPtr);
+}
+
+#endif // ORDEREDGOALSPLANNER_ENABLE_ALLOCATION_STATS
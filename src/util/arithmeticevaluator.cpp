@@ -1,111 +1,390 @@
 #include <orderedgoalsplanner/util/arithmeticevaluator.hpp>
-#include <string>
-#include <sstream>
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+#include <type_traits>
 
 namespace ogp
 {
+namespace
+{
+const std::size_t _smallStackSize = 16;
 
-class ArithmeticEvaluator
+Number _divide(const Number& pNb1,
+               const Number& pNb2)
 {
-public:
-ArithmeticEvaluator(const std::string& pExpressionToParse,
-                    std::size_t pBeginPos)
- : expressionToParse(pExpressionToParse),
-   _currentPos(pBeginPos)
+  return std::visit([](auto&& l, auto&& r) -> Number {
+    if constexpr (std::is_integral_v<std::decay_t<decltype(l)>> && std::is_integral_v<std::decay_t<decltype(r)>>)
+      if (r == 0)
+        throw std::runtime_error("Division by zero");
+    return l / r;
+  }, pNb1, pNb2);
+}
+
+Number _negate(const Number& pNb)
 {
+  return std::visit([](auto&& v) -> Number { return -v; }, pNb);
+}
 }
 
-int expression()
+
+/// Parser of the expressions, it gives what it reads to a backend that compiles or interprets it.
+template <typename TBackend>
+struct ArithmeticExpression::Parser
+{
+Parser(TBackend& pBackend,
+       const std::string& pExpressionToParse,
+       std::size_t pBeginPos)
+ : backend(pBackend),
+   expressionToParse(pExpressionToParse),
+   currentPos(pBeginPos)
 {
-  int result = term();
+}
+
+void expression()
+{
+  term();
   while (peek() == '+' || peek() == '-')
   {
     if (get() == '+')
-      result += term();
+    {
+      term();
+      backend.applyOperator(OpCode::PLUS);
+    }
     else
-      result -= term();
+    {
+      term();
+      backend.applyOperator(OpCode::MINUS);
+    }
   }
-  return result;
 }
 
-
-private:
+TBackend& backend;
 const std::string& expressionToParse;
-std::size_t _currentPos;
+std::size_t currentPos;
 
+private:
 char peek()
 {
-  return expressionToParse[_currentPos];
+  while (currentPos < expressionToParse.size() && expressionToParse[currentPos] == ' ')
+    ++currentPos;
+  return currentPos < expressionToParse.size() ? expressionToParse[currentPos] : '\0';
 }
 
 char get()
 {
-  return expressionToParse[_currentPos++];
+  char currChar = peek();
+  if (currChar != '\0')
+    ++currentPos;
+  return currChar;
 }
 
-int number()
+void number()
 {
-  int result = get() - '0';
-  while (peek() >= '0' && peek() <= '9')
-    result = (10 * result) + get() - '0';
-  return result;
+  auto beginPos = currentPos;
+  bool isFloat = false;
+  while (currentPos < expressionToParse.size() &&
+         ((expressionToParse[currentPos] >= '0' && expressionToParse[currentPos] <= '9') ||
+          (!isFloat && expressionToParse[currentPos] == '.')))
+  {
+    if (expressionToParse[currentPos] == '.')
+      isFloat = true;
+    ++currentPos;
+  }
+
+  const char* begin = expressionToParse.data() + beginPos;
+  const char* end = expressionToParse.data() + currentPos;
+  std::from_chars_result result;
+  Number value;
+  if (isFloat)
+  {
+    float floatValue = 0;
+    result = std::from_chars(begin, end, floatValue);
+    value = floatValue;
+  }
+  else
+  {
+    int intValue = 0;
+    result = std::from_chars(begin, end, intValue);
+    value = intValue;
+  }
+  if (result.ec != std::errc() || result.ptr != end)
+    throw std::runtime_error("Invalid number in the expression \"" + expressionToParse + "\"");
+  backend.pushConstant(value);
 }
 
-int factor()
+void variable()
 {
-  if (peek() >= '0' && peek() <= '9')
-    return number();
-  else if (peek() == '(')
+  auto endPos = expressionToParse.find('}', currentPos);
+  if (endPos == std::string::npos)
+    throw std::runtime_error("Variable not closed in the expression \"" + expressionToParse + "\"");
+  auto name = expressionToParse.substr(currentPos, endPos - currentPos);
+  currentPos = endPos + 1;
+  backend.pushVariable(std::move(name));
+}
+
+void factor()
+{
+  char currChar = peek();
+  if ((currChar >= '0' && currChar <= '9') || currChar == '.')
+  {
+    number();
+  }
+  else if (currChar == '(')
   {
     get(); // '('
-    int result = expression();
-    get(); // ')'
-    return result;
+    expression();
+    if (get() != ')')
+      throw std::runtime_error("Parenthesis not closed in the expression \"" + expressionToParse + "\"");
   }
-  else if (peek() == '-')
+  else if (currChar == '-')
   {
     get();
-    return -factor();
+    factor();
+    backend.applyOperator(OpCode::NEGATE);
+  }
+  else if (currChar == '$' && currentPos + 1 < expressionToParse.size() &&
+           expressionToParse[currentPos + 1] == '{')
+  {
+    currentPos += 2;
+    variable();
+  }
+  else
+  {
+    throw std::runtime_error("Cannot evaluate this expression");
   }
-  throw std::runtime_error("Cannot evaluate this expression");
-  return 0; // error
 }
 
 
-int term()
+void term()
 {
-  int result = factor();
+  factor();
   while (peek() == '*' || peek() == '/')
+  {
     if (get() == '*')
-      result *= factor();
+    {
+      factor();
+      backend.applyOperator(OpCode::MULTIPLY);
+    }
     else
-      result /= factor();
-  return result;
+    {
+      factor();
+      backend.applyOperator(OpCode::DIVIDE);
+    }
+  }
 }
 };
 
 
+/// Backend that writes the bytecode of the expression.
+struct ArithmeticExpression::Compiler
+{
+Compiler(ArithmeticExpression& pRes)
+ : res(pRes),
+   _stackSize(0)
+{
+}
+
+void pushConstant(const Number& pValue)
+{
+  res._constants.emplace_back(pValue);
+  _emitPush(OpCode::PUSH_CONSTANT, res._constants.size() - 1);
+}
+
+void pushVariable(std::string&& pName)
+{
+  auto itVariable = std::find(res._variables.begin(), res._variables.end(), pName);
+  if (itVariable == res._variables.end())
+    itVariable = res._variables.insert(res._variables.end(), std::move(pName));
+  _emitPush(OpCode::PUSH_VARIABLE, static_cast<std::size_t>(itVariable - res._variables.begin()));
+}
+
+void applyOperator(OpCode pOpCode)
+{
+  res._instructions.push_back({pOpCode, 0});
+  if (pOpCode != OpCode::NEGATE)
+    --_stackSize;
+}
+
+ArithmeticExpression& res;
+
+private:
+std::size_t _stackSize;
+
+void _emitPush(OpCode pOpCode,
+               std::size_t pOperand)
+{
+  res._instructions.push_back({pOpCode, pOperand});
+  ++_stackSize;
+  res._maxStackSize = std::max(res._maxStackSize, _stackSize);
+}
+};
+
+
+/// Backend that computes the value of the expression while it is read, for the one-shot evaluations.
+struct ArithmeticExpression::Interpreter
+{
+void pushConstant(const Number& pValue)
+{
+  if (_stackSize < _smallStackSize)
+    _smallStack[_stackSize] = pValue;
+  else
+    _bigStack.emplace_back(pValue);
+  ++_stackSize;
+}
+
+void pushVariable(std::string&&)
+{
+  throw std::runtime_error("Missing values for the variables of the expression");
+}
+
+void applyOperator(OpCode pOpCode)
+{
+  if (pOpCode == OpCode::NEGATE)
+  {
+    Number value = _pop();
+    pushConstant(_negate(value));
+    return;
+  }
+  Number right = _pop();
+  Number left = _pop();
+  pushConstant(_applyBinaryOperator(pOpCode, left, right));
+}
+
+Number result()
+{
+  return _pop();
+}
+
+private:
+// No allocation for the usual small expressions
+Number _smallStack[_smallStackSize];
+std::vector<Number> _bigStack;
+std::size_t _stackSize = 0;
+
+Number _pop()
+{
+  --_stackSize;
+  if (_stackSize < _smallStackSize)
+    return _smallStack[_stackSize];
+  Number res = _bigStack.back();
+  _bigStack.pop_back();
+  return res;
+}
+};
+
+
+Number ArithmeticExpression::_applyBinaryOperator(OpCode pOpCode,
+                                                  const Number& pLeft,
+                                                  const Number& pRight)
+{
+  switch (pOpCode)
+  {
+  case OpCode::PLUS:
+    return pLeft + pRight;
+  case OpCode::MINUS:
+    return pLeft - pRight;
+  case OpCode::MULTIPLY:
+    return pLeft * pRight;
+  case OpCode::DIVIDE:
+    return _divide(pLeft, pRight);
+  default:
+    throw std::runtime_error("Not a binary operator");
+  }
+}
+
+
+ArithmeticExpression ArithmeticExpression::compile(const std::string& pText,
+                                                   std::size_t pBeginPos,
+                                                   std::size_t* pEndPosPtr)
+{
+  ArithmeticExpression res;
+  Compiler compiler(res);
+  Parser<Compiler> parser(compiler, pText, pBeginPos);
+  parser.expression();
+  if (pEndPosPtr != nullptr)
+    *pEndPosPtr = parser.currentPos;
+  return res;
+}
+
+
+Number ArithmeticExpression::interpret(const std::string& pText,
+                                       std::size_t pBeginPos,
+                                       std::size_t* pEndPosPtr)
+{
+  Interpreter interpreter;
+  Parser<Interpreter> parser(interpreter, pText, pBeginPos);
+  parser.expression();
+  if (pEndPosPtr != nullptr)
+    *pEndPosPtr = parser.currentPos;
+  return interpreter.result();
+}
+
+
+Number ArithmeticExpression::evaluate(const std::vector<Number>& pVariableValues) const
+{
+  if (pVariableValues.size() < _variables.size())
+    throw std::runtime_error("Missing values for the variables of the expression");
+
+  // No allocation for the usual small expressions
+  Number smallStack[_smallStackSize];
+  std::vector<Number> bigStack;
+  Number* stack = smallStack;
+  if (_maxStackSize > _smallStackSize)
+  {
+    bigStack.resize(_maxStackSize);
+    stack = bigStack.data();
+  }
+
+  std::size_t stackSize = 0;
+  for (const auto& currInstruction : _instructions)
+  {
+    switch (currInstruction.opCode)
+    {
+    case OpCode::PUSH_CONSTANT:
+      stack[stackSize++] = _constants[currInstruction.operand];
+      break;
+    case OpCode::PUSH_VARIABLE:
+      stack[stackSize++] = pVariableValues[currInstruction.operand];
+      break;
+    case OpCode::NEGATE:
+      stack[stackSize - 1] = _negate(stack[stackSize - 1]);
+      break;
+    default:
+      --stackSize;
+      stack[stackSize - 1] = _applyBinaryOperator(currInstruction.opCode, stack[stackSize - 1], stack[stackSize]);
+      break;
+    }
+  }
+  return stack[0];
+}
 
 
 
 int evalute(const std::string& pText,
             std::size_t pBeginPos)
 {
-  ArithmeticEvaluator evaluator(pText, pBeginPos);
-  return evaluator.expression();
+  auto result = ArithmeticExpression::interpret(pText, pBeginPos);
+  return std::visit([](auto&& v) { return static_cast<int>(v); }, result);
 }
 
 
 std::string evaluteToStr(const std::string& pText,
                          std::size_t pBeginPos)
 {
-  std::stringstream ss;
   try {
-    ss << evalute(pText, pBeginPos);
-    return ss.str();
+    return evaluationResultToStr(ArithmeticExpression::interpret(pText, pBeginPos));
   } catch (...) {}
   return "_";
 }
 
 
+std::string evaluationResultToStr(const Number& pNumber)
+{
+  char buffer[32];
+  auto result = std::visit([&](auto&& v) { return std::to_chars(buffer, buffer + sizeof(buffer), v); }, pNumber);
+  return std::string(buffer, result.ptr);
+}
+
+
 }
@@ -0,0 +1,113 @@
+#include <orderedgoalsplanner/util/mappedfile.hpp>
+#include <fstream>
+#include <stdexcept>
+#if defined(__unix__) || defined(__APPLE__)
+# define ORDEREDGOALSPLANNER_HAS_MMAP
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace ogp
+{
+namespace
+{
+const char* _emptyContent = "";
+}
+
+
+MappedFile::MappedFile(const std::string& pFilePath)
+  : _data(_emptyContent),
+    _size(0),
+    _buffer()
+{
+#ifdef ORDEREDGOALSPLANNER_HAS_MMAP
+  int fd = ::open(pFilePath.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Could not open file " + pFilePath);
+
+  struct stat fileStat;
+  if (::fstat(fd, &fileStat) != 0)
+  {
+    ::close(fd);
+    throw std::runtime_error("Could not read the size of file " + pFilePath);
+  }
+
+  if (fileStat.st_size > 0)
+  {
+    void* mappedMemory = ::mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mappedMemory != MAP_FAILED)
+    {
+      ::madvise(mappedMemory, static_cast<std::size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+      _data = static_cast<const char*>(mappedMemory);
+      _size = static_cast<std::size_t>(fileStat.st_size);
+      ::close(fd);
+      return;
+    }
+  }
+  ::close(fd);
+  if (fileStat.st_size == 0 && S_ISREG(fileStat.st_mode))
+    return;
+#endif
+
+  // Fallback: read the file with only one allocation
+  std::ifstream file(pFilePath, std::ios::binary | std::ios::ate);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open file " + pFilePath);
+  auto fileSize = file.tellg();
+  if (fileSize > 0)
+  {
+    _buffer.resize(static_cast<std::size_t>(fileSize));
+    file.seekg(0);
+    file.read(&_buffer[0], fileSize);
+    _buffer.resize(static_cast<std::size_t>(file.gcount()));
+  }
+  _data = _buffer.data();
+  _size = _buffer.size();
+}
+
+
+MappedFile::~MappedFile()
+{
+  _release();
+}
+
+
+MappedFile::MappedFile(MappedFile&& pOther) noexcept
+  : _data(_emptyContent),
+    _size(0),
+    _buffer()
+{
+  *this = std::move(pOther);
+}
+
+
+MappedFile& MappedFile::operator=(MappedFile&& pOther) noexcept
+{
+  if (this == &pOther)
+    return *this;
+  _release();
+  bool isOtherInBuffer = pOther._data == pOther._buffer.data();
+  _buffer = std::move(pOther._buffer);
+  _data = isOtherInBuffer ? _buffer.data() : pOther._data;
+  _size = pOther._size;
+  pOther._data = _emptyContent;
+  pOther._size = 0;
+  return *this;
+}
+
+
+void MappedFile::_release()
+{
+#ifdef ORDEREDGOALSPLANNER_HAS_MMAP
+  if (_size > 0 && _data != _buffer.data())
+    ::munmap(const_cast<char*>(_data), _size);
+#endif
+  _data = _emptyContent;
+  _size = 0;
+  _buffer.clear();
+}
+
+
+} // !ogp
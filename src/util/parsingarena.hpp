@@ -0,0 +1,88 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_UTIL_PARSINGARENA_HPP
+#define ORDEREDGOALSPLANNER_SRC_UTIL_PARSINGARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ogp
+{
+
+/**
+ * Bump allocator used to build short-lived parsing trees.
+ * Nothing is freed individually, all the objects are released in one shot by reset() or by the destructor.
+ * Only trivially destructible objects can be allocated in it.
+ */
+class ParsingArena
+{
+public:
+  ParsingArena(std::size_t pBlockSize = 16384)
+    : _blockSize(pBlockSize),
+      _blocks(),
+      _currentBlock(0),
+      _posInCurrentBlock(0)
+  {
+  }
+
+  ParsingArena(const ParsingArena&) = delete;
+  ParsingArena& operator=(const ParsingArena&) = delete;
+
+  template<typename T, typename... ARGS>
+  T* make(ARGS&&... pArgs)
+  {
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "Objects allocated in a parsing arena are never destroyed");
+    void* memory = _allocate(sizeof(T), alignof(T));
+    return new (memory) T(std::forward<ARGS>(pArgs)...);
+  }
+
+  /// Release all the objects but keep the memory blocks for the next usages.
+  void reset()
+  {
+    _currentBlock = 0;
+    _posInCurrentBlock = 0;
+  }
+
+private:
+  struct Block
+  {
+    std::unique_ptr<unsigned char[]> memory;
+    std::size_t size;
+  };
+
+  std::size_t _blockSize;
+  std::vector<Block> _blocks;
+  std::size_t _currentBlock;
+  std::size_t _posInCurrentBlock;
+
+  void* _allocate(std::size_t pSize,
+                  std::size_t pAlignment)
+  {
+    while (_currentBlock < _blocks.size())
+    {
+      auto& block = _blocks[_currentBlock];
+      std::size_t alignedPos = (_posInCurrentBlock + pAlignment - 1) & ~(pAlignment - 1);
+      if (alignedPos + pSize <= block.size)
+      {
+        _posInCurrentBlock = alignedPos + pSize;
+        return block.memory.get() + alignedPos;
+      }
+      ++_currentBlock;
+      _posInCurrentBlock = 0;
+    }
+
+    std::size_t newBlockSize = pSize > _blockSize ? pSize : _blockSize;
+    _blocks.push_back(Block{std::unique_ptr<unsigned char[]>(new unsigned char[newBlockSize]), newBlockSize});
+    _currentBlock = _blocks.size() - 1;
+    _posInCurrentBlock = pSize;
+    return _blocks.back().memory.get();
+  }
+};
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_UTIL_PARSINGARENA_HPP
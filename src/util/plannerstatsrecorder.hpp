@@ -0,0 +1,73 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_UTIL_PLANNERSTATSRECORDER_HPP
+#define ORDEREDGOALSPLANNER_SRC_UTIL_PLANNERSTATSRECORDER_HPP
+
+#include <cstddef>
+#include <orderedgoalsplanner/types/plannerstats.hpp>
+
+#if defined(ORDEREDGOALSPLANNER_ENABLE_ALLOCATION_STATS) && !defined(ORDEREDGOALSPLANNER_ENABLE_STATS)
+# error "The allocation accounting needs the planner stats"
+#endif
+
+namespace ogp
+{
+
+#ifdef ORDEREDGOALSPLANNER_ENABLE_STATS
+
+/// Stats where the work done by the planner in the current thread is counted, nullptr if nobody records it.
+PlannerStats*& currentPlannerStatsPtr();
+
+
+/// Track the depth of recursion of the searches of an effect during the lifetime of this object.
+class LookForAPossibleEffectDepthScope
+{
+public:
+  LookForAPossibleEffectDepthScope();
+  ~LookForAPossibleEffectDepthScope();
+
+  LookForAPossibleEffectDepthScope(const LookForAPossibleEffectDepthScope&) = delete;
+  LookForAPossibleEffectDepthScope& operator=(const LookForAPossibleEffectDepthScope&) = delete;
+};
+
+#define ORDEREDGOALSPLANNER_STATS_SCOPE(statsPtr) ::ogp::PlannerStatsScope plannerStatsScope(statsPtr)
+#define ORDEREDGOALSPLANNER_STATS_INCREMENT(counter) \
+  do { if (auto* plannerStatsPtr = ::ogp::currentPlannerStatsPtr()) ++plannerStatsPtr->counter; } while (false)
+#define ORDEREDGOALSPLANNER_STATS_LOOK_FOR_A_POSSIBLE_EFFECT_SCOPE() \
+  ::ogp::LookForAPossibleEffectDepthScope lookForAPossibleEffectDepthScope
+
+#else
+
+#define ORDEREDGOALSPLANNER_STATS_SCOPE(statsPtr) static_cast<void>(0)
+#define ORDEREDGOALSPLANNER_STATS_INCREMENT(counter) static_cast<void>(0)
+#define ORDEREDGOALSPLANNER_STATS_LOOK_FOR_A_POSSIBLE_EFFECT_SCOPE() static_cast<void>(0)
+
+#endif // ORDEREDGOALSPLANNER_ENABLE_STATS
+
+
+#ifdef ORDEREDGOALSPLANNER_ENABLE_ALLOCATION_STATS
+
+/// Attribute the allocations of the current thread to a phase of the planner during the lifetime of this object.
+class AllocationPhaseScope
+{
+public:
+  explicit AllocationPhaseScope(PlannerPhase pPlannerPhase);
+  ~AllocationPhaseScope();
+
+  AllocationPhaseScope(const AllocationPhaseScope&) = delete;
+  AllocationPhaseScope& operator=(const AllocationPhaseScope&) = delete;
+
+private:
+  PlannerPhase _previousPlannerPhase;
+};
+
+#define ORDEREDGOALSPLANNER_ALLOCATION_PHASE(phase) ::ogp::AllocationPhaseScope allocationPhaseScope(::ogp::PlannerPhase::phase)
+
+#else
+
+#define ORDEREDGOALSPLANNER_ALLOCATION_PHASE(phase) static_cast<void>(0)
+
+#endif // ORDEREDGOALSPLANNER_ENABLE_ALLOCATION_STATS
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_UTIL_PLANNERSTATSRECORDER_HPP
@@ -0,0 +1,425 @@
+#include <orderedgoalsplanner/util/planvalidator.hpp>
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <orderedgoalsplanner/types/condition.hpp>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include "../types/worldstatemodificationprivate.hpp"
+
+namespace ogp
+{
+namespace
+{
+const std::size_t _noGroup = static_cast<std::size_t>(-1);
+const std::size_t _nbOfBitsPerWord = 64;
+
+
+bool _hasBit(const std::vector<std::uint64_t>& pBitset,
+             std::size_t pIndex)
+{
+  return (pBitset[pIndex / _nbOfBitsPerWord] >> (pIndex % _nbOfBitsPerWord)) & 1;
+}
+
+void _setBit(std::vector<std::uint64_t>& pBitset,
+             std::size_t pIndex)
+{
+  pBitset[pIndex / _nbOfBitsPerWord] |= std::uint64_t(1) << (pIndex % _nbOfBitsPerWord);
+}
+
+void _resetBit(std::vector<std::uint64_t>& pBitset,
+               std::size_t pIndex)
+{
+  pBitset[pIndex / _nbOfBitsPerWord] &= ~(std::uint64_t(1) << (pIndex % _nbOfBitsPerWord));
+}
+
+}
+
+
+bool PlanValidation::isValid() const
+{
+  if (!preconditionFailures.empty() || !effectConflicts.empty())
+    return false;
+  for (bool currGoalSatisfied : goalsSatisfied)
+    if (!currGoalSatisfied)
+      return false;
+  return true;
+}
+
+
+
+PlanValidator::PlanValidator(const Problem& pProblem,
+                             const Domain& pDomain)
+  : _domain(pDomain),
+    _factToId(),
+    _factIdToFact(),
+    _factIdToGroupId(),
+    _groupToId(),
+    _groupIdToFactIds(),
+    _initialFactIds(),
+    _goals(),
+    _actionIdToParametersToGroundAction()
+{
+  for (const auto& currFact : pDomain.getTimelessFacts().setOfFacts().facts())
+    _initialFactIds.push_back(_factId(currFact.first));
+  for (const auto& currFact : pProblem.worldState.facts())
+    _initialFactIds.push_back(_factId(currFact.first));
+
+  const auto& goals = pProblem.goalStack.goals();
+  for (auto itGoals = goals.rbegin(); itGoals != goals.rend(); ++itGoals)
+  {
+    for (const auto& currGoal : itGoals->second)
+    {
+      std::vector<Literal> literals;
+      _compileCondition(literals, nullptr, currGoal.objective());
+      _goals.push_back(std::move(literals));
+    }
+  }
+}
+
+
+PlanValidation PlanValidator::validate(const ParallelPan& pPlan)
+{
+  std::vector<std::vector<const ActionInvocation*>> steps;
+  steps.reserve(pPlan.actionsToDoInParallel.size());
+  for (const auto& currStep : pPlan.actionsToDoInParallel)
+  {
+    steps.emplace_back();
+    for (const auto& currAction : currStep.actions)
+      steps.back().push_back(&currAction.actionInvocation);
+  }
+  return _validate(steps);
+}
+
+
+PlanValidation PlanValidator::validate(const std::list<ActionInvocationWithGoal>& pPlan)
+{
+  std::vector<std::vector<const ActionInvocation*>> steps;
+  steps.reserve(pPlan.size());
+  for (const auto& currAction : pPlan)
+    steps.push_back({&currAction.actionInvocation});
+  return _validate(steps);
+}
+
+
+std::vector<PlanValidation> PlanValidator::validate(const std::vector<ParallelPan>& pPlans)
+{
+  std::vector<PlanValidation> res;
+  res.reserve(pPlans.size());
+  for (const auto& currPlan : pPlans)
+    res.push_back(validate(currPlan));
+  return res;
+}
+
+
+std::size_t PlanValidator::_factId(const Fact& pFact)
+{
+  auto it = _factToId.find(pFact);
+  if (it != _factToId.end())
+    return it->second;
+
+  auto res = _factIdToGroupId.size();
+  _factIdToFact.push_back(&_factToId.emplace(pFact, res).first->first);
+  if (pFact.fluent())
+  {
+    auto groupId = _groupId(pFact);
+    _factIdToGroupId.push_back(groupId);
+    _groupIdToFactIds[groupId].push_back(res);
+  }
+  else
+  {
+    _factIdToGroupId.push_back(_noGroup);
+  }
+  return res;
+}
+
+
+std::size_t PlanValidator::_groupId(const Fact& pFact)
+{
+  auto groupFact = pFact;
+  groupFact.setValueNegated(false);
+  groupFact.setFluentValue(Entity::anyEntityValue());
+  auto it = _groupToId.find(groupFact);
+  if (it != _groupToId.end())
+    return it->second;
+  auto res = _groupIdToFactIds.size();
+  _groupToId.emplace(std::move(groupFact), res);
+  _groupIdToFactIds.emplace_back();
+  return res;
+}
+
+
+void PlanValidator::_compileCondition(std::vector<Literal>& pLiterals,
+                                      std::vector<FactOptional>* pFactsPtr,
+                                      const Condition& pCondition)
+{
+  if (const auto* nodePtr = pCondition.fcNodePtr())
+  {
+    if (nodePtr->nodeType == ConditionNodeType::AND)
+    {
+      if (nodePtr->leftOperand)
+        _compileCondition(pLiterals, pFactsPtr, *nodePtr->leftOperand);
+      if (nodePtr->rightOperand)
+        _compileCondition(pLiterals, pFactsPtr, *nodePtr->rightOperand);
+      return;
+    }
+  }
+  else if (const auto* factPtr = pCondition.fcFactPtr())
+  {
+    const auto& factOptional = factPtr->factOptional;
+    const auto& fluent = factOptional.fact.fluent();
+    if (fluent && fluent->isAnyValue())
+    {
+      pLiterals.push_back(Literal{factOptional.isFactNegated != factOptional.fact.isValueNegated() ?
+                                  LiteralKind::GROUP_EMPTY : LiteralKind::GROUP_NOT_EMPTY,
+                                  _groupId(factOptional.fact)});
+    }
+    else
+    {
+      auto fact = factOptional.fact;
+      fact.setValueNegated(false);
+      pLiterals.push_back(Literal{factOptional.isFactNegated != factOptional.fact.isValueNegated() ?
+                                  LiteralKind::ABSENT : LiteralKind::PRESENT,
+                                  _factId(fact)});
+    }
+    if (pFactsPtr != nullptr)
+      pFactsPtr->push_back(factOptional);
+    return;
+  }
+  throw std::runtime_error("The condition \"" + pCondition.toStr() + "\" is not handled by the plan validator");
+}
+
+
+void PlanValidator::_compileEffect(std::vector<Effect>& pEffects,
+                                   const WorldStateModification& pWsModification)
+{
+  if (const auto* nodePtr = toWmNode(pWsModification))
+  {
+    if (nodePtr->nodeType == WorldStateModificationNodeType::AND)
+    {
+      if (nodePtr->leftOperand)
+        _compileEffect(pEffects, *nodePtr->leftOperand);
+      if (nodePtr->rightOperand)
+        _compileEffect(pEffects, *nodePtr->rightOperand);
+      return;
+    }
+
+    if (nodePtr->nodeType == WorldStateModificationNodeType::ASSIGN && nodePtr->leftOperand && nodePtr->rightOperand)
+    {
+      const auto* leftFactPtr = toWmFact(*nodePtr->leftOperand);
+      const auto* rightNumberPtr = toWmNumber(*nodePtr->rightOperand);
+      if (leftFactPtr != nullptr && rightNumberPtr != nullptr)
+      {
+        auto fact = leftFactPtr->factOptional.fact;
+        fact.setFluent(Entity::createNumberEntity(rightNumberPtr->getNb()));
+        pEffects.push_back(Effect{EffectKind::CLEAR_GROUP, _groupId(fact)});
+        pEffects.push_back(Effect{EffectKind::ADD, _factId(fact)});
+        return;
+      }
+    }
+  }
+  else if (const auto* factPtr = toWmFact(pWsModification))
+  {
+    const auto& factOptional = factPtr->factOptional;
+    const auto& fluent = factOptional.fact.fluent();
+    if (!factOptional.fact.isValueNegated())
+    {
+      if (fluent && fluent->isAnyValue())
+      {
+        if (factOptional.isFactNegated)
+        {
+          pEffects.push_back(Effect{EffectKind::CLEAR_GROUP, _groupId(factOptional.fact)});
+          return;
+        }
+      }
+      else if (factOptional.isFactNegated)
+      {
+        pEffects.push_back(Effect{EffectKind::REMOVE, _factId(factOptional.fact)});
+        return;
+      }
+      else
+      {
+        if (fluent)
+          pEffects.push_back(Effect{EffectKind::CLEAR_GROUP, _groupId(factOptional.fact)});
+        pEffects.push_back(Effect{EffectKind::ADD, _factId(factOptional.fact)});
+        return;
+      }
+    }
+  }
+  throw std::runtime_error("The effect \"" + pWsModification.toStr() + "\" is not handled by the plan validator");
+}
+
+
+const PlanValidator::GroundAction& PlanValidator::_groundAction(const ActionInvocation& pActionInvocation)
+{
+  auto& parametersToGroundAction = _actionIdToParametersToGroundAction[pActionInvocation.actionId];
+  auto it = parametersToGroundAction.find(pActionInvocation.parameters);
+  if (it != parametersToGroundAction.end())
+    return it->second;
+
+  const auto* actionPtr = _domain.getActionPtr(pActionInvocation.actionId);
+  if (actionPtr == nullptr)
+    throw std::runtime_error("ActionId \"" + pActionInvocation.actionId + "\" not found in the plan validator");
+  const auto* parametersPtr = pActionInvocation.parameters.empty() ? nullptr : &pActionInvocation.parameters;
+
+  GroundAction res;
+  if (actionPtr->precondition)
+  {
+    auto precondition = actionPtr->precondition->clone(parametersPtr);
+    _compileCondition(res.precondition, &res.preconditionFacts, *precondition);
+  }
+  for (const auto* wsModificationPtr : {actionPtr->effect.worldStateModificationAtStart.get(),
+                                        actionPtr->effect.worldStateModification.get(),
+                                        actionPtr->effect.potentialWorldStateModification.get()})
+  {
+    if (wsModificationPtr != nullptr)
+    {
+      auto wsModification = wsModificationPtr->clone(parametersPtr);
+      _compileEffect(res.effects, *wsModification);
+    }
+  }
+  return parametersToGroundAction.emplace(pActionInvocation.parameters, std::move(res)).first->second;
+}
+
+
+void PlanValidator::_addEffectConflicts(std::vector<PlanValidation::EffectConflict>& pEffectConflicts,
+                                        std::size_t pStepIndex,
+                                        const std::vector<const GroundAction*>& pStep) const
+{
+  std::map<std::size_t, std::size_t> addedFactIdToActionIndex;
+  for (std::size_t actionIndex = 0; actionIndex < pStep.size(); ++actionIndex)
+    for (const auto& currEffect : pStep[actionIndex]->effects)
+      if (currEffect.kind == EffectKind::ADD)
+        addedFactIdToActionIndex.emplace(currEffect.id, actionIndex);
+
+  std::set<std::pair<std::size_t, std::size_t>> actionsInConflict;
+  for (std::size_t actionIndex = 0; actionIndex < pStep.size(); ++actionIndex)
+  {
+    const auto& effects = pStep[actionIndex]->effects;
+    auto checkRemovedFact = [&](std::size_t pFactId) {
+      auto it = addedFactIdToActionIndex.find(pFactId);
+      if (it == addedFactIdToActionIndex.end() || it->second == actionIndex)
+        return;
+      // An assignment clears the group of the fluent but it keeps its new value
+      for (const auto& currEffect : effects)
+        if (currEffect.kind == EffectKind::ADD && currEffect.id == pFactId)
+          return;
+      auto actions = std::minmax(it->second, actionIndex);
+      if (actionsInConflict.insert(actions).second)
+        pEffectConflicts.push_back(PlanValidation::EffectConflict{pStepIndex, actions.first, actions.second, *_factIdToFact[pFactId]});
+    };
+
+    for (const auto& currEffect : effects)
+    {
+      if (currEffect.kind == EffectKind::REMOVE)
+        checkRemovedFact(currEffect.id);
+      else if (currEffect.kind == EffectKind::CLEAR_GROUP)
+        for (auto currFactId : _groupIdToFactIds[currEffect.id])
+          checkRemovedFact(currFactId);
+    }
+  }
+}
+
+
+PlanValidation PlanValidator::_validate(const std::vector<std::vector<const ActionInvocation*>>& pSteps)
+{
+  // Ground the actions first because it can add new facts
+  std::vector<std::vector<const GroundAction*>> groundSteps;
+  groundSteps.reserve(pSteps.size());
+  for (const auto& currStep : pSteps)
+  {
+    groundSteps.emplace_back();
+    groundSteps.back().reserve(currStep.size());
+    for (const auto* currActionInvocationPtr : currStep)
+      groundSteps.back().push_back(&_groundAction(*currActionInvocationPtr));
+  }
+
+  std::vector<std::uint64_t> state((_factIdToGroupId.size() + _nbOfBitsPerWord - 1) / _nbOfBitsPerWord, 0);
+  for (auto currFactId : _initialFactIds)
+    _setBit(state, currFactId);
+
+  auto isGroupEmpty = [&](std::size_t pGroupId) {
+    for (auto currFactId : _groupIdToFactIds[pGroupId])
+      if (_hasBit(state, currFactId))
+        return false;
+    return true;
+  };
+  auto isLiteralTrue = [&](const Literal& pLiteral) {
+    switch (pLiteral.kind)
+    {
+    case LiteralKind::PRESENT:
+      return _hasBit(state, pLiteral.id);
+    case LiteralKind::ABSENT:
+      return !_hasBit(state, pLiteral.id);
+    case LiteralKind::GROUP_NOT_EMPTY:
+      return !isGroupEmpty(pLiteral.id);
+    case LiteralKind::GROUP_EMPTY:
+      return isGroupEmpty(pLiteral.id);
+    }
+    return false;
+  };
+
+  PlanValidation res;
+  for (std::size_t stepIndex = 0; stepIndex < groundSteps.size(); ++stepIndex)
+  {
+    const auto& currStep = groundSteps[stepIndex];
+    // Check all the preconditions on the state at the beginning of the step
+    for (std::size_t actionIndex = 0; actionIndex < currStep.size(); ++actionIndex)
+    {
+      const auto& groundAction = *currStep[actionIndex];
+      for (std::size_t i = 0; i < groundAction.precondition.size(); ++i)
+      {
+        if (!isLiteralTrue(groundAction.precondition[i]))
+        {
+          if (res.preconditionFailures.empty() ||
+              res.preconditionFailures.back().stepIndex != stepIndex ||
+              res.preconditionFailures.back().actionIndex != actionIndex)
+            res.preconditionFailures.push_back(PlanValidation::PreconditionFailure{stepIndex, actionIndex, {}});
+          res.preconditionFailures.back().unsatisfiedFacts.push_back(groundAction.preconditionFacts[i]);
+        }
+      }
+    }
+
+    if (currStep.size() > 1)
+      _addEffectConflicts(res.effectConflicts, stepIndex, currStep);
+
+    for (const auto* currGroundActionPtr : currStep)
+    {
+      for (const auto& currEffect : currGroundActionPtr->effects)
+      {
+        switch (currEffect.kind)
+        {
+        case EffectKind::ADD:
+          _setBit(state, currEffect.id);
+          break;
+        case EffectKind::REMOVE:
+          _resetBit(state, currEffect.id);
+          break;
+        case EffectKind::CLEAR_GROUP:
+          for (auto currFactId : _groupIdToFactIds[currEffect.id])
+            _resetBit(state, currFactId);
+          break;
+        }
+      }
+    }
+  }
+
+  res.goalsSatisfied.reserve(_goals.size());
+  for (const auto& currGoal : _goals)
+  {
+    bool isSatisfied = true;
+    for (const auto& currLiteral : currGoal)
+    {
+      if (!isLiteralTrue(currLiteral))
+      {
+        isSatisfied = false;
+        break;
+      }
+    }
+    res.goalsSatisfied.push_back(isSatisfied);
+  }
+  return res;
+}
+
+
+} // !ogp
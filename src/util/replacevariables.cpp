@@ -1,50 +1,173 @@
 #include <orderedgoalsplanner/util/replacevariables.hpp>
 #include <orderedgoalsplanner/util/arithmeticevaluator.hpp>
+#include <memory>
+#include <mutex>
 
 namespace ogp
 {
+namespace
+{
+/// Above this number of templates, the cache is cleared to bound its memory.
+const std::size_t _maxNbOfCachedTemplates = 256;
 
+struct TemplatesCache
+{
+  std::mutex mutex{};
+  std::map<std::string, std::shared_ptr<const CompiledTemplate>> templates{};
+};
+
+/// Get the compiled form of a template, it is compiled only the first time it is seen.
+std::shared_ptr<const CompiledTemplate> _getCompiledTemplate(const std::string& pStr)
+{
+  static TemplatesCache cache;
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto it = cache.templates.find(pStr);
+  if (it != cache.templates.end())
+    return it->second;
+  if (cache.templates.size() >= _maxNbOfCachedTemplates)
+    cache.templates.clear();
+  auto res = std::make_shared<const CompiledTemplate>(pStr);
+  cache.templates.emplace(pStr, res);
+  return res;
+}
+}
 
 void replaceVariables(std::string& pStr,
                       const std::map<std::string, std::string>& pVariablesToValue)
 {
-  // replace variable
-  auto currentPos = pStr.find_first_of("${");
-  while (currentPos != std::string::npos)
+  if (pStr.find_first_of("$`") == std::string::npos)
+    return;
+  pStr = _getCompiledTemplate(pStr)->apply(pVariablesToValue);
+}
+
+
+
+CompiledTemplate::CompiledTemplate(const std::string& pStr)
+  : _parts()
+{
+  std::size_t currentPos = 0;
+  while (currentPos < pStr.size())
   {
-    auto beginOfVarName = currentPos + 2;
-    auto endVarPos = pStr.find("}", beginOfVarName);
-    if (endVarPos != std::string::npos)
+    auto beginOfExpPos = pStr.find("`", currentPos);
+    auto endExpPos = beginOfExpPos != std::string::npos ? pStr.find("`", beginOfExpPos + 1) : std::string::npos;
+    if (endExpPos == std::string::npos)
     {
-      auto varParam = pStr.substr(beginOfVarName, endVarPos - beginOfVarName);
+      _addTextWithVariables(pStr, currentPos, pStr.size());
+      break;
+    }
 
-      auto it = pVariablesToValue.find(varParam);
-      if (it != pVariablesToValue.end())
+    _addTextWithVariables(pStr, currentPos, beginOfExpPos);
+    Part expressionPart;
+    expressionPart.text = pStr.substr(beginOfExpPos + 1, endExpPos - beginOfExpPos - 1);
+    expressionPart.isExpression = true;
+    try {
+      expressionPart.expression.emplace(ArithmeticExpression::compile(expressionPart.text));
+    } catch (...) {}
+    _parts.emplace_back(std::move(expressionPart));
+    currentPos = endExpPos + 1;
+  }
+}
+
+
+std::string CompiledTemplate::apply(const std::map<std::string, std::string>& pVariablesToValue) const
+{
+  std::string res;
+  std::vector<Number> variableValues;
+  for (const auto& currPart : _parts)
+  {
+    if (currPart.isExpression)
+    {
+      if (!currPart.expression)
       {
-        auto& varValue = it->second;
-        pStr.replace(currentPos, endVarPos - currentPos + 1, varValue);
-        currentPos += varValue.size();
+        res += "_";
+        continue;
       }
-      else
+
+      variableValues.clear();
+      for (const auto& currVariable : currPart.expression->variables())
       {
-        currentPos = endVarPos;
+        auto it = pVariablesToValue.find(currVariable);
+        if (it == pVariablesToValue.end())
+          break;
+        auto numberOpt = tryToConvertToNumber(it->second);
+        if (!numberOpt)
+          break;
+        variableValues.emplace_back(*numberOpt);
       }
 
+      if (variableValues.size() < currPart.expression->variables().size())
+      {
+        res += _substituteAndInterpret(currPart.text, pVariablesToValue);
+        continue;
+      }
+      try {
+        res += evaluationResultToStr(currPart.expression->evaluate(variableValues));
+      } catch (...) {
+        res += "_";
+      }
+    }
+    else if (currPart.isVariable)
+    {
+      auto it = pVariablesToValue.find(currPart.text);
+      if (it != pVariablesToValue.end())
+        res += it->second;
+      else
+        res += "${" + currPart.text + "}";
+    }
+    else
+    {
+      res += currPart.text;
     }
-    currentPos = pStr.find_first_of("${", currentPos);
   }
+  return res;
+}
+
 
-  // evalute expressions
-  currentPos = pStr.find("`");
-  while (currentPos != std::string::npos)
+std::string CompiledTemplate::_substituteAndInterpret(const std::string& pExpression,
+                                                      const std::map<std::string, std::string>& pVariablesToValue)
+{
+  std::string expression;
+  CompiledTemplate expressionTemplate;
+  expressionTemplate._addTextWithVariables(pExpression, 0, pExpression.size());
+  for (const auto& currPart : expressionTemplate._parts)
   {
-    auto beginOfExp = currentPos + 1;
-    auto endExpPos = pStr.find("`", beginOfExp);
-    if (endExpPos == std::string::npos)
-      break;
-    pStr.replace(currentPos, endExpPos - currentPos + 1, evaluteToStr(pStr, beginOfExp));
-    currentPos = endExpPos + 1;
-    currentPos = pStr.find("`", currentPos);
+    auto it = currPart.isVariable ? pVariablesToValue.find(currPart.text) : pVariablesToValue.end();
+    if (it != pVariablesToValue.end())
+      expression += it->second;
+    else if (currPart.isVariable)
+      return "_";
+    else
+      expression += currPart.text;
+  }
+  return evaluteToStr(expression);
+}
+
+
+void CompiledTemplate::_addTextWithVariables(const std::string& pStr,
+                                             std::size_t pBeginPos,
+                                             std::size_t pEndPos)
+{
+  auto currentPos = pBeginPos;
+  while (currentPos < pEndPos)
+  {
+    auto beginOfVarPos = pStr.find("${", currentPos);
+    auto endVarPos = beginOfVarPos < pEndPos ? pStr.find("}", beginOfVarPos + 2) : std::string::npos;
+    if (endVarPos == std::string::npos || endVarPos >= pEndPos)
+    {
+      _parts.emplace_back();
+      _parts.back().text = pStr.substr(currentPos, pEndPos - currentPos);
+      return;
+    }
+
+    if (beginOfVarPos > currentPos)
+    {
+      _parts.emplace_back();
+      _parts.back().text = pStr.substr(currentPos, beginOfVarPos - currentPos);
+    }
+    _parts.emplace_back();
+    _parts.back().text = pStr.substr(beginOfVarPos + 2, endVarPos - beginOfVarPos - 2);
+    _parts.back().isVariable = true;
+    currentPos = endVarPos + 1;
   }
 }
 
@@ -0,0 +1,209 @@
+#include "binarysnapshot.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace ogp
+{
+namespace
+{
+const char _magic[4] = {'O', 'G', 'P', 'S'};
+const std::size_t _headerSize = 32;
+const std::uint64_t _fnvOffsetBasis = 14695981039346656037ULL;
+const std::uint64_t _fnvPrime = 1099511628211ULL;
+
+
+std::uint64_t _checksum(std::string_view pData)
+{
+  std::uint64_t res = _fnvOffsetBasis;
+  for (char currChar : pData)
+  {
+    res ^= static_cast<unsigned char>(currChar);
+    res *= _fnvPrime;
+  }
+  return res;
+}
+
+void _writeFixedUInt(std::string& pStr,
+                     std::uint64_t pValue,
+                     std::size_t pNbOfBytes)
+{
+  for (std::size_t i = 0; i < pNbOfBytes; ++i)
+    pStr.push_back(static_cast<char>((pValue >> (8 * i)) & 0xFF));
+}
+
+std::uint64_t _readFixedUInt(std::string_view pStr,
+                             std::size_t pPos,
+                             std::size_t pNbOfBytes)
+{
+  std::uint64_t res = 0;
+  for (std::size_t i = 0; i < pNbOfBytes; ++i)
+    res |= static_cast<std::uint64_t>(static_cast<unsigned char>(pStr[pPos + i])) << (8 * i);
+  return res;
+}
+
+void _writeVarUInt(std::string& pStr,
+                   std::uint64_t pValue)
+{
+  while (pValue >= 0x80)
+  {
+    pStr.push_back(static_cast<char>((pValue & 0x7F) | 0x80));
+    pValue >>= 7;
+  }
+  pStr.push_back(static_cast<char>(pValue));
+}
+
+}
+
+
+void BinarySnapshotWriter::writeUInt(std::uint64_t pValue)
+{
+  _writeVarUInt(_body, pValue);
+}
+
+
+void BinarySnapshotWriter::writeInt(std::int64_t pValue)
+{
+  // Zigzag encoding to have small varints for the small negative numbers
+  _writeVarUInt(_body, (static_cast<std::uint64_t>(pValue) << 1) ^ static_cast<std::uint64_t>(pValue >> 63));
+}
+
+
+void BinarySnapshotWriter::writeFloat(float pValue)
+{
+  std::uint32_t bits = 0;
+  std::memcpy(&bits, &pValue, sizeof(bits));
+  _writeFixedUInt(_body, bits, sizeof(bits));
+}
+
+
+void BinarySnapshotWriter::writeStr(const std::string& pStr)
+{
+  auto itStr = _strToIndex.find(pStr);
+  if (itStr == _strToIndex.end())
+  {
+    itStr = _strToIndex.emplace(pStr, _strs.size()).first;
+    _strs.push_back(&itStr->first);
+  }
+  _writeVarUInt(_body, itStr->second);
+}
+
+
+std::string BinarySnapshotWriter::finalize(BinarySnapshotKind pKind) const
+{
+  std::string payload;
+  _writeVarUInt(payload, _strs.size());
+  for (const auto* currStrPtr : _strs)
+  {
+    _writeVarUInt(payload, currStrPtr->size());
+    payload += *currStrPtr;
+  }
+  payload += _body;
+
+  std::string res;
+  res.reserve(_headerSize + payload.size());
+  res.append(_magic, sizeof(_magic));
+  _writeFixedUInt(res, binarySnapshotFormatVersion, 4);
+  _writeFixedUInt(res, static_cast<std::uint32_t>(pKind), 4);
+  _writeFixedUInt(res, 0, 4);
+  _writeFixedUInt(res, payload.size(), 8);
+  _writeFixedUInt(res, _checksum(payload), 8);
+  res += payload;
+  return res;
+}
+
+
+
+BinarySnapshotReader::BinarySnapshotReader(std::string_view pData,
+                                           BinarySnapshotKind pKind)
+  : _data(),
+    _pos(0),
+    _strs()
+{
+  if (pData.size() < _headerSize || pData.compare(0, sizeof(_magic), std::string_view(_magic, sizeof(_magic))) != 0)
+    throw std::runtime_error("The data is not a binary snapshot");
+  auto formatVersion = _readFixedUInt(pData, 4, 4);
+  if (formatVersion != binarySnapshotFormatVersion)
+    throw std::runtime_error("The binary snapshot has the format version " + std::to_string(formatVersion) +
+                             " but the version " + std::to_string(binarySnapshotFormatVersion) + " is expected");
+  if (_readFixedUInt(pData, 8, 4) != static_cast<std::uint32_t>(pKind))
+    throw std::runtime_error("The binary snapshot does not contain the expected kind of object");
+  auto payloadSize = _readFixedUInt(pData, 16, 8);
+  if (payloadSize != pData.size() - _headerSize)
+    throw std::runtime_error("The binary snapshot is truncated");
+  _data = pData.substr(_headerSize);
+  if (_readFixedUInt(pData, 24, 8) != _checksum(_data))
+    throw std::runtime_error("The binary snapshot is corrupted (wrong checksum)");
+
+  auto nbOfStrs = readSize();
+  _strs.reserve(nbOfStrs);
+  for (std::size_t i = 0; i < nbOfStrs; ++i)
+  {
+    auto strSize = readSize();
+    if (strSize > _data.size() - _pos)
+      throw std::runtime_error("The binary snapshot is truncated");
+    _strs.emplace_back(_data.substr(_pos, strSize));
+    _pos += strSize;
+  }
+}
+
+
+std::uint64_t BinarySnapshotReader::readUInt()
+{
+  std::uint64_t res = 0;
+  for (std::size_t shift = 0; shift < 64; shift += 7)
+  {
+    auto currByte = readByte();
+    res |= static_cast<std::uint64_t>(currByte & 0x7F) << shift;
+    if ((currByte & 0x80) == 0)
+      return res;
+  }
+  throw std::runtime_error("Invalid integer in the binary snapshot");
+}
+
+
+std::size_t BinarySnapshotReader::readSize()
+{
+  auto res = readUInt();
+  if (res > _data.size())
+    throw std::runtime_error("Invalid size in the binary snapshot");
+  return static_cast<std::size_t>(res);
+}
+
+
+std::int64_t BinarySnapshotReader::readInt()
+{
+  auto value = readUInt();
+  return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+
+float BinarySnapshotReader::readFloat()
+{
+  if (_data.size() - _pos < 4)
+    throw std::runtime_error("The binary snapshot is truncated");
+  auto bits = static_cast<std::uint32_t>(_readFixedUInt(_data, _pos, 4));
+  _pos += 4;
+  float res = 0;
+  std::memcpy(&res, &bits, sizeof(res));
+  return res;
+}
+
+
+std::uint8_t BinarySnapshotReader::readByte()
+{
+  if (_pos >= _data.size())
+    throw std::runtime_error("The binary snapshot is truncated");
+  return static_cast<std::uint8_t>(_data[_pos++]);
+}
+
+
+const std::string& BinarySnapshotReader::readStr()
+{
+  auto index = readUInt();
+  if (index >= _strs.size())
+    throw std::runtime_error("Invalid string index in the binary snapshot");
+  return _strs[static_cast<std::size_t>(index)];
+}
+
+
+} // !ogp
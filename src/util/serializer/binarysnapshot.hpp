@@ -0,0 +1,102 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_UTIL_SERIALIZER_BINARYSNAPSHOT_HPP
+#define ORDEREDGOALSPLANNER_SRC_UTIL_SERIALIZER_BINARYSNAPSHOT_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ogp
+{
+
+/**
+ * Layout of a binary snapshot:<br/>
+ * - header of 32 bytes: magic, format version, kind of snapshot, reserved, payload size, payload checksum<br/>
+ * - payload: table of the strings, then the body that refers to the strings by their index.<br/>
+ * All the integers are stored in little endian, the integers of the payload are stored as varints.
+ */
+enum class BinarySnapshotKind : std::uint32_t
+{
+  DOMAIN_SNAPSHOT = 1,
+  PROBLEM_SNAPSHOT = 2
+};
+
+/// Version of the format. It has to be incremented each time the layout of the payload changes.
+constexpr std::uint32_t binarySnapshotFormatVersion = 3;
+
+/// Tags of the condition nodes.
+enum class BinaryConditionTag : std::uint8_t
+{
+  NONE,
+  NODE,
+  EXISTS,
+  NOT,
+  FACT,
+  NUMBER
+};
+
+/// Tags of the world state modification nodes.
+enum class BinaryWsModificationTag : std::uint8_t
+{
+  NONE,
+  NODE,
+  FACT,
+  NUMBER
+};
+
+
+/// Write a binary snapshot.
+struct BinarySnapshotWriter
+{
+  void writeUInt(std::uint64_t pValue);
+  void writeInt(std::int64_t pValue);
+  void writeFloat(float pValue);
+  void writeBool(bool pValue) { _body.push_back(pValue ? 1 : 0); }
+  void writeByte(std::uint8_t pValue) { _body.push_back(static_cast<char>(pValue)); }
+  void writeStr(const std::string& pStr);
+
+  /// Create the snapshot with its header.
+  std::string finalize(BinarySnapshotKind pKind) const;
+
+private:
+  std::string _body;
+  std::vector<const std::string*> _strs;
+  std::unordered_map<std::string, std::size_t> _strToIndex;
+};
+
+
+/// Read a binary snapshot. The data read are not copied, so they have to outlive this object.
+struct BinarySnapshotReader
+{
+  /**
+   * @brief Check the header, the checksum and read the table of strings.
+   * @param[in] pData Snapshot, it can be a view on a memory mapped file.
+   * @param[in] pKind Kind of snapshot expected.
+   * An exception is raised if the snapshot is not valid.
+   */
+  BinarySnapshotReader(std::string_view pData,
+                       BinarySnapshotKind pKind);
+
+  std::uint64_t readUInt();
+  std::size_t readSize();
+  std::int64_t readInt();
+  float readFloat();
+  bool readBool() { return readByte() != 0; }
+  std::uint8_t readByte();
+  const std::string& readStr();
+
+  /// Check that all the snapshot has been read.
+  bool isAtEnd() const { return _pos == _data.size(); }
+
+private:
+  std::string_view _data;
+  std::size_t _pos;
+  std::vector<std::string> _strs;
+};
+
+
+} // !ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_UTIL_SERIALIZER_BINARYSNAPSHOT_HPP
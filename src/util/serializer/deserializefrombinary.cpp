@@ -0,0 +1,395 @@
+#include <orderedgoalsplanner/util/serializer/deserializefrombinary.hpp>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/types/setofcallbacks.hpp>
+#include "../../types/worldstatemodificationprivate.hpp"
+#include "binarysnapshot.hpp"
+
+
+namespace ogp
+{
+namespace
+{
+/// Maximum number of times that an action can have been done in a snapshot, a bigger value means that it is corrupted.
+const std::uint64_t _maxNbOfTimesAnActionWasDone = 1ULL << 40;
+
+
+const Type* _binaryToType(BinarySnapshotReader& pReader,
+                                    const SetOfTypes& pSetOfTypes)
+{
+  const auto& typeName = pReader.readStr();
+  if (typeName.empty())
+    return {};
+  return pSetOfTypes.nameToType(typeName);
+}
+
+std::vector<Parameter> _binaryToParameters(BinarySnapshotReader& pReader,
+                                           const SetOfTypes& pSetOfTypes)
+{
+  std::vector<Parameter> res;
+  auto nbOfParameters = pReader.readSize();
+  res.reserve(nbOfParameters);
+  for (std::size_t i = 0; i < nbOfParameters; ++i)
+  {
+    const auto& name = pReader.readStr();
+    res.emplace_back(name, _binaryToType(pReader, pSetOfTypes));
+  }
+  return res;
+}
+
+Parameter _binaryToParameter(BinarySnapshotReader& pReader,
+                             const SetOfTypes& pSetOfTypes)
+{
+  auto parameters = _binaryToParameters(pReader, pSetOfTypes);
+  if (parameters.size() != 1)
+    throw std::runtime_error("Expected one parameter in the binary snapshot");
+  return parameters.front();
+}
+
+Entity _binaryToEntity(BinarySnapshotReader& pReader,
+                       const SetOfTypes& pSetOfTypes)
+{
+  const auto& value = pReader.readStr();
+  return Entity(value, _binaryToType(pReader, pSetOfTypes));
+}
+
+Predicate _binaryToPredicate(BinarySnapshotReader& pReader,
+                             const SetOfTypes& pSetOfTypes)
+{
+  const auto& name = pReader.readStr();
+  auto parameters = _binaryToParameters(pReader, pSetOfTypes);
+  return Predicate(name, parameters, _binaryToType(pReader, pSetOfTypes));
+}
+
+Fact _binaryToFact(BinarySnapshotReader& pReader,
+                   const SetOfTypes& pSetOfTypes)
+{
+  auto predicate = _binaryToPredicate(pReader, pSetOfTypes);
+  std::vector<Entity> arguments;
+  auto nbOfArguments = pReader.readSize();
+  arguments.reserve(nbOfArguments);
+  for (std::size_t i = 0; i < nbOfArguments; ++i)
+    arguments.emplace_back(_binaryToEntity(pReader, pSetOfTypes));
+  std::optional<Entity> fluent;
+  if (pReader.readBool())
+    fluent.emplace(_binaryToEntity(pReader, pSetOfTypes));
+  bool isFluentNegated = pReader.readBool();
+  return Fact(predicate, std::move(arguments), std::move(fluent), isFluentNegated);
+}
+
+FactOptional _binaryToFactOptional(BinarySnapshotReader& pReader,
+                                   const SetOfTypes& pSetOfTypes)
+{
+  bool isFactNegated = pReader.readBool();
+  return FactOptional(_binaryToFact(pReader, pSetOfTypes), isFactNegated);
+}
+
+Number _binaryToNumber(BinarySnapshotReader& pReader)
+{
+  if (pReader.readByte() == 0)
+    return static_cast<int>(pReader.readInt());
+  return pReader.readFloat();
+}
+
+std::set<std::string> _binaryToIds(BinarySnapshotReader& pReader)
+{
+  std::set<std::string> res;
+  auto nbOfIds = pReader.readSize();
+  for (std::size_t i = 0; i < nbOfIds; ++i)
+    res.insert(res.end(), pReader.readStr());
+  return res;
+}
+
+void _binaryToSuccessions(BinarySnapshotReader& pReader,
+                          Successions& pSuccessions)
+{
+  pSuccessions.actions = _binaryToIds(pReader);
+  auto nbOfSetOfEvents = pReader.readSize();
+  for (std::size_t i = 0; i < nbOfSetOfEvents; ++i)
+  {
+    const auto& setOfEventsId = pReader.readStr();
+    pSuccessions.events[setOfEventsId] = _binaryToIds(pReader);
+  }
+}
+
+template <typename ENUM>
+ENUM _binaryToEnum(BinarySnapshotReader& pReader,
+                   ENUM pLastValue)
+{
+  auto value = pReader.readUInt();
+  if (value > static_cast<std::uint64_t>(pLastValue))
+    throw std::runtime_error("Invalid enum value in the binary snapshot");
+  return static_cast<ENUM>(value);
+}
+
+std::unique_ptr<Condition> _binaryToCondition(BinarySnapshotReader& pReader,
+                                              const SetOfTypes& pSetOfTypes)
+{
+  auto tag = static_cast<BinaryConditionTag>(pReader.readByte());
+  switch (tag)
+  {
+  case BinaryConditionTag::NONE:
+    return {};
+  case BinaryConditionTag::NODE:
+  {
+    auto nodeType = _binaryToEnum(pReader, ConditionNodeType::MINUS);
+    auto leftOperand = _binaryToCondition(pReader, pSetOfTypes);
+    auto rightOperand = _binaryToCondition(pReader, pSetOfTypes);
+    return std::make_unique<ConditionNode>(nodeType, std::move(leftOperand), std::move(rightOperand));
+  }
+  case BinaryConditionTag::EXISTS:
+  {
+    auto parameter = _binaryToParameter(pReader, pSetOfTypes);
+    return std::make_unique<ConditionExists>(parameter, _binaryToCondition(pReader, pSetOfTypes));
+  }
+  case BinaryConditionTag::NOT:
+    return std::make_unique<ConditionNot>(_binaryToCondition(pReader, pSetOfTypes));
+  case BinaryConditionTag::FACT:
+    return std::make_unique<ConditionFact>(_binaryToFactOptional(pReader, pSetOfTypes));
+  case BinaryConditionTag::NUMBER:
+    return std::make_unique<ConditionNumber>(_binaryToNumber(pReader));
+  }
+  throw std::runtime_error("Invalid condition in the binary snapshot");
+}
+
+std::unique_ptr<WorldStateModification> _binaryToWsModification(BinarySnapshotReader& pReader,
+                                                                const SetOfTypes& pSetOfTypes)
+{
+  auto tag = static_cast<BinaryWsModificationTag>(pReader.readByte());
+  switch (tag)
+  {
+  case BinaryWsModificationTag::NONE:
+    return {};
+  case BinaryWsModificationTag::NODE:
+  {
+    auto nodeType = _binaryToEnum(pReader, WorldStateModificationNodeType::MINUS);
+    std::optional<Parameter> parameterOpt;
+    if (pReader.readBool())
+      parameterOpt.emplace(_binaryToParameter(pReader, pSetOfTypes));
+    auto leftOperand = _binaryToWsModification(pReader, pSetOfTypes);
+    auto rightOperand = _binaryToWsModification(pReader, pSetOfTypes);
+    auto res = std::make_unique<WorldStateModificationNode>(nodeType, std::move(leftOperand), std::move(rightOperand), parameterOpt);
+    _binaryToSuccessions(pReader, res->successions());
+    return res;
+  }
+  case BinaryWsModificationTag::FACT:
+  {
+    auto res = std::make_unique<WorldStateModificationFact>(_binaryToFactOptional(pReader, pSetOfTypes));
+    _binaryToSuccessions(pReader, res->successions());
+    return res;
+  }
+  case BinaryWsModificationTag::NUMBER:
+    return std::make_unique<WorldStateModificationNumber>(_binaryToNumber(pReader));
+  }
+  throw std::runtime_error("Invalid world state modification in the binary snapshot");
+}
+
+Goal _binaryToGoal(BinarySnapshotReader& pReader,
+                   const SetOfTypes& pSetOfTypes)
+{
+  auto objective = _binaryToCondition(pReader, pSetOfTypes);
+  if (!objective)
+    throw std::runtime_error("Goal without objective in the binary snapshot");
+  bool isPersistent = pReader.readBool();
+  bool isOneStepTowards = pReader.readBool();
+  auto maxTimeToKeepInactive = static_cast<int>(pReader.readInt());
+  const auto& goalGroupId = pReader.readStr();
+  return Goal(std::move(objective), isPersistent, isOneStepTowards, maxTimeToKeepInactive, goalGroupId);
+}
+
+std::vector<Goal> _binaryToGoals(BinarySnapshotReader& pReader,
+                                 const SetOfTypes& pSetOfTypes)
+{
+  std::vector<Goal> res;
+  auto nbOfGoals = pReader.readSize();
+  res.reserve(nbOfGoals);
+  for (std::size_t i = 0; i < nbOfGoals; ++i)
+    res.emplace_back(_binaryToGoal(pReader, pSetOfTypes));
+  return res;
+}
+
+std::map<int, std::vector<Goal>> _binaryToPriorityToGoals(BinarySnapshotReader& pReader,
+                                                          const SetOfTypes& pSetOfTypes)
+{
+  std::map<int, std::vector<Goal>> res;
+  auto nbOfPriorities = pReader.readSize();
+  for (std::size_t i = 0; i < nbOfPriorities; ++i)
+  {
+    auto priority = static_cast<int>(pReader.readInt());
+    res.emplace(priority, _binaryToGoals(pReader, pSetOfTypes));
+  }
+  return res;
+}
+
+Action _binaryToAction(BinarySnapshotReader& pReader,
+                       const SetOfTypes& pSetOfTypes)
+{
+  auto parameters = _binaryToParameters(pReader, pSetOfTypes);
+  auto precondition = _binaryToCondition(pReader, pSetOfTypes);
+  auto overAllCondition = _binaryToCondition(pReader, pSetOfTypes);
+  auto preferInContext = _binaryToCondition(pReader, pSetOfTypes);
+  ProblemModification effect;
+  effect.worldStateModification = _binaryToWsModification(pReader, pSetOfTypes);
+  effect.potentialWorldStateModification = _binaryToWsModification(pReader, pSetOfTypes);
+  effect.worldStateModificationAtStart = _binaryToWsModification(pReader, pSetOfTypes);
+  effect.goalsToAdd = _binaryToPriorityToGoals(pReader, pSetOfTypes);
+  effect.goalsToAddInCurrentPriority = _binaryToGoals(pReader, pSetOfTypes);
+
+  Action res(std::move(precondition), std::move(effect), std::move(preferInContext));
+  res.parameters = std::move(parameters);
+  res.overAllCondition = std::move(overAllCondition);
+  res.highImportanceOfNotRepeatingIt = pReader.readBool();
+  res.canThisActionBeUsedByThePlanner = pReader.readBool();
+  res.actionsSuccessionsWithoutInterestCache = _binaryToIds(pReader);
+  res.actionsPredecessorsCache = _binaryToIds(pReader);
+  res.eventsPredecessorsCache = _binaryToIds(pReader);
+  return res;
+}
+
+Event _binaryToEvent(BinarySnapshotReader& pReader,
+                     const SetOfTypes& pSetOfTypes)
+{
+  auto parameters = _binaryToParameters(pReader, pSetOfTypes);
+  auto precondition = _binaryToCondition(pReader, pSetOfTypes);
+  auto factsToModify = _binaryToWsModification(pReader, pSetOfTypes);
+  auto goalsToAdd = _binaryToPriorityToGoals(pReader, pSetOfTypes);
+  Event res(std::move(precondition), std::move(factsToModify), parameters, goalsToAdd);
+  res.actionsPredecessorsCache = _binaryToIds(pReader);
+  res.eventsPredecessorsCache = _binaryToIds(pReader);
+  return res;
+}
+
+}
+
+
+
+Domain binaryToDomain(std::string_view pData)
+{
+  BinarySnapshotReader reader(pData, BinarySnapshotKind::DOMAIN_SNAPSHOT);
+  std::string name = reader.readStr();
+
+  std::set<std::string> requirements;
+  auto nbOfRequirements = reader.readSize();
+  for (std::size_t i = 0; i < nbOfRequirements; ++i)
+    requirements.insert(reader.readStr());
+
+  Ontology ontology;
+  auto nbOfTypes = reader.readSize();
+  for (std::size_t i = 0; i < nbOfTypes; ++i)
+  {
+    const auto& typeName = reader.readStr();
+    ontology.types.addType(typeName, reader.readStr());
+  }
+
+  auto nbOfPredicates = reader.readSize();
+  for (std::size_t i = 0; i < nbOfPredicates; ++i)
+    ontology.predicates.addPredicate(_binaryToPredicate(reader, ontology.types));
+
+  auto nbOfConstants = reader.readSize();
+  for (std::size_t i = 0; i < nbOfConstants; ++i)
+    ontology.constants.add(_binaryToEntity(reader, ontology.types));
+
+  auto nbOfDerivedPredicates = reader.readSize();
+  for (std::size_t i = 0; i < nbOfDerivedPredicates; ++i)
+  {
+    auto predicate = _binaryToPredicate(reader, ontology.types);
+    ontology.derivedPredicates.addDerivedPredicate(DerivedPredicate(predicate, _binaryToCondition(reader, ontology.types)));
+  }
+  ontology.derivedPredicates.setMaterialized(reader.readBool());
+
+  SetOfConstFacts timelessFacts;
+  auto nbOfTimelessFacts = reader.readSize();
+  for (std::size_t i = 0; i < nbOfTimelessFacts; ++i)
+    timelessFacts.add(_binaryToFact(reader, ontology.types));
+
+  std::map<ActionId, Action> actions;
+  auto nbOfActions = reader.readSize();
+  for (std::size_t i = 0; i < nbOfActions; ++i)
+  {
+    const auto& actionId = reader.readStr();
+    actions.emplace(actionId, _binaryToAction(reader, ontology.types));
+  }
+
+  std::map<SetOfEventsId, SetOfEvents> idToSetOfEvents;
+  auto nbOfSetOfEvents = reader.readSize();
+  for (std::size_t i = 0; i < nbOfSetOfEvents; ++i)
+  {
+    auto& setOfEvents = idToSetOfEvents[reader.readStr()];
+    auto nbOfEvents = reader.readSize();
+    for (std::size_t j = 0; j < nbOfEvents; ++j)
+    {
+      const auto& eventId = reader.readStr();
+      setOfEvents.add(_binaryToEvent(reader, ontology.types), eventId);
+    }
+  }
+
+  if (!reader.isAtEnd())
+    throw std::runtime_error("Unexpected data at the end of the binary snapshot");
+
+  // The succession caches are restored from the snapshot instead of being recomputed
+  auto res = Domain::fromActionsWithSuccessionCaches(actions, ontology, idToSetOfEvents, timelessFacts, name);
+  for (const auto& currRequirement : requirements)
+    res.addRequirement(currRequirement);
+  return res;
+}
+
+
+DomainAndProblemPtrs binaryToProblem(std::string_view pData,
+                                     const std::map<std::string, Domain>& pLoadedDomains)
+{
+  DomainAndProblemPtrs res;
+  BinarySnapshotReader reader(pData, BinarySnapshotKind::PROBLEM_SNAPSHOT);
+  const auto& domainName = reader.readStr();
+  auto itDomain = pLoadedDomains.find(domainName);
+  if (itDomain == pLoadedDomains.end())
+    throw std::runtime_error("Domain \"" + domainName + "\" is unknown!");
+  res.domainPtr = std::make_unique<Domain>(itDomain->second);
+  res.problemPtr = std::make_unique<Problem>(&res.domainPtr->getTimelessFacts().setOfFacts());
+  auto& problem = *res.problemPtr;
+  const auto& ontology = res.domainPtr->getOntology();
+  problem.name = reader.readStr();
+
+  auto nbOfEntities = reader.readSize();
+  for (std::size_t i = 0; i < nbOfEntities; ++i)
+    problem.entities.add(_binaryToEntity(reader, ontology.types));
+
+  std::vector<Fact> factsThatCanBeRemoved;
+  std::vector<Fact> factsThatCannotBeRemoved;
+  auto nbOfFacts = reader.readSize();
+  factsThatCanBeRemoved.reserve(nbOfFacts);
+  for (std::size_t i = 0; i < nbOfFacts; ++i)
+  {
+    auto fact = _binaryToFact(reader, ontology.types);
+    if (reader.readBool())
+      factsThatCanBeRemoved.emplace_back(std::move(fact));
+    else
+      factsThatCannotBeRemoved.emplace_back(std::move(fact));
+  }
+  const SetOfCallbacks callbacks;
+  if (!factsThatCanBeRemoved.empty())
+    problem.worldState.addFacts(factsThatCanBeRemoved, problem.goalStack, {}, callbacks,
+                                ontology, problem.entities, {}, true);
+  if (!factsThatCannotBeRemoved.empty())
+    problem.worldState.addFacts(factsThatCannotBeRemoved, problem.goalStack, {}, callbacks,
+                                ontology, problem.entities, {}, false);
+
+  auto goals = _binaryToPriorityToGoals(reader, ontology.types);
+  problem.goalStack.addGoals(goals, problem.worldState, {});
+
+  auto nbOfActionsDone = reader.readSize();
+  for (std::size_t i = 0; i < nbOfActionsDone; ++i)
+  {
+    const auto& actionId = reader.readStr();
+    auto nbOfTimes = reader.readUInt();
+    if (nbOfTimes == 0 || nbOfTimes > _maxNbOfTimesAnActionWasDone)
+      throw std::runtime_error("Invalid number of times that the action \"" + actionId + "\" was done in the binary snapshot");
+    problem.historical.setNbOfTimeAnActionHasAlreadyBeenDone(actionId, static_cast<std::size_t>(nbOfTimes));
+  }
+
+  if (!reader.isAtEnd())
+    throw std::runtime_error("Unexpected data at the end of the binary snapshot");
+  return res;
+}
+
+
+} // !ogp
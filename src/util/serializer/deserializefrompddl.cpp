@@ -1,11 +1,18 @@
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <memory>
+#include <thread>
 #include <orderedgoalsplanner/types/axiom.hpp>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
 #include <orderedgoalsplanner/types/setofcallbacks.hpp>
+#include <orderedgoalsplanner/util/trace.hpp>
 #include "../../types/expressionParsed.hpp"
+#include "../../types/expressionParsedView.hpp"
 #include "../../types/worldstatemodificationprivate.hpp"
+#include "../plannerstatsrecorder.hpp"
 
 namespace ogp
 {
@@ -499,7 +506,7 @@ std::unique_ptr<WorldStateModification> _expressionParsedToWsModification(const
   return res;
 }
 
-std::vector<Parameter> _pddlToParameters(const std::string& pStr,
+std::vector<Parameter> _pddlToParameters(std::string_view pStr,
                                          std::size_t& pPos,
                                          const SetOfTypes& pSetOfTypes)
 {
@@ -510,7 +517,7 @@ std::vector<Parameter> _pddlToParameters(const std::string& pStr,
     return res;
 
   if (pStr[pPos] != '(')
-    throw std::runtime_error("Parameters does not start with '(' in: " + pStr.substr(pPos, strSize - pPos));
+    throw std::runtime_error("Parameters does not start with '(' in: " + std::string(pStr.substr(pPos, strSize - pPos)));
 
   ++pPos;
   ExpressionParsed::skipSpaces(pStr, pPos);
@@ -527,7 +534,7 @@ std::vector<Parameter> _pddlToParameters(const std::string& pStr,
     }
     else if (ExpressionParsed::isEndOfTokenSeparator(pStr[pPos]))
     {
-      auto token = pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
+      auto token = std::string(pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos));
       if (token == "-")
       {
         nextIsAParameterName = false;
@@ -553,7 +560,7 @@ std::vector<Parameter> _pddlToParameters(const std::string& pStr,
   }
 
   // Manage last token
-  auto lastToken = pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
+  auto lastToken = std::string(pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos));
   if (lastToken != "")
   {
     if (nextIsAParameterName)
@@ -677,7 +684,7 @@ ExpressionParsed _extractWsModificationPart(const ExpressionParsed& pInput,
 }
 
 
-Axiom _pddlToAxiom(const std::string& pStr,
+Axiom _pddlToAxiom(std::string_view pStr,
                    std::size_t& pPos,
                    const Ontology& pOntology)
 {
@@ -704,7 +711,7 @@ Axiom _pddlToAxiom(const std::string& pStr,
     else if (subToken == ":implies")
       impliesPtr = std::make_unique<Fact>(Fact::fromPddl(pStr, pOntology, {}, vars, pPos, &pPos));
     else
-      throw std::runtime_error("Unknown axiom token \"" + subToken + "\" in: " + pStr.substr(beginPos, strSize - beginPos));
+      throw std::runtime_error("Unknown axiom token \"" + subToken + "\" in: " + std::string(pStr.substr(beginPos, strSize - beginPos)));
   }
 
   if (!impliesPtr)
@@ -713,7 +720,25 @@ Axiom _pddlToAxiom(const std::string& pStr,
 }
 
 
-Event _pddlToEvent(const std::string& pStr,
+DerivedPredicate _pddlToDerivedPredicate(std::string_view pStr,
+                                         std::size_t& pPos,
+                                         const Ontology& pOntology)
+{
+  ExpressionParsed::skipSpaces(pStr, pPos);
+  Predicate predicate(pStr, true, pOntology.types, pPos, &pPos);
+  std::vector<Parameter> parameters;
+  for (const auto& currParam : predicate.parameters)
+    if (currParam.isAParameterToFill())
+      parameters.emplace_back(currParam);
+  auto condition = pddlToCondition(pStr, pPos, pOntology, {}, parameters);
+  if (!condition)
+    throw std::runtime_error("The derived predicate \"" + predicate.name + "\" has no condition");
+  ExpressionParsed::skipSpaces(pStr, pPos);
+  return DerivedPredicate(predicate, std::move(condition));
+}
+
+
+Event _pddlToEvent(std::string_view pStr,
                    std::size_t& pPos,
                    const Ontology& pOntology)
 {
@@ -740,7 +765,7 @@ Event _pddlToEvent(const std::string& pStr,
     else if (subToken == ":effect")
       effect = pddlToWsModification(pStr, pPos, pOntology, {}, parameters);
     else
-      throw std::runtime_error("Unknown event token \"" + subToken + "\" in: " + pStr.substr(beginPos, strSize - beginPos));
+      throw std::runtime_error("Unknown event token \"" + subToken + "\" in: " + std::string(pStr.substr(beginPos, strSize - beginPos)));
   }
 
   if (!precondition)
@@ -750,7 +775,7 @@ Event _pddlToEvent(const std::string& pStr,
   return Event(std::move(precondition), std::move(effect), std::move(parameters));
 }
 
-Action _actionPddlToAction(const std::string& pStr,
+Action _actionPddlToAction(std::string_view pStr,
                            std::size_t& pPos,
                            const Ontology& pOntology)
 {
@@ -777,7 +802,7 @@ Action _actionPddlToAction(const std::string& pStr,
     else if (subToken == ":effect")
       effect = pddlToWsModification(pStr, pPos, pOntology, {}, parameters);
     else
-      throw std::runtime_error("Unknown axiom token \"" + subToken + "\" in: " + pStr.substr(beginPos, strSize - beginPos));
+      throw std::runtime_error("Unknown axiom token \"" + subToken + "\" in: " + std::string(pStr.substr(beginPos, strSize - beginPos)));
   }
 
   if (!effect)
@@ -788,7 +813,7 @@ Action _actionPddlToAction(const std::string& pStr,
 }
 
 
-Action _durativeActionPddlToAction(const std::string& pStr,
+Action _durativeActionPddlToAction(std::string_view pStr,
                                    std::size_t& pPos,
                                    const Ontology& pOntology)
 {
@@ -850,7 +875,7 @@ Action _durativeActionPddlToAction(const std::string& pStr,
     }
     else
     {
-      throw std::runtime_error("Unknown axiom token \"" + subToken + "\" in: " + pStr.substr(beginPos, strSize - beginPos));
+      throw std::runtime_error("Unknown axiom token \"" + subToken + "\" in: " + std::string(pStr.substr(beginPos, strSize - beginPos)));
     }
   }
 
@@ -867,17 +892,355 @@ Action _durativeActionPddlToAction(const std::string& pStr,
   return res;
 }
 
+
+std::string_view _parseToken(std::string_view pStr,
+                             std::size_t& pPos)
+{
+  std::size_t beginOfTokenPos = pPos;
+  auto res = ExpressionParsedView::parseTokenThatCanBeEmpty(pStr, pPos);
+  if (res.empty())
+    throw std::runtime_error("Empty token in str " + std::string(pStr.substr(beginOfTokenPos)));
+  return res;
+}
+
+
+/// Move the position after the end of the expression that begins at the position (comments are skipped).
+void _moveUntilEndOfExpression(std::string_view pStr,
+                               std::size_t& pPos)
+{
+  ExpressionParsedView::skipSpaces(pStr, pPos);
+  auto strSize = pStr.size();
+  if (pPos >= strSize)
+    return;
+  if (pStr[pPos] != '(')
+  {
+    ExpressionParsedView::parseTokenThatCanBeEmpty(pStr, pPos);
+    return;
+  }
+
+  std::size_t depth = 0;
+  while (pPos < strSize)
+  {
+    if (pStr[pPos] == ';')
+    {
+      ExpressionParsedView::moveUntilEndOfLine(pStr, pPos);
+      continue;
+    }
+    if (pStr[pPos] == '(')
+    {
+      ++depth;
+    }
+    else if (pStr[pPos] == ')')
+    {
+      --depth;
+      if (depth == 0)
+      {
+        ++pPos;
+        return;
+      }
+    }
+    ++pPos;
+  }
+}
+
+
+/// Move the position to the parenthesis that closes the block where the position is (comments are skipped).
+void _moveUntilEndOfBlock(std::string_view pStr,
+                          std::size_t& pPos)
+{
+  std::size_t depth = 0;
+  auto strSize = pStr.size();
+  while (pPos < strSize)
+  {
+    if (pStr[pPos] == ';')
+    {
+      ExpressionParsedView::moveUntilEndOfLine(pStr, pPos);
+      continue;
+    }
+    if (pStr[pPos] == '(')
+    {
+      ++depth;
+    }
+    else if (pStr[pPos] == ')')
+    {
+      if (depth == 0)
+        return;
+      --depth;
+    }
+    ++pPos;
+  }
+}
+
+
+enum class DomainBlockType
+{
+  ACTION,
+  DURATIVE_ACTION,
+  EVENT,
+  AXIOM
+};
+
+/// Block of a domain that can be parsed independently from the other blocks once the ontology is known.
+struct DomainBlock
+{
+  DomainBlock(DomainBlockType pType,
+              std::string pName,
+              std::size_t pBeginPos)
+    : type(pType),
+      name(std::move(pName)),
+      beginPos(pBeginPos),
+      actionPtr(),
+      events(),
+      error()
+  {
+  }
+
+  DomainBlockType type;
+  std::string name;
+  std::size_t beginPos;
+  std::unique_ptr<Action> actionPtr;
+  std::list<Event> events;
+  std::exception_ptr error;
+};
+
+
+void _parseDomainBlock(DomainBlock& pBlock,
+                       std::string_view pStr,
+                       std::size_t& pPos,
+                       const Ontology& pOntology)
+{
+  switch (pBlock.type)
+  {
+  case DomainBlockType::ACTION:
+    pBlock.actionPtr = std::make_unique<Action>(_actionPddlToAction(pStr, pPos, pOntology));
+    break;
+  case DomainBlockType::DURATIVE_ACTION:
+    pBlock.actionPtr = std::make_unique<Action>(_durativeActionPddlToAction(pStr, pPos, pOntology));
+    break;
+  case DomainBlockType::EVENT:
+    pBlock.events.emplace_back(_pddlToEvent(pStr, pPos, pOntology));
+    break;
+  case DomainBlockType::AXIOM:
+    pBlock.events = _pddlToAxiom(pStr, pPos, pOntology).toEvents(pOntology, {});
+    break;
+  }
+}
+
+
+/// Parse the blocks on several threads. The errors are stored in the blocks.
+void _parseDomainBlocksInParallel(std::vector<DomainBlock>& pBlocks,
+                                  std::string_view pStr,
+                                  const Ontology& pOntology,
+                                  std::size_t pNbOfThreads)
+{
+  std::atomic<std::size_t> nextBlockIndex{0};
+  auto parseBlocks = [&]() {
+    for (auto i = nextBlockIndex++; i < pBlocks.size(); i = nextBlockIndex++)
+    {
+      auto& block = pBlocks[i];
+      try
+      {
+        std::size_t pos = block.beginPos;
+        _parseDomainBlock(block, pStr, pos, pOntology);
+      }
+      catch (...)
+      {
+        block.error = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < std::min(pNbOfThreads, pBlocks.size()); ++i)
+    threads.emplace_back(parseBlocks);
+  parseBlocks();
+  for (auto& currThread : threads)
+    currThread.join();
+}
+
+
+void _addDomainBlock(DomainBlock& pBlock,
+                     std::map<ActionId, Action>& pActions,
+                     std::map<SetOfEventsId, SetOfEvents>& pIdToSetOfEvents)
+{
+  if (pBlock.error)
+    std::rethrow_exception(pBlock.error);
+  if (pBlock.actionPtr)
+    pActions.emplace(pBlock.name, std::move(*pBlock.actionPtr));
+  const std::string eventId = pBlock.type == DomainBlockType::AXIOM ? "from_axiom" : pBlock.name;
+  for (auto& currEvent : pBlock.events)
+    pIdToSetOfEvents[Domain::getSetOfEventsIdFromConstructor()].add(currEvent, eventId);
+}
+
+
+/**
+ * @brief Parse a PDDL problem.
+ * @param[in] pStr PDDL content of the problem.
+ * @param[in] pLoadedDomains Domains already loaded.
+ * @param[out] pDomainPtr Domain of the problem.
+ * @param[out] pDomainCopyPtr If it is not nullptr, the domain of the problem is copied inside and the problem refers
+ * to this copy. Otherwise the problem refers to the domain inside pLoadedDomains.
+ * @return The problem parsed.
+ */
+std::unique_ptr<Problem> _pddlToProblem(std::string_view pStr,
+                                        const std::map<std::string, Domain>& pLoadedDomains,
+                                        const Domain*& pDomainPtr,
+                                        std::unique_ptr<Domain>* pDomainCopyPtr)
+{
+  TraceSpan traceSpan("pddlToProblem");
+  ORDEREDGOALSPLANNER_ALLOCATION_PHASE(PARSING);
+  std::unique_ptr<Problem> problemPtr;
+  std::string problemName;
+
+  const std::string defineToken = "(define";
+  std::size_t found = pStr.find(defineToken);
+  if (found != std::string::npos)
+  {
+    auto strSize = pStr.size();
+    std::size_t pos = found + defineToken.size();
+
+    while (pos < strSize)
+    {
+      if (pStr[pos] == ';')
+      {
+        ExpressionParsedView::moveUntilEndOfLine(pStr, pos);
+        ++pos;
+        continue;
+      }
+
+      if (pStr[pos] == '(')
+      {
+        ++pos;
+        auto token = _parseToken(pStr, pos);
+
+        if (token == "problem")
+        {
+          problemName = std::string(_parseToken(pStr, pos));
+        }
+        else if (token == ":domain")
+        {
+          while (pos < strSize && pStr[pos] != ')')
+          {
+            auto domainToExtend = std::string(_parseToken(pStr, pos));
+            auto itDomain = pLoadedDomains.find(domainToExtend);
+            if (itDomain == pLoadedDomains.end())
+              throw std::runtime_error("Domain \"" + domainToExtend + "\" is unknown!");
+            if (pDomainCopyPtr != nullptr)
+            {
+              *pDomainCopyPtr = std::make_unique<Domain>(itDomain->second);
+              pDomainPtr = &**pDomainCopyPtr;
+            }
+            else
+            {
+              pDomainPtr = &itDomain->second;
+            }
+            problemPtr = std::make_unique<Problem>(&pDomainPtr->getTimelessFacts().setOfFacts());
+          }
+        }
+        else if (token == ":objects")
+        {
+          if (!pDomainPtr)
+            throw std::runtime_error("problem objects are defined before the domain.");
+          const auto& ontology = pDomainPtr->getOntology();
+          std::size_t beginPos = pos;
+          pos = std::min(pStr.find(')', pos), strSize);
+          std::string entitiesStr(pStr.substr(beginPos, pos - beginPos));
+          problemPtr->entities.addAllFromPddl(entitiesStr, ontology.types);
+        }
+        else if (token == ":init")
+        {
+          if (!pDomainPtr)
+            throw std::runtime_error("problem init are defined before the domain.");
+          const auto& ontology = pDomainPtr->getOntology();
+          auto& setOfEventsMap = pDomainPtr->getSetOfEvents();
+          const SetOfCallbacks callbacks;
+          problemPtr->worldState.modifyFactsFromPddl(pStr, pos, problemPtr->goalStack,
+                                                         setOfEventsMap, callbacks,
+                                                         ontology, problemPtr->entities, {});
+          // The materialized derived predicates that are true without any fact change (ex: on a "not") are added now
+          if (ontology.derivedPredicates.isMaterialized())
+            problemPtr->worldState.applyEventsOfASet(Domain::getSetOfEventsIdFromDerivedPredicates(),
+                                                         problemPtr->goalStack, setOfEventsMap, callbacks,
+                                                         ontology, problemPtr->entities, {});
+        }
+        else if (token == ":goal")
+        {
+          if (!pDomainPtr)
+            throw std::runtime_error("problem objects are defined before the domain.");
+          if (!problemPtr)
+            throw std::runtime_error("problem not initialized before to set the goals.");
+          const auto& ontology = pDomainPtr->getOntology();
+          std::vector<Goal> goals;
+          const auto& worldState = problemPtr->worldState;
+          const auto& entities = problemPtr->entities;
+
+          std::size_t beginPos = pos;
+          _moveUntilEndOfExpression(pStr, pos);
+          std::string goalStr(pStr.substr(beginPos, pos - beginPos));
+          std::size_t goalPos = 0;
+          auto expressionParsed = ExpressionParsed::fromPddl(goalStr, goalPos, false);
+          pos = beginPos + goalPos;
+          if (expressionParsed.name == "and" && expressionParsed.tags.count("__ORDERED") > 0)
+          {
+            for (auto& currGoalExpParsed : expressionParsed.arguments)
+            {
+              auto goalPtr = _expressionParsedToGoal(currGoalExpParsed, ontology, entities, -1, "");
+              if (!goalPtr)
+                throw std::runtime_error("Failed to parse a pddl goal");
+              goals.emplace_back(std::move(*goalPtr));
+            }
+          }
+          else
+          {
+            auto goalPtr = _expressionParsedToGoal(expressionParsed, ontology, entities, -1, "");
+            if (!goalPtr)
+              throw std::runtime_error("Failed to parse a pddl goal");
+            goals.emplace_back(std::move(*goalPtr));
+          }
+
+          problemPtr->goalStack.addGoals(goals, worldState, {});
+        }
+        else if (token == ":constraints")
+        {
+          break;
+        }
+        else
+        {
+          throw std::runtime_error("Unknown domain PDDL token: \"" + std::string(token) + "\"");
+        }
+      }
+
+      ++pos;
+    }
+
+  } else {
+    throw std::runtime_error("No '(define' found in domain file");
+  }
+
+  if (!problemPtr)
+    throw std::runtime_error("problem not initialized");
+  problemPtr->name = problemName;
+  return problemPtr;
+}
+
 }
 
-Domain pddlToDomain(const std::string& pStr,
-                    const std::map<std::string, Domain>& pPreviousDomains)
+Domain pddlToDomain(std::string_view pStr,
+                    const std::map<std::string, Domain>& pPreviousDomains,
+                    std::size_t pNbOfParsingThreads,
+                    bool pMaterializeDerivedPredicates)
 {
+  TraceSpan traceSpan("pddlToDomain");
+  ORDEREDGOALSPLANNER_ALLOCATION_PHASE(PARSING);
   std::string domainName = "";
   ogp::Ontology ontology;
   std::map<ActionId, Action> actions;
   std::map<SetOfEventsId, SetOfEvents> idToSetOfEvents;
   SetOfConstFacts timelessFacts;
   std::set<std::string> requirements;
+  if (pNbOfParsingThreads == 0)
+    pNbOfParsingThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  std::vector<DomainBlock> blocksToParseInParallel;
 
   const std::string defineToken = "(define";
   std::size_t found = pStr.find(defineToken);
@@ -886,6 +1249,19 @@ Domain pddlToDomain(const std::string& pStr,
     auto strSize = pStr.size();
     std::size_t pos = found + defineToken.size();
 
+    // The actions, events and axioms are parsed now or kept to be parsed in parallel when the ontology is complete
+    auto processBlock = [&](DomainBlockType pType, std::string pName) {
+      if (pNbOfParsingThreads > 1)
+      {
+        blocksToParseInParallel.emplace_back(pType, std::move(pName), pos);
+        _moveUntilEndOfBlock(pStr, pos);
+        return;
+      }
+      DomainBlock block(pType, std::move(pName), pos);
+      _parseDomainBlock(block, pStr, pos, ontology);
+      _addDomainBlock(block, actions, idToSetOfEvents);
+    };
+
     while (pos < strSize)
     {
       if (pStr[pos] == ';')
@@ -928,14 +1304,14 @@ Domain pddlToDomain(const std::string& pStr,
         {
           std::size_t beginPos = pos;
           ExpressionParsed::moveUntilClosingParenthesis(pStr, pos);
-          std::string typesStr = pStr.substr(beginPos, pos - beginPos);
+          std::string typesStr(pStr.substr(beginPos, pos - beginPos));
           ontology.types.addTypesFromPddl(typesStr);
         }
         else if (token == ":constants")
         {
           std::size_t beginPos = pos;
           ExpressionParsed::moveUntilClosingParenthesis(pStr, pos);
-          std::string constantsStr = pStr.substr(beginPos, pos - beginPos);
+          std::string constantsStr(pStr.substr(beginPos, pos - beginPos));
           ontology.constants.addAllFromPddl(constantsStr, ontology.types);
         }
         else if (token == ":predicates")
@@ -951,29 +1327,25 @@ Domain pddlToDomain(const std::string& pStr,
         {
           timelessFacts = ogp::SetOfConstFacts::fromPddl(pStr, pos, ontology, {});
         }
+        else if (token == ":derived")
+        {
+          ontology.derivedPredicates.addDerivedPredicate(_pddlToDerivedPredicate(pStr, pos, ontology));
+        }
         else if (token == ":axiom")
         {
-          auto axiom = _pddlToAxiom(pStr, pos, ontology);
-          for (auto& currEvent : axiom.toEvents(ontology, {}))
-            idToSetOfEvents[Domain::getSetOfEventsIdFromConstructor()].add(currEvent, "from_axiom");
+          processBlock(DomainBlockType::AXIOM, "");
         }
         else if (token == ":event")
         {
-          auto eventName = ExpressionParsed::parseToken(pStr, pos);
-          auto event = _pddlToEvent(pStr, pos, ontology);
-          idToSetOfEvents[Domain::getSetOfEventsIdFromConstructor()].add(event, eventName);
+          processBlock(DomainBlockType::EVENT, ExpressionParsed::parseToken(pStr, pos));
         }
         else if (token == ":action")
         {
-          auto actionName = ExpressionParsed::parseToken(pStr, pos);
-          auto action = _actionPddlToAction(pStr, pos, ontology);
-          actions.emplace(actionName, std::move(action));
+          processBlock(DomainBlockType::ACTION, ExpressionParsed::parseToken(pStr, pos));
         }
         else if (token == ":durative-action")
         {
-          auto actionName = ExpressionParsed::parseToken(pStr, pos);
-          auto action = _durativeActionPddlToAction(pStr, pos, ontology);
-          actions.emplace(actionName, std::move(action));
+          processBlock(DomainBlockType::DURATIVE_ACTION, ExpressionParsed::parseToken(pStr, pos));
         }
         else
         {
@@ -987,6 +1359,19 @@ Domain pddlToDomain(const std::string& pStr,
   } else {
     throw std::runtime_error("No '(define' found in domain file");
   }
+
+  if (!blocksToParseInParallel.empty())
+  {
+    _parseDomainBlocksInParallel(blocksToParseInParallel, pStr, ontology, pNbOfParsingThreads);
+    // Insertion in the order of the file to have the same domain than with a sequential parsing
+    for (auto& currBlock : blocksToParseInParallel)
+      _addDomainBlock(currBlock, actions, idToSetOfEvents);
+  }
+
+  // The events of the materialized derived predicates are recreated by the constructor if they are still materialized
+  ontology.derivedPredicates.setMaterialized(pMaterializeDerivedPredicates);
+  idToSetOfEvents.erase(Domain::getSetOfEventsIdFromDerivedPredicates());
+  // The succession caches are computed only once, in the constructor
   auto res = Domain(actions, ontology, {}, idToSetOfEvents, timelessFacts, domainName);
   for (auto& currRequirement : requirements)
     res.addRequirement(currRequirement);
@@ -994,127 +1379,26 @@ Domain pddlToDomain(const std::string& pStr,
 }
 
 
-DomainAndProblemPtrs pddlToProblem(const std::string& pStr,
+DomainAndProblemPtrs pddlToProblem(std::string_view pStr,
                                    const std::map<std::string, Domain>& pLoadedDomains)
 {
   DomainAndProblemPtrs res;
-  std::string problemName;
-
-  const std::string defineToken = "(define";
-  std::size_t found = pStr.find(defineToken);
-  if (found != std::string::npos)
-  {
-    auto strSize = pStr.size();
-    std::size_t pos = found + defineToken.size();
-
-    while (pos < strSize)
-    {
-      if (pStr[pos] == ';')
-      {
-        ExpressionParsed::moveUntilEndOfLine(pStr, pos);
-        ++pos;
-        continue;
-      }
-
-      if (pStr[pos] == '(')
-      {
-        ++pos;
-        auto token = ExpressionParsed::parseToken(pStr, pos);
-
-        if (token == "problem")
-        {
-          problemName = ExpressionParsed::parseToken(pStr, pos);
-        }
-        else if (token == ":domain")
-        {
-          while (pos < strSize && pStr[pos] != ')')
-          {
-            auto domainToExtend = ExpressionParsed::parseToken(pStr, pos);
-            auto itDomain = pLoadedDomains.find(domainToExtend);
-            if (itDomain == pLoadedDomains.end())
-              throw std::runtime_error("Domain \"" + domainToExtend + "\" is unknown!");
-            res.domainPtr = std::make_unique<Domain>(itDomain->second);
-            res.problemPtr = std::make_unique<Problem>(&res.domainPtr->getTimelessFacts().setOfFacts());
-          }
-        }
-        else if (token == ":objects")
-        {
-          if (!res.domainPtr)
-            throw std::runtime_error("problem objects are defined before the domain.");
-          const auto& ontology = res.domainPtr->getOntology();
-          std::size_t beginPos = pos;
-          ExpressionParsed::moveUntilClosingParenthesis(pStr, pos);
-          std::string entitiesStr = pStr.substr(beginPos, pos - beginPos);
-          res.problemPtr->entities.addAllFromPddl(entitiesStr, ontology.types);
-        }
-        else if (token == ":init")
-        {
-          if (!res.domainPtr)
-            throw std::runtime_error("problem init are defined before the domain.");
-          const auto& ontology = res.domainPtr->getOntology();
-          auto& setOfEventsMap = res.domainPtr->getSetOfEvents();
-          const SetOfCallbacks callbacks;
-          res.problemPtr->worldState.modifyFactsFromPddl(pStr, pos, res.problemPtr->goalStack,
-                                                         setOfEventsMap, callbacks,
-                                                         ontology, res.problemPtr->entities, {});
-        }
-        else if (token == ":goal")
-        {
-          if (!res.domainPtr)
-            throw std::runtime_error("problem objects are defined before the domain.");
-          if (!res.problemPtr)
-            throw std::runtime_error("problem not initialized before to set the goals.");
-          const auto& ontology = res.domainPtr->getOntology();
-          std::vector<Goal> goals;
-          const auto& worldState = res.problemPtr->worldState;
-          const auto& entities = res.problemPtr->entities;
-
-          auto expressionParsed = ExpressionParsed::fromPddl(pStr, pos, false);
-          if (expressionParsed.name == "and" && expressionParsed.tags.count("__ORDERED") > 0)
-          {
-            for (auto& currGoalExpParsed : expressionParsed.arguments)
-            {
-              auto goalPtr = _expressionParsedToGoal(currGoalExpParsed, ontology, entities, -1, "");
-              if (!goalPtr)
-                throw std::runtime_error("Failed to parse a pddl goal");
-              goals.emplace_back(std::move(*goalPtr));
-            }
-          }
-          else
-          {
-            auto goalPtr = _expressionParsedToGoal(expressionParsed, ontology, entities, -1, "");
-            if (!goalPtr)
-              throw std::runtime_error("Failed to parse a pddl goal");
-            goals.emplace_back(std::move(*goalPtr));
-          }
-
-          res.problemPtr->goalStack.addGoals(goals, worldState, {});
-        }
-        else if (token == ":constraints")
-        {
-          break;
-        }
-        else
-        {
-          throw std::runtime_error("Unknown domain PDDL token: \"" + token + "\"");
-        }
-      }
-
-      ++pos;
-    }
+  const Domain* domainPtr = nullptr;
+  res.problemPtr = _pddlToProblem(pStr, pLoadedDomains, domainPtr, &res.domainPtr);
+  return res;
+}
 
-  } else {
-    throw std::runtime_error("No '(define' found in domain file");
-  }
 
-  if (!res.problemPtr)
-    throw std::runtime_error("problem not initialized");
-  res.problemPtr->name = problemName;
+LoadedDomainAndProblemPtrs pddlToProblemOfLoadedDomain(std::string_view pStr,
+                                                       const std::map<std::string, Domain>& pLoadedDomains)
+{
+  LoadedDomainAndProblemPtrs res;
+  res.problemPtr = _pddlToProblem(pStr, pLoadedDomains, res.domainPtr, nullptr);
   return res;
 }
 
 
-std::unique_ptr<Condition> pddlToCondition(const std::string& pStr,
+std::unique_ptr<Condition> pddlToCondition(std::string_view pStr,
                                            std::size_t& pPos,
                                            const Ontology& pOntology,
                                            const SetOfEntities& pEntities,
@@ -1166,7 +1450,7 @@ std::unique_ptr<Goal> strToGoal(const std::string& pStr,
                                  pMaxTimeToKeepInactive, pGoalGroupId);
 }
 
-std::unique_ptr<WorldStateModification> pddlToWsModification(const std::string& pStr,
+std::unique_ptr<WorldStateModification> pddlToWsModification(std::string_view pStr,
                                                              std::size_t& pPos,
                                                              const Ontology& pOntology,
                                                              const SetOfEntities& pEntities,
@@ -0,0 +1,357 @@
+#include <orderedgoalsplanner/util/serializer/serializeinbinary.hpp>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include "../../types/worldstatemodificationprivate.hpp"
+#include "binarysnapshot.hpp"
+
+
+namespace ogp
+{
+namespace
+{
+
+void _typeToBinary(BinarySnapshotWriter& pWriter,
+                   const Type* pType)
+{
+  pWriter.writeStr(pType ? pType->name : "");
+}
+
+void _typeWithSubTypes(std::vector<const Type*>& pTypes,
+                       const Type& pType)
+{
+  pTypes.emplace_back(&pType);
+  for (const auto& currSubType : pType.subTypes)
+    _typeWithSubTypes(pTypes, *currSubType);
+}
+
+void _parametersToBinary(BinarySnapshotWriter& pWriter,
+                         const std::vector<Parameter>& pParameters)
+{
+  pWriter.writeUInt(pParameters.size());
+  for (const auto& currParam : pParameters)
+  {
+    pWriter.writeStr(currParam.name);
+    _typeToBinary(pWriter, currParam.type);
+  }
+}
+
+void _entityToBinary(BinarySnapshotWriter& pWriter,
+                     const Entity& pEntity)
+{
+  pWriter.writeStr(pEntity.value);
+  _typeToBinary(pWriter, pEntity.type);
+}
+
+void _predicateToBinary(BinarySnapshotWriter& pWriter,
+                        const Predicate& pPredicate)
+{
+  pWriter.writeStr(pPredicate.name);
+  _parametersToBinary(pWriter, pPredicate.parameters);
+  _typeToBinary(pWriter, pPredicate.fluent);
+}
+
+void _factToBinary(BinarySnapshotWriter& pWriter,
+                   const Fact& pFact)
+{
+  _predicateToBinary(pWriter, pFact.predicate);
+  pWriter.writeUInt(pFact.arguments().size());
+  for (const auto& currArg : pFact.arguments())
+    _entityToBinary(pWriter, currArg);
+  const auto& fluent = pFact.fluent();
+  pWriter.writeBool(fluent.has_value());
+  if (fluent)
+    _entityToBinary(pWriter, *fluent);
+  pWriter.writeBool(pFact.isValueNegated());
+}
+
+void _factOptionalToBinary(BinarySnapshotWriter& pWriter,
+                           const FactOptional& pFactOptional)
+{
+  pWriter.writeBool(pFactOptional.isFactNegated);
+  _factToBinary(pWriter, pFactOptional.fact);
+}
+
+void _numberToBinary(BinarySnapshotWriter& pWriter,
+                     const Number& pNumber)
+{
+  if (std::holds_alternative<int>(pNumber))
+  {
+    pWriter.writeByte(0);
+    pWriter.writeInt(std::get<int>(pNumber));
+  }
+  else
+  {
+    pWriter.writeByte(1);
+    pWriter.writeFloat(std::get<float>(pNumber));
+  }
+}
+
+void _idsToBinary(BinarySnapshotWriter& pWriter,
+                  const std::set<std::string>& pIds)
+{
+  pWriter.writeUInt(pIds.size());
+  for (const auto& currId : pIds)
+    pWriter.writeStr(currId);
+}
+
+void _successionsToBinary(BinarySnapshotWriter& pWriter,
+                          const Successions& pSuccessions)
+{
+  _idsToBinary(pWriter, pSuccessions.actions);
+  pWriter.writeUInt(pSuccessions.events.size());
+  for (const auto& currSetOfEventsToEvents : pSuccessions.events)
+  {
+    pWriter.writeStr(currSetOfEventsToEvents.first);
+    _idsToBinary(pWriter, currSetOfEventsToEvents.second);
+  }
+}
+
+void _conditionToBinary(BinarySnapshotWriter& pWriter,
+                        const Condition* pConditionPtr)
+{
+  if (pConditionPtr == nullptr)
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(BinaryConditionTag::NONE));
+    return;
+  }
+
+  if (const auto* nodePtr = pConditionPtr->fcNodePtr())
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(BinaryConditionTag::NODE));
+    pWriter.writeUInt(static_cast<std::uint64_t>(nodePtr->nodeType));
+    _conditionToBinary(pWriter, nodePtr->leftOperand.get());
+    _conditionToBinary(pWriter, nodePtr->rightOperand.get());
+  }
+  else if (const auto* existsPtr = pConditionPtr->fcExistsPtr())
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(BinaryConditionTag::EXISTS));
+    _parametersToBinary(pWriter, {existsPtr->parameter});
+    _conditionToBinary(pWriter, existsPtr->condition.get());
+  }
+  else if (const auto* notPtr = pConditionPtr->fcNotPtr())
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(BinaryConditionTag::NOT));
+    _conditionToBinary(pWriter, notPtr->condition.get());
+  }
+  else if (const auto* factPtr = pConditionPtr->fcFactPtr())
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(BinaryConditionTag::FACT));
+    _factOptionalToBinary(pWriter, factPtr->factOptional);
+  }
+  else if (const auto* nbPtr = pConditionPtr->fcNbPtr())
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(BinaryConditionTag::NUMBER));
+    _numberToBinary(pWriter, nbPtr->nb);
+  }
+  else
+  {
+    throw std::runtime_error("Unknown condition type to save in binary");
+  }
+}
+
+void _wsModificationToBinary(BinarySnapshotWriter& pWriter,
+                             const WorldStateModification* pWsModificationPtr)
+{
+  if (pWsModificationPtr == nullptr)
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(BinaryWsModificationTag::NONE));
+    return;
+  }
+
+  if (const auto* nodePtr = toWmNode(*pWsModificationPtr))
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(BinaryWsModificationTag::NODE));
+    pWriter.writeUInt(static_cast<std::uint64_t>(nodePtr->nodeType));
+    pWriter.writeBool(nodePtr->parameterOpt.has_value());
+    if (nodePtr->parameterOpt)
+      _parametersToBinary(pWriter, {*nodePtr->parameterOpt});
+    _wsModificationToBinary(pWriter, nodePtr->leftOperand.get());
+    _wsModificationToBinary(pWriter, nodePtr->rightOperand.get());
+    _successionsToBinary(pWriter, nodePtr->successions());
+  }
+  else if (const auto* factPtr = toWmFact(*pWsModificationPtr))
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(BinaryWsModificationTag::FACT));
+    _factOptionalToBinary(pWriter, factPtr->factOptional);
+    _successionsToBinary(pWriter, factPtr->successions());
+  }
+  else if (const auto* nbPtr = toWmNumber(*pWsModificationPtr))
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(BinaryWsModificationTag::NUMBER));
+    _numberToBinary(pWriter, nbPtr->getNb());
+  }
+  else
+  {
+    throw std::runtime_error("Unknown world state modification type to save in binary");
+  }
+}
+
+void _goalToBinary(BinarySnapshotWriter& pWriter,
+                   const Goal& pGoal)
+{
+  _conditionToBinary(pWriter, &pGoal.objective());
+  pWriter.writeBool(pGoal.isPersistent());
+  pWriter.writeBool(pGoal.isOneStepTowards());
+  pWriter.writeInt(pGoal.getMaxTimeToKeepInactive());
+  pWriter.writeStr(pGoal.getGoalGroupId());
+}
+
+void _goalsToBinary(BinarySnapshotWriter& pWriter,
+                    const std::vector<Goal>& pGoals)
+{
+  pWriter.writeUInt(pGoals.size());
+  for (const auto& currGoal : pGoals)
+    _goalToBinary(pWriter, currGoal);
+}
+
+void _priorityToGoalsToBinary(BinarySnapshotWriter& pWriter,
+                              const std::map<int, std::vector<Goal>>& pGoals)
+{
+  pWriter.writeUInt(pGoals.size());
+  for (const auto& currPriorityToGoals : pGoals)
+  {
+    pWriter.writeInt(currPriorityToGoals.first);
+    _goalsToBinary(pWriter, currPriorityToGoals.second);
+  }
+}
+
+void _actionToBinary(BinarySnapshotWriter& pWriter,
+                     const Action& pAction)
+{
+  _parametersToBinary(pWriter, pAction.parameters);
+  _conditionToBinary(pWriter, pAction.precondition.get());
+  _conditionToBinary(pWriter, pAction.overAllCondition.get());
+  _conditionToBinary(pWriter, pAction.preferInContext.get());
+  _wsModificationToBinary(pWriter, pAction.effect.worldStateModification.get());
+  _wsModificationToBinary(pWriter, pAction.effect.potentialWorldStateModification.get());
+  _wsModificationToBinary(pWriter, pAction.effect.worldStateModificationAtStart.get());
+  _priorityToGoalsToBinary(pWriter, pAction.effect.goalsToAdd);
+  _goalsToBinary(pWriter, pAction.effect.goalsToAddInCurrentPriority);
+  pWriter.writeBool(pAction.highImportanceOfNotRepeatingIt);
+  pWriter.writeBool(pAction.canThisActionBeUsedByThePlanner);
+  _idsToBinary(pWriter, pAction.actionsSuccessionsWithoutInterestCache);
+  _idsToBinary(pWriter, pAction.actionsPredecessorsCache);
+  _idsToBinary(pWriter, pAction.eventsPredecessorsCache);
+}
+
+void _eventToBinary(BinarySnapshotWriter& pWriter,
+                    const Event& pEvent)
+{
+  _parametersToBinary(pWriter, pEvent.parameters);
+  _conditionToBinary(pWriter, pEvent.precondition.get());
+  _wsModificationToBinary(pWriter, pEvent.factsToModify.get());
+  _priorityToGoalsToBinary(pWriter, pEvent.goalsToAdd);
+  _idsToBinary(pWriter, pEvent.actionsPredecessorsCache);
+  _idsToBinary(pWriter, pEvent.eventsPredecessorsCache);
+}
+
+}
+
+
+
+std::string domainToBinary(const Domain& pDomain)
+{
+  BinarySnapshotWriter writer;
+  writer.writeStr(pDomain.getName());
+
+  const auto& requirements = pDomain.requirements();
+  writer.writeUInt(requirements.size());
+  for (const auto& currRequirement : requirements)
+    writer.writeStr(currRequirement);
+
+  const auto& ontology = pDomain.getOntology();
+  std::vector<const Type*> types;
+  for (const auto& currType : ontology.types.rootTypes())
+    _typeWithSubTypes(types, *currType);
+  writer.writeUInt(types.size());
+  for (const auto* currTypePtr : types)
+  {
+    writer.writeStr(currTypePtr->name);
+    _typeToBinary(writer, currTypePtr->parent);
+  }
+
+  const auto& predicates = ontology.predicates.predicates();
+  writer.writeUInt(predicates.size());
+  for (const auto& currPredicate : predicates)
+    _predicateToBinary(writer, currPredicate.second);
+
+  const auto& constants = ontology.constants.entities();
+  writer.writeUInt(constants.size());
+  for (const auto& currConstant : constants)
+    _entityToBinary(writer, currConstant.second);
+
+  const auto& derivedPredicates = ontology.derivedPredicates.derivedPredicates();
+  writer.writeUInt(derivedPredicates.size());
+  for (const auto& currDerivedPredicate : derivedPredicates)
+  {
+    _predicateToBinary(writer, currDerivedPredicate.second.predicate);
+    _conditionToBinary(writer, currDerivedPredicate.second.condition.get());
+  }
+  writer.writeBool(ontology.derivedPredicates.isMaterialized());
+
+  const auto& timelessFacts = pDomain.getTimelessFacts().setOfFacts().facts();
+  writer.writeUInt(timelessFacts.size());
+  for (const auto& currFact : timelessFacts)
+    _factToBinary(writer, currFact.first);
+
+  const auto& actions = pDomain.actions();
+  writer.writeUInt(actions.size());
+  for (const auto& currAction : actions)
+  {
+    writer.writeStr(currAction.first);
+    _actionToBinary(writer, currAction.second);
+  }
+
+  const auto& setOfEvents = pDomain.getSetOfEvents();
+  writer.writeUInt(setOfEvents.size());
+  for (const auto& currSetOfEvents : setOfEvents)
+  {
+    writer.writeStr(currSetOfEvents.first);
+    const auto& events = currSetOfEvents.second.events();
+    writer.writeUInt(events.size());
+    for (const auto& currEvent : events)
+    {
+      writer.writeStr(currEvent.first);
+      _eventToBinary(writer, currEvent.second);
+    }
+  }
+
+  return writer.finalize(BinarySnapshotKind::DOMAIN_SNAPSHOT);
+}
+
+
+std::string problemToBinary(const Problem& pProblem,
+                            const Domain& pDomain)
+{
+  BinarySnapshotWriter writer;
+  writer.writeStr(pDomain.getName());
+  writer.writeStr(pProblem.name);
+
+  const auto& entities = pProblem.entities.entities();
+  writer.writeUInt(entities.size());
+  for (const auto& currEntity : entities)
+    _entityToBinary(writer, currEntity.second);
+
+  const auto& facts = pProblem.worldState.facts();
+  writer.writeUInt(facts.size());
+  for (const auto& currFact : facts)
+  {
+    _factToBinary(writer, currFact.first);
+    writer.writeBool(currFact.second);
+  }
+
+  _priorityToGoalsToBinary(writer, pProblem.goalStack.goals());
+
+  auto actionsAlreadyDone = pProblem.historical.getActionsAlreadyDone();
+  writer.writeUInt(actionsAlreadyDone.size());
+  for (const auto& currActionDone : actionsAlreadyDone)
+  {
+    writer.writeStr(currActionDone.first);
+    writer.writeUInt(currActionDone.second);
+  }
+
+  return writer.finalize(BinarySnapshotKind::PROBLEM_SNAPSHOT);
+}
+
+
+} // !ogp
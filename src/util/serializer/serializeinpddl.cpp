@@ -1,4 +1,5 @@
 #include <orderedgoalsplanner/util/serializer/serializeinpddl.hpp>
+#include <sstream>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
 #include "../../types/worldstatemodificationprivate.hpp"
@@ -255,146 +256,167 @@ std::string _effectsToPddl(
 
 std::string domainToPddl(const Domain& pDomain)
 {
-  std::string res = "(define\n";
+  std::ostringstream ss;
+  domainToPddl(ss, pDomain);
+  return ss.str();
+}
+
+
+void domainToPddl(std::ostream& pOs,
+                  const Domain& pDomain)
+{
+  pOs << "(define\n";
 
   std::size_t identation = _identationOffset;
+  const std::string identationStr(identation, ' ');
 
 
-  res += std::string(identation, ' ') + "(domain " + pDomain.getName() + ")\n";
+  pOs << identationStr << "(domain " << pDomain.getName() << ")\n";
 
   const auto& requirements = pDomain.requirements();
   if (!requirements.empty())
   {
-    res += std::string(identation, ' ') + "(:requirements";
+    pOs << identationStr << "(:requirements";
     for (const auto& currRequirement : requirements)
-      res += " " + currRequirement;
-    res += ")\n";
+      pOs << " " << currRequirement;
+    pOs << ")\n";
   }
-  res += "\n";
+  pOs << "\n";
 
   const auto& ontology = pDomain.getOntology();
 
   if (!ontology.types.empty())
   {
-    res += std::string(identation, ' ') + "(:types\n";
-    res += ontology.types.toStr(_identationOffset + identation);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOs << identationStr << "(:types\n";
+    pOs << ontology.types.toStr(_identationOffset + identation);
+    pOs << "\n" << identationStr << ")\n\n";
   }
 
   if (!ontology.constants.empty())
   {
-    res += std::string(identation, ' ') + "(:constants\n";
-    res += ontology.constants.toStr(_identationOffset + identation);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOs << identationStr << "(:constants\n";
+    pOs << ontology.constants.toStr(_identationOffset + identation);
+    pOs << "\n" << identationStr << ")\n\n";
   }
 
   if (ontology.predicates.hasPredicateOfPddlType(PredicatePddlType::PDDL_PREDICATE))
   {
-    res += std::string(identation, ' ') + "(:predicates\n";
-    res += ontology.predicates.toPddl(PredicatePddlType::PDDL_PREDICATE, _identationOffset + identation);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOs << identationStr << "(:predicates\n";
+    pOs << ontology.predicates.toPddl(PredicatePddlType::PDDL_PREDICATE, _identationOffset + identation);
+    pOs << "\n" << identationStr << ")\n\n";
   }
 
   if (ontology.predicates.hasPredicateOfPddlType(PredicatePddlType::PDDL_FUNCTION))
   {
-    res += std::string(identation, ' ') + "(:functions\n";
-    res += ontology.predicates.toPddl(PredicatePddlType::PDDL_FUNCTION, _identationOffset + identation);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOs << identationStr << "(:functions\n";
+    pOs << ontology.predicates.toPddl(PredicatePddlType::PDDL_FUNCTION, _identationOffset + identation);
+    pOs << "\n" << identationStr << ")\n\n";
   }
 
   const auto& timelessFacts = pDomain.getTimelessFacts().setOfFacts();
   if (!timelessFacts.empty())
   {
-    res += std::string(identation, ' ') + "(:timeless\n";
-    res += timelessFacts.toPddl(_identationOffset + identation, true);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOs << identationStr << "(:timeless\n";
+    timelessFacts.toPddl(pOs, _identationOffset + identation, true);
+    pOs << "\n" << identationStr << ")\n\n";
   }
 
-  auto setOfEvents = pDomain.getSetOfEvents();
-  if (!setOfEvents.empty())
+  for (const auto& currDerivedPredicate : ontology.derivedPredicates.derivedPredicates())
+  {
+    std::size_t subIdentation = identation + _identationOffset;
+    pOs << identationStr << "(:derived " << currDerivedPredicate.second.predicate.toPddl() << "\n";
+    pOs << std::string(subIdentation, ' ') <<
+        conditionToPddl(*currDerivedPredicate.second.condition, subIdentation) << "\n";
+    pOs << identationStr << ")\n\n";
+  }
+
+  const auto& setOfEvents = pDomain.getSetOfEvents();
+  // The events of the materialized derived predicates are not written because they are deduced from the derived predicates
+  const auto& derivedPredicatesSetOfEventsId = Domain::getSetOfEventsIdFromDerivedPredicates();
+  auto nbOfSetOfEvents = setOfEvents.size() - setOfEvents.count(derivedPredicatesSetOfEventsId);
+  if (nbOfSetOfEvents > 0)
   {
     for (const auto& currSetOfEvent : setOfEvents)
     {
+      if (currSetOfEvent.first == derivedPredicatesSetOfEventsId)
+        continue;
       for (const auto& currEventIdToEvent : currSetOfEvent.second.events())
       {
         const Event& currEvent = currEventIdToEvent.second;
-        res += std::string(identation, ' ') + "(:event ";
-        if (setOfEvents.size() == 1)
-          res += currEventIdToEvent.first + "\n";
+        pOs << identationStr << "(:event ";
+        if (nbOfSetOfEvents == 1)
+          pOs << currEventIdToEvent.first << "\n";
         else
-          res += currSetOfEvent.first + "-" + currEventIdToEvent.first + "\n";
-        res += "\n";
+          pOs << currSetOfEvent.first << "-" << currEventIdToEvent.first << "\n";
+        pOs << "\n";
         std::size_t subIdentation = identation + _identationOffset;
         std::size_t subSubIdentation = subIdentation + _identationOffset;
 
-        std::string eventContent;
+        bool hasContent = false;
         if (!currEvent.parameters.empty())
         {
-          eventContent += std::string(subIdentation, ' ') + ":parameters\n";
-          eventContent += std::string(subSubIdentation, ' ') + _parametersToPddl(currEvent.parameters) + "\n";
+          pOs << std::string(subIdentation, ' ') << ":parameters\n";
+          pOs << std::string(subSubIdentation, ' ') << _parametersToPddl(currEvent.parameters) << "\n";
+          hasContent = true;
         }
 
         if (currEvent.precondition)
         {
-          if (!eventContent.empty())
-            eventContent += "\n";
-          eventContent += std::string(subIdentation, ' ') + ":precondition\n";
-          eventContent += std::string(subSubIdentation, ' ') +
-              conditionToPddl(*currEvent.precondition, subSubIdentation) + "\n";
+          if (hasContent)
+            pOs << "\n";
+          pOs << std::string(subIdentation, ' ') << ":precondition\n";
+          pOs << std::string(subSubIdentation, ' ') <<
+              conditionToPddl(*currEvent.precondition, subSubIdentation) << "\n";
+          hasContent = true;
         }
 
         if (currEvent.factsToModify)
         {
-          if (!eventContent.empty())
-            eventContent += "\n";
-          eventContent += std::string(subIdentation, ' ') + ":effect\n";
-          eventContent += std::string(subSubIdentation, ' ') +
+          if (hasContent)
+            pOs << "\n";
+          pOs << std::string(subIdentation, ' ') << ":effect\n";
+          pOs << std::string(subSubIdentation, ' ') <<
               _effectToPddl(*currEvent.factsToModify, subSubIdentation);
         }
 
-        res += eventContent;
-        res += "\n" + std::string(identation, ' ') + ")\n\n";
+        pOs << "\n" << identationStr << ")\n\n";
       }
     }
   }
 
   for (const auto& currActionNameToAction : pDomain.actions())
   {
-    res += std::string(identation, ' ') + "(:durative-action " +
-        currActionNameToAction.first + "\n";
+    pOs << identationStr << "(:durative-action " <<
+        currActionNameToAction.first << "\n";
     std::size_t subIdentation = identation + _identationOffset;
     std::size_t subSubIdentation = subIdentation + _identationOffset;
 
-    std::string actionContent;
     const Action& currAction = currActionNameToAction.second;
     if (!currAction.parameters.empty())
     {
-      actionContent += std::string(subIdentation, ' ') + ":parameters\n";
-      actionContent += std::string(subSubIdentation, ' ') + _parametersToPddl(currAction.parameters) + "\n";
+      pOs << std::string(subIdentation, ' ') << ":parameters\n";
+      pOs << std::string(subSubIdentation, ' ') << _parametersToPddl(currAction.parameters) << "\n";
+      pOs << "\n";
     }
 
-    {
-      if (!actionContent.empty())
-        actionContent += "\n";
-      actionContent += std::string(subIdentation, ' ') + ":duration (= ?duration 1)\n";
-    }
+    pOs << std::string(subIdentation, ' ') << ":duration (= ?duration 1)\n";
 
     if (currAction.precondition || currAction.overAllCondition)
     {
-      actionContent += "\n";
-      actionContent += std::string(subIdentation, ' ') + ":condition\n";
+      pOs << "\n";
+      pOs << std::string(subIdentation, ' ') << ":condition\n";
       std::list<ConditionWithPartInfo> conditionWithPartInfos;
       if (currAction.precondition)
         conditionWithPartInfos.emplace_back(*currAction.precondition, ConditionPart::AT_START);
       if (currAction.overAllCondition)
         conditionWithPartInfos.emplace_back(*currAction.overAllCondition, ConditionPart::OVER_ALL);
-      actionContent += std::string(subSubIdentation, ' ') +
-          _conditionsToPddl(conditionWithPartInfos, subSubIdentation) + "\n";
+      pOs << std::string(subSubIdentation, ' ') <<
+          _conditionsToPddl(conditionWithPartInfos, subSubIdentation) << "\n";
     }
 
     {
-      actionContent += "\n";
-      actionContent += std::string(subIdentation, ' ') + ":effect\n";
+      pOs << "\n";
+      pOs << std::string(subIdentation, ' ') << ":effect\n";
       std::list<WorldStateModificationWithPartInfo> worldStateModificationWithPartInfos;
       if (currAction.effect.worldStateModificationAtStart)
         worldStateModificationWithPartInfos.emplace_back(*currAction.effect.worldStateModificationAtStart, WsModificationPart::AT_START);
@@ -402,41 +424,50 @@ std::string domainToPddl(const Domain& pDomain)
         worldStateModificationWithPartInfos.emplace_back(*currAction.effect.worldStateModification, WsModificationPart::AT_END);
       if (currAction.effect.potentialWorldStateModification)
         worldStateModificationWithPartInfos.emplace_back(*currAction.effect.potentialWorldStateModification, WsModificationPart::POTENTIALLY_AT_END);
-      actionContent += std::string(subSubIdentation, ' ') +
+      pOs << std::string(subSubIdentation, ' ') <<
           _effectsToPddl(worldStateModificationWithPartInfos, subSubIdentation);
     }
 
-
-    res += actionContent;
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOs << "\n" << identationStr << ")\n\n";
   }
 
-  return res + ")";
+  pOs << ")";
 }
 
 
 std::string problemToPddl(const Problem& pProblem,
                           const Domain& pDomain)
 {
-  std::string res = "(define\n";
+  std::ostringstream ss;
+  problemToPddl(ss, pProblem, pDomain);
+  return ss.str();
+}
+
+
+void problemToPddl(std::ostream& pOs,
+                   const Problem& pProblem,
+                   const Domain& pDomain)
+{
+  pOs << "(define\n";
   std::size_t identation = _identationOffset;
+  const std::string identationStr(identation, ' ');
 
-  res += std::string(identation, ' ') + "(problem " + pProblem.name + ")\n";
-  res += std::string(identation, ' ') + "(:domain " + pDomain.getName() + ")\n\n";
+  pOs << identationStr << "(problem " << pProblem.name << ")\n";
+  pOs << identationStr << "(:domain " << pDomain.getName() << ")\n\n";
 
   if (!pProblem.entities.empty())
   {
-    res += std::string(identation, ' ') + "(:objects\n";
-    res += pProblem.entities.toStr(_identationOffset + identation);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOs << identationStr << "(:objects\n";
+    pOs << pProblem.entities.toStr(_identationOffset + identation);
+    pOs << "\n" << identationStr << ")\n\n";
   }
 
   const SetOfFacts& facts = pProblem.worldState.factsMapping();
   if (!facts.empty())
   {
-    res += std::string(identation, ' ') + "(:init\n";
-    res += facts.toPddl(_identationOffset + identation, false);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOs << identationStr << "(:init\n";
+    facts.toPddl(pOs, _identationOffset + identation, false);
+    pOs << "\n" << identationStr << ")\n\n";
   }
 
 
@@ -447,37 +478,37 @@ std::string problemToPddl(const Problem& pProblem,
   const auto& goals = pProblem.goalStack.goals();
   if (!goals.empty())
   {
-    res += std::string(identation, ' ') + "(:goal\n";
+    pOs << identationStr << "(:goal\n";
     if (goals.size() == 1 && goals.begin()->second.size() == 1)
     {
       const auto& currGoal = goals.begin()->second.front();
       auto pddlGoal = currGoal.toPddl(subSubIdentation);
-      res += std::string(subSubIdentation, ' ') + pddlGoal + "\n";
+      pOs << std::string(subSubIdentation, ' ') << pddlGoal << "\n";
       pddlGoals.emplace_back(pddlGoal);
     }
     else
     {
-      res += std::string(subIdentation, ' ') + "(and ;; __ORDERED\n";
+      pOs << std::string(subIdentation, ' ') << "(and ;; __ORDERED\n";
       for (auto itGoalsGroup = goals.end(); itGoalsGroup != goals.begin(); )
       {
         --itGoalsGroup;
         for (const Goal& currGoal : itGoalsGroup->second)
         {
           auto pddlGoal = currGoal.toPddl(subSubIdentation);
-          res += std::string(subSubIdentation, ' ') + pddlGoal + "\n";
+          pOs << std::string(subSubIdentation, ' ') << pddlGoal << "\n";
           pddlGoals.emplace_back(pddlGoal);
         }
       }
-      res += std::string(subIdentation, ' ') + ")\n";
+      pOs << std::string(subIdentation, ' ') << ")\n";
     }
-    res += std::string(identation, ' ') + ")\n\n";
+    pOs << identationStr << ")\n\n";
   }
 
   if (pddlGoals.size() > 1)
   {
     std::size_t subSubSubIdentation = subSubIdentation + _identationOffset;
-    res += std::string(identation, ' ') + "(:constraints\n";
-    res += std::string(subIdentation, ' ') + "(and ; These contraints are to specify the goals order\n";
+    pOs << identationStr << "(:constraints\n";
+    pOs << std::string(subIdentation, ' ') << "(and ; These contraints are to specify the goals order\n";
 
     std::size_t preferenceIndex = 0;
     std::string previousGoal;
@@ -485,20 +516,20 @@ std::string problemToPddl(const Problem& pProblem,
     {
       if (previousGoal != "")
       {
-        res += std::string(subSubIdentation, ' ') + "(preference p" + std::to_string(preferenceIndex) + "\n";
+        pOs << std::string(subSubIdentation, ' ') << "(preference p" << preferenceIndex << "\n";
         ++preferenceIndex;
-        res += std::string(subSubSubIdentation, ' ') + "(sometime-after " +
-            previousGoal + " " + currPddlGoal + ")\n";
-        res += std::string(subSubIdentation, ' ') + ")\n";
+        pOs << std::string(subSubSubIdentation, ' ') << "(sometime-after " <<
+            previousGoal << " " << currPddlGoal << ")\n";
+        pOs << std::string(subSubIdentation, ' ') << ")\n";
       }
       previousGoal = currPddlGoal;
     }
 
-    res += std::string(subIdentation, ' ') + ")\n";
-    res += std::string(identation, ' ') + ")\n\n";
+    pOs << std::string(subIdentation, ' ') << ")\n";
+    pOs << identationStr << ")\n\n";
   }
 
-  return res + ")";
+  pOs << ")";
 }
 
 
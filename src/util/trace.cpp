@@ -0,0 +1,121 @@
+#include <orderedgoalsplanner/util/trace.hpp>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+
+namespace ogp
+{
+namespace
+{
+
+struct Tracer
+{
+  /// It guards all the members except the atomic ones.
+  std::mutex mutex{};
+  std::ofstream file{};
+  /// Start of the tracing, in microseconds of the steady clock.
+  long long beginInUs = 0;
+  bool isFirstEvent = true;
+  /// Identifier of the current tracing, it changes at each start to drop the spans begun before.
+  std::atomic<std::size_t> tracingId{0};
+  /// Set with a release store and read with an acquire load, to skip the spans without taking the mutex.
+  std::atomic<bool> isTracing{false};
+};
+
+Tracer& _tracer()
+{
+  static Tracer res;
+  return res;
+}
+
+/// Small identifier of the current thread, to have readable thread ids in the trace.
+std::size_t _threadId()
+{
+  static std::atomic<std::size_t> nextThreadId{1};
+  thread_local std::size_t res = nextThreadId++;
+  return res;
+}
+
+long long _nowInUs()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void _stopTracing(Tracer& pTracer)
+{
+  if (!pTracer.file.is_open())
+    return;
+  pTracer.isTracing.store(false, std::memory_order_release);
+  pTracer.file << "\n]\n";
+  pTracer.file.close();
+}
+
+}
+
+
+void startTracing(const std::string& pFilePath)
+{
+  auto& tracer = _tracer();
+  std::lock_guard<std::mutex> lock(tracer.mutex);
+  _stopTracing(tracer);
+  tracer.file.open(pFilePath, std::ios::out | std::ios::trunc);
+  if (!tracer.file.is_open())
+    throw std::runtime_error("Failed to open the trace file: " + pFilePath);
+  tracer.file << "[";
+  tracer.beginInUs = _nowInUs();
+  tracer.isFirstEvent = true;
+  ++tracer.tracingId;
+  tracer.isTracing.store(true, std::memory_order_release);
+}
+
+
+void stopTracing()
+{
+  auto& tracer = _tracer();
+  std::lock_guard<std::mutex> lock(tracer.mutex);
+  _stopTracing(tracer);
+}
+
+
+bool isTracing()
+{
+  return _tracer().isTracing.load(std::memory_order_acquire);
+}
+
+
+TraceSpan::TraceSpan(const char* pName)
+  : _name(pName),
+    _tracingId(0),
+    _beginInUs(-1)
+{
+  if (isTracing())
+  {
+    _tracingId = _tracer().tracingId.load(std::memory_order_relaxed);
+    _beginInUs = _nowInUs();
+  }
+}
+
+
+TraceSpan::~TraceSpan()
+{
+  if (_beginInUs < 0 || !isTracing())
+    return;
+  auto& tracer = _tracer();
+  auto durationInUs = _nowInUs() - _beginInUs;
+  auto threadId = _threadId();
+  std::lock_guard<std::mutex> lock(tracer.mutex);
+  // The start of the tracing is only read under the mutex, a span begun before a restart of the tracing is dropped
+  if (!tracer.file.is_open() || _tracingId != tracer.tracingId.load(std::memory_order_relaxed))
+    return;
+  if (tracer.isFirstEvent)
+    tracer.isFirstEvent = false;
+  else
+    tracer.file << ",";
+  tracer.file << "\n{\"name\":\"" << _name << "\",\"cat\":\"ogp\",\"ph\":\"X\",\"ts\":" << _beginInUs - tracer.beginInUs
+              << ",\"dur\":" << durationInUs << ",\"pid\":1,\"tid\":" << threadId << "}";
+}
+
+} // !ogp
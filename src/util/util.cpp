@@ -1,5 +1,6 @@
 #include <orderedgoalsplanner/util/util.hpp>
 #include <cctype> // For isdigit()
+#include <charconv>
 #include <sstream>
 #include <orderedgoalsplanner/types/entity.hpp>
 #include <orderedgoalsplanner/types/parameter.hpp>
@@ -25,6 +26,19 @@ T _lexical_cast(const std::string& pStr)
   return atoi(pStr.c_str());
 }
 
+bool _compNumbers(const Number& pNb1,
+                  const Number& pNb2,
+                  bool pBoolSuperiorOrInferior,
+                  bool pCanBeEqual)
+{
+  // Compare the values and not the alternatives of the variants, so that 20 and 20.0 are equal
+  auto nb1 = numberToDouble(pNb1);
+  auto nb2 = numberToDouble(pNb2);
+  if (nb1 == nb2)
+    return pCanBeEqual;
+  return pBoolSuperiorOrInferior ? nb1 > nb2 : nb1 < nb2;
+}
+
 void _unfoldMapWithSet(std::list<std::map<Parameter, Entity>>& pOutMap,
                        std::map<Parameter, std::set<Entity>>& pInMap)
 {
@@ -64,25 +78,38 @@ void _unfoldMapWithSet(std::list<std::map<Parameter, Entity>>& pOutMap,
 
 // Function to convert a string to either an int or a float and store it in a variant
 Number stringToNumber(const std::string& str) {
-    std::istringstream iss(str);
+    auto res = tryToConvertToNumber(str);
+    if (res)
+        return *res;
 
-    // Try to parse as an int first
-    int intValue;
-    if (iss >> intValue && iss.eof()) {
-        return intValue;  // Successfully parsed as an int
-    }
+    // If neither works, throw an exception
+    throw std::invalid_argument("Invalid number format: " + str);
+}
 
-    // Clear error flags and try parsing as a float
-    iss.clear();
-    iss.str(str);
 
-    float floatValue;
-    if (iss >> floatValue && iss.eof()) {
-        return floatValue;  // Successfully parsed as a float
-    }
+std::optional<Number> tryToConvertToNumber(const std::string& pStr)
+{
+  const char* begin = pStr.data();
+  const char* end = begin + pStr.size();
+  if (begin != end && *begin == '+')
+    ++begin;
+  // Quick rejection of the entities that are not numbers, without any parsing
+  const char* firstDigit = begin != end && *begin == '-' ? begin + 1 : begin;
+  if (firstDigit == end ||
+      (!std::isdigit(static_cast<unsigned char>(*firstDigit)) && *firstDigit != '.'))
+    return {};
 
-    // If neither works, throw an exception
-    throw std::invalid_argument("Invalid number format: " + str);
+  // Try to parse as an int first
+  int intValue = 0;
+  auto intResult = std::from_chars(begin, end, intValue);
+  if (intResult.ec == std::errc() && intResult.ptr == end)
+    return Number(intValue);
+
+  float floatValue = 0;
+  auto floatResult = std::from_chars(begin, end, floatValue);
+  if (floatResult.ec == std::errc() && floatResult.ptr == end)
+    return Number(floatValue);
+  return {};
 }
 
 // Overloaded operator for addition of two Number objects
@@ -108,9 +135,12 @@ Number operator*(const Number& lhs, const Number& rhs) {
 
 // Overloaded operator for equality comparison of two Number objects
 bool operator==(const Number& lhs, const Number& rhs) {
-    return std::visit([](auto&& l, auto&& r) -> bool {
-        return static_cast<float>(l) == static_cast<float>(r);
-    }, lhs, rhs);
+    return numberToDouble(lhs) == numberToDouble(rhs);
+}
+
+double numberToDouble(const Number& pNumber)
+{
+  return std::visit([](auto&& pValue) { return static_cast<double>(pValue); }, pNumber);
 }
 
 // Function to convert a Number to a std::string
@@ -171,12 +201,8 @@ std::optional<Entity> plusIntOrStr(const std::optional<Entity>& pNb1,
 {
   if (!pNb1 || !pNb2 || pNb1->type != pNb2->type)
     return {};
-  try
-  {
-    auto nb1 = stringToNumber(pNb1->value);
-    auto nb2 = stringToNumber(pNb2->value);
-    return Entity(numberToString(nb1 + nb2), pNb1->type);
-  } catch (...) {}
+  if (pNb1->number && pNb2->number)
+    return Entity(*pNb1->number + *pNb2->number, pNb1->type);
   return Entity(pNb1->value + pNb2->value, pNb1->type);
 }
 
@@ -186,12 +212,8 @@ std::optional<Entity> minusIntOrStr(const std::optional<Entity>& pNb1,
 {
   if (!pNb1 || !pNb2 || pNb1->type != pNb2->type)
     return {};
-  try
-  {
-    auto nb1 = stringToNumber(pNb1->value);
-    auto nb2 = stringToNumber(pNb2->value);
-    return Entity(numberToString(nb1 - nb2), pNb1->type);
-  } catch (...) {}
+  if (pNb1->number && pNb2->number)
+    return Entity(*pNb1->number - *pNb2->number, pNb1->type);
   return Entity(pNb1->value + "-" + pNb2->value, pNb1->type);
 }
 
@@ -201,12 +223,8 @@ std::optional<Entity> multiplyNbOrStr(const std::optional<Entity>& pNb1,
 {
   if (!pNb1 || !pNb2 || pNb1->type != pNb2->type)
     return {};
-  try
-  {
-    auto nb1 = stringToNumber(pNb1->value);
-    auto nb2 = stringToNumber(pNb2->value);
-    return Entity(numberToString(nb1 * nb2), pNb1->type);
-  } catch (...) {}
+  if (pNb1->number && pNb2->number)
+    return Entity(*pNb1->number * *pNb2->number, pNb1->type);
   return Entity(pNb1->value + "*" + pNb2->value, pNb1->type);
 }
 
@@ -217,16 +235,21 @@ bool compIntNb(
     bool pBoolSuperiorOrInferior,
     bool pCanBeEqual)
 {
-  try
-  {
-    auto nb1 = stringToNumber(pNb1Str);
-    if (nb1 == pNb2)
-      return pCanBeEqual;
-    if (pBoolSuperiorOrInferior)
-      return nb1 > pNb2;
-    else
-      return nb1 < pNb2;
-  } catch (...) {}
+  auto nb1Opt = tryToConvertToNumber(pNb1Str);
+  if (nb1Opt)
+    return _compNumbers(*nb1Opt, pNb2, pBoolSuperiorOrInferior, pCanBeEqual);
+  return false;
+}
+
+
+bool compIntNb(
+    const Entity& pNb1,
+    const Number& pNb2,
+    bool pBoolSuperiorOrInferior,
+    bool pCanBeEqual)
+{
+  if (pNb1.number)
+    return _compNumbers(*pNb1.number, pNb2, pBoolSuperiorOrInferior, pCanBeEqual);
   return false;
 }
 
@@ -1,20 +1,34 @@
 #include "plannerusingexternaldata.hpp"
+#include "perfregression.hpp"
 #include <orderedgoalsplanner/util/util.hpp>
 
 std::string PlannerUsingExternalData::dataPath = "";
+std::string PerfRegression::baselineFile = "";
+bool PerfRegression::recordBaseline = false;
+double PerfRegression::threshold = 1.25;
+std::size_t PerfRegression::nbOfRepeats = 5;
 
 // Arguments to set: --dataPath ../../data/
+// Optional arguments of the performance regression test: --perfBaseline <json_file> [--perfRecord] [--perfThreshold <ratio>] [--perfRepeat <nb_of_runs>]
 
 
 int main(int argc, char **argv)
 {
   for (int i = 0; i < argc; ++i)
   {
+    const std::string currAgrv = argv[i];
+    if (currAgrv == "--perfRecord")
+      PerfRegression::recordBaseline = true;
     if ((i + 1) < argc)
     {
-      const std::string currAgrv = argv[i];
       if (currAgrv == "--dataPath")
         PlannerUsingExternalData::dataPath = argv[i + 1];
+      else if (currAgrv == "--perfBaseline")
+        PerfRegression::baselineFile = argv[i + 1];
+      else if (currAgrv == "--perfThreshold")
+        PerfRegression::threshold = std::stod(argv[i + 1]);
+      else if (currAgrv == "--perfRepeat")
+        PerfRegression::nbOfRepeats = static_cast<std::size_t>(std::stoul(argv[i + 1]));
     }
   }
 
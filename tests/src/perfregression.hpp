@@ -0,0 +1,22 @@
+#ifndef ORDEREDGOALSPLANNERGTESTS_PERFREGRESSION_HPP
+#define ORDEREDGOALSPLANNERGTESTS_PERFREGRESSION_HPP
+
+#include <cstddef>
+#include <string>
+
+
+/// Options of the performance regression test, set from the command line.
+struct PerfRegression
+{
+  /// JSON file of the measures of reference. The test is skipped if it is empty.
+  static std::string baselineFile;
+  /// Write the measures in the baseline file instead of comparing them to it.
+  static bool recordBaseline;
+  /// Ratio of the baseline above which a scenario is considered as regressed.
+  static double threshold;
+  /// Number of runs of each scenario, the fastest one is kept.
+  static std::size_t nbOfRepeats;
+};
+
+
+#endif // ORDEREDGOALSPLANNERGTESTS_PERFREGRESSION_HPP
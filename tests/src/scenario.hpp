@@ -0,0 +1,23 @@
+#ifndef ORDEREDGOALSPLANNERGTESTS_SCENARIO_HPP
+#define ORDEREDGOALSPLANNERGTESTS_SCENARIO_HPP
+
+#include <string>
+#include <vector>
+
+
+/// Planning situation checked by a test, that can also be timed by the performance regression test.
+struct Scenario
+{
+  std::string name;
+  void (*function)();
+};
+
+
+/// Scenarios of test_planner.cpp.
+const std::vector<Scenario>& plannerScenarios();
+
+/// Scenarios of test_plannerWithSingleType.cpp.
+const std::vector<Scenario>& plannerWithSingleTypeScenarios();
+
+
+#endif // ORDEREDGOALSPLANNERGTESTS_SCENARIO_HPP
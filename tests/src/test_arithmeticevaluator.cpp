@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <orderedgoalsplanner/util/arithmeticevaluator.hpp>
+#include <orderedgoalsplanner/util/replacevariables.hpp>
 
 using namespace ogp;
 
@@ -16,3 +17,55 @@ TEST(Tool, test_arithmeticEvaluator)
   EXPECT_EQ("14", evaluteToStr("`13+1`", 1));
   EXPECT_EQ("_", evaluteToStr("`13+1`"));
 }
+
+
+TEST(Tool, test_compiledArithmeticExpression)
+{
+  EXPECT_EQ("7", evaluteToStr("1+2*3"));
+  EXPECT_EQ("-3", evaluteToStr("-(1+2)"));
+  EXPECT_EQ("2.5", evaluteToStr("5/2.0"));
+  EXPECT_EQ("2", evaluteToStr("5/2"));
+  EXPECT_EQ("_", evaluteToStr("5/0"));
+
+  auto expression = ArithmeticExpression::compile("${battery} - ${cost} * 2");
+  ASSERT_EQ(2u, expression.variables().size());
+  EXPECT_EQ("battery", expression.variables()[0]);
+  EXPECT_EQ("cost", expression.variables()[1]);
+  EXPECT_EQ(Number(6), expression.evaluate({10, 2}));
+  EXPECT_EQ("6.5", evaluationResultToStr(expression.evaluate({10.5f, 2})));
+  EXPECT_ANY_THROW(expression.evaluate({10}));
+
+  std::size_t endPos = 0;
+  ArithmeticExpression::compile("`13+1`", 1, &endPos);
+  EXPECT_EQ(5u, endPos);
+
+  CompiledTemplate compiledTemplate("go to ${location} with `${battery}-10`% (`${unknown}+1`) ${other}");
+  EXPECT_EQ("go to kitchen with 90% (_) ${other}",
+            compiledTemplate.apply({{"location", "kitchen"}, {"battery", "100"}}));
+  EXPECT_EQ("go to room with 2.5% (_) ${other}",
+            compiledTemplate.apply({{"location", "room"}, {"battery", "12.5"}}));
+  std::string str = "go to ${location} with `${battery}-10`%";
+  replaceVariables(str, {{"location", "kitchen"}, {"battery", "100"}});
+  EXPECT_EQ("go to kitchen with 90%", str);
+  str = "go to ${location} with `${battery}-10`%";
+  replaceVariables(str, {{"location", "room"}, {"battery", "50"}});
+  EXPECT_EQ("go to room with 40%", str);
+  // A value that is not a number is substituted as text in the expression
+  str = "`${battery}*2`";
+  replaceVariables(str, {{"battery", "1+2"}});
+  EXPECT_EQ("5", str);
+  str = "`${unknown}*2`";
+  replaceVariables(str, {});
+  EXPECT_EQ("_", str);
+
+  EXPECT_EQ(Number(7), ArithmeticExpression::interpret("1+2*3"));
+  // More pending values than the small stack of the interpreter
+  std::string deepExpression = "`";
+  for (std::size_t i = 0; i < 20; ++i)
+    deepExpression += "1+(";
+  deepExpression += "0.5" + std::string(20, ')') + "`";
+  EXPECT_EQ("20.5", evaluationResultToStr(ArithmeticExpression::interpret(deepExpression, 1, &endPos)));
+  EXPECT_EQ(deepExpression.size() - 1, endPos);
+  EXPECT_EQ(ArithmeticExpression::compile(deepExpression, 1).evaluate(), ArithmeticExpression::interpret(deepExpression, 1));
+  EXPECT_ANY_THROW(ArithmeticExpression::interpret("${battery} + 1"));
+}
@@ -2,6 +2,7 @@
 #include <orderedgoalsplanner/orderedgoalsplanner.hpp>
 #include <orderedgoalsplanner/types/parallelplan.hpp>
 #include <orderedgoalsplanner/types/setofcallbacks.hpp>
+#include <orderedgoalsplanner/util/planvalidator.hpp>
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 
 namespace
@@ -214,6 +215,97 @@ void _testAlreadySatisfiedGoal()
 }
 
 
+void _testPlanValidator()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("robot location");
+  ontology.constants = ogp::SetOfEntities::fromPddl("r1 - robot\n"
+                                                    "l1 l2 l3 - location", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("at(?r - robot) - location\n" +
+                                                      _fact_a, ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  std::vector<ogp::Parameter> act1Parameters{_parameter("?r - robot", ontology),
+                                             _parameter("?from - location", ontology),
+                                             _parameter("?to - location", ontology)};
+  ogp::Action actionObj1(_condition_fromStr("at(?r)=?from", ontology, act1Parameters),
+                         _worldStateModification_fromStr("at(?r)=?to", ontology, act1Parameters));
+  actionObj1.parameters = std::move(act1Parameters);
+  actions.emplace(action1, actionObj1);
+  actions.emplace(action2, ogp::Action(_condition_fromStr("at(r1)=l3", ontology),
+                                       _worldStateModification_fromStr(_fact_a, ontology)));
+
+  ogp::Domain domain(std::move(actions), ontology);
+  ogp::Problem problem;
+  _addFact(problem.worldState, "at(r1)=l1", problem.goalStack, ontology);
+  _setGoalsForAPriority(problem, {_goal(_fact_a, ontology), _goal("at(r1)=l3", ontology)});
+
+  auto move = [&](const std::string& pFrom, const std::string& pTo) {
+    std::map<ogp::Parameter, ogp::Entity> parameters;
+    for (const auto& currParameter : domain.getActionPtr(action1)->parameters)
+    {
+      const auto& value = currParameter.name == "?r" ? "r1" : (currParameter.name == "?from" ? pFrom : pTo);
+      parameters.emplace(currParameter, *ontology.constants.valueToEntity(value));
+    }
+    return ogp::ActionInvocationWithGoal(action1, parameters, {}, 0);
+  };
+  auto toParallelPlan = [](const std::list<std::list<ogp::ActionInvocationWithGoal>>& pSteps) {
+    ogp::ParallelPan res;
+    for (const auto& currStep : pSteps)
+      res.actionsToDoInParallel.push_back(ogp::ActionsToDoInParallel{currStep});
+    return res;
+  };
+  const ogp::ActionInvocationWithGoal doAction2(action2, std::map<ogp::Parameter, ogp::Entity>(), {}, 0);
+
+  ogp::PlanValidator validator(problem, domain);
+  auto validation = validator.validate(toParallelPlan({{move("l1", "l2")}, {move("l2", "l3")}, {doAction2}}));
+  EXPECT_TRUE(validation.isValid());
+  EXPECT_EQ(std::vector<bool>({true, true}), validation.goalsSatisfied);
+
+  validation = validator.validate(std::list<ogp::ActionInvocationWithGoal>{move("l1", "l2"), doAction2});
+  EXPECT_FALSE(validation.isValid());
+  ASSERT_EQ(1u, validation.preconditionFailures.size());
+  EXPECT_EQ(1u, validation.preconditionFailures[0].stepIndex);
+  EXPECT_EQ(0u, validation.preconditionFailures[0].actionIndex);
+  ASSERT_EQ(1u, validation.preconditionFailures[0].unsatisfiedFacts.size());
+  EXPECT_EQ("at(r1)=l3", validation.preconditionFailures[0].unsatisfiedFacts[0].toStr());
+  EXPECT_EQ(std::vector<bool>({true, false}), validation.goalsSatisfied);
+
+  auto validations = validator.validate(std::vector<ogp::ParallelPan>{
+                                          toParallelPlan({{move("l1", "l3")}, {doAction2}}),
+                                          toParallelPlan({{move("l2", "l3")}})});
+  ASSERT_EQ(2u, validations.size());
+  EXPECT_TRUE(validations[0].isValid());
+  EXPECT_FALSE(validations[1].isValid());
+  EXPECT_EQ(std::vector<bool>({false, true}), validations[1].goalsSatisfied);
+
+  // The preconditions of a step are checked on the state at the beginning of the step
+  validation = validator.validate(toParallelPlan({{move("l1", "l3"), doAction2}}));
+  EXPECT_FALSE(validation.isValid());
+  ASSERT_EQ(1u, validation.preconditionFailures.size());
+  EXPECT_EQ(0u, validation.preconditionFailures[0].stepIndex);
+  EXPECT_EQ(1u, validation.preconditionFailures[0].actionIndex);
+  EXPECT_TRUE(validation.effectConflicts.empty());
+
+  // Two actions of a step cannot assign different values to the same fluent
+  validation = validator.validate(toParallelPlan({{move("l1", "l2"), move("l1", "l3")}}));
+  EXPECT_FALSE(validation.isValid());
+  EXPECT_TRUE(validation.preconditionFailures.empty());
+  ASSERT_EQ(1u, validation.effectConflicts.size());
+  EXPECT_EQ(0u, validation.effectConflicts[0].stepIndex);
+  EXPECT_EQ(0u, validation.effectConflicts[0].firstActionIndex);
+  EXPECT_EQ(1u, validation.effectConflicts[0].secondActionIndex);
+  EXPECT_EQ("at(r1)=l3", validation.effectConflicts[0].fact.toStr());
+
+  // The same assignment twice is not a conflict
+  validation = validator.validate(toParallelPlan({{move("l1", "l3"), move("l1", "l3")}, {doAction2}}));
+  EXPECT_TRUE(validation.isValid());
+}
+
+
 }
 
 
@@ -224,4 +316,5 @@ TEST(Planner, test_evaluator)
   _testEvaluateWithFirstActionAlreadyDone();
   _testEvaluateWithOneOfFirstActionAlreadyDone();
   _testAlreadySatisfiedGoal();
+  _testPlanValidator();
 }
@@ -283,6 +283,223 @@ void _goalsToDoInParallelWithConflitingEffects()
 }
 
 
+
+void _actionWithAPreconditionEnabledByAnEvent()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+  const std::string action3 = "action3";
+
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr(_fact_a + "\n" +
+                                                      _fact_b + "\n" +
+                                                      _fact_c + "\n" +
+                                                      _fact_d, ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, _worldStateModification_fromStr(_fact_a, ontology)));
+  actions.emplace(action2, ogp::Action(_condition_fromStr(_fact_b, ontology),
+                                       _worldStateModification_fromStr(_fact_c, ontology)));
+  actions.emplace(action3, ogp::Action({}, _worldStateModification_fromStr(_fact_d, ontology)));
+
+  ogp::SetOfEvents setOfEvents;
+  setOfEvents.add(ogp::Event(_condition_fromStr(_fact_a, ontology),
+                             _worldStateModification_fromStr(_fact_b, ontology)));
+
+  ogp::Domain domain(std::move(actions), ontology, std::move(setOfEvents));
+  ogp::Problem problem;
+  _setGoalsForAPriority(problem, {_goal(_fact_c + " & " + _fact_d, ontology)});
+
+  // action2 does not depend on action1 from their facts, but it needs the fact added by the event that action1 triggers
+  EXPECT_EQ("action1, action3\n"
+            "action2", _parallelPlanStr(problem, domain, _now));
+}
+
+
+void _layerThatMustNotBeMerged()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr(_fact_a + "\n" +
+                                                      _fact_b + "\n" +
+                                                      _fact_c + "\n" +
+                                                      _fact_d, ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, _worldStateModification_fromStr(_fact_a, ontology)));
+  actions.emplace(action2, ogp::Action(_condition_fromStr(_fact_c, ontology),
+                                       _worldStateModification_fromStr(_fact_d, ontology)));
+
+  ogp::SetOfEvents setOfEvents;
+  setOfEvents.add(ogp::Event(_condition_fromStr(_fact_a, ontology),
+                             _worldStateModification_fromStr(_fact_b, ontology)));
+  setOfEvents.add(ogp::Event(_condition_fromStr(_fact_b, ontology),
+                             _worldStateModification_fromStr(_fact_c, ontology)));
+
+  ogp::Domain domain(std::move(actions), ontology, std::move(setOfEvents));
+  ogp::Problem problem;
+  auto problem2 = problem;
+  _setGoalsForAPriority(problem, {_goal(_fact_a + " & " + _fact_d, ontology)});
+  _setGoalsForAPriority(problem2, {_goal(_fact_a + " & " + _fact_d, ontology)});
+
+  // The precondition of action2 is false at the beginning of the layer, so the layer is split
+  EXPECT_EQ("action1\n"
+            "action2", _parallelPlanStr(problem, domain, _now));
+
+  auto actionsToDoInParallel = ogp::actionsToDoInParallelNow(problem2, domain, _now);
+  EXPECT_EQ(action1, ogp::planToStr(actionsToDoInParallel.actions));
+}
+
+
+void _interferingAndIndependentActionsOfRobots()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("robot location");
+  ontology.constants = ogp::SetOfEntities::fromPddl("r1 r2 - robot\n"
+                                                    "l1 l2 - location", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("at(?r - robot) - location\n"
+                                                      "charged(?r - robot)", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  std::vector<ogp::Parameter> act1Parameters{_parameter("?r - robot", ontology), _parameter("?to - location", ontology)};
+  ogp::Action actionObj1({}, _worldStateModification_fromStr("at(?r)=?to", ontology, act1Parameters));
+  actionObj1.parameters = std::move(act1Parameters);
+  actions.emplace(action1, actionObj1);
+
+  std::vector<ogp::Parameter> act2Parameters{_parameter("?r - robot", ontology)};
+  ogp::Action actionObj2(_condition_fromStr("at(?r)=l1", ontology, act2Parameters),
+                         _worldStateModification_fromStr("charged(?r)", ontology, act2Parameters));
+  actionObj2.parameters = std::move(act2Parameters);
+  actions.emplace(action2, actionObj2);
+
+  ogp::Domain domain(std::move(actions), ontology);
+  auto& setOfEventsMap = domain.getSetOfEvents();
+  ogp::Problem problem;
+  _addFact(problem.worldState, "at(r1)=l1", problem.goalStack, ontology, setOfEventsMap, _now);
+  _addFact(problem.worldState, "at(r2)=l1", problem.goalStack, ontology, setOfEventsMap, _now);
+  auto problem2 = problem;
+
+  // Moving r1 changes the location read by the charge of r1, so they interfere
+  _setGoalsForAPriority(problem, {_goal("charged(r1) & at(r1)=l2", ontology)});
+  EXPECT_EQ("action2(?r -> r1)\n"
+            "action1(?r -> r1, ?to -> l2)", _parallelPlanStr(problem, domain, _now));
+
+  // Moving r1 does not change anything for the charge of r2
+  _setGoalsForAPriority(problem2, {_goal("charged(r2) & at(r1)=l2", ontology)});
+  EXPECT_EQ("action1(?r -> r1, ?to -> l2), action2(?r -> r2)", _parallelPlanStr(problem2, domain, _now));
+}
+
+
+void _onlyTheFirstStepIsParallelised()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+  const std::string action3 = "action3";
+  const std::string action4 = "action4";
+
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr(_fact_a + "\n" +
+                                                      _fact_b + "\n" +
+                                                      _fact_c + "\n" +
+                                                      _fact_d, ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, _worldStateModification_fromStr(_fact_a, ontology)));
+  actions.emplace(action2, ogp::Action(_condition_fromStr(_fact_a, ontology),
+                                       _worldStateModification_fromStr(_fact_b, ontology)));
+  actions.emplace(action3, ogp::Action({}, _worldStateModification_fromStr(_fact_c, ontology)));
+  actions.emplace(action4, ogp::Action(_condition_fromStr(_fact_b, ontology),
+                                       _worldStateModification_fromStr(_fact_d, ontology)));
+
+  ogp::Domain domain(std::move(actions), ontology);
+  ogp::Problem problem;
+  _setGoalsForAPriority(problem, {_goal(_fact_b + " & " + _fact_c + " & " + _fact_d, ontology)});
+  auto problem2 = problem;
+
+  EXPECT_EQ("action1, action3\n"
+            "action2\n"
+            "action4", _parallelPlanStr(problem2, domain, _now));
+
+  // Only the first step is returned, the next steps are computed again after it is done
+  EXPECT_EQ("action1, action3", _lookForAnActionToDoInParallelThenNotifyToStr(problem, domain, _now));
+  EXPECT_EQ(action2, _lookForAnActionToDoInParallelThenNotifyToStr(problem, domain, _now));
+  EXPECT_EQ(action4, _lookForAnActionToDoInParallelThenNotifyToStr(problem, domain, _now));
+  EXPECT_EQ("", _lookForAnActionToDoInParallelThenNotifyToStr(problem, domain, _now));
+}
+
+
+void _actionsInterference()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+  const std::string action3 = "action3";
+
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("robot location");
+  ontology.constants = ogp::SetOfEntities::fromPddl("r1 r2 - robot\n"
+                                                    "l1 l2 - location", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("at(?r - robot) - location\n"
+                                                      "charged(?r - robot)\n" +
+                                                      _fact_a, ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  std::vector<ogp::Parameter> act1Parameters{_parameter("?r - robot", ontology), _parameter("?to - location", ontology)};
+  ogp::Action actionObj1({}, _worldStateModification_fromStr("at(?r)=?to", ontology, act1Parameters));
+  actionObj1.parameters = std::move(act1Parameters);
+  actions.emplace(action1, actionObj1);
+
+  std::vector<ogp::Parameter> act2Parameters{_parameter("?r - robot", ontology)};
+  ogp::Action actionObj2(_condition_fromStr("at(?r)=l1", ontology, act2Parameters),
+                         _worldStateModification_fromStr("charged(?r)", ontology, act2Parameters));
+  actionObj2.parameters = std::move(act2Parameters);
+  actions.emplace(action2, actionObj2);
+
+  actions.emplace(action3, ogp::Action({}, _worldStateModification_fromStr(_fact_a, ontology)));
+
+  ogp::Domain domain(std::move(actions), ontology);
+  auto invocation = [&](const std::string& pActionId, const std::map<std::string, std::string>& pArguments) {
+    std::map<ogp::Parameter, ogp::Entity> parameters;
+    for (const auto& currArgument : pArguments)
+    {
+      auto entity = ontology.constants.valueToEntity(currArgument.second);
+      parameters.emplace(ogp::Parameter(currArgument.first, entity->type), *entity);
+    }
+    return ogp::ActionInvocation(pActionId, parameters);
+  };
+
+  EXPECT_FALSE(domain.canActionsInterfere(invocation(action1, {{"?r", "r1"}, {"?to", "l2"}}),
+                                          invocation(action3, {})));
+  EXPECT_TRUE(domain.canActionsInterfere(invocation(action3, {}), invocation(action3, {})));
+  EXPECT_TRUE(domain.canActionsInterfere(invocation(action1, {{"?r", "r1"}, {"?to", "l2"}}),
+                                         invocation(action2, {{"?r", "r1"}})));
+  EXPECT_FALSE(domain.canActionsInterfere(invocation(action1, {{"?r", "r1"}, {"?to", "l2"}}),
+                                          invocation(action2, {{"?r", "r2"}})));
+  EXPECT_FALSE(domain.canActionsInterfere(invocation(action2, {{"?r", "r2"}}),
+                                          invocation(action1, {{"?r", "r1"}, {"?to", "l2"}})));
+  EXPECT_FALSE(domain.canActionsInterfere(invocation(action2, {{"?r", "r1"}}),
+                                          invocation(action2, {{"?r", "r2"}})));
+
+  // The interferences are updated when an action is added or removed
+  const std::string action4 = "action4";
+  domain.addAction(action4, ogp::Action(_condition_fromStr(_fact_a, ontology),
+                                        _worldStateModification_fromStr("charged(r1)", ontology)));
+  EXPECT_TRUE(domain.canActionsInterfere(invocation(action3, {}), invocation(action4, {})));
+  EXPECT_TRUE(domain.canActionsInterfere(invocation(action4, {}), invocation(action2, {{"?r", "r1"}})));
+  EXPECT_FALSE(domain.canActionsInterfere(invocation(action4, {}), invocation(action2, {{"?r", "r2"}})));
+  EXPECT_FALSE(domain.canActionsInterfere(invocation(action1, {{"?r", "r1"}, {"?to", "l2"}}),
+                                          invocation(action4, {})));
+  domain.removeAction(action3);
+  EXPECT_TRUE(domain.canActionsInterfere(invocation(action3, {}), invocation(action4, {})));
+  domain.removeAction(action2);
+  EXPECT_TRUE(domain.canActionsInterfere(invocation(action4, {}), invocation(action4, {})));
+  EXPECT_TRUE(domain.canActionsInterfere(invocation(action4, {}), invocation(action2, {{"?r", "r2"}})));
+}
+
 }
 
 
@@ -294,4 +511,9 @@ TEST(Planner, test_parallelPlan)
   _2actionsNotInParallelBecauseFrom2DifferentSkills();
   _moreThan2GoalsInParallel();
   _goalsToDoInParallelWithConflitingEffects();
+  _actionWithAPreconditionEnabledByAnEvent();
+  _layerThatMustNotBeMerged();
+  _interferingAndIndependentActionsOfRobots();
+  _onlyTheFirstStepIsParallelised();
+  _actionsInterference();
 }
@@ -1,4 +1,6 @@
+#include <sstream>
 #include <gtest/gtest.h>
+#include <orderedgoalsplanner/orderedgoalsplanner.hpp>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
@@ -6,7 +8,9 @@
 #include <orderedgoalsplanner/types/setofentities.hpp>
 #include <orderedgoalsplanner/types/setofpredicates.hpp>
 #include <orderedgoalsplanner/types/worldstatemodification.hpp>
+#include <orderedgoalsplanner/util/serializer/deserializefrombinary.hpp>
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
+#include <orderedgoalsplanner/util/serializer/serializeinbinary.hpp>
 #include <orderedgoalsplanner/util/serializer/serializeinpddl.hpp>
 
 namespace
@@ -54,6 +58,27 @@ void _test_pddlSerializationParts()
     EXPECT_EQ("(= (battery-amount toto) 3.1)", fact.toPddl(false));
   }
 
+  {
+    std::string factsStr = "  (pred_a toto) ; a comment\n"
+                           "  ( pred_c  titi )\n"
+                           "  (= (battery-amount toto) 5)";
+    std::size_t pos = 0;
+    ogp::Fact fact1 = ogp::Fact::fromPddl(factsStr, ontology, {}, {}, pos, &pos);
+    EXPECT_EQ("(pred_a toto)", fact1.toPddl(false));
+    ogp::Fact fact2 = ogp::Fact::fromPddl(factsStr, ontology, {}, {}, pos, &pos);
+    EXPECT_EQ("(pred_c titi)", fact2.toPddl(false));
+    ogp::Fact fact3 = ogp::Fact::fromPddl(factsStr, ontology, {}, {}, pos, &pos);
+    EXPECT_EQ("(= (battery-amount toto) 5)", fact3.toPddl(false));
+    EXPECT_EQ(factsStr.size(), pos);
+  }
+
+  {
+    bool isFactNegated = false;
+    ogp::Fact fact("(not (pred_a toto))", true, ontology, {}, {}, &isFactNegated);
+    EXPECT_TRUE(isFactNegated);
+    EXPECT_EQ("(pred_a toto)", fact.toPddl(false));
+  }
+
   {
     std::size_t pos = 0;
     EXPECT_THROW(ogp::Fact::fromPddl("(battery-amount toto)", ontology, {}, {}, pos, &pos), std::runtime_error);
@@ -136,7 +161,7 @@ void _test_loadPddlDomain()
     loadedDomains.emplace(firstDomain.getName(), std::move(firstDomain));
   }
 
-  auto domain = ogp::pddlToDomain(R"(
+  const std::string constructionDomainPddl = R"(
 (define
     (domain construction)
     (:extends building)
@@ -236,7 +261,8 @@ void _test_loadPddlDomain()
     )
 
 )
-)", loadedDomains);
+)";
+  auto domain = ogp::pddlToDomain(constructionDomainPddl, loadedDomains);
   loadedDomains.emplace(domain.getName(), domain);
 
   const std::string expectedDomain = R"((define
@@ -401,6 +427,10 @@ void _test_loadPddlDomain()
     ASSERT_TRUE(false);
   }
 
+  auto domainParsedInParallel = ogp::pddlToDomain(constructionDomainPddl, loadedDomains, 4);
+  EXPECT_EQ(expectedDomain, ogp::domainToPddl(domainParsedInParallel));
+  EXPECT_EQ(domain.printSuccessionCache(), domainParsedInParallel.printSuccessionCache());
+
 
   ogp::DomainAndProblemPtrs domainAndProblemPtrs = pddlToProblem(R"((define
     (problem buildingahouse)
@@ -474,11 +504,25 @@ void _test_loadPddlDomain()
     ASSERT_TRUE(false);
   }
 
+  // serialize directly in a stream
+  std::ostringstream domainAndProblemStream;
+  ogp::domainToPddl(domainAndProblemStream, domain);
+  ogp::problemToPddl(domainAndProblemStream, *domainAndProblemPtrs.problemPtr,
+                     *domainAndProblemPtrs.domainPtr);
+  EXPECT_EQ(expectedDomain + expectedProblem, domainAndProblemStream.str());
+
   // deserialize what is serialized
   auto domain2 = ogp::pddlToDomain(outDomainPddl1, {});
   std::map<std::string, ogp::Domain> loadedDomains2;
   loadedDomains2.emplace(domain2.getName(), domain2);
   auto outDomainAndProblemPtrs2 = ogp::pddlToProblem(outProblemPddl1, loadedDomains2);
+  // the returned domain is a copy owned by the result
+  EXPECT_NE(&loadedDomains2.begin()->second, outDomainAndProblemPtrs2.domainPtr.get());
+  // the domain of the problem is not copied
+  auto outLoadedDomainAndProblemPtrs2 = ogp::pddlToProblemOfLoadedDomain(outProblemPddl1, loadedDomains2);
+  EXPECT_EQ(&loadedDomains2.begin()->second, outLoadedDomainAndProblemPtrs2.domainPtr);
+  EXPECT_EQ(expectedProblem, ogp::problemToPddl(*outLoadedDomainAndProblemPtrs2.problemPtr,
+                                                *outLoadedDomainAndProblemPtrs2.domainPtr));
 
   // re serialize
   auto outDomainPddl2 = ogp::domainToPddl(domain2);
@@ -495,6 +539,199 @@ void _test_loadPddlDomain()
     std::cout << outProblemPddl2 << std::endl;
     ASSERT_TRUE(false);
   }
+
+  // binary snapshots
+  auto domainBinary = ogp::domainToBinary(domain);
+  auto domain3 = ogp::binaryToDomain(domainBinary);
+  EXPECT_EQ(expectedDomain, ogp::domainToPddl(domain3));
+  EXPECT_EQ(domain.printSuccessionCache(), domain3.printSuccessionCache());
+  for (const auto& currAction : domain.actions())
+  {
+    const auto* loadedActionPtr = domain3.getActionPtr(currAction.first);
+    ASSERT_TRUE(loadedActionPtr != nullptr);
+    EXPECT_EQ(currAction.second.actionsSuccessionsWithoutInterestCache, loadedActionPtr->actionsSuccessionsWithoutInterestCache);
+    EXPECT_EQ(currAction.second.actionsPredecessorsCache, loadedActionPtr->actionsPredecessorsCache);
+    EXPECT_EQ(currAction.second.eventsPredecessorsCache, loadedActionPtr->eventsPredecessorsCache);
+    EXPECT_EQ(currAction.second.preconditionProgramCache != nullptr, loadedActionPtr->preconditionProgramCache != nullptr);
+  }
+  std::map<std::string, ogp::Domain> loadedDomains3;
+  loadedDomains3.emplace(domain3.getName(), domain3);
+  auto problemBinary = ogp::problemToBinary(*domainAndProblemPtrs.problemPtr, *domainAndProblemPtrs.domainPtr);
+  auto outDomainAndProblemPtrs3 = ogp::binaryToProblem(problemBinary, loadedDomains3);
+  EXPECT_EQ(expectedProblem, ogp::problemToPddl(*outDomainAndProblemPtrs3.problemPtr,
+                                                *outDomainAndProblemPtrs3.domainPtr));
+
+  // the historical is restored with its counts, and an absurd count is rejected
+  auto problemWithHistorical = *domainAndProblemPtrs.problemPtr;
+  const std::string actionIdDone = "action_done";
+  problemWithHistorical.historical.setNbOfTimeAnActionHasAlreadyBeenDone(actionIdDone, 1000000000);
+  auto historicalBinary = ogp::problemToBinary(problemWithHistorical, *domainAndProblemPtrs.domainPtr);
+  auto outDomainAndProblemPtrs4 = ogp::binaryToProblem(historicalBinary, loadedDomains3);
+  EXPECT_EQ(1000000000u, outDomainAndProblemPtrs4.problemPtr->historical.getNbOfTimeAnActionHasAlreadyBeenDone(actionIdDone));
+  problemWithHistorical.historical.setNbOfTimeAnActionHasAlreadyBeenDone(actionIdDone, static_cast<std::size_t>(1ULL << 50));
+  EXPECT_ANY_THROW(ogp::binaryToProblem(ogp::problemToBinary(problemWithHistorical, *domainAndProblemPtrs.domainPtr),
+                                        loadedDomains3));
+  problemWithHistorical.historical.setNbOfTimeAnActionHasAlreadyBeenDone(actionIdDone, 0);
+  EXPECT_FALSE(problemWithHistorical.historical.hasActionAlreadyBeenDone(actionIdDone));
+
+  auto corruptedDomainBinary = domainBinary;
+  corruptedDomainBinary.back() ^= 1;
+  EXPECT_ANY_THROW(ogp::binaryToDomain(corruptedDomainBinary));
+  auto otherVersionDomainBinary = domainBinary;
+  ++otherVersionDomainBinary[4];
+  EXPECT_ANY_THROW(ogp::binaryToDomain(otherVersionDomainBinary));
+  EXPECT_ANY_THROW(ogp::binaryToDomain(problemBinary));
+}
+
+
+
+void _test_initFactsEventsDeducedAtTheEnd()
+{
+  std::map<std::string, ogp::Domain> loadedDomains;
+  auto domain = ogp::pddlToDomain(R"((define
+    (domain init_events)
+    (:predicates
+        (a)
+        (b)
+        (c)
+    )
+    (:event deduce_b
+        :parameters ()
+        :precondition (and (a) (not (c)))
+        :effect (b)
+    )
+))", loadedDomains);
+  loadedDomains.emplace(domain.getName(), std::move(domain));
+
+  auto problemWithC = [](const std::string& pInitFacts) {
+    return R"((define
+    (problem pb)
+    (:domain init_events)
+    (:init
+)" + pInitFacts + R"(
+    )
+))";
+  };
+
+  // "(c)" comes after "(a)", the event must not see the state where only "(a)" is there
+  {
+    auto domainAndProblemPtrs = ogp::pddlToProblem(problemWithC("(a)\n(c)"), loadedDomains);
+    EXPECT_EQ("(a)\n(c)", domainAndProblemPtrs.problemPtr->worldState.factsMapping().toPddl(0, true));
+  }
+
+  {
+    auto domainAndProblemPtrs = ogp::pddlToProblem(problemWithC("(a)"), loadedDomains);
+    EXPECT_EQ("(a)\n(b)", domainAndProblemPtrs.problemPtr->worldState.factsMapping().toPddl(0, true));
+  }
+
+  // A negated fact removes a fact inserted before it
+  auto domainAndProblemPtrs = ogp::pddlToProblem(problemWithC("(c)\n(a)\n(not (c))"), loadedDomains);
+  EXPECT_EQ("(a)\n(b)", domainAndProblemPtrs.problemPtr->worldState.factsMapping().toPddl(0, true));
+}
+
+
+void _test_derivedPredicates()
+{
+  const std::string domainPddl = R"((define
+    (domain derived)
+    (:types robot)
+    (:predicates
+        (busy ?r - robot)
+        (done)
+    )
+    (:derived (free ?r - robot)
+        (not (busy ?r))
+    )
+    (:action work
+        :parameters (?r - robot)
+        :precondition (free ?r)
+        :effect (done)
+    )
+))";
+  const std::string problemPddl = R"((define
+    (problem pb)
+    (:domain derived)
+    (:objects r1 r2 - robot)
+    (:init
+        (busy r1)
+    )
+    (:goal (done))
+))";
+
+  for (bool materializeDerivedPredicates : {false, true})
+  {
+    std::map<std::string, ogp::Domain> loadedDomains;
+    auto domain = ogp::pddlToDomain(domainPddl, loadedDomains, 1, materializeDerivedPredicates);
+    EXPECT_EQ(materializeDerivedPredicates, domain.getOntology().derivedPredicates.isMaterialized());
+    EXPECT_EQ(1u, domain.getOntology().derivedPredicates.derivedPredicates().size());
+    EXPECT_EQ(materializeDerivedPredicates ? "free(?r)" : "!busy(?r)",
+              domain.getActionPtr("work")->precondition->toStr());
+
+    // The derived predicate is written and it is parsed back to the same domain
+    auto domainPddlWritten = ogp::domainToPddl(domain);
+    EXPECT_NE(std::string::npos, domainPddlWritten.find("(:derived (free ?r - robot)"));
+    EXPECT_EQ(domainPddlWritten, ogp::domainToPddl(ogp::pddlToDomain(domainPddlWritten, {}, 1, materializeDerivedPredicates)));
+
+    loadedDomains.emplace(domain.getName(), std::move(domain));
+    auto domainAndProblemPtrs = ogp::pddlToProblem(problemPddl, loadedDomains);
+    auto& problem = *domainAndProblemPtrs.problemPtr;
+    // The derived fact on a "not" is true without any fact change so it is evaluated after the init section
+    EXPECT_EQ(materializeDerivedPredicates ? "(busy r1)\n(free r2)" : "(busy r1)",
+              problem.worldState.factsMapping().toPddl(0, true));
+
+    if (materializeDerivedPredicates)
+    {
+      // The robot to use is found from the fact of the derived predicate
+      auto plan = ogp::planForEveryGoals(problem, *domainAndProblemPtrs.domainPtr, {});
+      EXPECT_EQ("00: (work r2) [1]\n", ogp::planToPddl(plan, *domainAndProblemPtrs.domainPtr));
+    }
+  }
+}
+
+
+
+void _test_problemOutlivesTheLoadedDomains()
+{
+  ogp::DomainAndProblemPtrs domainAndProblemPtrs;
+  {
+    std::map<std::string, ogp::Domain> loadedDomains;
+    auto domain = ogp::pddlToDomain(R"((define
+    (domain lifetime)
+    (:types robot location)
+    (:predicates
+        (at ?r - robot) - location
+    )
+    (:action move
+        :parameters (?r - robot ?to - location)
+        :effect (assign (at ?r) ?to)
+    )
+))", loadedDomains);
+    loadedDomains.emplace(domain.getName(), std::move(domain));
+    domainAndProblemPtrs = ogp::pddlToProblem(R"((define
+    (problem pb)
+    (:domain lifetime)
+    (:objects
+        r1 - robot
+        kitchen bedroom - location
+    )
+    (:init
+        (= (at r1) kitchen)
+    )
+    (:goal (= (at r1) bedroom))
+))", loadedDomains);
+  }
+
+  // The loaded domains are destroyed, the problem still uses the types of the domain owned by the result
+  const auto& domain = *domainAndProblemPtrs.domainPtr;
+  const auto* r1Ptr = domainAndProblemPtrs.problemPtr->entities.valueToEntity("r1");
+  ASSERT_TRUE(r1Ptr != nullptr);
+  EXPECT_EQ(domain.getOntology().types.nameToType("robot"), r1Ptr->type);
+  EXPECT_EQ("(= (at r1) kitchen)", domainAndProblemPtrs.problemPtr->worldState.factsMapping().toPddl(0, true));
+
+  auto problem = *domainAndProblemPtrs.problemPtr;
+  auto plan = ogp::planForEveryGoals(problem, domain, {});
+  EXPECT_EQ("00: (move r1 bedroom) [1]\n", ogp::planToPddl(plan, domain));
+  EXPECT_EQ("(= (at r1) bedroom)", problem.worldState.factsMapping().toPddl(0, true));
 }
 
 }
@@ -505,4 +742,7 @@ TEST(Tool, test_pddlSerialization)
 {
   _test_pddlSerializationParts();
   _test_loadPddlDomain();
+  _test_initFactsEventsDeducedAtTheEnd();
+  _test_derivedPredicates();
+  _test_problemOutlivesTheLoadedDomains();
 }
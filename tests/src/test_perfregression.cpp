@@ -0,0 +1,150 @@
+#include "perfregression.hpp"
+#include <gtest/gtest.h>
+#include <gtest/gtest-spi.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <orderedgoalsplanner/types/plannerstats.hpp>
+#include "scenario.hpp"
+
+
+namespace
+{
+/// Differences of time below this value are considered as noise.
+const double _minTimeDifferenceInMs = 0.05;
+/// A scenario is run several times in a row until this duration to measure the short scenarios.
+const double _minSampleDurationInMs = 5;
+
+struct ScenarioMeasure
+{
+  /// Mean time of a run in the fastest sample.
+  double timeInMs = 0;
+  /// Number of allocations of a run, 0 if the allocations are not counted.
+  std::size_t nbOfAllocations = 0;
+};
+
+
+ScenarioMeasure _measure(const Scenario& pScenario)
+{
+  // The checks of the scenarios are done by their own tests, here only the performances matter
+  testing::TestPartResultArray checkResults;
+  testing::ScopedFakeTestPartResultReporter checkResultsReporter(
+        testing::ScopedFakeTestPartResultReporter::INTERCEPT_ONLY_CURRENT_THREAD, &checkResults);
+
+  ScenarioMeasure res;
+  {
+    // The first run also warms up the caches
+    ogp::PlannerStats stats;
+    ogp::PlannerStatsScope statsScope(&stats);
+    pScenario.function();
+    res.nbOfAllocations = stats.totalAllocations().nbOfAllocations;
+  }
+
+  for (std::size_t i = 0; i < PerfRegression::nbOfRepeats; ++i)
+  {
+    std::size_t nbOfRuns = 0;
+    double sampleDurationInMs = 0;
+    auto begin = std::chrono::steady_clock::now();
+    while (sampleDurationInMs < _minSampleDurationInMs)
+    {
+      pScenario.function();
+      ++nbOfRuns;
+      sampleDurationInMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+    auto timeInMs = sampleDurationInMs / static_cast<double>(nbOfRuns);
+    if (i == 0 || timeInMs < res.timeInMs)
+      res.timeInMs = timeInMs;
+  }
+  return res;
+}
+
+
+std::map<std::string, ScenarioMeasure> _measureAllScenarios()
+{
+  std::map<std::string, ScenarioMeasure> res;
+  for (const auto& currScenario : plannerScenarios())
+    res["planner/" + currScenario.name] = _measure(currScenario);
+  for (const auto& currScenario : plannerWithSingleTypeScenarios())
+    res["plannerWithSingleType/" + currScenario.name] = _measure(currScenario);
+  return res;
+}
+
+
+void _writeBaseline(const std::string& pFilePath,
+                    const std::map<std::string, ScenarioMeasure>& pMeasures)
+{
+  std::ofstream file(pFilePath);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open the file " + pFilePath);
+  file << "{\n  \"scenarios\": {";
+  bool firstScenario = true;
+  for (const auto& currMeasure : pMeasures)
+  {
+    file << (firstScenario ? "\n" : ",\n") << "    \"" << currMeasure.first << "\": {\"time_ms\": "
+         << std::fixed << std::setprecision(4) << currMeasure.second.timeInMs
+         << ", \"allocations\": " << currMeasure.second.nbOfAllocations << "}";
+    firstScenario = false;
+  }
+  file << "\n  }\n}\n";
+}
+
+
+std::map<std::string, ScenarioMeasure> _readBaseline(const std::string& pFilePath)
+{
+  std::ifstream file(pFilePath);
+  if (!file.is_open())
+    throw std::runtime_error("Could not open the file " + pFilePath);
+  std::stringstream content;
+  content << file.rdbuf();
+  auto contentStr = content.str();
+
+  std::map<std::string, ScenarioMeasure> res;
+  const std::regex scenarioRegex("\"([^\"]+)\"\\s*:\\s*\\{\\s*\"time_ms\"\\s*:\\s*([0-9.eE+-]+)\\s*,\\s*\"allocations\"\\s*:\\s*([0-9]+)\\s*\\}");
+  for (auto it = std::sregex_iterator(contentStr.begin(), contentStr.end(), scenarioRegex); it != std::sregex_iterator(); ++it)
+  {
+    ScenarioMeasure measure;
+    measure.timeInMs = std::stod((*it)[2].str());
+    measure.nbOfAllocations = static_cast<std::size_t>(std::stoull((*it)[3].str()));
+    res[(*it)[1].str()] = measure;
+  }
+  return res;
+}
+
+}
+
+
+
+TEST(PerfRegression, test_scenarios)
+{
+  if (PerfRegression::baselineFile.empty())
+    GTEST_SKIP() << "No baseline, give one with --perfBaseline <json_file>.";
+
+  auto measures = _measureAllScenarios();
+  if (PerfRegression::recordBaseline || !std::ifstream(PerfRegression::baselineFile).good())
+  {
+    _writeBaseline(PerfRegression::baselineFile, measures);
+    std::cout << "Baseline of " << measures.size() << " scenarios written in " << PerfRegression::baselineFile << std::endl;
+    return;
+  }
+
+  auto baseline = _readBaseline(PerfRegression::baselineFile);
+  for (const auto& currMeasure : measures)
+  {
+    auto itReference = baseline.find(currMeasure.first);
+    if (itReference == baseline.end())
+      continue;
+    const auto& reference = itReference->second;
+    const auto& measure = currMeasure.second;
+    EXPECT_FALSE(measure.timeInMs > reference.timeInMs * PerfRegression::threshold &&
+                 measure.timeInMs - reference.timeInMs > _minTimeDifferenceInMs)
+        << currMeasure.first << " takes " << measure.timeInMs << " ms instead of " << reference.timeInMs << " ms";
+    // The allocations are compared only if they are counted now and in the baseline
+    EXPECT_FALSE(reference.nbOfAllocations > 0 && measure.nbOfAllocations > 0 &&
+                 static_cast<double>(measure.nbOfAllocations) > static_cast<double>(reference.nbOfAllocations) * PerfRegression::threshold)
+        << currMeasure.first << " does " << measure.nbOfAllocations << " allocations instead of " << reference.nbOfAllocations;
+  }
+}
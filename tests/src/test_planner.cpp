@@ -7,6 +7,7 @@
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 #include <orderedgoalsplanner/util/trackers/goalsremovedtracker.hpp>
 #include <orderedgoalsplanner/util/print.hpp>
+#include "scenario.hpp"
 #include "docexamples/test_planningDummyExample.hpp"
 #include "docexamples/test_planningExampleWithAPreconditionSolve.hpp"
 
@@ -669,28 +670,89 @@ void _disjunctivePrecondition()
 }
 
 
+void _plannerStats()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, ogp::strToWsModification("fact_a", ontology, {}, {})));
+  actions.emplace(action2, ogp::Action(ogp::strToCondition("fact_a", ontology, {}, {}),
+                                       ogp::strToWsModification("fact_b", ontology, {}, {})));
+  ogp::Domain domain(std::move(actions), ontology);
+
+  ogp::Problem problem;
+  auto& entities = problem.entities;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_b", ontology, entities)});
+
+  ogp::LookForAnActionOutputInfos lookForAnActionOutputInfos;
+  auto plan = ogp::planForEveryGoals(problem, domain, _now, nullptr, nullptr, &lookForAnActionOutputInfos);
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(plan, ", "));
+  const auto& stats = lookForAnActionOutputInfos.stats();
+  if (ogp::PlannerStats::isEnabled())
+  {
+    EXPECT_LT(0u, stats.nbOfCandidateActions);
+    EXPECT_LT(0u, stats.nbOfLookForAPossibleEffectCalls);
+    EXPECT_LT(0u, stats.maxLookForAPossibleEffectDepth);
+    EXPECT_LT(0u, stats.nbOfProblemCopies);
+    EXPECT_LT(0u, stats.nbOfConditionEvaluations);
+    EXPECT_LT(0u, stats.nbOfWorldStateCacheHits + stats.nbOfWorldStateCacheMisses);
+  }
+  else
+  {
+    EXPECT_EQ(0u, stats.nbOfCandidateActions);
+    EXPECT_EQ(0u, stats.nbOfConditionEvaluations);
+  }
+
+  if (ogp::PlannerStats::isAllocationAccountingEnabled())
+  {
+    EXPECT_LT(0u, stats.allocations(ogp::PlannerPhase::PLANNING).nbOfAllocations);
+    EXPECT_LT(0u, stats.allocations(ogp::PlannerPhase::PROBLEM_COPY).nbOfBytes);
+  }
+  else
+  {
+    EXPECT_EQ(0u, stats.totalAllocations().nbOfAllocations);
+  }
 }
 
+}
+
+
+
+const std::vector<Scenario>& plannerScenarios()
+{
+  static const std::vector<Scenario> res = {
+    {"planningDummyExample", planningDummyExample},
+    {"planningExampleWithAPreconditionSolve", planningExampleWithAPreconditionSolve},
+    {"simplest_plan_possible", _simplest_plan_possible},
+    {"wrong_condition_type", _wrong_condition_type},
+    {"number_type", _number_type},
+    {"planWithActionThenEventWithFluentParameter", _planWithActionThenEventWithFluentParameter},
+    {"planWithActionThenEventWithAssign", _planWithActionThenEventWithAssign},
+    {"fluentEqualityInPrecoditionOfAnAction", _fluentEqualityInPrecoditionOfAnAction},
+    {"testIncrementOfVariables", _testIncrementOfVariables},
+    {"actionWithParametersInPreconditionsAndEffects", _actionWithParametersInPreconditionsAndEffects},
+    {"testQuiz", _testQuiz},
+    {"doNextActionThatBringsToTheSmallerCost", _doNextActionThatBringsToTheSmallerCost},
+    {"satisfyGoalWithSuperiorOperator", _satisfyGoalWithSuperiorOperator},
+    {"parameterToFillFromConditionOfFirstAction", _parameterToFillFromConditionOfFirstAction},
+    {"planToMove", _planToMove},
+    {"disjunctiveGoal", _disjunctiveGoal},
+    {"disjunctivePrecondition", _disjunctivePrecondition},
+    {"plannerStats", _plannerStats}
+  };
+  return res;
+}
 
 
 TEST(Planner, test_planner)
 {
-  planningDummyExample();
-  planningExampleWithAPreconditionSolve();
-
-  _simplest_plan_possible();
-  _wrong_condition_type();
-  _number_type();
-  _planWithActionThenEventWithFluentParameter();
-  _planWithActionThenEventWithAssign();
-  _fluentEqualityInPrecoditionOfAnAction();
-  _testIncrementOfVariables();
-  _actionWithParametersInPreconditionsAndEffects();
-  _testQuiz();
-  _doNextActionThatBringsToTheSmallerCost();
-  _satisfyGoalWithSuperiorOperator();
-  _parameterToFillFromConditionOfFirstAction();
-  _planToMove();
-  _disjunctiveGoal();
-  _disjunctivePrecondition();
+  for (const auto& currScenario : plannerScenarios())
+  {
+    SCOPED_TRACE(currScenario.name);
+    currScenario.function();
+  }
 }
@@ -7,6 +7,7 @@
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 #include <orderedgoalsplanner/util/trackers/goalsremovedtracker.hpp>
 #include <orderedgoalsplanner/util/print.hpp>
+#include "scenario.hpp"
 
 namespace
 {
@@ -1595,6 +1596,97 @@ void _checkMaxTimeToKeepInactiveForGoals()
 }
 
 
+void _checkInactivityDeadlinesOfGoals()
+{
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr(_fact_greeted + "\n" +
+                                                     _fact_checkedIn + "\n" +
+                                                     _fact_beHappy + "\n" +
+                                                     _fact_advertised + "\n" +
+                                                     _fact_presented, ontology.types);
+  ogp::WorldState worldState;
+  const auto since = std::chrono::steady_clock::now();
+  auto at = [&](std::chrono::steady_clock::duration pElapsed) {
+    return std::make_unique<std::chrono::steady_clock::time_point>(since + pElapsed);
+  };
+  auto hasGoal = [](const ogp::GoalStack& pGoalStack, const std::string& pGoalStr) {
+    for (const auto& currGoalsGroup : pGoalStack.goals())
+      for (const auto& currGoal : currGoalsGroup.second)
+        if (currGoal.toStr() == pGoalStr)
+          return true;
+    return false;
+  };
+  // Moving the goal of the lowest priority makes the goal stack remove the goals inactive for too long.
+  auto checkGoalsAt = [&](ogp::GoalStack& pGoalStack, std::chrono::steady_clock::duration pElapsed) {
+    pGoalStack.changeGoalPriority(_fact_presented, 1, false, worldState, at(pElapsed));
+  };
+  // Previous rule: a goal is inactive for too long when its number of whole seconds of inactivity exceeds the maximum.
+  auto wasInactiveForTooLong = [](std::chrono::steady_clock::duration pElapsed, int pMaxTimeToKeepInactive) {
+    return std::chrono::duration_cast<std::chrono::seconds>(pElapsed).count() > pMaxTimeToKeepInactive;
+  };
+  const auto oneTick = std::chrono::steady_clock::duration(1);
+
+  // The goal is removed exactly at the time it is inactive since more than max + 1 seconds
+  {
+    ogp::GoalStack goalStack;
+    goalStack.pushBackGoal(_goal(_fact_presented, ontology), worldState, at(std::chrono::seconds(0)), 1);
+    goalStack.pushBackGoal(_goal(_fact_greeted, ontology), worldState, at(std::chrono::seconds(0)), 10);
+    goalStack.pushBackGoal(_goal(_fact_checkedIn, ontology, 60), worldState, at(std::chrono::seconds(0)), 10);
+    EXPECT_FALSE(wasInactiveForTooLong(std::chrono::seconds(61) - oneTick, 60));
+    checkGoalsAt(goalStack, std::chrono::seconds(61) - oneTick);
+    EXPECT_TRUE(hasGoal(goalStack, _fact_checkedIn));
+    EXPECT_TRUE(wasInactiveForTooLong(std::chrono::seconds(61), 60));
+    checkGoalsAt(goalStack, std::chrono::seconds(61));
+    EXPECT_FALSE(hasGoal(goalStack, _fact_checkedIn));
+    EXPECT_TRUE(hasGoal(goalStack, _fact_greeted));
+  }
+
+  // A goal with a max time to keep inactive of 0 is kept while it is active and removed as soon as it is inactive
+  {
+    ogp::GoalStack goalStack;
+    goalStack.pushBackGoal(_goal(_fact_presented, ontology), worldState, at(std::chrono::seconds(0)), 1);
+    goalStack.pushBackGoal(_goal(_fact_checkedIn, ontology, 0), worldState, at(std::chrono::seconds(0)), 10);
+    checkGoalsAt(goalStack, std::chrono::seconds(1000));
+    EXPECT_TRUE(hasGoal(goalStack, _fact_checkedIn));
+    goalStack.pushBackGoal(_goal(_fact_greeted, ontology), worldState, at(std::chrono::seconds(1001)), 11);
+    EXPECT_FALSE(hasGoal(goalStack, _fact_checkedIn));
+    EXPECT_TRUE(hasGoal(goalStack, _fact_presented));
+  }
+
+  // A goal active again after being pushed is not removed when its old deadline is reached
+  {
+    ogp::GoalStack goalStack;
+    goalStack.pushBackGoal(_goal(_fact_presented, ontology), worldState, at(std::chrono::seconds(0)), 1);
+    goalStack.pushBackGoal(_goal(_fact_checkedIn, ontology, 60), worldState, at(std::chrono::seconds(0)), 10);
+    goalStack.pushBackGoal(_goal(_fact_greeted, ontology, -1, "greetGroup"), worldState, at(std::chrono::seconds(0)), 11);
+    EXPECT_TRUE(goalStack.removeGoals("greetGroup", worldState, at(std::chrono::seconds(10))));
+    checkGoalsAt(goalStack, std::chrono::seconds(100));
+    EXPECT_TRUE(hasGoal(goalStack, _fact_checkedIn));
+  }
+
+  // The deadlines of the goals removed or moved do not remove the other goals
+  {
+    ogp::GoalStack goalStack;
+    goalStack.pushBackGoal(_goal(_fact_presented, ontology), worldState, at(std::chrono::seconds(0)), 1);
+    goalStack.pushBackGoal(_goal(_fact_greeted, ontology), worldState, at(std::chrono::seconds(0)), 10);
+    goalStack.pushBackGoal(_goal(_fact_checkedIn, ontology, 10, "checkInGroup"), worldState, at(std::chrono::seconds(0)), 10);
+    goalStack.pushBackGoal(_goal(_fact_advertised, ontology, 30), worldState, at(std::chrono::seconds(0)), 10);
+    goalStack.pushBackGoal(_goal(_fact_beHappy, ontology, 60), worldState, at(std::chrono::seconds(0)), 10);
+    EXPECT_TRUE(goalStack.removeGoals("checkInGroup", worldState, at(std::chrono::seconds(5))));
+    goalStack.changeGoalPriority(_fact_advertised, 11, true, worldState, at(std::chrono::seconds(5)));
+    checkGoalsAt(goalStack, std::chrono::seconds(40));
+    EXPECT_TRUE(hasGoal(goalStack, _fact_advertised));
+    EXPECT_TRUE(hasGoal(goalStack, _fact_beHappy));
+    checkGoalsAt(goalStack, std::chrono::seconds(61) - oneTick);
+    EXPECT_TRUE(hasGoal(goalStack, _fact_beHappy));
+    checkGoalsAt(goalStack, std::chrono::seconds(61));
+    EXPECT_FALSE(hasGoal(goalStack, _fact_beHappy));
+    EXPECT_TRUE(hasGoal(goalStack, _fact_advertised));
+    EXPECT_TRUE(hasGoal(goalStack, _fact_greeted));
+  }
+}
+
+
 
 void _changePriorityOfGoal()
 {
@@ -4154,6 +4246,53 @@ void _derivedPredicates()
 }
 
 
+void _materializedDerivedPredicates()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("param");
+  ontology.constants = ogp::SetOfEntities::fromPddl("p1 p2 - param", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr(_fact_a + "(?p - param)\n" +
+                                                     _fact_b + "(?p - param)\n" +
+                                                     _fact_d, ontology.types);
+  ontology.derivedPredicates.addDerivedPredicate(
+        ogp::DerivedPredicate(ogp::Predicate(_fact_e + "(?a - param)", false, ontology.types),
+                             _fact_a + "(?a) & " + _fact_b + "(?a)", ontology));
+  ontology.derivedPredicates.setMaterialized(true);
+
+  std::map<std::string, ogp::Action> actions;
+  std::vector<ogp::Parameter> action1Parameters{_parameter("?p - param", ontology)};
+  ogp::Action action1Obj(_condition_fromStr(_fact_a + "(?p)", ontology, action1Parameters),
+                         _worldStateModification_fromStr(_fact_b + "(?p)", ontology, action1Parameters));
+  action1Obj.parameters = std::move(action1Parameters);
+  actions.emplace(action1, action1Obj);
+  actions.emplace(action2, ogp::Action(_condition_fromStr(_fact_e + "(p2)", ontology),
+                                       _worldStateModification_fromStr(_fact_d, ontology)));
+
+  ogp::Domain domain(std::move(actions), ontology);
+  // The derived predicate is not expanded in the precondition
+  EXPECT_EQ(_fact_e + "(p2)", domain.getActionPtr(action2)->precondition->toStr());
+  auto& setOfEventsMap = domain.getSetOfEvents();
+  EXPECT_EQ(1u, setOfEventsMap.count(ogp::Domain::getSetOfEventsIdFromDerivedPredicates()));
+
+  ogp::Problem problem;
+  _addFact(problem.worldState, _fact_a + "(p1)", problem.goalStack, ontology, setOfEventsMap, _now);
+  _addFact(problem.worldState, _fact_b + "(p1)", problem.goalStack, ontology, setOfEventsMap, _now);
+  EXPECT_TRUE(_hasFact(problem.worldState, _fact_e + "(p1)", ontology));
+  _removeFact(problem.worldState, _fact_a + "(p1)", problem.goalStack, ontology, setOfEventsMap, _now);
+  EXPECT_FALSE(_hasFact(problem.worldState, _fact_e + "(p1)", ontology));
+
+  _addFact(problem.worldState, _fact_a + "(p2)", problem.goalStack, ontology, setOfEventsMap, _now);
+  EXPECT_FALSE(_hasFact(problem.worldState, _fact_e + "(p2)", ontology));
+  _setGoalsForAPriority(problem, {_goal(_fact_d, ontology)});
+  EXPECT_EQ(action1 + "(?p -> p2)", _lookForAnActionToDoThenNotify(problem, domain, _now).actionInvocation.toStr());
+  EXPECT_TRUE(_hasFact(problem.worldState, _fact_e + "(p2)", ontology));
+  EXPECT_EQ(action2, _lookForAnActionToDoThenNotify(problem, domain, _now).actionInvocation.toStr());
+}
+
+
 void _assignAFactTwoTimesInTheSamePlan()
 {
   const std::string action1 = "action1";
@@ -4315,121 +4454,136 @@ void _eventToRemoveAFactWithoutFluent()
 
 
 
+const std::vector<Scenario>& plannerWithSingleTypeScenarios()
+{
+  static const std::vector<Scenario> res = {
+    {"test_createEmptyGoal", _test_createEmptyGoal},
+    {"test_goalToStr", _test_goalToStr},
+    {"test_factToStr", _test_factToStr},
+    {"test_conditionParameters", _test_conditionParameters},
+    {"test_wsModificationToStr", _test_wsModificationToStr},
+    {"test_invertCondition", _test_invertCondition},
+    {"test_checkCondition", _test_checkCondition},
+    {"automaticallyRemoveGoalsWithAMaxTimeToKeepInactiveEqualTo0", _automaticallyRemoveGoalsWithAMaxTimeToKeepInactiveEqualTo0},
+    {"maxTimeToKeepInactiveEqualTo0UnderAnAlreadySatisfiedGoal", _maxTimeToKeepInactiveEqualTo0UnderAnAlreadySatisfiedGoal},
+    {"noPreconditionGoalImmediatlyReached", _noPreconditionGoalImmediatlyReached},
+    {"removeGoalWhenItIsSatisfiedByAnAction", _removeGoalWhenItIsSatisfiedByAnAction},
+    {"removeAnAction", _removeAnAction},
+    {"removeSomeGoals", _removeSomeGoals},
+    {"notifyGoalRemovedWhenItIsImmediatlyRemoved", _notifyGoalRemovedWhenItIsImmediatlyRemoved},
+    {"handlePreconditionWithNegatedFacts", _handlePreconditionWithNegatedFacts},
+    {"testWithNegatedAccessibleFacts", _testWithNegatedAccessibleFacts},
+    {"noPlanWithALengthOf2", _noPlanWithALengthOf2},
+    {"noPlanWithALengthOf3", _noPlanWithALengthOf3},
+    {"2preconditions", _2preconditions},
+    {"2Goals", _2Goals},
+    {"2UnrelatedGoals", _2UnrelatedGoals},
+    {"impossibleGoal", _impossibleGoal},
+    {"privigelizeTheActionsThatHaveManyPreferedInContext", _privigelizeTheActionsThatHaveManyPreferedInContext},
+    {"preconditionThatCannotBeSolved", _preconditionThatCannotBeSolved},
+    {"preferInContext", _preferInContext},
+    {"preferWhenPreconditionAreCloserToTheRealFacts", _preferWhenPreconditionAreCloserToTheRealFacts},
+    {"avoidToDo2TimesTheSameActionIfPossble", _avoidToDo2TimesTheSameActionIfPossble},
+    {"takeHistoricalIntoAccount", _takeHistoricalIntoAccount},
+    {"goDoTheActionThatHaveTheMostPreferInContextValidated", _goDoTheActionThatHaveTheMostPreferInContextValidated},
+    {"checkNotInAPrecondition", _checkNotInAPrecondition},
+    {"checkClearGoalsWhenItsAlreadySatisfied", _checkClearGoalsWhenItsAlreadySatisfied},
+    {"checkActionHasAFact", _checkActionHasAFact},
+    {"precoditionEqualEffect", _precoditionEqualEffect},
+    {"addGoalEvenForEmptyAction", _addGoalEvenForEmptyAction},
+    {"circularDependencies", _circularDependencies},
+    {"triggerActionThatRemoveAFact", _triggerActionThatRemoveAFact},
+    {"actionWithConstantValue", _actionWithConstantValue},
+    {"actionWithParameterizedValue", _actionWithParameterizedValue},
+    {"actionWithParameterizedParameter", _actionWithParameterizedParameter},
+    {"actionWithParametersInPreconditionsAndEffectsWithoutSolution", _actionWithParametersInPreconditionsAndEffectsWithoutSolution},
+    {"actionWithParametersInsideThePath", _actionWithParametersInsideThePath},
+    {"testPersistGoal", _testPersistGoal},
+    {"testPersistImplyGoal", _testPersistImplyGoal},
+    {"testImplyGoal", _testImplyGoal},
+    {"checkPreviousBugAboutSelectingAnInappropriateAction", _checkPreviousBugAboutSelectingAnInappropriateAction},
+    {"dontLinkActionWithPreferredInContext", _dontLinkActionWithPreferredInContext},
+    {"checkPriorities", _checkPriorities},
+    {"stackablePropertyOfGoals", _stackablePropertyOfGoals},
+    {"doNotRemoveAGoalWithMaxTimeToKeepInactiveEqual0BelowAGoalWithACondotionNotSatisfied", _doNotRemoveAGoalWithMaxTimeToKeepInactiveEqual0BelowAGoalWithACondotionNotSatisfied},
+    {"checkMaxTimeToKeepInactiveForGoals", _checkMaxTimeToKeepInactiveForGoals},
+    {"checkInactivityDeadlinesOfGoals", _checkInactivityDeadlinesOfGoals},
+    {"changePriorityOfGoal", _changePriorityOfGoal},
+    {"factChangedNotification", _factChangedNotification},
+    {"checkEvents", _checkEvents},
+    {"checkEventsWithImply", _checkEventsWithImply},
+    {"checkEventWithPunctualCondition", _checkEventWithPunctualCondition},
+    {"checkEventAtEndOfAPlan", _checkEventAtEndOfAPlan},
+    {"checkEventInsideAPlan", _checkEventInsideAPlan},
+    {"checkEventThatAddAGoal", _checkEventThatAddAGoal},
+    {"testGetNotSatisfiedGoals", _testGetNotSatisfiedGoals},
+    {"testGoalUnderPersist", _testGoalUnderPersist},
+    {"checkLinkedEvents", _checkLinkedEvents},
+    {"oneStepTowards", _oneStepTowards},
+    {"infrenceLinksFromManyEventsSets", _infrenceLinksFromManyEventsSets},
+    {"factValueModification", _factValueModification},
+    {"removeGoaWhenAnActionFinishesByAddingNewGoals", _removeGoaWhenAnActionFinishesByAddingNewGoals},
+    {"setWsModification", _setWsModification},
+    {"forAllWsModification", _forAllWsModification},
+    {"actionNavigationAndGrabObjectWithParameters", _actionNavigationAndGrabObjectWithParameters},
+    {"actionNavigationAndGrabObjectWithParameters2", _actionNavigationAndGrabObjectWithParameters2},
+    {"moveObject", _moveObject},
+    {"moveAndUngrabObject", _moveAndUngrabObject},
+    {"failToMoveAnUnknownObject", _failToMoveAnUnknownObject},
+    {"completeMovingObjectScenario", _completeMovingObjectScenario},
+    {"moveAnObject", _moveAnObject},
+    {"matchSkillWithObjectsWithASubType", _matchSkillWithObjectsWithASubType},
+    {"eventWithANegatedFactWithParameter", _eventWithANegatedFactWithParameter},
+    {"actionWithANegatedFactNotTriggeredIfNotNecessary", _actionWithANegatedFactNotTriggeredIfNotNecessary},
+    {"useTwoTimesAnEvent", _useTwoTimesAnEvent},
+    {"linkWithAnyValueInCondition", _linkWithAnyValueInCondition},
+    {"removeAFactWithAnyValue", _removeAFactWithAnyValue},
+    {"notDeducePathIfTheParametersOfAFactAreDifferents", _notDeducePathIfTheParametersOfAFactAreDifferents},
+    {"checkPreferInContext", _checkPreferInContext},
+    {"checkPreferHighImportanceOfNotRepeatingIt", _checkPreferHighImportanceOfNotRepeatingIt},
+    {"actionWithFactWithANegatedFact", _actionWithFactWithANegatedFact},
+    {"negatedFactValueInWorldState", _negatedFactValueInWorldState},
+    {"problemThatUseADomainThatChangedSinceLastUsage", _problemThatUseADomainThatChangedSinceLastUsage},
+    {"checkFilterFactInCondition", _checkFilterFactInCondition},
+    {"checkFilterFactInConditionAndThenPropagate", _checkFilterFactInConditionAndThenPropagate},
+    {"checkOutputValueOfLookForAnActionToDo", _checkOutputValueOfLookForAnActionToDo},
+    {"hardProblemThatNeedsToBeSmart", _hardProblemThatNeedsToBeSmart},
+    {"hardProblemThatNeedsToBeSmartWithAnEvent", _hardProblemThatNeedsToBeSmartWithAnEvent},
+    {"checkOverallEffectDuringParallelisation", _checkOverallEffectDuringParallelisation},
+    {"checkSimpleExists", _checkSimpleExists},
+    {"checkExistsWithActionParameterInvolved", _checkExistsWithActionParameterInvolved},
+    {"checkExistsWithManyFactsInvolved", _checkExistsWithManyFactsInvolved},
+    {"doAnActionToSatisfyAnExists", _doAnActionToSatisfyAnExists},
+    {"checkForAllEffectAtStart", _checkForAllEffectAtStart},
+    {"existsWithValue", _existsWithValue},
+    {"notExists", _notExists},
+    {"actionToSatisfyANotExists", _actionToSatisfyANotExists},
+    {"orInCondition", _orInCondition},
+    {"axioms", _axioms},
+    {"assignAnotherValueToSatisfyNotGoal", _assignAnotherValueToSatisfyNotGoal},
+    {"assignUndefined", _assignUndefined},
+    {"assignAFact", _assignAFact},
+    {"assignAFactToAction", _assignAFactToAction},
+    {"assignAFactThenCheckEqualityWithAnotherFact", _assignAFactThenCheckEqualityWithAnotherFact},
+    {"assignAFactThenCheckExistWithAnotherFact", _assignAFactThenCheckExistWithAnotherFact},
+    {"existWithEqualityInEvent", _existWithEqualityInEvent},
+    {"existWithEqualityInEvent_withEqualityInverted", _existWithEqualityInEvent_withEqualityInverted},
+    {"fixEventWithFluentInParameter", _fixEventWithFluentInParameter},
+    {"derivedPredicates", _derivedPredicates},
+    {"materializedDerivedPredicates", _materializedDerivedPredicates},
+    {"assignAFactTwoTimesInTheSamePlan", _assignAFactTwoTimesInTheSamePlan},
+    {"checkTwoTimesTheEqualityOfAFact", _checkTwoTimesTheEqualityOfAFact},
+    {"eventToRemoveAFactWithoutFluent", _eventToRemoveAFactWithoutFluent}
+  };
+  return res;
+}
+
+
 TEST(Planner, test_planWithSingleType)
 {
-  _test_createEmptyGoal();
-  _test_goalToStr();
-  _test_factToStr();
-  _test_conditionParameters();
-  _test_wsModificationToStr();
-  _test_invertCondition();
-  _test_checkCondition();
-  _automaticallyRemoveGoalsWithAMaxTimeToKeepInactiveEqualTo0();
-  _maxTimeToKeepInactiveEqualTo0UnderAnAlreadySatisfiedGoal();
-  _noPreconditionGoalImmediatlyReached();
-  _removeGoalWhenItIsSatisfiedByAnAction();
-  _removeAnAction();
-  _removeSomeGoals();
-  _notifyGoalRemovedWhenItIsImmediatlyRemoved();
-  _handlePreconditionWithNegatedFacts();
-  _testWithNegatedAccessibleFacts();
-  _noPlanWithALengthOf2();
-  _noPlanWithALengthOf3();
-  _2preconditions();
-  _2Goals();
-  _2UnrelatedGoals();
-  _impossibleGoal();
-  _privigelizeTheActionsThatHaveManyPreferedInContext();
-  _preconditionThatCannotBeSolved();
-  _preferInContext();
-  _preferWhenPreconditionAreCloserToTheRealFacts();
-  _avoidToDo2TimesTheSameActionIfPossble();
-  _takeHistoricalIntoAccount();
-  _goDoTheActionThatHaveTheMostPreferInContextValidated();
-  _checkNotInAPrecondition();
-  _checkClearGoalsWhenItsAlreadySatisfied();
-  _checkActionHasAFact();
-  _precoditionEqualEffect();
-  _addGoalEvenForEmptyAction();
-  _circularDependencies();
-  _triggerActionThatRemoveAFact();
-  _actionWithConstantValue();
-  _actionWithParameterizedValue();
-  _actionWithParameterizedParameter();
-  _actionWithParametersInPreconditionsAndEffectsWithoutSolution();
-  _actionWithParametersInsideThePath();
-  _testPersistGoal();
-  _testPersistImplyGoal();
-  _testImplyGoal();
-  _checkPreviousBugAboutSelectingAnInappropriateAction();
-  _dontLinkActionWithPreferredInContext();
-  _checkPriorities();
-  _stackablePropertyOfGoals();
-  _doNotRemoveAGoalWithMaxTimeToKeepInactiveEqual0BelowAGoalWithACondotionNotSatisfied();
-  _checkMaxTimeToKeepInactiveForGoals();
-  _changePriorityOfGoal();
-  _factChangedNotification();
-  _checkEvents();
-  _checkEventsWithImply();
-  _checkEventWithPunctualCondition();
-  _checkEventAtEndOfAPlan();
-  _checkEventInsideAPlan();
-  _checkEventThatAddAGoal();
-  _testGetNotSatisfiedGoals();
-  _testGoalUnderPersist();
-  _checkLinkedEvents();
-  _oneStepTowards();
-  _infrenceLinksFromManyEventsSets();
-  _factValueModification();
-  _removeGoaWhenAnActionFinishesByAddingNewGoals();
-  _setWsModification();
-  _forAllWsModification();
-  _actionNavigationAndGrabObjectWithParameters();
-  _actionNavigationAndGrabObjectWithParameters2();
-  _moveObject();
-  _moveAndUngrabObject();
-  _failToMoveAnUnknownObject();
-  _completeMovingObjectScenario();
-  _moveAnObject();
-  _matchSkillWithObjectsWithASubType();
-  _eventWithANegatedFactWithParameter();
-  _actionWithANegatedFactNotTriggeredIfNotNecessary();
-  _useTwoTimesAnEvent();
-  _linkWithAnyValueInCondition();
-  _removeAFactWithAnyValue();
-  _notDeducePathIfTheParametersOfAFactAreDifferents();
-  _checkPreferInContext();
-  _checkPreferHighImportanceOfNotRepeatingIt();
-  _actionWithFactWithANegatedFact();
-  _negatedFactValueInWorldState();
-  _problemThatUseADomainThatChangedSinceLastUsage();
-  _checkFilterFactInCondition();
-  _checkFilterFactInConditionAndThenPropagate();
-  _checkOutputValueOfLookForAnActionToDo();
-  _hardProblemThatNeedsToBeSmart();
-  _hardProblemThatNeedsToBeSmartWithAnEvent();
-  _checkOverallEffectDuringParallelisation();
-  _checkSimpleExists();
-  _checkExistsWithActionParameterInvolved();
-  _checkExistsWithManyFactsInvolved();
-  _doAnActionToSatisfyAnExists();
-  _checkForAllEffectAtStart();
-  _existsWithValue();
-  _notExists();
-  _actionToSatisfyANotExists();
-  _orInCondition();
-  _axioms();
-  _assignAnotherValueToSatisfyNotGoal();
-  _assignUndefined();
-  _assignAFact();
-  _assignAFactToAction();
-  _assignAFactThenCheckEqualityWithAnotherFact();
-  _assignAFactThenCheckExistWithAnotherFact();
-  _existWithEqualityInEvent();
-  _existWithEqualityInEvent_withEqualityInverted();
-  _fixEventWithFluentInParameter();
-  _derivedPredicates();
-  _assignAFactTwoTimesInTheSamePlan();
-  _checkTwoTimesTheEqualityOfAFact();
-  _eventToRemoveAFactWithoutFluent();
+  for (const auto& currScenario : plannerWithSingleTypeScenarios())
+  {
+    SCOPED_TRACE(currScenario.name);
+    currScenario.function();
+  }
 }
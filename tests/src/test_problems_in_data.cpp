@@ -3,6 +3,7 @@
 #include <fstream>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/util/mappedfile.hpp>
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 #include <orderedgoalsplanner/util/serializer/serializeinpddl.hpp>
 #include <orderedgoalsplanner/orderedgoalsplanner.hpp>
@@ -13,22 +14,6 @@ using namespace ogp;
 namespace
 {
 
-std::string _getFileContent(const std::string& filePath)
-{
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        throw std::runtime_error("Error: Could not open file " + filePath);
-    }
-
-    std::string res;
-    std::string line;
-    while (std::getline(file, line))
-        res += line + "\n";
-
-    file.close();
-    return res;
-}
-
 std::string _getFileContentWithoutComments(const std::string& filePath)
 {
     std::ifstream file(filePath);
@@ -61,13 +46,17 @@ void _test_dataDirectory(const std::string& pDataPath,
 {
   auto directory = pDataPath + "/" + pProblemDirectory;
 
-  auto domainContent = _getFileContent(directory + "/domain.pddl");
   std::map<std::string, ogp::Domain> loadedDomains;
-  auto domain = ogp::pddlToDomain(domainContent, loadedDomains);
-  loadedDomains.emplace(domain.getName(), std::move(domain));
-
-  auto problemContent = _getFileContent(directory + "/problem.pddl");
-  ogp::DomainAndProblemPtrs domainAndProblemPtrs = ogp::pddlToProblem(problemContent, loadedDomains);
+  {
+    ogp::MappedFile domainFile(directory + "/domain.pddl");
+    auto domain = ogp::pddlToDomain(domainFile.content(), loadedDomains);
+    auto domainName = domain.getName();
+    loadedDomains.emplace(domainName, std::move(domain));
+  }
+
+  ogp::MappedFile problemFile(directory + "/problem.pddl");
+  ogp::DomainAndProblemPtrs domainAndProblemPtrs = ogp::pddlToProblem(problemFile.content(), loadedDomains);
+  auto& domain = *domainAndProblemPtrs.domainPtr;
   auto& problem = *domainAndProblemPtrs.problemPtr;
 
   std::string expected = _getFileContentWithoutComments(directory + "/problem.plan");
@@ -3,6 +3,7 @@
 #include <orderedgoalsplanner/types/setoffacts.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
 #include <orderedgoalsplanner/util/alias.hpp>
+#include <orderedgoalsplanner/util/util.hpp>
 
 using namespace ogp;
 
@@ -88,3 +89,54 @@ TEST(Tool, test_setOfFacts)
     EXPECT_EQ("[]", factToFacts.find(factWithParam, true).toStr());
   }
 }
+
+
+TEST(Tool, test_setOfFactsNumericRange)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("robot");
+  ontology.predicates = ogp::SetOfPredicates::fromStr("battery(?r - robot) - number", ontology.types);
+  auto entities = ogp::SetOfEntities::fromPddl("r1 r2 r3 r4 - robot", ontology.types);
+
+  SetOfFacts factToFacts;
+  factToFacts.add(ogp::Fact::fromStr("battery(r1)=10", ontology, entities, {}));
+  factToFacts.add(ogp::Fact::fromStr("battery(r2)=20", ontology, entities, {}));
+  factToFacts.add(ogp::Fact::fromStr("battery(r3)=35", ontology, entities, {}));
+  factToFacts.add(ogp::Fact::fromStr("battery(r4)=20.5", ontology, entities, {}));
+
+  auto batteryOfARobot = ogp::Fact::fromStr("battery(?r)=*", ontology, entities, {ogp::Parameter::fromStr("?r - robot", ontology.types)});
+  EXPECT_EQ("[battery(r4)=20.5, battery(r3)=35]", factToFacts.findInNumericRange(batteryOfARobot, 20, true, false).toStr());
+  EXPECT_EQ("[battery(r2)=20, battery(r4)=20.5, battery(r3)=35]", factToFacts.findInNumericRange(batteryOfARobot, 20, true, true).toStr());
+  EXPECT_EQ("[battery(r1)=10]", factToFacts.findInNumericRange(batteryOfARobot, 20, false, false).toStr());
+  EXPECT_EQ("[battery(r1)=10, battery(r2)=20]", factToFacts.findInNumericRange(batteryOfARobot, 20.2f, false, true).toStr());
+
+  EXPECT_TRUE(factToFacts.erase(ogp::Fact::fromStr("battery(r3)=35", ontology, entities, {})));
+  EXPECT_EQ("[battery(r4)=20.5]", factToFacts.findInNumericRange(batteryOfARobot, 20, true, false).toStr());
+
+  // The index and the comparison of the numbers have to agree, whatever int or float the values are.
+  factToFacts.add(ogp::Fact::fromStr("battery(r3)=20.0", ontology, entities, {}));
+  const std::vector<ogp::Number> bounds{20, 20.0f, 20.5f, 21, 10};
+  for (const auto& currBound : bounds)
+  {
+    for (bool superior : {true, false})
+    {
+      for (bool canBeEqual : {true, false})
+      {
+        std::size_t nbOfFactsInRange = 0;
+        for (const auto& currFact : factToFacts.findInNumericRange(batteryOfARobot, currBound, superior, canBeEqual))
+        {
+          EXPECT_TRUE(ogp::compIntNb(*currFact.fluent(), currBound, superior, canBeEqual));
+          ++nbOfFactsInRange;
+        }
+        std::size_t nbOfFactsExpected = 0;
+        for (const auto& currFact : factToFacts.facts())
+          if (ogp::compIntNb(*currFact.first.fluent(), currBound, superior, canBeEqual))
+            ++nbOfFactsExpected;
+        EXPECT_EQ(nbOfFactsExpected, nbOfFactsInRange);
+      }
+    }
+  }
+
+  SetOfFacts emptyFacts;
+  EXPECT_TRUE(emptyFacts.findInNumericRange(batteryOfARobot, 20, true, true).empty());
+}
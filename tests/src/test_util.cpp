@@ -1,6 +1,12 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
 #include <gtest/gtest.h>
 #include <orderedgoalsplanner/types/entity.hpp>
 #include <orderedgoalsplanner/types/parameter.hpp>
+#include <orderedgoalsplanner/util/mappedfile.hpp>
+#include <orderedgoalsplanner/util/trace.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 
 using namespace ogp;
@@ -84,8 +90,134 @@ void test_autoIncrementOfVersion()
 }
 
 
+void test_numericEntities()
+{
+  EXPECT_TRUE(_entity("12").number.has_value());
+  EXPECT_TRUE(_entity("-3.5").number.has_value());
+  EXPECT_FALSE(_entity("s1").number.has_value());
+  EXPECT_FALSE(_entity("?battery").number.has_value());
+  EXPECT_FALSE(_entity("1a").number.has_value());
+
+  auto sum = ogp::plusIntOrStr(_entity("40"), _entity("2"));
+  ASSERT_TRUE(sum.has_value());
+  EXPECT_EQ("42", sum->value);
+  EXPECT_TRUE(sum->number && std::get<int>(*sum->number) == 42);
+  EXPECT_EQ("38", ogp::minusIntOrStr(_entity("40"), _entity("2"))->value);
+  EXPECT_EQ("80", ogp::multiplyNbOrStr(_entity("40"), _entity("2"))->value);
+  EXPECT_EQ("ab", ogp::plusIntOrStr(_entity("a"), _entity("b"))->value);
+
+  EXPECT_TRUE(ogp::compIntNb(_entity("5"), ogp::Number(3.5f), true, false));
+  EXPECT_FALSE(ogp::compIntNb(_entity("3"), ogp::Number(3.5f), true, false));
+  EXPECT_TRUE(ogp::compIntNb(_entity("3"), ogp::Number(3), false, true));
+  EXPECT_FALSE(ogp::compIntNb(_entity("a"), ogp::Number(3), false, true));
+  // An int and a float with the same value are equal
+  EXPECT_TRUE(ogp::compIntNb(_entity("20"), ogp::Number(20.0f), true, true));
+  EXPECT_TRUE(ogp::compIntNb(_entity("20"), ogp::Number(20.0f), false, true));
+  EXPECT_FALSE(ogp::compIntNb(_entity("20"), ogp::Number(20.0f), true, false));
+  EXPECT_FALSE(ogp::compIntNb(_entity("20"), ogp::Number(20.0f), false, false));
+  EXPECT_TRUE(ogp::compIntNb(_entity("20.0"), ogp::Number(20), true, true));
+  EXPECT_FALSE(ogp::compIntNb(_entity("16777217"), ogp::Number(16777216), true, true) &&
+               ogp::compIntNb(_entity("16777217"), ogp::Number(16777216), false, true));
+
+  auto entity = _entity("*");
+  entity.setValue("7");
+  EXPECT_TRUE(entity.number && std::get<int>(*entity.number) == 7);
+}
+
+
+void test_trace()
+{
+  auto traceFilePath = (std::filesystem::temp_directory_path() / "ogp_test_trace.json").string();
+  {
+    ogp::TraceSpan spanBeforeTracing("beforeTracing");
+  }
+  EXPECT_FALSE(ogp::isTracing());
+  ogp::startTracing(traceFilePath);
+  EXPECT_TRUE(ogp::isTracing());
+  {
+    ogp::TraceSpan parentSpan("parent");
+    ogp::TraceSpan childSpan("child");
+  }
+  ogp::stopTracing();
+  EXPECT_FALSE(ogp::isTracing());
+  {
+    ogp::TraceSpan spanAfterTracing("afterTracing");
+  }
+
+  std::ifstream traceFile(traceFilePath);
+  std::stringstream traceStream;
+  traceStream << traceFile.rdbuf();
+  auto trace = traceStream.str();
+  std::filesystem::remove(traceFilePath);
+  EXPECT_EQ('[', trace.front());
+  EXPECT_EQ("]\n", trace.substr(trace.size() - 2));
+  auto childPos = trace.find("{\"name\":\"child\",\"cat\":\"ogp\",\"ph\":\"X\"");
+  auto parentPos = trace.find("{\"name\":\"parent\",\"cat\":\"ogp\",\"ph\":\"X\"");
+  EXPECT_NE(std::string::npos, childPos);
+  EXPECT_NE(std::string::npos, parentPos);
+  EXPECT_LT(childPos, parentPos);
+  EXPECT_EQ(std::string::npos, trace.find("Tracing"));
+
+  // A span begun before a restart of the tracing is not written in the new trace
+  ogp::startTracing(traceFilePath);
+  {
+    ogp::TraceSpan spanBeforeRestart("beforeRestart");
+    ogp::startTracing(traceFilePath);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < 4; ++i)
+      threads.emplace_back([] { ogp::TraceSpan spanOfAThread("ofAThread"); });
+    for (auto& currThread : threads)
+      currThread.join();
+  }
+  ogp::stopTracing();
+  std::ifstream restartedTraceFile(traceFilePath);
+  std::stringstream restartedTraceStream;
+  restartedTraceStream << restartedTraceFile.rdbuf();
+  trace = restartedTraceStream.str();
+  std::filesystem::remove(traceFilePath);
+  EXPECT_EQ(std::string::npos, trace.find("beforeRestart"));
+  std::size_t nbOfThreadSpans = 0;
+  for (auto pos = trace.find("ofAThread"); pos != std::string::npos; pos = trace.find("ofAThread", pos + 1))
+    ++nbOfThreadSpans;
+  EXPECT_EQ(4u, nbOfThreadSpans);
+}
+
+
+void test_mappedFile()
+{
+  auto filePath = (std::filesystem::temp_directory_path() / "ogp_test_mapped_file.pddl").string();
+  const std::string content = "(define (problem p)\n  (:init (a))\n)\n";
+  {
+    std::ofstream file(filePath, std::ios::binary);
+    file << content;
+  }
+
+  ogp::MappedFile mappedFile(filePath);
+  EXPECT_EQ(content.size(), mappedFile.size());
+  EXPECT_EQ(content, mappedFile.content());
+
+  // The content stays valid after a move
+  ogp::MappedFile movedMappedFile(std::move(mappedFile));
+  EXPECT_EQ(content, movedMappedFile.content());
+  EXPECT_EQ(0u, mappedFile.size());
+
+  {
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+  }
+  ogp::MappedFile emptyMappedFile(filePath);
+  EXPECT_EQ(0u, emptyMappedFile.size());
+  EXPECT_TRUE(emptyMappedFile.content().empty());
+
+  std::filesystem::remove(filePath);
+  EXPECT_THROW(ogp::MappedFile missingFile(filePath), std::runtime_error);
+}
+
+
 TEST(Tool, test_util)
 {
   test_unfoldMapWithSet();
   test_autoIncrementOfVersion();
+  test_numericEntities();
+  test_trace();
+  test_mappedFile();
 }
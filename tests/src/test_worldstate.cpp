@@ -1,10 +1,13 @@
 #include <gtest/gtest.h>
+#include <orderedgoalsplanner/types/conditionprogram.hpp>
 #include <orderedgoalsplanner/types/goalstack.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
 #include <orderedgoalsplanner/types/setofcallbacks.hpp>
 #include <orderedgoalsplanner/types/setofevents.hpp>
 #include <orderedgoalsplanner/types/setofpredicates.hpp>
 #include <orderedgoalsplanner/types/worldstate.hpp>
+#include <orderedgoalsplanner/types/worldstatemodification.hpp>
+#include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 
 using namespace ogp;
 
@@ -61,3 +64,234 @@ TEST(Tool, test_wordstate)
   _modifyFactsFromPddl(worldstate, "(= (pred_e ent_b) undefined)", ontology, entities);
   EXPECT_EQ("(pred_a ent_a)\n(pred_b)", worldstate.factsMapping().toPddl(0, true));
 }
+
+
+
+TEST(Tool, test_wordstateNumericRangeCondition)
+{
+  ogp::WorldState worldstate;
+
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("robot");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(battery ?r - robot) - number", pos, ontology.types);
+  }
+  auto entities = ogp::SetOfEntities::fromPddl("r1 r2 r3 - robot", ontology.types);
+  auto pddlToCondition = [&](const std::string& pStr, const std::vector<ogp::Parameter>& pParameters) {
+    std::size_t pos = 0;
+    return ogp::pddlToCondition(pStr, pos, ontology, entities, pParameters);
+  };
+  _modifyFactsFromPddl(worldstate, "(= (battery r1) 10)\n(= (battery r2) 30)\n(= (battery r3) 25)", ontology, entities);
+
+  const std::vector<ogp::Parameter> parameters{ogp::Parameter::fromStr("?r - robot", ontology.types)};
+  auto condition = pddlToCondition("(> (battery ?r) 20)", parameters);
+  std::map<ogp::Parameter, std::set<ogp::Entity>> parametersToArguments{{parameters.front(), {}}};
+  EXPECT_TRUE(condition->isTrue(worldstate, {}, {}, &parametersToArguments));
+  EXPECT_EQ(2u, parametersToArguments[parameters.front()].size());
+  EXPECT_EQ(0u, parametersToArguments[parameters.front()].count(*entities.valueToEntity("r1")));
+
+  auto notCondition = pddlToCondition("(not (> (battery ?r) 20))", parameters);
+  std::map<ogp::Parameter, std::set<ogp::Entity>> parametersToArguments2{{parameters.front(), {}}};
+  EXPECT_TRUE(notCondition->isTrue(worldstate, {}, {}, &parametersToArguments2));
+  ASSERT_EQ(1u, parametersToArguments2[parameters.front()].size());
+  EXPECT_EQ("r1", parametersToArguments2[parameters.front()].begin()->value);
+
+  auto impossibleCondition = pddlToCondition("(> (battery ?r) 40)", parameters);
+  std::map<ogp::Parameter, std::set<ogp::Entity>> parametersToArguments3{{parameters.front(), {}}};
+  EXPECT_FALSE(impossibleCondition->isTrue(worldstate, {}, {}, &parametersToArguments3));
+}
+
+
+
+TEST(Tool, test_wordstateNumericRangeConditionWithIntAndFloatFluents)
+{
+  ogp::WorldState worldstate;
+
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("robot");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(battery ?r - robot) - number", pos, ontology.types);
+  }
+  auto entities = ogp::SetOfEntities::fromPddl("r1 r2 r3 r4 - robot", ontology.types);
+  auto pddlToCondition = [&](const std::string& pStr, const std::vector<ogp::Parameter>& pParameters) {
+    std::size_t pos = 0;
+    return ogp::pddlToCondition(pStr, pos, ontology, entities, pParameters);
+  };
+  _modifyFactsFromPddl(worldstate, "(= (battery r1) 10)\n(= (battery r2) 20)\n(= (battery r3) 20.0)\n(= (battery r4) 20.5)", ontology, entities);
+
+  const std::vector<ogp::Parameter> parameters{ogp::Parameter::fromStr("?r - robot", ontology.types)};
+  auto robotsInRange = [&](const ogp::WorldState& pWorldState, const std::string& pConditionStr) {
+    std::map<ogp::Parameter, std::set<ogp::Entity>> parametersToArguments{{parameters.front(), {}}};
+    pddlToCondition(pConditionStr, parameters)->isTrue(pWorldState, {}, {}, &parametersToArguments);
+    std::string res;
+    for (const auto& currRobot : parametersToArguments[parameters.front()])
+      res += (res.empty() ? "" : " ") + currRobot.value;
+    return res;
+  };
+  EXPECT_EQ("r2 r3 r4", robotsInRange(worldstate, "(>= (battery ?r) 20.0)"));
+  EXPECT_EQ("r4", robotsInRange(worldstate, "(> (battery ?r) 20)"));
+  EXPECT_EQ("r1", robotsInRange(worldstate, "(< (battery ?r) 20.0)"));
+  EXPECT_EQ("r4", robotsInRange(worldstate, "(not (<= (battery ?r) 20))"));
+
+  // The range scan has to bind the same robots as the comparison of each grounded fact.
+  for (const auto* comparison : {">", ">=", "<", "<="})
+  {
+    for (const auto* bound : {"10", "20", "20.0", "20.5", "21"})
+    {
+      for (bool negated : {false, true})
+      {
+        auto conditionStr = [&](const std::string& pRobot) {
+          std::string res = std::string("(") + comparison + " (battery " + pRobot + ") " + bound + ")";
+          return negated ? "(not " + res + ")" : res;
+        };
+        std::string expectedRobots;
+        for (const auto* robot : {"r1", "r2", "r3", "r4"})
+          if (pddlToCondition(conditionStr(robot), {})->isTrue(worldstate))
+            expectedRobots += (expectedRobots.empty() ? "" : " ") + std::string(robot);
+        EXPECT_EQ(expectedRobots, robotsInRange(worldstate, conditionStr("?r"))) << conditionStr("?r");
+      }
+    }
+  }
+
+  // A copy of the world state keeps its own index of the numeric values.
+  ogp::WorldState copiedWorldstate(worldstate);
+  _modifyFactsFromPddl(worldstate, "(= (battery r4) undefined)", ontology, entities);
+  EXPECT_EQ("", robotsInRange(worldstate, "(> (battery ?r) 20)"));
+  EXPECT_EQ("r4", robotsInRange(copiedWorldstate, "(> (battery ?r) 20)"));
+}
+
+
+TEST(Tool, test_conditionProgram)
+{
+  ogp::WorldState worldstate;
+
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("robot");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(charging ?r - robot)\n"
+                                                         "(ready)\n"
+                                                         "(battery ?r - robot) - number", pos, ontology.types);
+  }
+  auto entities = ogp::SetOfEntities::fromPddl("r1 r2 - robot", ontology.types);
+  _modifyFactsFromPddl(worldstate, "(charging r1)\n(= (battery r1) 10)\n(= (battery r2) 30)", ontology, entities);
+
+  const std::vector<ogp::Parameter> parameters{ogp::Parameter::fromStr("?r - robot", ontology.types)};
+  for (const auto* conditionStr : {"(ready)",
+                                   "(not (ready))",
+                                   "(and (charging ?r) (not (ready)))",
+                                   "(or (ready) (charging ?r))",
+                                   "(imply (charging r1) (ready))",
+                                   "(not (and (charging r2) (ready)))",
+                                   "(and (not (charging ?r)) (> (battery ?r) 20))",
+                                   "(exists (?x - robot) (charging ?x))"})
+  {
+    SCOPED_TRACE(conditionStr);
+    std::size_t pos = 0;
+    auto condition = ogp::pddlToCondition(conditionStr, pos, ontology, entities, parameters);
+    ogp::ConditionProgram program(*condition);
+
+    std::map<ogp::Parameter, std::set<ogp::Entity>> treeParameters{{parameters.front(), {}}};
+    std::map<ogp::Parameter, std::set<ogp::Entity>> programParameters{{parameters.front(), {}}};
+    EXPECT_EQ(condition->isTrue(worldstate, {}, {}, &treeParameters),
+              program.isTrue(worldstate, {}, {}, &programParameters));
+    EXPECT_EQ(treeParameters, programParameters);
+    EXPECT_EQ(condition->isTrue(worldstate), program.isTrue(worldstate));
+    EXPECT_EQ(condition->canBecomeTrue(worldstate, parameters), program.canBecomeTrue(worldstate, parameters));
+  }
+}
+
+
+TEST(Tool, test_goalSatisfactionCache)
+{
+  ogp::WorldState worldstate;
+
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("entity");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(pred_a ?e - entity)\n"
+                                                         "(pred_b ?e - entity)", pos, ontology.types);
+  }
+  auto entities = ogp::SetOfEntities::fromPddl("toto titi - entity", ontology.types);
+  std::size_t pos = 0;
+  ogp::Goal goal(ogp::pddlToCondition("(and (pred_a toto) (not (pred_b titi)))", pos, ontology, entities, {}));
+
+  EXPECT_FALSE(worldstate.isGoalSatisfied(goal));
+  _modifyFactsFromPddl(worldstate, "(pred_a toto)", ontology, entities);
+  EXPECT_TRUE(worldstate.isGoalSatisfied(goal));
+  _modifyFactsFromPddl(worldstate, "(pred_a titi)\n(pred_b toto)", ontology, entities);
+  EXPECT_TRUE(worldstate.isGoalSatisfied(goal));
+  _modifyFactsFromPddl(worldstate, "(pred_b titi)", ontology, entities);
+  EXPECT_FALSE(worldstate.isGoalSatisfied(goal));
+
+  // A copy of the world state has its own history of modifications
+  ogp::WorldState worldstateCopied(worldstate);
+  _modifyFactsFromPddl(worldstateCopied, "(not (pred_b titi))", ontology, entities);
+  EXPECT_TRUE(worldstateCopied.isGoalSatisfied(goal));
+  EXPECT_FALSE(worldstate.isGoalSatisfied(goal));
+}
+
+
+
+TEST(Tool, test_worldStateModificationWithArguments)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("robot location");
+  {
+    std::size_t pos = 0;
+    ontology.predicates = ogp::SetOfPredicates::fromPddl("(at ?r - robot) - location\n"
+                                                         "(busy ?r - robot)\n"
+                                                         "(battery ?r - robot) - number", pos, ontology.types);
+  }
+  auto entities = ogp::SetOfEntities::fromPddl("r1 r2 - robot\n"
+                                               "kitchen bedroom - location", ontology.types);
+  const std::vector<ogp::Parameter> parameters{ogp::Parameter::fromStr("?r - robot", ontology.types),
+                                               ogp::Parameter::fromStr("?l - location", ontology.types)};
+  std::size_t pos = 0;
+  auto effect = ogp::pddlToWsModification("(and (assign (at ?r) ?l) (busy ?r) (increase (battery ?r) 2))",
+                                          pos, ontology, entities, parameters);
+  const std::map<ogp::Parameter, ogp::Entity> parametersToArgument{{parameters[0], *entities.valueToEntity("r1")},
+                                                                   {parameters[1], *entities.valueToEntity("kitchen")}};
+  // The views with the arguments have to behave like the clone filled with the arguments
+  auto effectFilled = effect->clone(&parametersToArgument);
+
+  auto factsThatCanBeModified = [](const ogp::WorldStateModification& pWsModif,
+                                   const std::map<ogp::Parameter, ogp::Entity>* pParametersToArgumentPtr) {
+    std::set<ogp::FactOptional> res;
+    pWsModif.forAllThatCanBeModified([&](const ogp::FactOptional& pFactOptional) {
+      res.insert(pFactOptional);
+      return ogp::ContinueOrBreak::CONTINUE;
+    }, pParametersToArgumentPtr);
+    return res;
+  };
+  auto facts = factsThatCanBeModified(*effect, &parametersToArgument);
+  EXPECT_EQ(factsThatCanBeModified(*effectFilled, nullptr), facts);
+  EXPECT_EQ(3u, facts.size());
+
+  for (const auto* factsStr : {"at(r1)=bedroom", "at(r2)=bedroom", "!busy(r1)", "busy(r2)"})
+  {
+    SCOPED_TRACE(factsStr);
+    std::set<ogp::FactOptional> factsOpt{ogp::FactOptional(factsStr, ontology, entities, {})};
+    EXPECT_EQ(effectFilled->hasAContradictionWith(factsOpt),
+              effect->hasAContradictionWith(factsOpt, nullptr, &parametersToArgument));
+  }
+  std::set<ogp::FactOptional> atR1InBedroom{ogp::FactOptional("at(r1)=bedroom", ontology, entities, {})};
+  EXPECT_TRUE(effect->hasAContradictionWith(atR1InBedroom, nullptr, &parametersToArgument));
+  std::set<ogp::FactOptional> atR2InBedroom{ogp::FactOptional("at(r2)=bedroom", ontology, entities, {})};
+  EXPECT_FALSE(effect->hasAContradictionWith(atR2InBedroom, nullptr, &parametersToArgument));
+
+  ogp::WorldState worldStateWithView;
+  _modifyFactsFromPddl(worldStateWithView, "(= (battery r1) 3)\n(= (battery r2) 5)", ontology, entities);
+  ogp::WorldState worldStateWithClone(worldStateWithView);
+  GoalStack goalStack;
+  const std::map<SetOfEventsId, SetOfEvents> setOfEvents;
+  const SetOfCallbacks callbacks;
+  worldStateWithView.modify(&*effect, goalStack, setOfEvents, callbacks, ontology, entities, {}, true, &parametersToArgument);
+  worldStateWithClone.modify(&*effectFilled, goalStack, setOfEvents, callbacks, ontology, entities, {});
+  EXPECT_EQ("(= (at r1) kitchen)\n(= (battery r1) 5)\n(= (battery r2) 5)\n(busy r1)",
+            worldStateWithView.factsMapping().toPddl(0, true));
+  EXPECT_EQ(worldStateWithClone.factsMapping().toPddl(0, true), worldStateWithView.factsMapping().toPddl(0, true));
+}